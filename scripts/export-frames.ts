@@ -0,0 +1,36 @@
+/**
+ * Render a saved timeline (the "Save Timeline" JSON) to a frame-sequence
+ * archive without a browser:
+ *
+ *   npm run export-frames -- timeline.json animation.tar [gridSize]
+ *
+ * Frames are computed with the same DOM-free code the web workers run.
+ */
+import { readFileSync, writeFileSync } from 'node:fs';
+import { FrameCache, computeFrame, encodeFrame } from '../src/models/FrameCache';
+import { generateGridPositions } from '../src/models/FieldKernel';
+import { timelineFrameCount } from '../src/models/Timeline';
+import type { Timeline } from '../src/models/Timeline';
+import { buildFrameArchive } from '../src/export/FrameArchive';
+
+const [timelinePath, outputPath = 'animation.tar', gridSizeArgument = '8'] = process.argv.slice(2);
+if (!timelinePath) {
+  console.error('Usage: export-frames <timeline.json> [output.tar] [gridSize]');
+  process.exit(1);
+}
+
+const timeline = JSON.parse(readFileSync(timelinePath, 'utf8')) as Timeline;
+const bounds = { min: { x: -5, y: -5, z: -5 }, max: { x: 5, y: 5, z: 5 } };
+const gridPositions = generateGridPositions(bounds.min, bounds.max, parseInt(gridSizeArgument, 10) || 8);
+const lineConfig = { stepSize: 0.1, minStepSize: 0.01, maxSteps: 1000, bounds, linesPerCharge: 8 };
+
+const frameCount = timelineFrameCount(timeline);
+const cache = new FrameCache(timeline.fps, gridPositions, frameCount);
+for (let i = 0; i < frameCount; i++) {
+  cache.setFrame(i, encodeFrame(computeFrame(timeline, i / timeline.fps, gridPositions, lineConfig)));
+  process.stdout.write(`\rFrame ${i + 1}/${frameCount}`);
+}
+process.stdout.write('\n');
+
+writeFileSync(outputPath, buildFrameArchive(cache));
+console.log(`Wrote ${outputPath} (${(cache.byteLength / (1024 * 1024)).toFixed(1)} MB of frames)`);
@@ -0,0 +1,73 @@
+/**
+ * Compute the field of a saved scene (.efvs) and write it for ParaView and
+ * other VTK tools without a browser:
+ *
+ *   npm run export-vtk -- scene.efvs fields.tar [legacy|xml|raw] [gridSize]
+ *
+ * An output path not ending in .tar is treated as a directory and the files
+ * are written into it.
+ */
+import { mkdirSync, readFileSync, writeFileSync } from 'node:fs';
+import { join } from 'node:path';
+import { decodeScene } from '../src/export/SceneFile';
+import { buildTarArchive } from '../src/export/TarArchive';
+import { buildVtkExport, exportGridFromSamples } from '../src/export/VtkExport';
+import type { VtkFormat } from '../src/export/VtkExport';
+import { buildChargeTree, chargeTreeFieldBatch } from '../src/models/ChargeTree';
+import { generateGridPositions } from '../src/models/FieldKernel';
+import { DATASET_SEED_CHARGES, traceFieldLines } from '../src/models/FieldLineTracer';
+
+const [scenePath, outputPath = 'fields.tar', formatArgument = 'xml', gridSizeArgument = '32'] = process.argv.slice(2);
+if (!scenePath || !['legacy', 'xml', 'raw'].includes(formatArgument)) {
+  console.error('Usage: export-vtk <scene.efvs> [output.tar | directory] [legacy|xml|raw] [gridSize]');
+  process.exit(1);
+}
+
+const sceneData = decodeScene(readFileSync(scenePath));
+const charges = {
+  count: sceneData.magnitudes.length,
+  positions: sceneData.positions,
+  magnitudes: sceneData.magnitudes,
+};
+// Saved datasets can hold millions of charges: evaluate them through an
+// octree and seed lines from a bounded sample of them
+const tree = buildChargeTree(charges);
+
+// A cube around the charges with a margin of a quarter of its size (and at
+// least one scene unit), since the grid uses one spacing for all axes
+const low = [Infinity, Infinity, Infinity];
+const high = [-Infinity, -Infinity, -Infinity];
+for (let i = 0; i < charges.count; i++) {
+  for (let a = 0; a < 3; a++) {
+    low[a] = Math.min(low[a], charges.positions[i * 3 + a]);
+    high[a] = Math.max(high[a], charges.positions[i * 3 + a]);
+  }
+}
+const centre = charges.count > 0 ? low.map((value, a) => 0.5 * (value + high[a])) : [0, 0, 0];
+const extent = charges.count > 0 ? 0.5 * Math.max(high[0] - low[0], high[1] - low[1], high[2] - low[2]) : 4;
+const half = Math.max(1.25 * extent, extent + 1);
+const bounds = {
+  min: { x: centre[0] - half, y: centre[1] - half, z: centre[2] - half },
+  max: { x: centre[0] + half, y: centre[1] + half, z: centre[2] + half },
+};
+
+const gridPositions = generateGridPositions(bounds.min, bounds.max, parseInt(gridSizeArgument, 10) || 32);
+const field = new Float32Array(gridPositions.length);
+const potential = new Float32Array(gridPositions.length / 3);
+chargeTreeFieldBatch(tree, gridPositions, field, potential);
+const lineConfig = { stepSize: 0.1, minStepSize: 0.01, maxSteps: 1000, bounds, linesPerCharge: 8 };
+
+const entries = buildVtkExport({
+  format: formatArgument as VtkFormat,
+  grid: exportGridFromSamples(gridPositions, field, potential, 'E'),
+  lines: traceFieldLines(tree, lineConfig, DATASET_SEED_CHARGES),
+  mesh: null,
+});
+
+if (outputPath.endsWith('.tar')) {
+  writeFileSync(outputPath, buildTarArchive(entries));
+} else {
+  mkdirSync(outputPath, { recursive: true });
+  for (const entry of entries) writeFileSync(join(outputPath, entry.name), entry.data);
+}
+console.log(`Wrote ${entries.map((entry) => entry.name).join(', ')} to ${outputPath}`);
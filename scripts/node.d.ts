@@ -0,0 +1,20 @@
+// The few Node APIs the command-line tools use. Declared here rather than
+// pulled in from @types/node so the scripts type-check against the same
+// dependency set as the app; extend as the tools need more.
+
+declare module 'node:fs' {
+  export function readFileSync(path: string): Uint8Array;
+  export function readFileSync(path: string, encoding: 'utf8'): string;
+  export function writeFileSync(path: string, data: string | Uint8Array): void;
+  export function mkdirSync(path: string, options?: { recursive?: boolean }): void;
+}
+
+declare module 'node:path' {
+  export function join(...paths: string[]): string;
+}
+
+declare const process: {
+  argv: string[];
+  exit(code?: number): never;
+  stdout: { write(text: string): boolean };
+};
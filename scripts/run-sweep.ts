@@ -0,0 +1,31 @@
+/**
+ * Run a parameter sweep (the Parameter Sweep panel's "JSON" download) and
+ * write the metrics as CSV without a browser:
+ *
+ *   npm run run-sweep -- sweep.json sweep.csv
+ *
+ * Uses the same evaluator as the sweep workers, on a single thread.
+ */
+import { readFileSync, writeFileSync } from 'node:fs';
+import { runSweep, sweepConfigurationCount } from '../src/models/ParameterSweep';
+import type { SweepSpec } from '../src/models/ParameterSweep';
+import { buildSweepCsv } from '../src/export/SweepCsv';
+
+const [specPath, outputPath = 'sweep.csv'] = process.argv.slice(2);
+if (!specPath) {
+  console.error('Usage: run-sweep <sweep.json> [output.csv]');
+  process.exit(1);
+}
+
+const spec = JSON.parse(readFileSync(specPath, 'utf8')) as SweepSpec;
+spec.surfaces = spec.surfaces.map((surface) =>
+  surface.kind === 'mesh' ? { ...surface, triangles: Float32Array.from(surface.triangles) } : surface
+);
+
+const start = performance.now();
+const result = runSweep(spec);
+writeFileSync(outputPath, buildSweepCsv(result));
+console.log(
+  `Wrote ${outputPath}: ${sweepConfigurationCount(spec)} configurations × ${result.metrics.length} metrics ` +
+    `in ${((performance.now() - start) / 1000).toFixed(2)} s`
+);
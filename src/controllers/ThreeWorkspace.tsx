@@ -1,24 +1,121 @@
-import React, { useRef, useEffect, useState, useCallback } from 'react';
+import React, { useRef, useEffect, useState, useCallback, useMemo } from 'react';
 import { OrbitControls } from 'three/addons/controls/OrbitControls.js';
 import * as THREE from 'three';
 import { WebGPURenderer } from 'three/webgpu';
-import { createDefaultCharge, createCharge, electricFieldAt } from '../models/Charge';
+import { createDefaultCharge, createCharge } from '../models/Charge';
 import type { Charge } from '../models/Charge';
 import { VectorFieldRenderer, createDefaultVectorFieldConfig } from '../views/VectorField';
 import { FieldLineRenderer, createDefaultFieldLineConfig } from '../views/FieldLines';
+import { ParticleTracerRenderer, createDefaultParticleTracerConfig } from '../views/ParticleTracer';
+import ParticleTracerPanel from '../views/ParticleTracerPanel';
+import type { ParticleSwarmConfig } from '../models/TestParticles';
+import { OscillatingSourceRenderer } from '../views/OscillatingSources';
+import OscillatorPanel from '../views/OscillatorPanel';
+import type { OscillatingSource } from '../models/PhasorField';
+import { MovingChargeRenderer, createDefaultMovingChargeConfig } from '../views/MovingCharges';
+import MovingChargesPanel from '../views/MovingChargesPanel';
+import type { MovingCharge } from '../models/LienardWiechert';
+import { CurrentSourceRenderer } from '../views/CurrentSources';
+import CurrentsPanel from '../views/CurrentsPanel';
+import type { CurrentSource } from '../models/Current';
+import type { FieldKind } from '../models/FieldKernel';
+import { KeyframePlayer, createDefaultKeyframePlayerConfig } from '../views/KeyframePlayer';
+import TimelinePanel from '../views/TimelinePanel';
+import { setKeyframe } from '../models/Timeline';
+import type { Timeline } from '../models/Timeline';
+import { buildFrameArchive } from '../export/FrameArchive';
+import { GaussSurfaceRenderer } from '../views/GaussSurfaces';
+import GaussPanel from '../views/GaussPanel';
+import { GaussFluxIntegrator } from '../models/GaussFlux';
+import type { GaussFluxResult } from '../models/GaussFlux';
+import { parseObjTriangles } from '../models/GaussSurface';
+import type { GaussSurface } from '../models/GaussSurface';
+import { IntegrationPathRenderer } from '../views/IntegrationPath';
+import PathIntegralPanel from '../views/PathIntegralPanel';
+import { pathLineIntegral } from '../models/PathIntegral';
+import { NullPointRenderer } from '../views/NullPoints';
+import NullPointPanel from '../views/NullPointPanel';
+import { findNullPoints } from '../models/NullPoints';
+import type { NullPoint } from '../models/NullPoints';
+import { ForceArrowRenderer } from '../views/ForceArrows';
+import ForcePanel from '../views/ForcePanel';
+import { ChargeInteractions, groupForceAndTorque } from '../models/ChargeForces';
+import type { ChargeInteractionResult } from '../models/ChargeForces';
+import CapacitancePanel from '../views/CapacitancePanel';
+import { conductorTriangles, createDefaultCapacitanceOptions } from '../models/Capacitance';
+import type { CapacitanceResult, Conductor } from '../models/Capacitance';
+import { WorkerPool } from '../workers/WorkerPool';
+import type { CapacitanceWorkerRequest, CapacitanceWorkerResult } from '../workers/capacitance.worker';
+import InverseDesignPanel from '../views/InverseDesignPanel';
+import { createDefaultInverseDesignOptions } from '../models/InverseDesign';
+import type { InverseDesignOptions, InverseDesignResult } from '../models/InverseDesign';
+import type { InverseDesignWorkerRequest, InverseDesignWorkerResult } from '../workers/inverseDesign.worker';
+import { chargeTreeFieldBatch } from '../models/ChargeTree';
+import { OptimizationPathRenderer } from '../views/OptimizationPath';
+import type { OptimizerProgress } from '../views/OptimizationPath';
+import OptimizerPanel from '../views/OptimizerPanel';
+import { createDefaultLbfgsOptions } from '../models/Lbfgs';
+import { createDefaultPositionPenalties, objectiveSamples } from '../models/PositionObjective';
+import type { PositionObjective } from '../models/PositionObjective';
+import SweepPanel from '../views/SweepPanel';
+import {
+  scatterSweepRows,
+  sweepAxisValues,
+  sweepEvaluationOrder,
+  sweepMetricNames,
+  sweepParameterLabel,
+} from '../models/ParameterSweep';
+import type { SweepAxis, SweepResult, SweepSpec } from '../models/ParameterSweep';
+import type { SweepWorkerRequest, SweepWorkerResult } from '../workers/sweep.worker';
+import { buildSweepCsv } from '../export/SweepCsv';
+import { packCharges } from '../models/FieldKernel';
+import type { Vec3Like } from '../models/FieldKernel';
+import { sourcesFieldBatch } from '../models/FieldSources';
+import { VoltageProbeRenderer } from '../views/VoltageProbes';
+import type { ProbeBuffer } from '../views/VoltageProbes';
+import VoltagePointsList from '../views/VoltagePointsList';
+import { ProbeShapeRenderer } from '../views/ProbeShapes';
+import ProbePlotPanel from '../views/ProbePlotPanel';
+import { PotentialSliceRenderer, createDefaultPotentialSliceConfig } from '../views/PotentialSlice';
+import type { PotentialSliceConfig, SliceProgress } from '../views/PotentialSlice';
+import type { SlicePlane } from '../models/PotentialSlice';
+import PotentialSlicePanel from '../views/PotentialSlicePanel';
+import { HeightFieldRenderer, createDefaultHeightFieldConfig } from '../views/HeightField';
+import type { HeightFieldConfig, HeightFieldStats } from '../views/HeightField';
+import HeightFieldPanel from '../views/HeightFieldPanel';
+import { ChargeStore } from '../models/ChargeStore';
+import { ChargeCloudRenderer } from '../views/ChargeCloud';
+import { encodeScene } from '../export/SceneFile';
+import type { SceneData } from '../export/SceneFile';
+import type { SceneImportWorkerMessage, SceneImportWorkerRequest } from '../workers/sceneImport.worker';
+import SceneFilePanel from '../views/SceneFilePanel';
+import { chargeTextFormatFor } from '../export/ChargeTextParser';
+import type { ChargeTextOptions } from '../export/ChargeTextParser';
+import type {
+  ChargeTextImportWorkerMessage,
+  ChargeTextImportWorkerRequest,
+} from '../workers/chargeTextImport.worker';
+import type { SceneFileStatus } from '../views/SceneFilePanel';
+import { exportGridFromSamples } from '../export/VtkExport';
+import type { VtkFormat } from '../export/VtkExport';
+import { buildTarArchive } from '../export/TarArchive';
+import type { VtkExportWorkerRequest, VtkExportWorkerResult } from '../workers/vtkExport.worker';
+import { gltfGeometryFromBufferGeometry } from '../export/GltfExport';
+import type { GltfNodeSource } from '../export/GltfExport';
+import type { GltfExportWorkerRequest, GltfExportWorkerResult } from '../workers/gltfExport.worker';
+import { URL_STATE_PREFIX, decodeUrlState, encodeUrlState } from '../export/UrlState';
+import type { UrlStateOptions } from '../export/UrlState';
+import type { ProbeSamples, ProbeShape } from '../models/ProbeSampling';
 import { createVoltagePoint } from '../models/VoltagePoint';
 import type { VoltagePoint } from '../models/VoltagePoint';
 
-let renderer: WebGPURenderer | THREE.WebGLRenderer;
+// WebGPURenderer falls back to a WebGL 2 backend by itself, so node-material
+// shaders (e.g. the field-line flow glyphs) work on every browser
+const renderer = new WebGPURenderer({ antialias: true });
 const scene = new THREE.Scene();
 const camera = new THREE.PerspectiveCamera(70, window.innerWidth / window.innerHeight, 0.1, 2000);
 let controls: OrbitControls;
 
-if ('gpu' in navigator) {
-  renderer = new WebGPURenderer({ antialias: true });
-} else {
-  renderer = new THREE.WebGLRenderer({ antialias: true });
-}
 renderer.setClearColor(0x282c34, 1);
 renderer.setPixelRatio(window.devicePixelRatio);
 renderer.setSize(window.innerWidth, window.innerHeight);
@@ -41,6 +138,35 @@ const positiveChargeMaterial = new THREE.MeshStandardMaterial({ color: 0xff4444
 const negativeChargeMaterial = new THREE.MeshStandardMaterial({ color: 0x4444ff });
 
 
+/**
+ * Editable charges and the packed dataset as two instanced spheres, one per
+ * sign, for glTF export
+ */
+const chargeGltfNodes = (editable: Charge[], store: ChargeStore): GltfNodeSource[] => {
+  const dataset = store.packed();
+  const geometry = gltfGeometryFromBufferGeometry(chargeGeometry);
+  return [
+    { name: 'Positive charges', material: positiveChargeMaterial, sign: 1 },
+    { name: 'Negative charges', material: negativeChargeMaterial, sign: -1 },
+  ].map(({ name, material, sign }) => {
+    const translations: number[] = [];
+    for (const charge of editable) {
+      if (Math.sign(charge.magnitude) === sign) translations.push(charge.position.x, charge.position.y, charge.position.z);
+    }
+    for (let i = 0; i < dataset.count; i++) {
+      if (Math.sign(dataset.magnitudes[i]) !== sign) continue;
+      translations.push(dataset.positions[i * 3], dataset.positions[i * 3 + 1], dataset.positions[i * 3 + 2]);
+    }
+    const { r, g, b } = material.color;
+    return {
+      name,
+      geometry,
+      material: { color: [r, g, b, 1] as [number, number, number, number], unlit: false, doubleSided: false },
+      instances: { translations: new Float32Array(translations), rotations: null, scales: null },
+    };
+  });
+};
+
 // Add some default charges
 const charge1 = createDefaultCharge('charge-1');
 charge1.position.set(0, 0, 0);
@@ -54,24 +180,6 @@ let selectedChargeId: string | null = null;
 let raycaster = new THREE.Raycaster();
 let mouse = new THREE.Vector2();
 
-// Voltage point visualizations
-let voltagePointMeshes: Map<string, THREE.Mesh> = new Map();
-let voltagePointArrows: Map<string, THREE.Mesh[]> = new Map();
-const voltagePointGeometry = new THREE.SphereGeometry(0.15, 12, 12);
-const voltagePointMaterial = new THREE.MeshBasicMaterial({
-  color: 0x00ff00,
-  transparent: true,
-  opacity: 0.8,
-});
-
-// Arrow geometry for voltage points (same size as field arrows)
-const voltageArrowGeometry = new THREE.ConeGeometry(0.05, 0.2, 8);
-const voltageArrowMaterial = new THREE.MeshBasicMaterial({
-  color: 0x4444ff, // Blue color
-  transparent: true,
-  opacity: 0.8,
-});
-
 const updateChargeMeshes = () => {
   const seen: Set<string> = new Set();
 
@@ -119,137 +227,37 @@ const updateChargeMeshes = () => {
   }
 };
 
-// Function to update voltage point meshes
-const updateVoltagePointMeshes = (voltagePoints: VoltagePoint[]) => {
-  const seen: Set<string> = new Set();
-  const upVector = new THREE.Vector3(0, 1, 0);
-  const sphereRadius = 0.15;
-  const arrowScale = 2.0; 
-  const maxFieldMagnitude = 1e4;
-
-  // Generate points around each voltage orb in a small grid
-  const gridSize = 3; // 3x3x3 grid around each orb
-  const gridStep = 0.4; // Distance between grid points
-  const gridOffset = -(gridSize - 1) * gridStep / 2;
-
-  // Update existing and create missing
-  for (const point of voltagePoints) {
-    seen.add(point.id);
-    let mesh = voltagePointMeshes.get(point.id);
-    if (!mesh) {
-      mesh = new THREE.Mesh(voltagePointGeometry, voltagePointMaterial);
-      mesh.userData = { voltagePointId: point.id };
-      scene.add(mesh);
-      voltagePointMeshes.set(point.id, mesh);
-    }
-    mesh.position.copy(point.position);
-
-    // Create or update arrows for this voltage point
-    let arrows = voltagePointArrows.get(point.id);
-    
-    // Calculate positions for arrows around the orb
-    const arrowPositions: THREE.Vector3[] = [];
-    for (let x = 0; x < gridSize; x++) {
-      for (let y = 0; y < gridSize; y++) {
-        for (let z = 0; z < gridSize; z++) {
-          // Skip the center position (where the orb is)
-          if (x === 1 && y === 1 && z === 1) continue;
-          
-          const offset = new THREE.Vector3(
-            gridOffset + x * gridStep,
-            gridOffset + y * gridStep,
-            gridOffset + z * gridStep
-          );
-          const arrowPos = point.position.clone().add(offset);
-          
-          // Only add arrows that are at a reasonable distance from the orb
-          const distance = offset.length();
-          if (distance > sphereRadius && distance < sphereRadius + 0.6) {
-            arrowPositions.push(arrowPos);
-          }
-        }
-      }
-    }
-
-    // Remove old arrows if count changed
-    if (arrows && arrows.length !== arrowPositions.length) {
-      for (const arrow of arrows) {
-        scene.remove(arrow);
-        arrow.geometry.dispose();
-        (arrow.material as THREE.Material).dispose();
-      }
-      arrows = undefined;
-      voltagePointArrows.delete(point.id);
-    }
-
-    if (!arrows) {
-      arrows = [];
-      for (let i = 0; i < arrowPositions.length; i++) {
-        const arrow = new THREE.Mesh(voltageArrowGeometry, voltageArrowMaterial);
-        arrow.scale.set(1, 1, 1); 
-        scene.add(arrow);
-        arrows.push(arrow);
-      }
-      voltagePointArrows.set(point.id, arrows);
-    }
-
-    // Update arrow positions and orientations based on electric field
-    for (let i = 0; i < arrowPositions.length && i < arrows.length; i++) {
-      const arrow = arrows[i];
-      const arrowPos = arrowPositions[i];
-      
-      // Calculate electric field at this position
-      const fieldResult = electricFieldAt(arrowPos, charges);
-      const field = fieldResult.field;
-      
-      let arrowLength = field.length();
-      
-      if (field.length() < 1e-6) {
-        // Hide arrow if field is too small
-        arrow.scale.set(0, 0, 0);
-        continue;
-      }
-
-      const normalizedMagnitude = Math.min(arrowLength / maxFieldMagnitude, 1);
-      arrowLength = Math.max(normalizedMagnitude * arrowScale, 0.1);
-
-      // Position arrow at the grid position (same as vector field)
-      arrow.position.copy(arrowPos);
-      
-      // Orient arrow in field direction
-      const direction = field.clone().normalize();
-      const quaternion = new THREE.Quaternion().setFromUnitVectors(upVector, direction);
-      arrow.setRotationFromQuaternion(quaternion);
-      
-      // Scale arrow (length along Y axis) - exactly like vector field
-      arrow.scale.set(1, arrowLength, 1);
-    }
+const setChargeMeshesVisible = (visible: boolean) => {
+  for (const mesh of chargeMeshes.values()) {
+    mesh.visible = visible;
   }
+};
 
-  // Remove meshes and arrows that no longer have voltage points
-  for (const [id, mesh] of Array.from(voltagePointMeshes.entries())) {
-    if (!seen.has(id)) {
-      scene.remove(mesh);
-      voltagePointMeshes.delete(id);
-
-      const arrows = voltagePointArrows.get(id);
-      if (arrows) {
-        for (const arrow of arrows) {
-          scene.remove(arrow);
-          arrow.geometry.dispose();
-          (arrow.material as THREE.Material).dispose();
-        }
-        voltagePointArrows.delete(id);
-      }
-    }
-  }
+// Loaded scenes up to this many charges become editable charges with their
+// own meshes; larger ones stay in the packed charge store as a point cloud
+const EDITABLE_CHARGE_LIMIT = 2000;
+
+const downloadFile = (data: BlobPart, filename: string, type: string) => {
+  const url = URL.createObjectURL(new Blob([data], { type }));
+  const link = document.createElement('a');
+  link.href = url;
+  link.download = filename;
+  link.click();
+  URL.revokeObjectURL(url);
 };
 
 // Initialize charge meshes
 updateChargeMeshes();
 
+// Per-frame hooks for renderers that animate (receive elapsed seconds)
+const frameCallbacks: Set<(deltaSeconds: number) => void> = new Set();
+const clock = new THREE.Clock();
+let animationStarted = false;
+
 function animate() {
   requestAnimationFrame(animate);
+  const deltaSeconds = clock.getDelta();
+  for (const callback of frameCallbacks) callback(deltaSeconds);
   if (controls) controls.update();
   renderer.render(scene, camera);
 }
@@ -262,6 +270,87 @@ const ThreeWorkspace: React.FC = () => {
   const [fieldLineRenderer, setFieldLineRenderer] =
     useState<FieldLineRenderer | null>(null);
   const [showFieldLines, setShowFieldLines] = useState(false);
+  const [animateFieldLines, setAnimateFieldLines] = useState(false);
+  const [particleTracer, setParticleTracer] =
+    useState<ParticleTracerRenderer | null>(null);
+  const [particleCount, setParticleCount] = useState(0);
+  // Read from the scheduled update and click picking, so kept out of state
+  const voltageProbesRef = useRef<VoltageProbeRenderer | null>(null);
+  const probeLayoutRef = useRef('');
+  const [probeBuffer, setProbeBuffer] = useState<ProbeBuffer | null>(null);
+  // Bumped with the buffer's version, so the probe list re-renders
+  const [, setProbeVersion] = useState(0);
+  const probeShapesRef = useRef<ProbeShapeRenderer | null>(null);
+  const [probeSamples, setProbeSamples] = useState<ProbeSamples | null>(null);
+  const potentialSliceRef = useRef<PotentialSliceRenderer | null>(null);
+  const [sliceConfig, setSliceConfig] = useState<PotentialSliceConfig>(createDefaultPotentialSliceConfig);
+  const [sliceProgress, setSliceProgress] = useState<SliceProgress | null>(null);
+  const heightFieldRef = useRef<HeightFieldRenderer | null>(null);
+  const [heightFieldConfig, setHeightFieldConfig] = useState<HeightFieldConfig>(createDefaultHeightFieldConfig);
+  const [heightFieldStats, setHeightFieldStats] = useState<HeightFieldStats | null>(null);
+  const chargeStoreRef = useRef(new ChargeStore());
+  // The scene load or text import currently writing into the store
+  const importWorkerRef = useRef<Worker | null>(null);
+  const chargeCloudRef = useRef<ChargeCloudRenderer | null>(null);
+  const [datasetCount, setDatasetCount] = useState(0);
+  const [sceneFileStatus, setSceneFileStatus] = useState<SceneFileStatus | null>(null);
+  const [oscillatorRenderer, setOscillatorRenderer] =
+    useState<OscillatingSourceRenderer | null>(null);
+  const [oscillatingSources, setOscillatingSources] = useState<OscillatingSource[]>([]);
+  const [oscillatorPlaying, setOscillatorPlaying] = useState(true);
+  const phasorTimeRef = useRef(0);
+  const [movingChargeRenderer, setMovingChargeRenderer] =
+    useState<MovingChargeRenderer | null>(null);
+  const [movingCharges, setMovingCharges] = useState<MovingCharge[]>([]);
+  const [speedOfLight, setSpeedOfLight] = useState(
+    () => createDefaultMovingChargeConfig().speedOfLight,
+  );
+  const [movingChargesPlaying, setMovingChargesPlaying] = useState(true);
+  const [currentRenderer, setCurrentRenderer] = useState<CurrentSourceRenderer | null>(null);
+  const [currents, setCurrents] = useState<CurrentSource[]>([]);
+  const [fieldKind, setFieldKind] = useState<FieldKind>('electric');
+  const [keyframePlayer, setKeyframePlayer] = useState<KeyframePlayer | null>(null);
+  const [timeline, setTimeline] = useState<Timeline>({ fps: 30, keyframes: [] });
+  const [frameProgress, setFrameProgress] = useState<{ ready: number; total: number } | null>(null);
+  const [frameCacheBytes, setFrameCacheBytes] = useState<number | null>(null);
+  const [timelineActive, setTimelineActive] = useState(false);
+  const [timelinePlaying, setTimelinePlaying] = useState(false);
+  const [gaussRenderer, setGaussRenderer] = useState<GaussSurfaceRenderer | null>(null);
+  const [gaussSurfaces, setGaussSurfaces] = useState<GaussSurface[]>([]);
+  const [gaussResults, setGaussResults] = useState<Record<string, GaussFluxResult>>({});
+  const gaussIntegratorsRef = useRef<Map<string, GaussFluxIntegrator>>(new Map());
+  const [pathRenderer, setPathRenderer] = useState<IntegrationPathRenderer | null>(null);
+  const [integrationPath, setIntegrationPath] = useState<Vec3Like[]>([]);
+  const [nullRenderer, setNullRenderer] = useState<NullPointRenderer | null>(null);
+  const [showNullPoints, setShowNullPoints] = useState(false);
+  const [nullPoints, setNullPoints] = useState<NullPoint[]>([]);
+  const [nullScanTime, setNullScanTime] = useState(0);
+  const [nullRescan, setNullRescan] = useState(0);
+  const nullSeedsRef = useRef<Vec3Like[]>([]);
+  const [forceRenderer, setForceRenderer] = useState<ForceArrowRenderer | null>(null);
+  const [showForces, setShowForces] = useState(false);
+  const [interactions, setInteractions] = useState<ChargeInteractionResult | null>(null);
+  const [forceGroup, setForceGroup] = useState<string[]>([]);
+  const interactionsRef = useRef(new ChargeInteractions());
+  const [conductorRenderer, setConductorRenderer] = useState<GaussSurfaceRenderer | null>(null);
+  const [conductors, setConductors] = useState<Conductor[]>([]);
+  const [conductorPanelSize, setConductorPanelSize] = useState(createDefaultCapacitanceOptions().panelSize);
+  const [capacitance, setCapacitance] = useState<CapacitanceResult | null>(null);
+  const [capacitanceStatus, setCapacitanceStatus] = useState<string | null>(null);
+  const capacitancePoolRef = useRef<WorkerPool<CapacitanceWorkerRequest, CapacitanceWorkerResult> | null>(null);
+  const capacitanceGenerationRef = useRef(0);
+  const [inverseOptions, setInverseOptions] = useState<InverseDesignOptions>(createDefaultInverseDesignOptions);
+  const [inverseResult, setInverseResult] = useState<InverseDesignResult | null>(null);
+  const [inverseStatus, setInverseStatus] = useState<string | null>(null);
+  const inversePoolRef = useRef<WorkerPool<InverseDesignWorkerRequest, InverseDesignWorkerResult> | null>(null);
+  const inverseGenerationRef = useRef(0);
+  const [optimizationRenderer, setOptimizationRenderer] = useState<OptimizationPathRenderer | null>(null);
+  const [optimizerProgress, setOptimizerProgress] = useState<OptimizerProgress | null>(null);
+  const [sweepResult, setSweepResult] = useState<SweepResult | null>(null);
+  const [sweepStatus, setSweepStatus] = useState<string | null>(null);
+  const sweepPoolRef = useRef<WorkerPool<SweepWorkerRequest, SweepWorkerResult> | null>(null);
+  const sweepGenerationRef = useRef(0);
+  const [testCharge, setTestCharge] = useState(1e-6);
 
   // Charge state mirrors global `charges`
   const [chargesState, setChargesState] = useState<Charge[]>(charges);
@@ -298,7 +387,7 @@ const ThreeWorkspace: React.FC = () => {
     }
   }, [chargesState, selectedCharge?.id]);
 
-  // Voltage measurement points (computed via electricFieldAt)
+  // Voltage measurement points; potentials are refreshed by VoltageProbeRenderer
   const [voltagePoints, setVoltagePoints] = useState<VoltagePoint[]>([]);
   const [showVoltagePointUI, setShowVoltagePointUI] = useState(false);
   const [newVoltagePoint, setNewVoltagePoint] = useState({
@@ -322,20 +411,33 @@ const ThreeWorkspace: React.FC = () => {
       vfUpdateScheduled.current = true;
       requestAnimationFrame(() => {
         vfUpdateScheduled.current = false;
+        // The imported dataset is a second source for every field view
+        const dataset = chargeStoreRef.current.tree();
         if (vectorFieldRenderer) {
           const shouldBeVisible = showVectorField;
-          vectorFieldRenderer.updateCharges(nextCharges);
+          vectorFieldRenderer.updateCharges(nextCharges, dataset);
           if (shouldBeVisible) {
             vectorFieldRenderer.setVisible(true);
           }
         }
         // Update field lines as well
         if (fieldLineRenderer) {
-          fieldLineRenderer.updateCharges(nextCharges);
+          fieldLineRenderer.updateCharges(nextCharges, dataset);
         }
+        if (particleTracer) {
+          particleTracer.updateCharges(nextCharges, dataset);
+        }
+        // Every probe potential and arrow sample in one batch-kernel pass
+        if (voltageProbesRef.current) {
+          voltageProbesRef.current.updateCharges(nextCharges, dataset);
+          setProbeVersion(voltageProbesRef.current.getBuffer().version);
+        }
+        probeShapesRef.current?.updateCharges(nextCharges, dataset);
+        potentialSliceRef.current?.updateCharges(nextCharges, dataset);
+        heightFieldRef.current?.updateCharges(nextCharges, dataset);
       });
     },
-    [vectorFieldRenderer, fieldLineRenderer, showVectorField],
+    [vectorFieldRenderer, fieldLineRenderer, particleTracer, showVectorField],
   );
 
   // Charge management
@@ -424,40 +526,29 @@ const ThreeWorkspace: React.FC = () => {
       charges = newCharges;
       setChargesState(newCharges);
       updateChargeMeshes();
-      if (vectorFieldRenderer && showVectorField) {
-        scheduleVectorFieldUpdate(newCharges);
-      }
+      scheduleVectorFieldUpdate(newCharges);
     },
-    [chargesState, scheduleVectorFieldUpdate, vectorFieldRenderer, showVectorField],
+    [chargesState, scheduleVectorFieldUpdate],
   );
 
-  // Voltage point management (points store physically computed potentials)
+  // Voltage point management (the probe renderer fills in the potentials)
   const addVoltagePoint = useCallback(() => {
     const position = new THREE.Vector3(
       newVoltagePoint.x,
       newVoltagePoint.y,
       newVoltagePoint.z,
     );
-    const fieldResult = electricFieldAt(position, chargesRef.current);
-    const newPoint = createVoltagePoint(position, fieldResult.potential);
-    const updated = [...voltagePoints, newPoint];
-    setVoltagePoints(updated);
-    updateVoltagePointMeshes(updated);
+    setVoltagePoints((prev) => [...prev, createVoltagePoint(position)]);
     setShowVoltagePointUI(false);
-  }, [newVoltagePoint, voltagePoints]);
+  }, [newVoltagePoint]);
 
-  const removeVoltagePoint = useCallback(
-    (pointId: string) => {
-      const newPoints = voltagePoints.filter((point) => point.id !== pointId);
-      setVoltagePoints(newPoints);
-      updateVoltagePointMeshes(newPoints);
-    },
-    [voltagePoints],
-  );
+  const removeVoltagePoints = useCallback((pointIds: string[]) => {
+    const removed = new Set(pointIds);
+    setVoltagePoints((prev) => prev.filter((point) => !removed.has(point.id)));
+  }, []);
 
   const removeAllVoltagePoints = useCallback(() => {
     setVoltagePoints([]);
-    updateVoltagePointMeshes([]);
   }, []);
 
   const handleMouseClick = useCallback(
@@ -472,9 +563,8 @@ const ThreeWorkspace: React.FC = () => {
       const chargeIntersects = raycaster.intersectObjects(
         Array.from(chargeMeshes.values()),
       );
-      const voltageIntersects = raycaster.intersectObjects(
-        Array.from(voltagePointMeshes.values()),
-      );
+      const probes = voltageProbesRef.current;
+      const voltageIntersects = probes ? raycaster.intersectObject(probes.getPickTarget()) : [];
 
       if (chargeIntersects.length > 0) {
         const clickedChargeId = chargeIntersects[0].object.userData.chargeId;
@@ -482,7 +572,7 @@ const ThreeWorkspace: React.FC = () => {
       } else if (voltageIntersects.length > 0) {
         console.log(
           'Voltage point clicked:',
-          voltageIntersects[0].object.userData.voltagePointId,
+          probes!.probeIdAt(voltageIntersects[0].instanceId),
         );
       } else {
         setShowVoltagePointUI(true);
@@ -511,7 +601,7 @@ const ThreeWorkspace: React.FC = () => {
     if (!vectorFieldInitialized.current) {
     const vectorFieldConfig = createDefaultVectorFieldConfig();
     const vfRenderer = new VectorFieldRenderer(scene, vectorFieldConfig);
-    vfRenderer.updateCharges(charges);
+    vfRenderer.updateCharges(charges, chargeStoreRef.current.tree());
     setVectorFieldRenderer(vfRenderer);
       vectorFieldInitialized.current = true;
     }
@@ -519,7 +609,7 @@ const ThreeWorkspace: React.FC = () => {
     if (!fieldLineInitialized.current) {
       const fieldLineConfig = createDefaultFieldLineConfig();
       const flRenderer = new FieldLineRenderer(scene, fieldLineConfig);
-      flRenderer.updateCharges(charges);
+      flRenderer.updateCharges(charges, chargeStoreRef.current.tree());
       flRenderer.setVisible(showFieldLines);
       setFieldLineRenderer(flRenderer);
       fieldLineInitialized.current = true;
@@ -541,6 +631,9 @@ const ThreeWorkspace: React.FC = () => {
     const moveRaycaster = new THREE.Raycaster();
     const moveMouse = new THREE.Vector2();
     const plane = new THREE.Plane(new THREE.Vector3(0, 1, 0), 0);
+    const hoverPoint = new Float64Array(3);
+    const hoverField = new Float64Array(3);
+    const hoverPotential = new Float64Array(1);
 
     const onMouseMove = (event: MouseEvent) => {
       const rect = renderer.domElement.getBoundingClientRect();
@@ -554,8 +647,10 @@ const ThreeWorkspace: React.FC = () => {
       if (result !== null) {
         const pos = intersectionPoint.clone();
         setHoverPosition(pos);
-        const fieldResult = electricFieldAt(pos, chargesRef.current);
-        setHoverVoltage(fieldResult.potential);
+        pos.toArray(hoverPoint);
+        const sources = { charges: packCharges(chargesRef.current), dataset: chargeStoreRef.current.tree() };
+        sourcesFieldBatch(sources, hoverPoint, hoverField, hoverPotential);
+        setHoverVoltage(hoverPotential[0]);
       } else {
         setHoverPosition(null);
         setHoverVoltage(null);
@@ -564,7 +659,10 @@ const ThreeWorkspace: React.FC = () => {
 
     renderer.domElement.addEventListener('mousemove', onMouseMove);
 
-    animate();
+    if (!animationStarted) {
+      animationStarted = true;
+      animate();
+    }
 
     return () => {
       window.removeEventListener('resize', onResize);
@@ -582,11 +680,1059 @@ const ThreeWorkspace: React.FC = () => {
     };
   }, [handleMouseClick, vectorFieldRenderer]);
 
-  // Keep voltage point meshes in sync with state
+  // Test-particle tracer owns a worker, so it is created and torn down with the component
+  useEffect(() => {
+    const tracer = new ParticleTracerRenderer(scene, createDefaultParticleTracerConfig());
+    tracer.updateCharges(chargesRef.current, chargeStoreRef.current.tree());
+    const onFrame = (deltaSeconds: number) => tracer.update(deltaSeconds);
+    frameCallbacks.add(onFrame);
+    setParticleTracer(tracer);
+
+    // Poll the live count for the panel instead of re-rendering every frame
+    const countInterval = window.setInterval(() => {
+      setParticleCount(tracer.getParticleCount());
+    }, 500);
+
+    return () => {
+      window.clearInterval(countInterval);
+      frameCallbacks.delete(onFrame);
+      tracer.dispose();
+    };
+  }, []);
+
+  const launchParticles = useCallback(
+    (swarm: ParticleSwarmConfig) => {
+      particleTracer?.launch(swarm);
+    },
+    [particleTracer],
+  );
+
+  const clearParticles = useCallback(() => {
+    particleTracer?.clear();
+    setParticleCount(0);
+  }, [particleTracer]);
+
+  useEffect(() => {
+    const markers = new OscillatingSourceRenderer(scene);
+    setOscillatorRenderer(markers);
+    return () => {
+      markers.dispose();
+    };
+  }, []);
+
+  // Phasor amplitudes are rebuilt only when the set of oscillating sources changes
+  useEffect(() => {
+    if (vectorFieldRenderer) {
+      vectorFieldRenderer.setOscillatingSources(oscillatingSources);
+    }
+    if (oscillatorRenderer) {
+      oscillatorRenderer.updateSources(oscillatingSources);
+      oscillatorRenderer.setTime(phasorTimeRef.current);
+    }
+  }, [oscillatingSources, vectorFieldRenderer, oscillatorRenderer]);
+
+  // Animating is then just a phase rotation per frame
+  useEffect(() => {
+    if (!oscillatorPlaying || oscillatingSources.length === 0) return;
+    const onFrame = (deltaSeconds: number) => {
+      phasorTimeRef.current += deltaSeconds;
+      vectorFieldRenderer?.setPhasorTime(phasorTimeRef.current);
+      oscillatorRenderer?.setTime(phasorTimeRef.current);
+    };
+    frameCallbacks.add(onFrame);
+    return () => {
+      frameCallbacks.delete(onFrame);
+    };
+  }, [oscillatorPlaying, oscillatingSources.length, vectorFieldRenderer, oscillatorRenderer]);
+
+  // Liénard–Wiechert workers add the moving charges' field to the vector grid
+  useEffect(() => {
+    if (!vectorFieldRenderer) return;
+    const moving = new MovingChargeRenderer(
+      scene,
+      vectorFieldRenderer,
+      createDefaultMovingChargeConfig(),
+    );
+    setMovingChargeRenderer(moving);
+    return () => {
+      moving.dispose();
+    };
+  }, [vectorFieldRenderer]);
+
+  useEffect(() => {
+    movingChargeRenderer?.setCharges(movingCharges);
+  }, [movingChargeRenderer, movingCharges]);
+
+  useEffect(() => {
+    movingChargeRenderer?.setSpeedOfLight(speedOfLight);
+  }, [movingChargeRenderer, speedOfLight]);
+
+  useEffect(() => {
+    if (!movingChargeRenderer || !movingChargesPlaying || movingCharges.length === 0) return;
+    const onFrame = (deltaSeconds: number) => movingChargeRenderer.update(deltaSeconds);
+    frameCallbacks.add(onFrame);
+    return () => {
+      frameCallbacks.delete(onFrame);
+    };
+  }, [movingChargeRenderer, movingChargesPlaying, movingCharges.length]);
+
+  useEffect(() => {
+    const wires = new CurrentSourceRenderer(scene);
+    setCurrentRenderer(wires);
+    return () => {
+      wires.dispose();
+    };
+  }, []);
+
+  // Currents only change what is drawn while B is selected
+  useEffect(() => {
+    vectorFieldRenderer?.updateCurrents(currents);
+    fieldLineRenderer?.updateCurrents(currents);
+    currentRenderer?.updateSources(currents);
+  }, [currents, vectorFieldRenderer, fieldLineRenderer, currentRenderer]);
+
+  useEffect(() => {
+    vectorFieldRenderer?.setFieldKind(fieldKind);
+    fieldLineRenderer?.setFieldKind(fieldKind);
+  }, [fieldKind, vectorFieldRenderer, fieldLineRenderer]);
+
   useEffect(() => {
-    updateVoltagePointMeshes(voltagePoints);
+    if (!vectorFieldRenderer) return;
+    const player = new KeyframePlayer(scene, vectorFieldRenderer, createDefaultKeyframePlayerConfig());
+    setKeyframePlayer(player);
+    return () => {
+      player.dispose();
+    };
+  }, [vectorFieldRenderer]);
+
+  // Editing the timeline invalidates the frame cache
+  useEffect(() => {
+    keyframePlayer?.setCache(null);
+    setFrameCacheBytes(null);
+    setFrameProgress(null);
+  }, [timeline, keyframePlayer]);
+
+  // While the cached animation is shown, the live charges and field lines are hidden
+  useEffect(() => {
+    if (!keyframePlayer) return;
+    keyframePlayer.setActive(timelineActive);
+    setChargeMeshesVisible(!timelineActive);
+    fieldLineRenderer?.setVisible(showFieldLines && !timelineActive);
+  }, [timelineActive, keyframePlayer, fieldLineRenderer, showFieldLines]);
+
+  useEffect(() => {
+    if (!keyframePlayer || !timelineActive) return;
+    keyframePlayer.setPlaying(timelinePlaying);
+    if (!timelinePlaying) return;
+    const onFrame = (deltaSeconds: number) => keyframePlayer.update(deltaSeconds);
+    frameCallbacks.add(onFrame);
+    return () => {
+      frameCallbacks.delete(onFrame);
+    };
+  }, [keyframePlayer, timelineActive, timelinePlaying]);
+
+  const addKeyframe = useCallback(
+    (time: number) => {
+      setTimeline((prev) =>
+        setKeyframe(prev, {
+          time,
+          charges: chargesState.map((charge) => ({
+            id: charge.id,
+            position: { x: charge.position.x, y: charge.position.y, z: charge.position.z },
+            magnitude: charge.magnitude,
+          })),
+        }),
+      );
+    },
+    [chargesState],
+  );
+
+  const precomputeFrames = useCallback(async () => {
+    if (!keyframePlayer) return;
+    setTimelineActive(false);
+    setTimelinePlaying(false);
+    const cache = await keyframePlayer.precompute(timeline, (ready, total) =>
+      setFrameProgress({ ready, total }),
+    );
+    if (cache) {
+      setFrameCacheBytes(cache.byteLength);
+    }
+  }, [keyframePlayer, timeline]);
+
+  const toggleTimelinePlaying = useCallback(() => {
+    setTimelineActive(true);
+    setTimelinePlaying((prev) => !prev);
+  }, []);
+
+  const stopTimeline = useCallback(() => {
+    setTimelinePlaying(false);
+    setTimelineActive(false);
+  }, []);
+
+  const exportFrameArchive = useCallback(() => {
+    const cache = keyframePlayer?.getCache();
+    if (!cache) return;
+    downloadFile(buildFrameArchive(cache), 'charge-animation.tar', 'application/x-tar');
+  }, [keyframePlayer]);
+
+  const saveTimeline = useCallback(() => {
+    downloadFile(JSON.stringify(timeline, null, 2), 'timeline.json', 'application/json');
+  }, [timeline]);
+
+  useEffect(() => {
+    const surfaces = new GaussSurfaceRenderer(scene);
+    setGaussRenderer(surfaces);
+    return () => {
+      surfaces.dispose();
+    };
+  }, []);
+
+  // One integrator per surface; they cache per-charge flux, so only charges
+  // that moved since the last update are integrated again
+  useEffect(() => {
+    const integrators = gaussIntegratorsRef.current;
+    const ids = new Set(gaussSurfaces.map((surface) => surface.id));
+    for (const id of Array.from(integrators.keys())) {
+      if (!ids.has(id)) integrators.delete(id);
+    }
+    for (const surface of gaussSurfaces) {
+      if (!integrators.has(surface.id)) {
+        integrators.set(surface.id, new GaussFluxIntegrator(surface));
+      }
+    }
+    gaussRenderer?.updateSurfaces(
+      gaussSurfaces.map((surface) => integrators.get(surface.id)!.getTriangles()),
+    );
+  }, [gaussSurfaces, gaussRenderer]);
+
+  useEffect(() => {
+    const results: Record<string, GaussFluxResult> = {};
+    for (const surface of gaussSurfaces) {
+      const integrator = gaussIntegratorsRef.current.get(surface.id);
+      if (integrator) results[surface.id] = integrator.evaluate(chargesState);
+    }
+    setGaussResults(results);
+  }, [gaussSurfaces, chargesState]);
+
+  const importGaussMesh = useCallback(async (file: File) => {
+    try {
+      const triangles = parseObjTriangles(await file.text());
+      setGaussSurfaces((prev) => [
+        ...prev,
+        { id: `gauss-${Date.now()}`, kind: 'mesh', name: file.name, triangles },
+      ]);
+    } catch (error) {
+      console.error('Failed to import mesh:', error);
+    }
+  }, []);
+
+  useEffect(() => {
+    const pathLine = new IntegrationPathRenderer(scene);
+    setPathRenderer(pathLine);
+    return () => {
+      pathLine.dispose();
+    };
+  }, []);
+
+  useEffect(() => {
+    pathRenderer?.setPath(integrationPath);
+  }, [pathRenderer, integrationPath]);
+
+  // Recomputed only when the charges or the path change, and only for a real path
+  const pathIntegral = useMemo(() => {
+    if (integrationPath.length < 2) return null;
+    const vertices = new Float64Array(integrationPath.length * 3);
+    integrationPath.forEach((point, i) => {
+      vertices[i * 3] = point.x;
+      vertices[i * 3 + 1] = point.y;
+      vertices[i * 3 + 2] = point.z;
+    });
+    return pathLineIntegral(packCharges(chargesState), vertices);
+  }, [chargesState, integrationPath]);
+
+  useEffect(() => {
+    const markers = new NullPointRenderer(scene);
+    setNullRenderer(markers);
+    return () => {
+      markers.dispose();
+    };
+  }, []);
+
+  // Rescans on every charge edit, seeded with the previous nulls so small
+  // moves converge in a few Newton steps
+  useEffect(() => {
+    if (!nullRenderer) return;
+    nullRenderer.setVisible(showNullPoints);
+    if (!showNullPoints) return;
+    const start = performance.now();
+    const nulls = findNullPoints(packCharges(chargesState), undefined, nullSeedsRef.current);
+    setNullScanTime(performance.now() - start);
+    nullSeedsRef.current = nulls.map((nullPoint) => nullPoint.position);
+    nullRenderer.updateNullPoints(nulls);
+    setNullPoints(nulls);
+  }, [chargesState, showNullPoints, nullRenderer, nullRescan]);
+
+  useEffect(() => {
+    const arrows = new ForceArrowRenderer(scene);
+    setForceRenderer(arrows);
+    return () => {
+      arrows.dispose();
+    };
+  }, []);
+
+  // Forces are recomputed per edit; the energy tracker only adds ΔU for the
+  // charges that changed since its last update
+  useEffect(() => {
+    if (!forceRenderer) return;
+    forceRenderer.setVisible(showForces);
+    if (!showForces) return;
+    const result = interactionsRef.current.update(chargesState);
+    forceRenderer.updateForces(packCharges(chargesState).positions, result.forces);
+    setInteractions(result);
+  }, [chargesState, showForces, forceRenderer]);
+
+  const groupInteraction = useMemo(() => {
+    if (!interactions) return null;
+    const indices = forceGroup
+      .map((id) => interactions.ids.indexOf(id))
+      .filter((index) => index >= 0);
+    if (indices.length === 0) return null;
+    const packed = packCharges(chargesState);
+    const pivot = { x: 0, y: 0, z: 0 };
+    for (const i of indices) {
+      pivot.x += packed.positions[i * 3] / indices.length;
+      pivot.y += packed.positions[i * 3 + 1] / indices.length;
+      pivot.z += packed.positions[i * 3 + 2] / indices.length;
+    }
+    return groupForceAndTorque(packed, interactions.forces, indices, pivot);
+  }, [interactions, forceGroup, chargesState]);
+
+  useEffect(() => {
+    const surfaces = new GaussSurfaceRenderer(scene, 0xb0bec5);
+    setConductorRenderer(surfaces);
+    return () => {
+      surfaces.dispose();
+      capacitancePoolRef.current?.dispose();
+      capacitancePoolRef.current = null;
+    };
+  }, []);
+
+  // Conductors are drawn with the panels the solver will use
+  useEffect(() => {
+    conductorRenderer?.updateSurfaces(
+      conductors.map((conductor) => conductorTriangles(conductor, conductorPanelSize)),
+    );
+    // Results for the old layout are stale, including one still being solved
+    capacitanceGenerationRef.current++;
+    setCapacitance(null);
+    setCapacitanceStatus(null);
+  }, [conductors, conductorPanelSize, conductorRenderer]);
+
+  const computeCapacitance = useCallback(async () => {
+    if (!capacitancePoolRef.current) {
+      capacitancePoolRef.current = new WorkerPool<CapacitanceWorkerRequest, CapacitanceWorkerResult>(
+        () => new Worker(new URL('../workers/capacitance.worker.ts', import.meta.url), { type: 'module' }),
+        1,
+      );
+    }
+    const generation = ++capacitanceGenerationRef.current;
+    setCapacitanceStatus('Solving…');
+    try {
+      const reply = await capacitancePoolRef.current.run({
+        conductors,
+        options: { ...createDefaultCapacitanceOptions(), panelSize: conductorPanelSize },
+      });
+      if (generation !== capacitanceGenerationRef.current) return;
+      if ('error' in reply) {
+        setCapacitanceStatus(reply.error);
+      } else {
+        setCapacitance(reply.result);
+        setCapacitanceStatus(null);
+      }
+    } catch (error) {
+      if (generation === capacitanceGenerationRef.current) setCapacitanceStatus(String(error));
+    }
+  }, [conductors, conductorPanelSize]);
+
+  // A solve is O(N³) in the editable charges, so it runs in a worker on
+  // request. The worker keeps the designer's normal equations until the
+  // charges move. A result goes stale when the layout, the targets, the
+  // options or the dataset change.
+  const inverseKey = useMemo(
+    () =>
+      JSON.stringify([
+        chargesState.map((charge) => [charge.position.x, charge.position.y, charge.position.z]),
+        voltagePoints
+          .filter((point) => point.target !== undefined)
+          .map((point) => [point.id, point.position.x, point.position.y, point.position.z, point.target]),
+        inverseOptions,
+        datasetCount,
+      ]),
+    [chargesState, voltagePoints, inverseOptions, datasetCount],
+  );
+
+  useEffect(() => {
+    inverseGenerationRef.current++;
+    setInverseResult(null);
+    setInverseStatus(null);
+  }, [inverseKey]);
+
+  useEffect(
+    () => () => {
+      inversePoolRef.current?.dispose();
+      inversePoolRef.current = null;
+    },
+    [],
+  );
+
+  const solveInverseDesign = useCallback(async () => {
+    if (!inversePoolRef.current) {
+      inversePoolRef.current = new WorkerPool<InverseDesignWorkerRequest, InverseDesignWorkerResult>(
+        () => new Worker(new URL('../workers/inverseDesign.worker.ts', import.meta.url), { type: 'module' }),
+        1,
+      );
+    }
+    // The charges only have to make up what the dataset does not already
+    // supply at each probe, so achieved values match the probe readouts
+    const pinned = voltagePoints.filter((point) => point.target !== undefined);
+    const points = new Float64Array(pinned.length * 3);
+    pinned.forEach((point, i) => point.position.toArray(points, i * 3));
+    const background = new Float64Array(pinned.length);
+    chargeTreeFieldBatch(chargeStoreRef.current.tree(), points, new Float64Array(points.length), background);
+
+    const generation = ++inverseGenerationRef.current;
+    setInverseStatus('Solving…');
+    try {
+      const reply = await inversePoolRef.current.run({
+        charges: packCharges(chargesState),
+        probes: pinned.map((point, i) => ({
+          id: point.id,
+          position: { x: point.position.x, y: point.position.y, z: point.position.z },
+          target: point.target!,
+          background: background[i],
+        })),
+        options: inverseOptions,
+      });
+      if (generation !== inverseGenerationRef.current) return;
+      if ('error' in reply) {
+        setInverseStatus(reply.error);
+      } else {
+        setInverseResult(reply.result);
+        setInverseStatus(null);
+      }
+    } catch (error) {
+      if (generation === inverseGenerationRef.current) setInverseStatus(String(error));
+    }
+  }, [chargesState, voltagePoints, inverseOptions]);
+
+  const setVoltagePointTarget = useCallback((pointId: string, target: number | undefined) => {
+    setVoltagePoints((prev) => prev.map((point) => (point.id === pointId ? { ...point, target } : point)));
+  }, []);
+
+  const applyInverseDesign = useCallback(() => {
+    if (!inverseResult || inverseResult.magnitudes.length !== chargesState.length) return;
+    const newCharges = chargesState.map((charge, i) => ({ ...charge, magnitude: inverseResult.magnitudes[i] }));
+    charges = newCharges;
+    setChargesState(newCharges);
+    updateChargeMeshes();
+    scheduleVectorFieldUpdate(newCharges);
+  }, [inverseResult, chargesState, scheduleVectorFieldUpdate]);
+
+  useEffect(() => {
+    const path = new OptimizationPathRenderer(scene);
+    setOptimizationRenderer(path);
+    const onFrame = (deltaSeconds: number) => path.tick(deltaSeconds);
+    frameCallbacks.add(onFrame);
+    return () => {
+      frameCallbacks.delete(onFrame);
+      path.dispose();
+    };
+  }, []);
+
+  // Magnitudes stay fixed; the worker streams every accepted L-BFGS iterate
+  // and the renderer draws the path as it grows
+  const startOptimization = useCallback((objective: PositionObjective) => {
+    if (!optimizationRenderer || chargesState.length === 0) return;
+    optimizationRenderer.start(
+      {
+        charges: packCharges(chargesState),
+        objective,
+        penalties: createDefaultPositionPenalties(),
+        options: createDefaultLbfgsOptions(),
+      },
+      objectiveSamples(objective),
+      setOptimizerProgress,
+    );
+  }, [optimizationRenderer, chargesState]);
+
+  const stopOptimization = useCallback(() => {
+    optimizationRenderer?.stop();
+    setOptimizerProgress((prev) => prev && { ...prev, running: false, reason: 'cancelled' });
+  }, [optimizationRenderer]);
+
+  const applyOptimization = useCallback(() => {
+    const positions = optimizationRenderer?.getFinalPositions();
+    if (!positions || positions.length !== chargesState.length * 3) return;
+    const newCharges = chargesState.map((charge, i) => ({
+      ...charge,
+      position: new THREE.Vector3(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]),
+    }));
+    charges = newCharges;
+    setChargesState(newCharges);
+    updateChargeMeshes();
+    scheduleVectorFieldUpdate(newCharges);
+  }, [optimizationRenderer, chargesState, scheduleVectorFieldUpdate]);
+
+  useEffect(() => {
+    return () => {
+      sweepPoolRef.current?.dispose();
+      sweepPoolRef.current = null;
+    };
+  }, []);
+
+  const buildSweepSpec = useCallback((axes: SweepAxis[]): SweepSpec => ({
+    charges: chargesState.map((charge) => ({
+      id: charge.id,
+      position: { x: charge.position.x, y: charge.position.y, z: charge.position.z },
+      magnitude: charge.magnitude,
+    })),
+    probes: voltagePoints.map((point) => ({
+      id: point.id,
+      position: { x: point.position.x, y: point.position.y, z: point.position.z },
+    })),
+    surfaces: gaussSurfaces,
+    axes,
+  }), [chargesState, voltagePoints, gaussSurfaces]);
+
+  // The evaluation order keeps geometric parameters slowest, and each worker
+  // takes a contiguous slice of it so its influence-column cache stays warm
+  const runSweep = useCallback(async (axes: SweepAxis[]) => {
+    if (!sweepPoolRef.current) {
+      sweepPoolRef.current = new WorkerPool<SweepWorkerRequest, SweepWorkerResult>(
+        () => new Worker(new URL('../workers/sweep.worker.ts', import.meta.url), { type: 'module' }),
+      );
+    }
+    const pool = sweepPoolRef.current;
+    pool.cancelPending();
+    const generation = ++sweepGenerationRef.current;
+    const spec = buildSweepSpec(axes);
+    const order = sweepEvaluationOrder(spec);
+    const metrics = sweepMetricNames(spec);
+    const values = new Float64Array(order.length * metrics.length);
+    const chunk = Math.ceil(order.length / (pool.size * 4));
+    const start = performance.now();
+    let done = 0;
+    setSweepStatus(`Evaluating ${order.length} configurations…`);
+
+    try {
+      const slices: Promise<void>[] = [];
+      for (let offset = 0; offset < order.length; offset += chunk) {
+        const indices = order.slice(offset, offset + chunk);
+        slices.push(pool.run({ spec, indices }).then(({ rows }) => {
+          scatterSweepRows(indices, 0, rows, metrics.length, values);
+          done += indices.length;
+          if (generation === sweepGenerationRef.current) {
+            setSweepStatus(`Evaluated ${done}/${order.length} configurations…`);
+          }
+        }));
+      }
+      await Promise.all(slices);
+      if (generation !== sweepGenerationRef.current) return;
+      setSweepResult({
+        axisValues: axes.map(sweepAxisValues),
+        axisLabels: axes.map((axis) => sweepParameterLabel(axis.parameter)),
+        metrics,
+        values,
+      });
+      setSweepStatus(`${order.length} configurations in ${(performance.now() - start).toFixed(0)} ms`);
+    } catch (error) {
+      if (generation === sweepGenerationRef.current) setSweepStatus(String(error));
+    }
+  }, [buildSweepSpec]);
+
+  const exportSweepCsv = useCallback(() => {
+    if (sweepResult) downloadFile(buildSweepCsv(sweepResult), 'sweep.csv', 'text/csv');
+  }, [sweepResult]);
+
+  const saveSweepSpec = useCallback((axes: SweepAxis[]) => {
+    // Imported mesh triangles are written as plain arrays
+    const json = JSON.stringify(
+      buildSweepSpec(axes),
+      (_, value) => (value instanceof Float32Array ? Array.from(value) : value),
+      2,
+    );
+    downloadFile(json, 'sweep.json', 'application/json');
+  }, [buildSweepSpec]);
+
+  // Imported charge datasets too large for per-charge meshes
+  useEffect(() => {
+    const cloud = new ChargeCloudRenderer(scene);
+    cloud.sync(chargeStoreRef.current);
+    chargeCloudRef.current = cloud;
+    return () => {
+      cloud.dispose();
+      chargeCloudRef.current = null;
+    };
+  }, []);
+
+  const syncDataset = useCallback(() => {
+    chargeCloudRef.current?.sync(chargeStoreRef.current);
+    setDatasetCount(chargeStoreRef.current.count);
+    scheduleVectorFieldUpdate(charges);
+  }, [scheduleVectorFieldUpdate]);
+
+  const replaceCharges = useCallback(
+    (next: Charge[]) => {
+      charges = next;
+      setChargesState(next);
+      setSelectedCharge(null);
+      setChargeStack([]);
+      selectedChargeId = null;
+      updateChargeMeshes();
+      scheduleVectorFieldUpdate(next);
+    },
+    [scheduleVectorFieldUpdate],
+  );
+
+  // Stop a running import before anything else replaces the store's
+  // contents, so its remaining batches never land in the new ones
+  const stopImport = useCallback(() => {
+    const worker = importWorkerRef.current;
+    if (!worker) return;
+    worker.terminate();
+    importWorkerRef.current = null;
+    setSceneFileStatus({ message: 'Import stopped', progress: null });
+  }, []);
+
+  const finishImport = useCallback((worker: Worker) => {
+    worker.terminate();
+    if (importWorkerRef.current === worker) importWorkerRef.current = null;
+  }, []);
+
+  useEffect(() => () => importWorkerRef.current?.terminate(), []);
+
+  const clearDataset = useCallback(() => {
+    stopImport();
+    chargeStoreRef.current.clear();
+    syncDataset();
+  }, [stopImport, syncDataset]);
+
+  // Editable charges first, then the dataset; views are passed through when
+  // there is nothing to concatenate
+  const saveScene = useCallback(
+    (precision: 'float32' | 'float64') => {
+      const store = chargeStoreRef.current;
+      const dataset = store.packed();
+      const datasetIds = store.getIds();
+      let positions = dataset.positions;
+      let magnitudes = dataset.magnitudes;
+      if (chargesState.length > 0) {
+        const editable = packCharges(chargesState);
+        positions = new Float64Array(editable.positions.length + dataset.positions.length);
+        positions.set(editable.positions);
+        positions.set(dataset.positions, editable.positions.length);
+        magnitudes = new Float64Array(editable.count + dataset.count);
+        magnitudes.set(editable.magnitudes);
+        magnitudes.set(dataset.magnitudes, editable.count);
+      }
+      const sceneData: SceneData = {
+        positions,
+        magnitudes,
+        ids:
+          dataset.count === 0 || datasetIds
+            ? chargesState.map((charge) => charge.id).concat(datasetIds ?? [])
+            : null,
+        probes: voltagePoints,
+        primitives: gaussSurfaces,
+      };
+      downloadFile(encodeScene(sceneData, precision), 'scene.efvs', 'application/octet-stream');
+      setSceneFileStatus({ message: `Saved ${magnitudes.length.toLocaleString()} charges`, progress: null });
+    },
+    [chargesState, voltagePoints, gaussSurfaces],
+  );
+
+  const applyScene = useCallback(
+    (sceneData: SceneData) => {
+      const store = chargeStoreRef.current;
+      store.adopt(sceneData.positions, sceneData.magnitudes, sceneData.ids);
+      if (store.count <= EDITABLE_CHARGE_LIMIT) {
+        replaceCharges(store.toCharges());
+        store.clear();
+      } else {
+        replaceCharges([]);
+      }
+      syncDataset();
+      setVoltagePoints(
+        sceneData.probes.map((probe) => ({
+          id: probe.id,
+          position: new THREE.Vector3(probe.position.x, probe.position.y, probe.position.z),
+          ...(probe.target === undefined ? {} : { target: probe.target }),
+        })),
+      );
+      setGaussSurfaces(sceneData.primitives);
+    },
+    [replaceCharges, syncDataset],
+  );
+
+  // Decoding streams through a worker straight into the charge arrays
+  const loadScene = useCallback(
+    (file: File) => {
+      stopImport();
+      const worker = new Worker(new URL('../workers/sceneImport.worker.ts', import.meta.url), { type: 'module' });
+      importWorkerRef.current = worker;
+      const started = performance.now();
+      setSceneFileStatus({ message: `Reading ${file.name}…`, progress: 0 });
+      worker.onmessage = (event: MessageEvent<SceneImportWorkerMessage>) => {
+        const message = event.data;
+        if (message.type === 'progress') {
+          setSceneFileStatus({ message: `Reading ${file.name}…`, progress: message.loaded / message.total });
+          return;
+        }
+        finishImport(worker);
+        if (message.type === 'error') {
+          console.error('Failed to load scene:', message.message);
+          setSceneFileStatus({ message: `Failed: ${message.message}`, progress: null });
+          return;
+        }
+        applyScene(message.scene);
+        const seconds = ((performance.now() - started) / 1000).toFixed(2);
+        setSceneFileStatus({
+          message: `Loaded ${message.scene.magnitudes.length.toLocaleString()} charges in ${seconds} s`,
+          progress: null,
+        });
+      };
+      worker.onerror = (event) => {
+        finishImport(worker);
+        console.error('Failed to load scene:', event.message);
+        setSceneFileStatus({ message: `Failed: ${event.message}`, progress: null });
+      };
+      const request: SceneImportWorkerRequest = { file };
+      worker.postMessage(request);
+    },
+    [applyScene, stopImport, finishImport],
+  );
+
+  // Text imports append batch by batch, so the point cloud fills in while
+  // the rest of the file is still being parsed
+  const importChargeFile = useCallback(
+    (file: File, options: ChargeTextOptions) => {
+      stopImport();
+      const worker = new Worker(new URL('../workers/chargeTextImport.worker.ts', import.meta.url), {
+        type: 'module',
+      });
+      importWorkerRef.current = worker;
+      const store = chargeStoreRef.current;
+      const started = performance.now();
+      store.clear();
+      syncDataset();
+      setSceneFileStatus({ message: `Parsing ${file.name}…`, progress: 0 });
+      worker.onmessage = (event: MessageEvent<ChargeTextImportWorkerMessage>) => {
+        const message = event.data;
+        if (message.type === 'batch') {
+          store.append(message.batch.positions, message.batch.magnitudes);
+          syncDataset();
+          setSceneFileStatus({
+            message: `Parsing ${file.name}… ${store.count.toLocaleString()} charges`,
+            progress: message.loaded / message.total,
+          });
+          return;
+        }
+        finishImport(worker);
+        if (message.type === 'error') {
+          console.error('Failed to import charges:', message.message);
+          setSceneFileStatus({ message: `Failed: ${message.message}`, progress: null });
+          return;
+        }
+        if (store.count <= EDITABLE_CHARGE_LIMIT) {
+          replaceCharges(store.toCharges());
+          store.clear();
+          syncDataset();
+        }
+        const seconds = ((performance.now() - started) / 1000).toFixed(2);
+        const skipped = message.skipped > 0 ? `, ${message.skipped} lines skipped` : '';
+        setSceneFileStatus({
+          message: `Imported ${message.count.toLocaleString()} charges in ${seconds} s${skipped}`,
+          progress: null,
+        });
+      };
+      worker.onerror = (event) => {
+        finishImport(worker);
+        console.error('Failed to import charges:', event.message);
+        setSceneFileStatus({ message: `Failed: ${event.message}`, progress: null });
+      };
+      const request: ChargeTextImportWorkerRequest = { file, format: chargeTextFormatFor(file.name), options };
+      worker.postMessage(request);
+    },
+    [replaceCharges, syncDataset, stopImport, finishImport],
+  );
+
+  // Whatever is currently computed goes out as-is: the arrow grid, the traced
+  // lines and the potential surface. Copies are handed to the worker so the
+  // renderers keep their buffers.
+  const exportFields = useCallback(
+    (format: VtkFormat) => {
+      const samples = vectorFieldRenderer?.getSamples();
+      const request: VtkExportWorkerRequest = {
+        format,
+        grid:
+          samples && samples.positions.length > 0
+            ? exportGridFromSamples(
+                samples.positions,
+                samples.field,
+                samples.potential,
+                samples.kind === 'electric' ? 'E' : 'B',
+              )
+            : null,
+        lines: (fieldLineRenderer?.getTracedLines() ?? []).map((line) => line.slice()),
+        mesh: heightFieldRef.current?.getMesh() ?? null,
+      };
+      const transfer: Transferable[] = request.lines.map((line) => line.buffer as ArrayBuffer);
+      if (request.grid) {
+        transfer.push(request.grid.field.buffer as ArrayBuffer);
+        if (request.grid.potential) transfer.push(request.grid.potential.buffer as ArrayBuffer);
+      }
+      if (request.mesh) {
+        transfer.push(
+          request.mesh.positions.buffer as ArrayBuffer,
+          request.mesh.indices.buffer as ArrayBuffer,
+          request.mesh.scalars.buffer as ArrayBuffer,
+        );
+      }
+
+      const worker = new Worker(new URL('../workers/vtkExport.worker.ts', import.meta.url), { type: 'module' });
+      setSceneFileStatus({ message: 'Writing field files…', progress: null });
+      worker.onmessage = (event: MessageEvent<VtkExportWorkerResult>) => {
+        worker.terminate();
+        const { entries } = event.data;
+        if (entries.length === 0) {
+          setSceneFileStatus({ message: 'Nothing computed to export', progress: null });
+        } else if (entries.length === 1) {
+          downloadFile(entries[0].data, entries[0].name, 'application/octet-stream');
+          setSceneFileStatus({ message: `Exported ${entries[0].name}`, progress: null });
+        } else {
+          downloadFile(buildTarArchive(entries), 'fields-vtk.tar', 'application/x-tar');
+          setSceneFileStatus({ message: `Exported ${entries.map((entry) => entry.name).join(', ')}`, progress: null });
+        }
+      };
+      worker.onerror = (event) => {
+        worker.terminate();
+        console.error('Failed to export fields:', event.message);
+        setSceneFileStatus({ message: `Failed: ${event.message}`, progress: null });
+      };
+      worker.postMessage(request, transfer);
+    },
+    [vectorFieldRenderer, fieldLineRenderer],
+  );
+
+  // Arrows, lines, the potential surface and the charges as currently shown,
+  // written as a quantized, instanced GLB
+  const exportGltf = useCallback(() => {
+    const nodes = [
+      vectorFieldRenderer?.getGltfNode() ?? null,
+      fieldLineRenderer?.getGltfNode() ?? null,
+      heightFieldRef.current?.getGltfNode() ?? null,
+      ...chargeGltfNodes(chargesState, chargeStoreRef.current),
+    ].filter((node): node is GltfNodeSource => node !== null);
+    const request: GltfExportWorkerRequest = { nodes };
+
+    const worker = new Worker(new URL('../workers/gltfExport.worker.ts', import.meta.url), { type: 'module' });
+    setSceneFileStatus({ message: 'Writing scene.glb…', progress: null });
+    worker.onmessage = (event: MessageEvent<GltfExportWorkerResult>) => {
+      worker.terminate();
+      const { glb } = event.data;
+      downloadFile(glb, 'scene.glb', 'model/gltf-binary');
+      setSceneFileStatus({ message: `Exported scene.glb (${(glb.byteLength / 1024).toFixed(0)} KB)`, progress: null });
+    };
+    worker.onerror = (event) => {
+      worker.terminate();
+      console.error('Failed to export glTF:', event.message);
+      setSceneFileStatus({ message: `Failed: ${event.message}`, progress: null });
+    };
+    worker.postMessage(request);
+  }, [vectorFieldRenderer, fieldLineRenderer, chargesState]);
+
+  // Share links carry the editable charges, probes and view in the URL
+  // fragment. The dataset is left out: it would not fit in a URL.
+  const appliedUrlStateRef = useRef('');
+  const shareLink = useCallback(
+    async (options: UrlStateOptions) => {
+      try {
+        const payload = await encodeUrlState(
+          {
+            charges: chargesState.map((charge) => ({ position: charge.position, magnitude: charge.magnitude })),
+            probes: voltagePoints.map((point) => ({ position: point.position, target: point.target })),
+            camera: { position: camera.position, target: controls.target },
+            showVectorField,
+            showFieldLines,
+            magnetic: fieldKind === 'magnetic',
+          },
+          options,
+        );
+        const hash = URL_STATE_PREFIX + payload;
+        appliedUrlStateRef.current = hash;
+        window.history.replaceState(null, '', hash);
+        await navigator.clipboard.writeText(window.location.href);
+        const skipped = chargeStoreRef.current.count > 0 ? '; point-cloud dataset not included' : '';
+        setSceneFileStatus({
+          message: `Link copied (${window.location.href.length.toLocaleString()} characters${skipped})`,
+          progress: null,
+        });
+      } catch (error) {
+        console.error('Failed to create share link:', error);
+        setSceneFileStatus({ message: `Failed: ${error instanceof Error ? error.message : String(error)}`, progress: null });
+      }
+    },
+    [chargesState, voltagePoints, showVectorField, showFieldLines, fieldKind],
+  );
+
+  const applyUrlState = useCallback(
+    async (hash: string) => {
+      appliedUrlStateRef.current = hash;
+      try {
+        const state = await decodeUrlState(hash.slice(URL_STATE_PREFIX.length));
+        const stamp = Date.now();
+        stopImport();
+        chargeStoreRef.current.clear();
+        syncDataset();
+        replaceCharges(
+          state.charges.map(({ position, magnitude }, i) =>
+            createCharge(new THREE.Vector3(position.x, position.y, position.z), magnitude, `charge-${stamp}-${i}`),
+          ),
+        );
+        setVoltagePoints(
+          state.probes.map(({ position, target }, i) => ({
+            ...createVoltagePoint(new THREE.Vector3(position.x, position.y, position.z), `voltage-${stamp}-${i}`),
+            ...(target === undefined ? {} : { target }),
+          })),
+        );
+        const { position, target } = state.camera;
+        camera.position.set(position.x, position.y, position.z);
+        controls.target.set(target.x, target.y, target.z);
+        controls.update();
+        setShowVectorField(state.showVectorField);
+        vectorFieldRenderer?.setVisible(state.showVectorField);
+        setShowFieldLines(state.showFieldLines);
+        fieldLineRenderer?.setVisible(state.showFieldLines);
+        setFieldKind(state.magnetic ? 'magnetic' : 'electric');
+        setSceneFileStatus({ message: `Opened shared scene (${state.charges.length} charges)`, progress: null });
+      } catch (error) {
+        console.error('Failed to open share link:', error);
+        setSceneFileStatus({ message: 'Share link is damaged or from a newer version', progress: null });
+      }
+    },
+    [replaceCharges, syncDataset, stopImport, vectorFieldRenderer, fieldLineRenderer],
+  );
+
+  // Open a share link once the renderers exist, and again if the fragment
+  // is changed by hand
+  useEffect(() => {
+    if (!vectorFieldRenderer || !fieldLineRenderer) return;
+    const onHashChange = () => {
+      const hash = window.location.hash;
+      if (hash.startsWith(URL_STATE_PREFIX) && hash !== appliedUrlStateRef.current) void applyUrlState(hash);
+    };
+    onHashChange();
+    window.addEventListener('hashchange', onHashChange);
+    return () => window.removeEventListener('hashchange', onHashChange);
+  }, [vectorFieldRenderer, fieldLineRenderer, applyUrlState]);
+
+  const addOscillatingSource = useCallback((source: OscillatingSource) => {
+    setOscillatingSources((prev) => [...prev, source]);
+  }, []);
+
+  const removeOscillatingSource = useCallback((sourceId: string) => {
+    setOscillatingSources((prev) => prev.filter((source) => source.id !== sourceId));
+  }, []);
+
+  useEffect(() => {
+    const probes = new VoltageProbeRenderer(scene);
+    probes.updateCharges(chargesRef.current, chargeStoreRef.current.tree());
+    voltageProbesRef.current = probes;
+    probeLayoutRef.current = '';
+    setProbeBuffer(probes.getBuffer());
+    return () => {
+      probes.dispose();
+      voltageProbesRef.current = null;
+    };
+  }, []);
+
+  // Probe line or grid, sampled in a worker; the panel plots each result
+  useEffect(() => {
+    const shapes = new ProbeShapeRenderer(scene, setProbeSamples);
+    shapes.updateCharges(chargesRef.current, chargeStoreRef.current.tree());
+    probeShapesRef.current = shapes;
+    return () => {
+      shapes.dispose();
+      probeShapesRef.current = null;
+    };
+  }, []);
+
+  const setProbeShape = useCallback((shape: ProbeShape | null) => {
+    probeShapesRef.current?.setShape(shape);
+  }, []);
+
+  // Potential slice texture, refined coarse to fine by a worker pool
+  useEffect(() => {
+    const slice = new PotentialSliceRenderer(scene, setSliceProgress);
+    slice.updateCharges(chargesRef.current, chargeStoreRef.current.tree());
+    potentialSliceRef.current = slice;
+    return () => {
+      slice.dispose();
+      potentialSliceRef.current = null;
+    };
+  }, []);
+
+  useEffect(() => {
+    potentialSliceRef.current?.setConfig(sliceConfig);
+  }, [sliceConfig]);
+
+  const setSlicePlane = useCallback((plane: SlicePlane | null) => {
+    potentialSliceRef.current?.setPlane(plane);
+  }, []);
+
+  // Potential height-field surface; charge edits recompute only the tiles they affect
+  useEffect(() => {
+    const surface = new HeightFieldRenderer(scene, setHeightFieldStats);
+    surface.updateCharges(chargesRef.current, chargeStoreRef.current.tree());
+    heightFieldRef.current = surface;
+    return () => {
+      surface.dispose();
+      heightFieldRef.current = null;
+    };
+  }, []);
+
+  useEffect(() => {
+    heightFieldRef.current?.setConfig(heightFieldConfig);
+  }, [heightFieldConfig]);
+
+  const setHeightFieldPlane = useCallback((plane: SlicePlane | null) => {
+    heightFieldRef.current?.setPlane(plane);
+  }, []);
+
+  // Rebuild the probe layout only when probes are added, removed or moved,
+  // not when a target is edited
+  useEffect(() => {
+    const probes = voltageProbesRef.current;
+    if (!probes) return;
+    const layout = voltagePoints
+      .map((point) => `${point.id}:${point.position.x},${point.position.y},${point.position.z}`)
+      .join('|');
+    if (layout === probeLayoutRef.current) return;
+    probeLayoutRef.current = layout;
+    probes.setProbes(voltagePoints);
+    setProbeVersion(probes.getBuffer().version);
   }, [voltagePoints]);
 
+  const probeVoltage = useCallback((pointId: string): number => {
+    const row = probeBuffer?.index.get(pointId);
+    return row === undefined ? 0 : probeBuffer!.potentials[row];
+  }, [probeBuffer]);
+
+  const probeLabel = useCallback((pointId: string): number => {
+    const row = probeBuffer?.index.get(pointId);
+    return row === undefined ? 0 : probeBuffer!.labels[row];
+  }, [probeBuffer]);
+
   const toggleVectorField = () => {
     const newVisibility = !showVectorField;
     setShowVectorField(newVisibility);
@@ -603,6 +1749,24 @@ const ThreeWorkspace: React.FC = () => {
     }
   };
 
+  const toggleFieldLineAnimation = () => {
+    const animated = !animateFieldLines;
+    setAnimateFieldLines(animated);
+    if (fieldLineRenderer) {
+      fieldLineRenderer.setAnimated(animated);
+    }
+  };
+
+  // Flow glyphs only need their time uniform advanced each frame
+  useEffect(() => {
+    if (!fieldLineRenderer) return;
+    const onFrame = (deltaSeconds: number) => fieldLineRenderer.update(deltaSeconds);
+    frameCallbacks.add(onFrame);
+    return () => {
+      frameCallbacks.delete(onFrame);
+    };
+  }, [fieldLineRenderer]);
+
   return (
     <div style={{ position: 'relative', width: '100vw', height: '100vh' }}>
       <div
@@ -739,6 +1903,24 @@ const ThreeWorkspace: React.FC = () => {
           >
             {showFieldLines ? 'Hide' : 'Show'} Field Lines
           </button>
+          {showFieldLines && (
+            <button
+              onClick={toggleFieldLineAnimation}
+              style={{
+                padding: '8px 12px',
+                background: animateFieldLines ? '#4CAF50' : '#607D8B',
+                color: 'white',
+                border: 'none',
+                borderRadius: '4px',
+                cursor: 'pointer',
+                fontSize: '11px',
+                width: '100%',
+                marginTop: '5px',
+              }}
+            >
+              {animateFieldLines ? 'Stop' : 'Animate'} Field Line Flow
+            </button>
+          )}
         </div>
 
         <button
@@ -893,6 +2075,180 @@ const ThreeWorkspace: React.FC = () => {
         )}
       </div>
 
+      {/* Simulation tools - bottom left */}
+      <div
+        style={{
+          position: 'absolute',
+          bottom: '10px',
+          left: '10px',
+          display: 'flex',
+          flexDirection: 'column',
+          gap: '10px',
+          maxHeight: '60vh',
+          overflowY: 'auto',
+        }}
+      >
+        <CurrentsPanel
+          currents={currents}
+          fieldKind={fieldKind}
+          onAddCurrent={(source) => setCurrents((prev) => [...prev, source])}
+          onRemoveCurrent={(sourceId) =>
+            setCurrents((prev) => prev.filter((source) => source.id !== sourceId))
+          }
+          onFieldKindChange={setFieldKind}
+        />
+        <SceneFilePanel
+          datasetCount={datasetCount}
+          status={sceneFileStatus}
+          onSave={saveScene}
+          onLoad={loadScene}
+          onImport={importChargeFile}
+          onClearDataset={clearDataset}
+          onExportFields={exportFields}
+          onExportGltf={exportGltf}
+          onShareLink={shareLink}
+        />
+        <ProbePlotPanel samples={probeSamples} onShapeChange={setProbeShape} />
+        <PotentialSlicePanel
+          config={sliceConfig}
+          progress={sliceProgress}
+          onPlaneChange={setSlicePlane}
+          onConfigChange={setSliceConfig}
+        />
+        <HeightFieldPanel
+          config={heightFieldConfig}
+          stats={heightFieldStats}
+          onPlaneChange={setHeightFieldPlane}
+          onConfigChange={setHeightFieldConfig}
+        />
+        <SweepPanel
+          charges={chargesState}
+          result={sweepResult}
+          status={sweepStatus}
+          onRun={runSweep}
+          onExportCsv={exportSweepCsv}
+          onSaveSpec={saveSweepSpec}
+        />
+        <OptimizerPanel
+          chargeCount={chargesState.length}
+          progress={optimizerProgress}
+          onStart={startOptimization}
+          onStop={stopOptimization}
+          onReplay={() => optimizationRenderer?.replay()}
+          onApply={applyOptimization}
+        />
+        <InverseDesignPanel
+          voltagePoints={voltagePoints}
+          charges={chargesState}
+          options={inverseOptions}
+          result={inverseResult}
+          status={inverseStatus}
+          probeVoltage={probeVoltage}
+          probeLabel={probeLabel}
+          onTargetChange={setVoltagePointTarget}
+          onOptionsChange={setInverseOptions}
+          onSolve={solveInverseDesign}
+          onApply={applyInverseDesign}
+        />
+        <CapacitancePanel
+          conductors={conductors}
+          panelSize={conductorPanelSize}
+          result={capacitance}
+          status={capacitanceStatus}
+          onAddConductor={(conductor) => setConductors((prev) => [...prev, conductor])}
+          onRemoveConductor={(conductorId) =>
+            setConductors((prev) => prev.filter((conductor) => conductor.id !== conductorId))
+          }
+          onPanelSizeChange={setConductorPanelSize}
+          onCompute={computeCapacitance}
+        />
+        <ForcePanel
+          enabled={showForces}
+          result={interactions}
+          group={forceGroup}
+          groupResult={groupInteraction}
+          onToggle={() => setShowForces((prev) => !prev)}
+          onToggleGroupMember={(chargeId) =>
+            setForceGroup((prev) =>
+              prev.includes(chargeId) ? prev.filter((id) => id !== chargeId) : [...prev, chargeId]
+            )
+          }
+        />
+        <NullPointPanel
+          enabled={showNullPoints}
+          nulls={nullPoints}
+          scanTime={nullScanTime}
+          onToggle={() => setShowNullPoints((prev) => !prev)}
+          onRescan={() => {
+            nullSeedsRef.current = [];
+            setNullRescan((prev) => prev + 1);
+          }}
+        />
+        <PathIntegralPanel
+          path={integrationPath}
+          voltagePoints={voltagePoints}
+          testCharge={testCharge}
+          result={pathIntegral}
+          onAddPoint={(point) => setIntegrationPath((prev) => [...prev, point])}
+          onClearPath={() => setIntegrationPath([])}
+          onTestChargeChange={setTestCharge}
+        />
+        <GaussPanel
+          surfaces={gaussSurfaces}
+          results={gaussResults}
+          onAddSurface={(surface) => setGaussSurfaces((prev) => [...prev, surface])}
+          onImportMesh={importGaussMesh}
+          onRemoveSurface={(surfaceId) =>
+            setGaussSurfaces((prev) => prev.filter((surface) => surface.id !== surfaceId))
+          }
+        />
+        <TimelinePanel
+          keyframes={timeline.keyframes}
+          fps={timeline.fps}
+          progress={frameProgress}
+          cacheBytes={frameCacheBytes}
+          active={timelineActive}
+          playing={timelinePlaying}
+          onAddKeyframe={addKeyframe}
+          onRemoveKeyframe={(time) =>
+            setTimeline((prev) => ({
+              ...prev,
+              keyframes: prev.keyframes.filter((keyframe) => keyframe.time !== time),
+            }))
+          }
+          onFpsChange={(fps) => setTimeline((prev) => ({ ...prev, fps }))}
+          onPrecompute={precomputeFrames}
+          onTogglePlaying={toggleTimelinePlaying}
+          onStop={stopTimeline}
+          onExportArchive={exportFrameArchive}
+          onSaveTimeline={saveTimeline}
+        />
+        <ParticleTracerPanel
+          particleCount={particleCount}
+          onLaunch={launchParticles}
+          onClear={clearParticles}
+        />
+        <OscillatorPanel
+          sources={oscillatingSources}
+          playing={oscillatorPlaying}
+          onAddSource={addOscillatingSource}
+          onRemoveSource={removeOscillatingSource}
+          onTogglePlaying={() => setOscillatorPlaying((prev) => !prev)}
+        />
+        <MovingChargesPanel
+          charges={movingCharges}
+          speedOfLight={speedOfLight}
+          playing={movingChargesPlaying}
+          onAddCharge={(charge) => setMovingCharges((prev) => [...prev, charge])}
+          onRemoveCharge={(chargeId) =>
+            setMovingCharges((prev) => prev.filter((charge) => charge.id !== chargeId))
+          }
+          onSpeedOfLightChange={setSpeedOfLight}
+          onTogglePlaying={() => setMovingChargesPlaying((prev) => !prev)}
+          onResetTime={() => movingChargeRenderer?.resetTime()}
+        />
+      </div>
+
       {/* Voltage point coordinate dialog - top right */}
       {showVoltagePointUI && (
         <div
@@ -1022,84 +2378,12 @@ const ThreeWorkspace: React.FC = () => {
       )}
 
       {/* Voltage points list - bottom right */}
-      {voltagePoints.length > 0 && (
-        <div
-          style={{
-            position: 'absolute',
-            bottom: '10px',
-            right: '10px',
-            background: 'rgba(0, 0, 0, 0.8)',
-            color: 'white',
-            padding: '15px',
-            borderRadius: '8px',
-            fontFamily: 'monospace',
-            fontSize: '12px',
-            minWidth: '300px',
-            maxHeight: '300px',
-            overflowY: 'auto',
-          }}
-        >
-          <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
-            Voltage Points ({voltagePoints.length})
-          </div>
-
-          {voltagePoints.map((point, index) => (
-            <div
-              key={point.id}
-              style={{
-                border: '1px solid #555',
-                padding: '8px',
-                marginBottom: '5px',
-                borderRadius: '4px',
-                backgroundColor: 'rgba(255, 255, 255, 0.1)',
-              }}
-            >
-              <div style={{ fontWeight: 'bold', marginBottom: '4px' }}>
-                Point {index + 1}
-              </div>
-              <div style={{ fontSize: '10px', marginBottom: '2px' }}>
-                Position: ({point.position.x.toFixed(2)}, {point.position.y.toFixed(2)},{' '}
-                {point.position.z.toFixed(2)})
-              </div>
-              <div style={{ fontSize: '10px', marginBottom: '4px' }}>
-                Voltage: {point.voltage.toExponential(2)} V
-              </div>
-              <button
-                onClick={() => removeVoltagePoint(point.id)}
-                style={{
-                  padding: '4px 8px',
-                  background: '#f44336',
-                  color: 'white',
-                  border: 'none',
-                  borderRadius: '3px',
-                  cursor: 'pointer',
-                  fontSize: '10px',
-                }}
-              >
-                Remove
-              </button>
-            </div>
-          ))}
-
-          {voltagePoints.length > 0 && (
-            <button
-              onClick={removeAllVoltagePoints}
-              style={{
-                padding: '8px 12px',
-                background: '#ff6b6b',
-                color: 'white',
-                border: 'none',
-                borderRadius: '4px',
-                cursor: 'pointer',
-                fontSize: '11px',
-                width: '100%',
-                marginTop: '10px',
-              }}
-            >
-              🗑 Remove All
-            </button>
-          )}
-        </div>
+      {probeBuffer && (
+        <VoltagePointsList
+          probes={probeBuffer}
+          onRemoveVoltagePoints={removeVoltagePoints}
+          onRemoveAllVoltagePoints={removeAllVoltagePoints}
+        />
       )}
     </div>
   );
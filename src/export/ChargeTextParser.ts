@@ -0,0 +1,174 @@
+/**
+ * Incremental parser for plain-text charge lists:
+ *
+ *   pqr  ATOM/HETATM records; the last five fields are x y z charge radius
+ *   xyz  atom count, comment line, then "element x y z [charge]" per atom
+ *   csv  x, y, z, charge per row (comma, semicolon or whitespace separated),
+ *        with an optional header naming the columns
+ *
+ * Text arrives in arbitrary chunks; a line split across chunks is carried
+ * over to the next push. Parsed charges accumulate into batches, so a caller
+ * can hand them on while the rest of the file is still being read.
+ */
+
+export type ChargeTextFormat = 'pqr' | 'xyz' | 'csv';
+
+export interface ChargeTextOptions {
+  lengthScale: number; // Scene units per file length unit
+  chargeUnit: number; // C per file charge unit
+  recenter: boolean; // Shift so the first batch's centroid sits at the origin
+}
+
+export interface ChargeBatch {
+  positions: Float64Array;
+  magnitudes: Float64Array;
+}
+
+export const ELEMENTARY_CHARGE = 1.602176634e-19; // C
+
+export function chargeTextFormatFor(fileName: string): ChargeTextFormat {
+  const extension = fileName.toLowerCase().split('.').pop();
+  return extension === 'pqr' || extension === 'xyz' ? extension : 'csv';
+}
+
+export function createDefaultChargeTextOptions(): ChargeTextOptions {
+  return {
+    lengthScale: 0.1, // 1 Å → 0.1 scene units
+    chargeUnit: ELEMENTARY_CHARGE,
+    recenter: true,
+  };
+}
+
+const SEPARATOR = /[\s,;]+/;
+
+export class ChargeTextParser {
+  private format: ChargeTextFormat;
+  private options: ChargeTextOptions;
+  private batchSize: number;
+  private remainder = '';
+  private lineNumber = 0;
+  private positions: Float64Array;
+  private magnitudes: Float64Array;
+  private filled = 0;
+  private offset: [number, number, number] | null = null;
+  private columns = [0, 1, 2, 3]; // CSV column of x, y, z and charge
+  public count = 0;
+  public skipped = 0; // Non-empty lines that were not charges
+
+  constructor(format: ChargeTextFormat, options: ChargeTextOptions, batchSize: number = 65536) {
+    this.format = format;
+    this.options = options;
+    this.batchSize = batchSize;
+    this.positions = new Float64Array(batchSize * 3);
+    this.magnitudes = new Float64Array(batchSize);
+  }
+
+  /**
+   * Parse a chunk of text and return any batches it completed
+   */
+  public push(text: string): ChargeBatch[] {
+    const batches: ChargeBatch[] = [];
+    const lines = (this.remainder + text).split('\n');
+    this.remainder = lines.pop() ?? '';
+    for (const line of lines) {
+      this.parseLine(line);
+      if (this.filled === this.batchSize) batches.push(this.takeBatch());
+    }
+    return batches;
+  }
+
+  /**
+   * Parse whatever is left after the last chunk and return the final batch
+   */
+  public finish(): ChargeBatch | null {
+    if (this.remainder) this.parseLine(this.remainder);
+    this.remainder = '';
+    return this.filled > 0 ? this.takeBatch() : null;
+  }
+
+  private parseLine(raw: string) {
+    const line = raw.trim();
+    this.lineNumber++;
+    if (!line) return;
+
+    let x: number;
+    let y: number;
+    let z: number;
+    let charge: number;
+    if (this.format === 'pqr') {
+      if (!line.startsWith('ATOM') && !line.startsWith('HETATM')) return;
+      const fields = line.split(/\s+/);
+      const n = fields.length;
+      if (n < 6) {
+        this.skipped++;
+        return;
+      }
+      x = parseFloat(fields[n - 5]);
+      y = parseFloat(fields[n - 4]);
+      z = parseFloat(fields[n - 3]);
+      charge = parseFloat(fields[n - 2]);
+    } else if (this.format === 'xyz') {
+      // Line 1 is the atom count and line 2 a free-form comment
+      if (this.lineNumber <= 2) return;
+      const fields = line.split(/\s+/);
+      x = parseFloat(fields[1]);
+      y = parseFloat(fields[2]);
+      z = parseFloat(fields[3]);
+      charge = fields.length > 4 ? parseFloat(fields[4]) : 0;
+    } else {
+      if (line.startsWith('#')) return;
+      const fields = line.split(SEPARATOR);
+      if (this.count === 0 && this.filled === 0 && Number.isNaN(parseFloat(fields[0]))) {
+        this.readHeader(fields);
+        return;
+      }
+      const [cx, cy, cz, cq] = this.columns;
+      x = parseFloat(fields[cx]);
+      y = parseFloat(fields[cy]);
+      z = parseFloat(fields[cz]);
+      charge = parseFloat(fields[cq]);
+    }
+
+    if (!Number.isFinite(x) || !Number.isFinite(y) || !Number.isFinite(z) || !Number.isFinite(charge)) {
+      this.skipped++;
+      return;
+    }
+    const { lengthScale, chargeUnit } = this.options;
+    const i = this.filled;
+    this.positions[i * 3] = x * lengthScale;
+    this.positions[i * 3 + 1] = y * lengthScale;
+    this.positions[i * 3 + 2] = z * lengthScale;
+    this.magnitudes[i] = charge * chargeUnit;
+    this.filled++;
+    this.count++;
+  }
+
+  private readHeader(fields: string[]) {
+    const names = fields.map((field) => field.toLowerCase().replace(/["']/g, ''));
+    const find = (candidates: string[], fallback: number) => {
+      const index = names.findIndex((name) => candidates.includes(name));
+      return index >= 0 ? index : fallback;
+    };
+    this.columns = [
+      find(['x'], 0),
+      find(['y'], 1),
+      find(['z'], 2),
+      find(['q', 'charge', 'magnitude'], 3),
+    ];
+  }
+
+  private takeBatch(): ChargeBatch {
+    const positions = this.positions.slice(0, this.filled * 3);
+    const magnitudes = this.magnitudes.slice(0, this.filled);
+    if (this.options.recenter) {
+      if (!this.offset) {
+        const centroid: [number, number, number] = [0, 0, 0];
+        for (let i = 0; i < positions.length; i++) centroid[i % 3] += positions[i];
+        this.offset = centroid.map((sum) => sum / this.filled) as [number, number, number];
+      }
+      for (let i = 0; i < positions.length; i++) positions[i] -= this.offset[i % 3];
+    }
+    this.filled = 0;
+    return { positions, magnitudes };
+  }
+}
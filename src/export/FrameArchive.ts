@@ -0,0 +1,50 @@
+import type { FrameCache } from '../models/FrameCache';
+import { buildTarArchive } from './TarArchive';
+import type { TarEntry } from './TarArchive';
+
+/**
+ * Frame-sequence archive: a tar holding
+ *   manifest.json          fps, frame count, grid size and per-frame summaries
+ *   grid.bin               grid positions (float32 xyz, little endian)
+ *   frames/frame-NNNNN.bin one encoded frame each (see encodeFrame)
+ */
+export function buildFrameArchive(cache: FrameCache): Uint8Array<ArrayBuffer> {
+  const entries: TarEntry[] = [];
+  const frames = [];
+
+  for (let i = 0; i < cache.frameCount; i++) {
+    const buffer = cache.getFrameBuffer(i);
+    const frame = cache.getFrame(i);
+    if (!buffer || !frame) {
+      throw new Error(`Frame ${i} has not been computed`);
+    }
+    const name = `frames/frame-${String(i).padStart(5, '0')}.bin`;
+    entries.push({ name, data: new Uint8Array(buffer) });
+    frames.push({
+      file: name,
+      time: frame.time,
+      charges: frame.charges.length / 4,
+      lines: frame.lineLengths.length,
+    });
+  }
+
+  const manifest = {
+    format: 'electric-fields-frames',
+    version: 1,
+    fps: cache.fps,
+    frameCount: cache.frameCount,
+    gridPoints: cache.gridPositions.length / 3,
+    frames,
+  };
+  const grid = new Uint8Array(
+    cache.gridPositions.buffer,
+    cache.gridPositions.byteOffset,
+    cache.gridPositions.byteLength
+  );
+
+  return buildTarArchive([
+    { name: 'manifest.json', data: new TextEncoder().encode(JSON.stringify(manifest, null, 2)) },
+    { name: 'grid.bin', data: grid },
+    ...entries,
+  ]);
+}
@@ -0,0 +1,355 @@
+import type * as THREE from 'three';
+
+/**
+ * Binary glTF (GLB) writer for the visualization geometry.
+ *
+ * Attributes are stored quantized (KHR_mesh_quantization): positions as
+ * 16-bit integers, normals as 8-bit normalized vectors, vertex colours as
+ * 8-bit. Meshes drawn many times (arrows, charge spheres) are written once
+ * and placed by per-instance translation, rotation and scale
+ * (EXT_mesh_gpu_instancing), with rotations stored as 16-bit normalized
+ * quaternions. Lines and arrows use KHR_materials_unlit, as they are unlit
+ * in the app.
+ *
+ * DOM-free, so the export worker can run it.
+ */
+
+export interface GltfGeometry {
+  mode: 'triangles' | 'lines';
+  positions: Float32Array; // xyz
+  normals: Float32Array | null; // xyz, unit length
+  colors: Float32Array | null; // Linear rgb per vertex
+  indices: Uint32Array | null;
+}
+
+export interface GltfInstances {
+  translations: Float32Array; // xyz per instance
+  rotations: Float32Array | null; // Unit quaternion xyzw per instance
+  scales: Float32Array | null; // xyz per instance; 1 when null
+}
+
+export interface GltfMaterial {
+  color: [number, number, number, number]; // Linear rgba
+  unlit: boolean;
+  doubleSided: boolean;
+}
+
+export interface GltfNodeSource {
+  name: string;
+  geometry: GltfGeometry;
+  material: GltfMaterial;
+  instances: GltfInstances | null;
+}
+
+export interface GltfExportRequest {
+  nodes: GltfNodeSource[];
+}
+
+// glTF enums
+const ARRAY_BUFFER = 34962;
+const ELEMENT_ARRAY_BUFFER = 34963;
+const BYTE = 5120;
+const UNSIGNED_BYTE = 5121;
+const SHORT = 5122;
+const UNSIGNED_SHORT = 5123;
+const UNSIGNED_INT = 5125;
+const FLOAT = 5126;
+const MODE_LINES = 1;
+const MODE_TRIANGLES = 4;
+
+const GLB_MAGIC = 0x46546c67; // 'glTF'
+const CHUNK_JSON = 0x4e4f534a;
+const CHUNK_BIN = 0x004e4942;
+
+/**
+ * Copy of a BufferGeometry's position, normal and index data in the form
+ * buildGlb expects
+ */
+export function gltfGeometryFromBufferGeometry(geometry: THREE.BufferGeometry): GltfGeometry {
+  const normal = geometry.getAttribute('normal');
+  return {
+    mode: 'triangles',
+    positions: Float32Array.from(geometry.getAttribute('position').array),
+    normals: normal ? Float32Array.from(normal.array) : null,
+    colors: null,
+    indices: geometry.index ? Uint32Array.from(geometry.index.array) : null,
+  };
+}
+
+/**
+ * Polylines joined into one line-list geometry
+ */
+export function gltfGeometryFromPolylines(lines: Float32Array[]): GltfGeometry {
+  let points = 0;
+  let segments = 0;
+  for (const line of lines) {
+    points += line.length / 3;
+    segments += Math.max(0, line.length / 3 - 1);
+  }
+  const positions = new Float32Array(points * 3);
+  const indices = new Uint32Array(segments * 2);
+  let vertex = 0;
+  let index = 0;
+  for (const line of lines) {
+    positions.set(line, vertex * 3);
+    const length = line.length / 3;
+    for (let i = 0; i < length - 1; i++) {
+      indices[index++] = vertex + i;
+      indices[index++] = vertex + i + 1;
+    }
+    vertex += length;
+  }
+  return { mode: 'lines', positions, normals: null, colors: null, indices };
+}
+
+interface Accessor {
+  bufferView: number;
+  componentType: number;
+  normalized?: boolean;
+  count: number;
+  type: string;
+  min?: number[];
+  max?: number[];
+}
+
+/**
+ * Accumulates bufferViews and accessors over one binary chunk; every view
+ * starts on a 4-byte boundary
+ */
+class BinaryBuilder {
+  public bufferViews: Record<string, number>[] = [];
+  public accessors: Accessor[] = [];
+  private parts: Uint8Array[] = [];
+  private length = 0;
+
+  addView(bytes: Uint8Array, target?: number, byteStride?: number): number {
+    const padding = (4 - (this.length % 4)) % 4;
+    if (padding) {
+      this.parts.push(new Uint8Array(padding));
+      this.length += padding;
+    }
+    const view: Record<string, number> = { buffer: 0, byteOffset: this.length, byteLength: bytes.byteLength };
+    if (target !== undefined) view.target = target;
+    if (byteStride !== undefined) view.byteStride = byteStride;
+    this.parts.push(bytes);
+    this.length += bytes.byteLength;
+    this.bufferViews.push(view);
+    return this.bufferViews.length - 1;
+  }
+
+  addAccessor(accessor: Accessor): number {
+    this.accessors.push(accessor);
+    return this.accessors.length - 1;
+  }
+
+  finish(): Uint8Array {
+    const padded = new Uint8Array(Math.ceil(this.length / 4) * 4);
+    let offset = 0;
+    for (const part of this.parts) {
+      padded.set(part, offset);
+      offset += part.byteLength;
+    }
+    return padded;
+  }
+}
+
+const bytesOf = (array: ArrayBufferView) => new Uint8Array(array.buffer, array.byteOffset, array.byteLength);
+
+/**
+ * Vertex attribute as 16-bit integers (3 per vertex, padded to a 4-component
+ * stride as glTF requires vertex elements to be 4-byte aligned)
+ */
+function addShortVec3(builder: BinaryBuilder, values: Int16Array, normalized: boolean): number {
+  const count = values.length / 3;
+  const padded = new Int16Array(count * 4);
+  const min = [Infinity, Infinity, Infinity];
+  const max = [-Infinity, -Infinity, -Infinity];
+  for (let i = 0; i < count; i++) {
+    for (let c = 0; c < 3; c++) {
+      const value = values[i * 3 + c];
+      padded[i * 4 + c] = value;
+      if (value < min[c]) min[c] = value;
+      if (value > max[c]) max[c] = value;
+    }
+  }
+  const view = builder.addView(bytesOf(padded), ARRAY_BUFFER, 8);
+  return builder.addAccessor({ bufferView: view, componentType: SHORT, normalized, count, type: 'VEC3', min, max });
+}
+
+/**
+ * Unit vectors as normalized signed bytes, padded to a 4-byte stride
+ */
+function addNormals(builder: BinaryBuilder, normals: Float32Array): number {
+  const count = normals.length / 3;
+  const packed = new Int8Array(count * 4);
+  for (let i = 0; i < count; i++) {
+    for (let c = 0; c < 3; c++) packed[i * 4 + c] = Math.round(Math.max(-1, Math.min(1, normals[i * 3 + c])) * 127);
+  }
+  const view = builder.addView(bytesOf(packed), ARRAY_BUFFER, 4);
+  return builder.addAccessor({ bufferView: view, componentType: BYTE, normalized: true, count, type: 'VEC3' });
+}
+
+function addColors(builder: BinaryBuilder, colors: Float32Array): number {
+  const count = colors.length / 3;
+  const packed = new Uint8Array(count * 4);
+  for (let i = 0; i < count; i++) {
+    for (let c = 0; c < 3; c++) packed[i * 4 + c] = Math.round(Math.max(0, Math.min(1, colors[i * 3 + c])) * 255);
+  }
+  const view = builder.addView(packed, ARRAY_BUFFER, 4);
+  return builder.addAccessor({ bufferView: view, componentType: UNSIGNED_BYTE, normalized: true, count, type: 'VEC3' });
+}
+
+function addIndices(builder: BinaryBuilder, indices: Uint32Array, vertexCount: number): number {
+  const narrow = vertexCount <= 65535;
+  const data = narrow ? Uint16Array.from(indices) : indices;
+  const view = builder.addView(bytesOf(data), ELEMENT_ARRAY_BUFFER);
+  return builder.addAccessor({
+    bufferView: view,
+    componentType: narrow ? UNSIGNED_SHORT : UNSIGNED_INT,
+    count: indices.length,
+    type: 'SCALAR',
+  });
+}
+
+function addFloatVec3(builder: BinaryBuilder, values: Float32Array): number {
+  const view = builder.addView(bytesOf(values));
+  return builder.addAccessor({ bufferView: view, componentType: FLOAT, count: values.length / 3, type: 'VEC3' });
+}
+
+function addRotations(builder: BinaryBuilder, rotations: Float32Array): number {
+  const packed = new Int16Array(rotations.length);
+  for (let i = 0; i < rotations.length; i++) packed[i] = Math.round(Math.max(-1, Math.min(1, rotations[i])) * 32767);
+  const view = builder.addView(bytesOf(packed));
+  return builder.addAccessor({
+    bufferView: view,
+    componentType: SHORT,
+    normalized: true,
+    count: rotations.length / 4,
+    type: 'VEC4',
+  });
+}
+
+/**
+ * Build a GLB holding every node in the request as a top-level scene node
+ */
+export function buildGlb(request: GltfExportRequest): Uint8Array<ArrayBuffer> {
+  const builder = new BinaryBuilder();
+  const meshes: Record<string, unknown>[] = [];
+  const materials: Record<string, unknown>[] = [];
+  const nodes: Record<string, unknown>[] = [];
+  let instanced = false;
+  let unlit = false;
+
+  for (const source of request.nodes) {
+    const { geometry, instances } = source;
+    const vertexCount = geometry.positions.length / 3;
+    if (vertexCount === 0 || (instances && instances.translations.length === 0)) continue;
+
+    const node: Record<string, unknown> = { name: source.name, mesh: meshes.length };
+    const quantized = new Int16Array(geometry.positions.length);
+    let instanceScale = 1;
+    if (instances) {
+      // Instance transforms are applied to the vertices as stored, so the
+      // quantization scale is folded into each instance's scale and the
+      // positions are written normalized
+      let extent = 0;
+      for (const value of geometry.positions) extent = Math.max(extent, Math.abs(value));
+      instanceScale = extent || 1;
+      for (let i = 0; i < quantized.length; i++) quantized[i] = Math.round((geometry.positions[i] / instanceScale) * 32767);
+    } else {
+      // Integer positions around the bounding-box centre; the node's
+      // translation and (uniform) scale map them back
+      const min = [Infinity, Infinity, Infinity];
+      const max = [-Infinity, -Infinity, -Infinity];
+      for (let i = 0; i < geometry.positions.length; i++) {
+        const c = i % 3;
+        min[c] = Math.min(min[c], geometry.positions[i]);
+        max[c] = Math.max(max[c], geometry.positions[i]);
+      }
+      const centre = min.map((value, c) => (value + max[c]) / 2);
+      const halfExtent = Math.max(...max.map((value, c) => (value - min[c]) / 2)) || 1;
+      for (let i = 0; i < quantized.length; i++) {
+        quantized[i] = Math.round(((geometry.positions[i] - centre[i % 3]) / halfExtent) * 32767);
+      }
+      node.translation = centre;
+      node.scale = [halfExtent / 32767, halfExtent / 32767, halfExtent / 32767];
+    }
+
+    const attributes: Record<string, number> = { POSITION: addShortVec3(builder, quantized, instances !== null) };
+    if (geometry.normals) attributes.NORMAL = addNormals(builder, geometry.normals);
+    if (geometry.colors) attributes.COLOR_0 = addColors(builder, geometry.colors);
+    const primitive: Record<string, unknown> = {
+      attributes,
+      material: materials.length,
+      mode: geometry.mode === 'lines' ? MODE_LINES : MODE_TRIANGLES,
+    };
+    if (geometry.indices) primitive.indices = addIndices(builder, geometry.indices, vertexCount);
+    meshes.push({ name: source.name, primitives: [primitive] });
+
+    const { color } = source.material;
+    const material: Record<string, unknown> = {
+      name: source.name,
+      pbrMetallicRoughness: { baseColorFactor: color, metallicFactor: 0, roughnessFactor: 0.7 },
+      doubleSided: source.material.doubleSided,
+    };
+    if (color[3] < 1) material.alphaMode = 'BLEND';
+    if (source.material.unlit) {
+      material.extensions = { KHR_materials_unlit: {} };
+      unlit = true;
+    }
+    materials.push(material);
+
+    if (instances) {
+      const count = instances.translations.length / 3;
+      const scales = new Float32Array(count * 3);
+      for (let i = 0; i < scales.length; i++) scales[i] = (instances.scales ? instances.scales[i] : 1) * instanceScale;
+      const instanceAttributes: Record<string, number> = {
+        TRANSLATION: addFloatVec3(builder, instances.translations),
+        SCALE: addFloatVec3(builder, scales),
+      };
+      if (instances.rotations) instanceAttributes.ROTATION = addRotations(builder, instances.rotations);
+      node.extensions = { EXT_mesh_gpu_instancing: { attributes: instanceAttributes } };
+      instanced = true;
+    }
+    nodes.push(node);
+  }
+
+  const binary = builder.finish();
+  const extensionsUsed = ['KHR_mesh_quantization'];
+  if (instanced) extensionsUsed.push('EXT_mesh_gpu_instancing');
+  if (unlit) extensionsUsed.push('KHR_materials_unlit');
+  const json = {
+    asset: { version: '2.0', generator: 'Electric Fields Visualizer' },
+    extensionsUsed,
+    extensionsRequired: ['KHR_mesh_quantization'],
+    scene: 0,
+    scenes: [{ nodes: nodes.map((_, i) => i) }],
+    nodes,
+    meshes,
+    materials,
+    accessors: builder.accessors,
+    bufferViews: builder.bufferViews,
+    buffers: binary.byteLength > 0 ? [{ byteLength: binary.byteLength }] : [],
+  };
+
+  // JSON chunk padded with spaces, binary chunk with zeros
+  const jsonBytes = new TextEncoder().encode(JSON.stringify(json));
+  const jsonLength = Math.ceil(jsonBytes.length / 4) * 4;
+  const binaryChunk = binary.byteLength > 0 ? 8 + binary.byteLength : 0;
+  const total = 12 + 8 + jsonLength + binaryChunk;
+  const glb = new Uint8Array(total);
+  const view = new DataView(glb.buffer);
+  view.setUint32(0, GLB_MAGIC, true);
+  view.setUint32(4, 2, true);
+  view.setUint32(8, total, true);
+  view.setUint32(12, jsonLength, true);
+  view.setUint32(16, CHUNK_JSON, true);
+  glb.fill(0x20, 20, 20 + jsonLength);
+  glb.set(jsonBytes, 20);
+  if (binaryChunk === 0) return glb;
+  const binaryOffset = 20 + jsonLength;
+  view.setUint32(binaryOffset, binary.byteLength, true);
+  view.setUint32(binaryOffset + 4, CHUNK_BIN, true);
+  glb.set(binary, binaryOffset + 8);
+  return glb;
+}
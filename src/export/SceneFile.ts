@@ -0,0 +1,245 @@
+import type { GaussSurface } from '../models/GaussSurface';
+
+/**
+ * Binary scene file (.efvs), little endian throughout:
+ *
+ *   header      32 bytes
+ *     0  u32   magic 'EFVS'
+ *     4  u16   version
+ *     6  u16   flags (SCENE_FLAG_*)
+ *     8  u32   charge count
+ *     12 u32   probe count
+ *     16 u32   id section length (bytes)
+ *     20 u32   primitive section length (bytes)
+ *     24 u64   reserved
+ *   positions   charge count × xyz, float32 or float64
+ *   magnitudes  charge count, same precision (C)
+ *   ids         UTF-8, newline-separated, if SCENE_FLAG_IDS
+ *   probes      probe count × (x, y, z, target V or NaN), float64
+ *   primitives  UTF-8 JSON array of Gauss surfaces
+ *
+ * Every section starts on an 8-byte boundary, so a decoder can copy
+ * float64 sections straight into typed arrays.
+ */
+
+export const SCENE_MAGIC = 0x53564645; // 'EFVS' read as a little-endian u32
+export const SCENE_VERSION = 1;
+export const SCENE_FLAG_FLOAT64 = 1;
+export const SCENE_FLAG_IDS = 2;
+
+const HEADER_SIZE = 32;
+const ALIGNMENT = 8;
+
+export interface SceneProbe {
+  id: string;
+  position: { x: number; y: number; z: number };
+  target?: number;
+}
+
+export interface SceneData {
+  positions: Float64Array; // xyz per charge
+  magnitudes: Float64Array; // C per charge
+  ids: string[] | null;
+  probes: SceneProbe[];
+  primitives: GaussSurface[];
+}
+
+const padding = (length: number) => (ALIGNMENT - (length % ALIGNMENT)) % ALIGNMENT;
+
+const bytesOf = (array: Float32Array | Float64Array): Uint8Array<ArrayBuffer> =>
+  new Uint8Array(array.buffer as ArrayBuffer, array.byteOffset, array.byteLength);
+
+const LITTLE_ENDIAN = new Uint8Array(new Uint16Array([1]).buffer)[0] === 1;
+
+/**
+ * Encode a scene as a Blob. Charge arrays are handed to the Blob as views,
+ * not copied, when stored as float64.
+ */
+export function encodeScene(scene: SceneData, precision: 'float32' | 'float64' = 'float64'): Blob {
+  if (!LITTLE_ENDIAN) throw new Error('Scene files can only be written on little-endian hosts');
+  const encoder = new TextEncoder();
+  const count = scene.magnitudes.length;
+  const withIds = scene.ids !== null && count > 0;
+  const ids = withIds ? encoder.encode(scene.ids!.join('\n')) : new Uint8Array(0);
+  // Probe ids are not stored; they are reassigned on load
+  const probes = new Float64Array(scene.probes.length * 4);
+  scene.probes.forEach((probe, i) => {
+    probes[i * 4] = probe.position.x;
+    probes[i * 4 + 1] = probe.position.y;
+    probes[i * 4 + 2] = probe.position.z;
+    probes[i * 4 + 3] = probe.target ?? NaN;
+  });
+  const primitives = encoder.encode(
+    JSON.stringify(scene.primitives, (_, value) => (value instanceof Float32Array ? Array.from(value) : value))
+  );
+
+  const header = new DataView(new ArrayBuffer(HEADER_SIZE));
+  header.setUint32(0, SCENE_MAGIC, true);
+  header.setUint16(4, SCENE_VERSION, true);
+  header.setUint16(6, (precision === 'float64' ? SCENE_FLAG_FLOAT64 : 0) | (withIds ? SCENE_FLAG_IDS : 0), true);
+  header.setUint32(8, count, true);
+  header.setUint32(12, scene.probes.length, true);
+  header.setUint32(16, ids.length, true);
+  header.setUint32(20, primitives.length, true);
+
+  const toPrecision = (array: Float64Array) => (precision === 'float64' ? array : Float32Array.from(array));
+  const sections: Uint8Array[] = [
+    bytesOf(toPrecision(scene.positions.subarray(0, count * 3))),
+    bytesOf(toPrecision(scene.magnitudes)),
+    ids,
+    bytesOf(probes),
+    primitives,
+  ];
+  const parts: BlobPart[] = [header.buffer as ArrayBuffer];
+  for (const section of sections) {
+    parts.push(section as Uint8Array<ArrayBuffer>, new Uint8Array(padding(section.length)));
+  }
+  return new Blob(parts, { type: 'application/octet-stream' });
+}
+
+interface SceneSection {
+  bytes: Uint8Array; // Destination of the section's bytes
+  length: number; // Bytes including padding
+}
+
+/**
+ * Incremental decoder: push chunks as they arrive and call finish() once
+ * the input ends. Charge arrays are allocated from the header and filled in
+ * place, so a file is never held whole in memory alongside its decoded
+ * arrays.
+ */
+export class SceneDecoder {
+  private header = new Uint8Array(HEADER_SIZE);
+  private headerFilled = 0;
+  private flags = 0;
+  private chargeCount = 0;
+  private probeCount = 0;
+  private sections: SceneSection[] = [];
+  private section = 0;
+  private sectionFilled = 0;
+  private positions: Float32Array | Float64Array = new Float64Array(0);
+  private magnitudes: Float32Array | Float64Array = new Float64Array(0);
+  private ids = new Uint8Array(0);
+  private probes = new Float64Array(0);
+  private primitives = new Uint8Array(0);
+  public bytesRead = 0;
+
+  /**
+   * Total file size implied by the header, or null until it has been read
+   */
+  get expectedLength(): number | null {
+    if (this.headerFilled < HEADER_SIZE) return null;
+    return this.sections.reduce((sum, section) => sum + section.length, HEADER_SIZE);
+  }
+
+  get chargesExpected(): number {
+    return this.chargeCount;
+  }
+
+  public push(chunk: Uint8Array) {
+    this.bytesRead += chunk.length;
+    let offset = 0;
+    if (this.headerFilled < HEADER_SIZE) {
+      const take = Math.min(HEADER_SIZE - this.headerFilled, chunk.length);
+      this.header.set(chunk.subarray(0, take), this.headerFilled);
+      this.headerFilled += take;
+      offset = take;
+      if (this.headerFilled < HEADER_SIZE) return;
+      this.readHeader();
+      this.skipEmptySections();
+    }
+
+    while (offset < chunk.length && this.section < this.sections.length) {
+      const section = this.sections[this.section];
+      const take = Math.min(section.length - this.sectionFilled, chunk.length - offset);
+      const writable = Math.max(0, Math.min(section.bytes.length - this.sectionFilled, take));
+      if (writable > 0) section.bytes.set(chunk.subarray(offset, offset + writable), this.sectionFilled);
+      this.sectionFilled += take;
+      offset += take;
+      if (this.sectionFilled === section.length) {
+        this.section++;
+        this.sectionFilled = 0;
+        this.skipEmptySections();
+      }
+    }
+  }
+
+  private skipEmptySections() {
+    while (this.section < this.sections.length && this.sections[this.section].length === 0) this.section++;
+  }
+
+  private readHeader() {
+    const view = new DataView(this.header.buffer);
+    if (view.getUint32(0, true) !== SCENE_MAGIC) throw new Error('Not a scene file');
+    const version = view.getUint16(4, true);
+    if (version > SCENE_VERSION) throw new Error(`Unsupported scene file version ${version}`);
+    this.flags = view.getUint16(6, true);
+    this.chargeCount = view.getUint32(8, true);
+    this.probeCount = view.getUint32(12, true);
+    const idLength = view.getUint32(16, true);
+    const primitiveLength = view.getUint32(20, true);
+
+    const float64 = (this.flags & SCENE_FLAG_FLOAT64) !== 0;
+    this.positions = float64 ? new Float64Array(this.chargeCount * 3) : new Float32Array(this.chargeCount * 3);
+    this.magnitudes = float64 ? new Float64Array(this.chargeCount) : new Float32Array(this.chargeCount);
+    this.ids = new Uint8Array(idLength);
+    this.probes = new Float64Array(this.probeCount * 4);
+    this.primitives = new Uint8Array(primitiveLength);
+
+    const asBytes = (array: Float32Array | Float64Array) => new Uint8Array(array.buffer, array.byteOffset, array.byteLength);
+    this.sections = [asBytes(this.positions), asBytes(this.magnitudes), this.ids, asBytes(this.probes), this.primitives].map(
+      (bytes) => ({ bytes, length: bytes.length + padding(bytes.length) })
+    );
+  }
+
+  public finish(): SceneData {
+    if (this.headerFilled < HEADER_SIZE || this.section < this.sections.length) {
+      throw new Error('Scene file is truncated');
+    }
+    if (!LITTLE_ENDIAN) {
+      for (const array of [this.positions, this.magnitudes, this.probes]) swapToHost(array);
+    }
+    const decoder = new TextDecoder();
+    const primitives: GaussSurface[] = this.primitives.length > 0 ? JSON.parse(decoder.decode(this.primitives)) : [];
+    for (const surface of primitives) {
+      if (surface.kind === 'mesh') surface.triangles = Float32Array.from(surface.triangles);
+    }
+    const probes: SceneProbe[] = [];
+    const stamp = Date.now();
+    for (let i = 0; i < this.probeCount; i++) {
+      const target = this.probes[i * 4 + 3];
+      probes.push({
+        id: `voltage-${stamp}-${i}`,
+        position: { x: this.probes[i * 4], y: this.probes[i * 4 + 1], z: this.probes[i * 4 + 2] },
+        ...(Number.isNaN(target) ? {} : { target }),
+      });
+    }
+    return {
+      positions: this.positions instanceof Float64Array ? this.positions : Float64Array.from(this.positions),
+      magnitudes: this.magnitudes instanceof Float64Array ? this.magnitudes : Float64Array.from(this.magnitudes),
+      ids: (this.flags & SCENE_FLAG_IDS) !== 0 ? decoder.decode(this.ids).split('\n') : null,
+      probes,
+      primitives,
+    };
+  }
+}
+
+/**
+ * Reinterpret little-endian file bytes in place on a big-endian host
+ */
+function swapToHost(array: Float32Array | Float64Array) {
+  const view = new DataView(array.buffer, array.byteOffset, array.byteLength);
+  const size = array.BYTES_PER_ELEMENT;
+  for (let i = 0; i < array.length; i++) {
+    array[i] = size === 8 ? view.getFloat64(i * 8, true) : view.getFloat32(i * 4, true);
+  }
+}
+
+/**
+ * Decode a whole scene file held in memory
+ */
+export function decodeScene(bytes: Uint8Array): SceneData {
+  const decoder = new SceneDecoder();
+  decoder.push(bytes);
+  return decoder.finish();
+}
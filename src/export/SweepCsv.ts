@@ -0,0 +1,25 @@
+import type { SweepResult } from '../models/ParameterSweep';
+
+/**
+ * One CSV row per configuration: the swept parameter values, then every
+ * metric. Rows follow the result's row-major order (axis 0 slowest).
+ */
+export function buildSweepCsv(result: SweepResult): string {
+  const header = [...result.axisLabels, ...result.metrics];
+  const lines = [header.map((name) => `"${name.replace(/"/g, '""')}"`).join(',')];
+  const sizes = result.axisValues.map((values) => values.length);
+  const metricCount = result.metrics.length;
+  const configurations = result.values.length / metricCount;
+
+  for (let c = 0; c < configurations; c++) {
+    const cells: string[] = new Array(sizes.length);
+    let remainder = c;
+    for (let a = sizes.length - 1; a >= 0; a--) {
+      cells[a] = String(result.axisValues[a][remainder % sizes[a]]);
+      remainder = Math.floor(remainder / sizes[a]);
+    }
+    for (let m = 0; m < metricCount; m++) cells.push(String(result.values[c * metricCount + m]));
+    lines.push(cells.join(','));
+  }
+  return lines.join('\n') + '\n';
+}
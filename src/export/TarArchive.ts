@@ -0,0 +1,64 @@
+/**
+ * Minimal ustar writer. DOM-free, so the same code builds archives in the
+ * browser and under Node.
+ */
+
+export interface TarEntry {
+  name: string; // Up to 100 bytes
+  data: Uint8Array;
+  mtime?: number; // Seconds since the epoch
+}
+
+const BLOCK_SIZE = 512;
+
+function writeString(block: Uint8Array, offset: number, length: number, value: string) {
+  const bytes = new TextEncoder().encode(value);
+  block.set(bytes.subarray(0, length), offset);
+}
+
+function writeOctal(block: Uint8Array, offset: number, length: number, value: number) {
+  // Zero-padded octal followed by a NUL
+  writeString(block, offset, length, value.toString(8).padStart(length - 1, '0') + '\0');
+}
+
+function tarHeader(entry: TarEntry): Uint8Array {
+  if (new TextEncoder().encode(entry.name).length > 100) {
+    throw new Error(`Archive entry name too long: ${entry.name}`);
+  }
+
+  const header = new Uint8Array(BLOCK_SIZE);
+  writeString(header, 0, 100, entry.name);
+  writeOctal(header, 100, 8, 0o644); // mode
+  writeOctal(header, 108, 8, 0); // uid
+  writeOctal(header, 116, 8, 0); // gid
+  writeOctal(header, 124, 12, entry.data.length);
+  writeOctal(header, 136, 12, Math.floor(entry.mtime ?? Date.now() / 1000));
+  header.fill(0x20, 148, 156); // Checksum is computed with its own field as spaces
+  header[156] = 0x30; // '0': regular file
+  writeString(header, 257, 6, 'ustar\0');
+  writeString(header, 263, 2, '00');
+
+  let checksum = 0;
+  for (let i = 0; i < BLOCK_SIZE; i++) checksum += header[i];
+  writeString(header, 148, 8, checksum.toString(8).padStart(6, '0') + '\0 ');
+  return header;
+}
+
+/**
+ * Concatenate entries into a tar archive (each entry padded to 512 bytes,
+ * followed by two zero blocks)
+ */
+export function buildTarArchive(entries: TarEntry[]): Uint8Array<ArrayBuffer> {
+  const padded = (length: number) => Math.ceil(length / BLOCK_SIZE) * BLOCK_SIZE;
+  const total = entries.reduce((sum, entry) => sum + BLOCK_SIZE + padded(entry.data.length), 0) + 2 * BLOCK_SIZE;
+  const archive = new Uint8Array(total);
+
+  let offset = 0;
+  for (const entry of entries) {
+    archive.set(tarHeader(entry), offset);
+    offset += BLOCK_SIZE;
+    archive.set(entry.data, offset);
+    offset += padded(entry.data.length);
+  }
+  return archive;
+}
@@ -0,0 +1,247 @@
+/**
+ * Compact scene state for share links (#s=… in the URL fragment).
+ *
+ * Positions are quantized to a grid and charges to a step relative to the
+ * largest |q| in the scene, so partial charges of ~1e-20 C keep the same
+ * resolution as microcoulombs; both steps are stored in the header. Each
+ * charge and probe is written as the zigzag varint difference from the
+ * previous one, so neighbouring or equal values take a byte or two. The
+ * byte stream is deflated (CompressionStream 'deflate-raw') and
+ * base64url-encoded. Decoding needs no server.
+ *
+ *   u8       version
+ *   f32 f32  grid step (scene units), charge step (C)
+ *   u8       flags: 1 arrows, 2 field lines, 4 B field
+ *   6 × sv   camera position and target, in grid steps
+ *   uv       charge count, then per charge sv dx dy dz dq
+ *   uv       probe count, then per probe sv dx dy dz, u8 has-target [f32 target V]
+ *
+ * (uv: unsigned LEB128 varint, sv: zigzag varint)
+ *
+ * DOM-free apart from CompressionStream, which browsers and Node 18+ share.
+ */
+
+type Vec3 = { x: number; y: number; z: number };
+
+export interface UrlState {
+  charges: { position: Vec3; magnitude: number }[]; // C
+  probes: { position: Vec3; target?: number }[];
+  camera: { position: Vec3; target: Vec3 };
+  showVectorField: boolean;
+  showFieldLines: boolean;
+  magnetic: boolean;
+}
+
+export interface UrlStateOptions {
+  gridStep: number; // Scene units
+  chargeResolution: number; // Charge step as a fraction of the largest |q|
+}
+
+export const URL_STATE_PREFIX = '#s=';
+
+const VERSION = 1;
+
+export function createDefaultUrlStateOptions(): UrlStateOptions {
+  return {
+    gridStep: 0.01,
+    chargeResolution: 1e-6,
+  };
+}
+
+class ByteWriter {
+  private bytes = new Uint8Array(256);
+  private length = 0;
+
+  private reserve(count: number) {
+    if (this.length + count <= this.bytes.length) return;
+    const grown = new Uint8Array(Math.max(this.bytes.length * 2, this.length + count));
+    grown.set(this.bytes.subarray(0, this.length));
+    this.bytes = grown;
+  }
+
+  u8(value: number) {
+    this.reserve(1);
+    this.bytes[this.length++] = value;
+  }
+
+  f32(value: number) {
+    this.reserve(4);
+    new DataView(this.bytes.buffer).setFloat32(this.length, value, true);
+    this.length += 4;
+  }
+
+  // Values beyond 2^31 are fine: the arithmetic stays in doubles
+  uvarint(value: number) {
+    while (value >= 0x80) {
+      this.u8((value % 0x80) | 0x80);
+      value = Math.floor(value / 0x80);
+    }
+    this.u8(value);
+  }
+
+  svarint(value: number) {
+    this.uvarint(value < 0 ? -2 * value - 1 : 2 * value);
+  }
+
+  finish(): Uint8Array<ArrayBuffer> {
+    return this.bytes.slice(0, this.length);
+  }
+}
+
+class ByteReader {
+  private bytes: Uint8Array;
+  private view: DataView;
+  private offset = 0;
+
+  constructor(bytes: Uint8Array) {
+    this.bytes = bytes;
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  }
+
+  u8(): number {
+    if (this.offset >= this.bytes.length) throw new Error('Share link is truncated');
+    return this.bytes[this.offset++];
+  }
+
+  f32(): number {
+    if (this.offset + 4 > this.bytes.length) throw new Error('Share link is truncated');
+    const value = this.view.getFloat32(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  uvarint(): number {
+    let value = 0;
+    let scale = 1;
+    for (;;) {
+      const byte = this.u8();
+      value += (byte & 0x7f) * scale;
+      if (byte < 0x80) return value;
+      scale *= 0x80;
+    }
+  }
+
+  svarint(): number {
+    const value = this.uvarint();
+    return value % 2 === 0 ? value / 2 : -(value + 1) / 2;
+  }
+}
+
+async function transform(bytes: Uint8Array<ArrayBuffer>, stream: CompressionStream | DecompressionStream) {
+  const output = new Blob([bytes]).stream().pipeThrough(stream);
+  return new Uint8Array(await new Response(output).arrayBuffer());
+}
+
+function toBase64Url(bytes: Uint8Array): string {
+  let binary = '';
+  for (let i = 0; i < bytes.length; i += 0x8000) {
+    binary += String.fromCharCode(...bytes.subarray(i, i + 0x8000));
+  }
+  return btoa(binary).replace(/\+/g, '-').replace(/\//g, '_').replace(/=+$/, '');
+}
+
+function fromBase64Url(text: string): Uint8Array<ArrayBuffer> {
+  const binary = atob(text.replace(/-/g, '+').replace(/_/g, '/'));
+  const bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+  return bytes;
+}
+
+// Steps travel as float32; rounding to float32's 7 significant digits turns
+// 0.0099999998 back into 0.01, so decoded positions are not off by that error
+const readStep = (value: number) => Number(value.toPrecision(7));
+
+/**
+ * Encode a scene as the payload of a #s= fragment. Throws if a non-zero
+ * charge would round to zero, rather than share a different scene.
+ */
+export async function encodeUrlState(state: UrlState, options: UrlStateOptions): Promise<string> {
+  const { gridStep, chargeResolution } = options;
+  const largest = state.charges.reduce((max, { magnitude }) => Math.max(max, Math.abs(magnitude)), 0);
+  const chargeStep = largest > 0 ? largest * chargeResolution : 1;
+  const writer = new ByteWriter();
+  writer.u8(VERSION);
+  writer.f32(gridStep);
+  writer.f32(chargeStep);
+  // Quantize with the steps exactly as the decoder will read them back
+  const grid = readStep(Math.fround(gridStep));
+  const charge = readStep(Math.fround(chargeStep));
+  writer.u8((state.showVectorField ? 1 : 0) | (state.showFieldLines ? 2 : 0) | (state.magnetic ? 4 : 0));
+
+  const q = (value: number) => Math.round(value / grid);
+  for (const point of [state.camera.position, state.camera.target]) {
+    writer.svarint(q(point.x));
+    writer.svarint(q(point.y));
+    writer.svarint(q(point.z));
+  }
+
+  let previous = [0, 0, 0, 0];
+  writer.uvarint(state.charges.length);
+  for (const { position, magnitude } of state.charges) {
+    const current = [q(position.x), q(position.y), q(position.z), Math.round(magnitude / charge)];
+    if (current[3] === 0 && magnitude !== 0) {
+      const step = charge.toExponential(2);
+      throw new Error(`Charge ${magnitude.toExponential(2)} C is below the link's charge step ${step} C`);
+    }
+    for (let i = 0; i < 4; i++) writer.svarint(current[i] - previous[i]);
+    previous = current;
+  }
+
+  previous = [0, 0, 0];
+  writer.uvarint(state.probes.length);
+  for (const { position, target } of state.probes) {
+    const current = [q(position.x), q(position.y), q(position.z)];
+    for (let i = 0; i < 3; i++) writer.svarint(current[i] - previous[i]);
+    previous = current;
+    writer.u8(target === undefined ? 0 : 1);
+    if (target !== undefined) writer.f32(target);
+  }
+
+  return toBase64Url(await transform(writer.finish(), new CompressionStream('deflate-raw')));
+}
+
+/**
+ * Decode the payload of a #s= fragment; throws on malformed input
+ */
+export async function decodeUrlState(payload: string): Promise<UrlState> {
+  const reader = new ByteReader(await transform(fromBase64Url(payload), new DecompressionStream('deflate-raw')));
+  const version = reader.u8();
+  if (version !== VERSION) throw new Error(`Unsupported share link version ${version}`);
+  const grid = readStep(reader.f32());
+  const charge = readStep(reader.f32());
+  const flags = reader.u8();
+
+  const readPoint = () => ({ x: reader.svarint() * grid, y: reader.svarint() * grid, z: reader.svarint() * grid });
+  const camera = { position: readPoint(), target: readPoint() };
+
+  const charges: UrlState['charges'] = [];
+  let previous = [0, 0, 0, 0];
+  const chargeCount = reader.uvarint();
+  for (let n = 0; n < chargeCount; n++) {
+    const current = previous.map((value) => value + reader.svarint());
+    charges.push({
+      position: { x: current[0] * grid, y: current[1] * grid, z: current[2] * grid },
+      magnitude: current[3] * charge,
+    });
+    previous = current;
+  }
+
+  const probes: UrlState['probes'] = [];
+  previous = [0, 0, 0];
+  const probeCount = reader.uvarint();
+  for (let n = 0; n < probeCount; n++) {
+    const current = previous.map((value) => value + reader.svarint());
+    const position = { x: current[0] * grid, y: current[1] * grid, z: current[2] * grid };
+    probes.push(reader.u8() ? { position, target: reader.f32() } : { position });
+    previous = current;
+  }
+
+  return {
+    charges,
+    probes,
+    camera,
+    showVectorField: (flags & 1) !== 0,
+    showFieldLines: (flags & 2) !== 0,
+    magnetic: (flags & 4) !== 0,
+  };
+}
@@ -0,0 +1,367 @@
+import type { TarEntry } from './TarArchive';
+
+/**
+ * Field data for ParaView and other VTK tools, in three flavours:
+ *
+ *   legacy  .vtk files (binary, big endian as the legacy format requires)
+ *   xml     .vti image data and .vtp poly data, raw appended little-endian blocks
+ *   raw     bare little-endian arrays with NRRD headers for the volumes and a
+ *           manifest.json describing every file
+ *
+ * DOM-free, so the export worker and the Node tools share it.
+ */
+
+export type VtkFormat = 'legacy' | 'xml' | 'raw';
+
+/**
+ * Regular grid with x varying fastest, as VTK expects
+ */
+export interface ExportGrid {
+  dimensions: [number, number, number];
+  origin: [number, number, number];
+  spacing: [number, number, number];
+  fieldName: string; // 'E' or 'B'
+  field: Float32Array; // xyz per point
+  potential: Float32Array | null; // V per point
+}
+
+/**
+ * Indexed triangle mesh with one scalar per vertex
+ */
+export interface ExportMesh {
+  positions: Float32Array;
+  indices: Uint32Array;
+  scalarName: string;
+  scalars: Float32Array;
+}
+
+export interface VtkExportRequest {
+  format: VtkFormat;
+  grid: ExportGrid | null;
+  lines: Float32Array[]; // xyz polylines
+  mesh: ExportMesh | null;
+}
+
+const TITLE = 'Electric Fields Visualizer export';
+
+/**
+ * Convert vector-field samples from generateGridPositions (z varying
+ * fastest) to an ExportGrid. This reorders the samples but does not
+ * resample them.
+ */
+export function exportGridFromSamples(
+  positions: Float32Array,
+  field: Float32Array,
+  potential: Float32Array | null,
+  fieldName: string
+): ExportGrid {
+  const count = positions.length / 3;
+  const n = Math.round(Math.cbrt(count));
+  const step = n > 1 ? positions[5] - positions[2] : 1;
+  const reordered = new Float32Array(count * 3);
+  const reorderedPotential = potential ? new Float32Array(count) : null;
+  for (let ix = 0; ix < n; ix++) {
+    for (let iy = 0; iy < n; iy++) {
+      for (let iz = 0; iz < n; iz++) {
+        const source = (ix * n + iy) * n + iz;
+        const target = (iz * n + iy) * n + ix;
+        reordered[target * 3] = field[source * 3];
+        reordered[target * 3 + 1] = field[source * 3 + 1];
+        reordered[target * 3 + 2] = field[source * 3 + 2];
+        if (reorderedPotential) reorderedPotential[target] = potential![source];
+      }
+    }
+  }
+  return {
+    dimensions: [n, n, n],
+    origin: [positions[0], positions[1], positions[2]],
+    spacing: [step, step, step],
+    fieldName,
+    field: reordered,
+    potential: reorderedPotential,
+  };
+}
+
+/**
+ * Files for everything in the request, named by dataset
+ */
+export function buildVtkExport(request: VtkExportRequest): TarEntry[] {
+  const { format, grid, lines, mesh } = request;
+  const entries: TarEntry[] = [];
+  if (format === 'raw') return buildRawExport(request);
+  if (grid) {
+    entries.push(format === 'legacy' ? { name: 'field.vtk', data: gridToLegacyVtk(grid) } : { name: 'field.vti', data: gridToVti(grid) });
+  }
+  if (lines.length > 0) {
+    entries.push(
+      format === 'legacy'
+        ? { name: 'field-lines.vtk', data: polylinesToLegacyVtk(lines) }
+        : { name: 'field-lines.vtp', data: polylinesToVtp(lines) }
+    );
+  }
+  if (mesh) {
+    entries.push(
+      format === 'legacy' ? { name: 'surface.vtk', data: meshToLegacyVtk(mesh) } : { name: 'surface.vtp', data: meshToVtp(mesh) }
+    );
+  }
+  return entries;
+}
+
+// --- Legacy ---------------------------------------------------------------
+
+class LegacyWriter {
+  private parts: Uint8Array[] = [];
+  private encoder = new TextEncoder();
+
+  text(value: string) {
+    this.parts.push(this.encoder.encode(value));
+  }
+
+  float32(values: ArrayLike<number>) {
+    const bytes = new Uint8Array(values.length * 4);
+    const view = new DataView(bytes.buffer);
+    for (let i = 0; i < values.length; i++) view.setFloat32(i * 4, values[i], false);
+    this.parts.push(bytes);
+    this.text('\n');
+  }
+
+  int32(values: ArrayLike<number>) {
+    const bytes = new Uint8Array(values.length * 4);
+    const view = new DataView(bytes.buffer);
+    for (let i = 0; i < values.length; i++) view.setInt32(i * 4, values[i], false);
+    this.parts.push(bytes);
+    this.text('\n');
+  }
+
+  header(dataset: string) {
+    this.text(`# vtk DataFile Version 3.0\n${TITLE}\nBINARY\nDATASET ${dataset}\n`);
+  }
+
+  finish(): Uint8Array<ArrayBuffer> {
+    return concatBytes(this.parts);
+  }
+}
+
+export function gridToLegacyVtk(grid: ExportGrid): Uint8Array<ArrayBuffer> {
+  const writer = new LegacyWriter();
+  const count = grid.field.length / 3;
+  writer.header('STRUCTURED_POINTS');
+  writer.text(
+    `DIMENSIONS ${grid.dimensions.join(' ')}\nORIGIN ${grid.origin.join(' ')}\nSPACING ${grid.spacing.join(' ')}\n` +
+      `POINT_DATA ${count}\nVECTORS ${grid.fieldName} float\n`
+  );
+  writer.float32(grid.field);
+  if (grid.potential) {
+    writer.text('SCALARS V float 1\nLOOKUP_TABLE default\n');
+    writer.float32(grid.potential);
+  }
+  return writer.finish();
+}
+
+export function polylinesToLegacyVtk(lines: Float32Array[]): Uint8Array<ArrayBuffer> {
+  const { points, connectivity } = flattenPolylines(lines);
+  const writer = new LegacyWriter();
+  writer.header('POLYDATA');
+  writer.text(`POINTS ${points.length / 3} float\n`);
+  writer.float32(points);
+  const cells = new Int32Array(connectivity.length + lines.length);
+  let offset = 0;
+  let point = 0;
+  for (const line of lines) {
+    const length = line.length / 3;
+    cells[offset++] = length;
+    for (let i = 0; i < length; i++) cells[offset++] = point++;
+  }
+  writer.text(`LINES ${lines.length} ${cells.length}\n`);
+  writer.int32(cells);
+  return writer.finish();
+}
+
+export function meshToLegacyVtk(mesh: ExportMesh): Uint8Array<ArrayBuffer> {
+  const writer = new LegacyWriter();
+  const triangles = mesh.indices.length / 3;
+  writer.header('POLYDATA');
+  writer.text(`POINTS ${mesh.positions.length / 3} float\n`);
+  writer.float32(mesh.positions);
+  const cells = new Int32Array(triangles * 4);
+  for (let t = 0; t < triangles; t++) {
+    cells[t * 4] = 3;
+    cells[t * 4 + 1] = mesh.indices[t * 3];
+    cells[t * 4 + 2] = mesh.indices[t * 3 + 1];
+    cells[t * 4 + 3] = mesh.indices[t * 3 + 2];
+  }
+  writer.text(`POLYGONS ${triangles} ${cells.length}\n`);
+  writer.int32(cells);
+  writer.text(`POINT_DATA ${mesh.scalars.length}\nSCALARS ${mesh.scalarName} float 1\nLOOKUP_TABLE default\n`);
+  writer.float32(mesh.scalars);
+  return writer.finish();
+}
+
+// --- XML --------------------------------------------------------------------
+
+/**
+ * Blocks for an <AppendedData encoding="raw"> section, each prefixed with
+ * its byte length as a little-endian UInt64
+ */
+class AppendedBlocks {
+  private blocks: Uint8Array[] = [];
+  private length = 0;
+
+  add(array: Float32Array | Int32Array): number {
+    const offset = this.length;
+    const header = new Uint8Array(8);
+    new DataView(header.buffer).setUint32(0, array.byteLength, true);
+    this.blocks.push(header, new Uint8Array(array.buffer, array.byteOffset, array.byteLength));
+    this.length += 8 + array.byteLength;
+    return offset;
+  }
+
+  wrap(type: string, body: string): Uint8Array<ArrayBuffer> {
+    const encoder = new TextEncoder();
+    const head =
+      `<?xml version="1.0"?>\n<VTKFile type="${type}" version="1.0" byte_order="LittleEndian" header_type="UInt64">\n` +
+      `${body}  <AppendedData encoding="raw">\n   _`;
+    return concatBytes([encoder.encode(head), ...this.blocks, encoder.encode('\n  </AppendedData>\n</VTKFile>\n')]);
+  }
+}
+
+const dataArray = (type: string, name: string, components: number, offset: number) =>
+  `<DataArray type="${type}" Name="${name}" NumberOfComponents="${components}" format="appended" offset="${offset}"/>`;
+
+export function gridToVti(grid: ExportGrid): Uint8Array<ArrayBuffer> {
+  const blocks = new AppendedBlocks();
+  const extent = grid.dimensions.map((n) => `0 ${n - 1}`).join(' ');
+  const fieldOffset = blocks.add(grid.field);
+  const potential = grid.potential ? `        ${dataArray('Float32', 'V', 1, blocks.add(grid.potential))}\n` : '';
+  const scalars = grid.potential ? ' Scalars="V"' : '';
+  return blocks.wrap(
+    'ImageData',
+    `  <ImageData WholeExtent="${extent}" Origin="${grid.origin.join(' ')}" Spacing="${grid.spacing.join(' ')}">\n` +
+      `    <Piece Extent="${extent}">\n` +
+      `      <PointData Vectors="${grid.fieldName}"${scalars}>\n` +
+      `        ${dataArray('Float32', grid.fieldName, 3, fieldOffset)}\n${potential}` +
+      `      </PointData>\n    </Piece>\n  </ImageData>\n`
+  );
+}
+
+export function polylinesToVtp(lines: Float32Array[]): Uint8Array<ArrayBuffer> {
+  const { points, connectivity, offsets } = flattenPolylines(lines);
+  const blocks = new AppendedBlocks();
+  const pointOffset = blocks.add(points);
+  const connectivityOffset = blocks.add(connectivity);
+  const offsetsOffset = blocks.add(offsets);
+  return blocks.wrap(
+    'PolyData',
+    `  <PolyData>\n    <Piece NumberOfPoints="${points.length / 3}" NumberOfLines="${lines.length}">\n` +
+      `      <Points>${dataArray('Float32', 'Points', 3, pointOffset)}</Points>\n` +
+      `      <Lines>\n        ${dataArray('Int32', 'connectivity', 1, connectivityOffset)}\n` +
+      `        ${dataArray('Int32', 'offsets', 1, offsetsOffset)}\n      </Lines>\n` +
+      `    </Piece>\n  </PolyData>\n`
+  );
+}
+
+export function meshToVtp(mesh: ExportMesh): Uint8Array<ArrayBuffer> {
+  const triangles = mesh.indices.length / 3;
+  const offsets = Int32Array.from({ length: triangles }, (_, t) => (t + 1) * 3);
+  const blocks = new AppendedBlocks();
+  const scalarOffset = blocks.add(mesh.scalars);
+  const pointOffset = blocks.add(mesh.positions);
+  const connectivityOffset = blocks.add(Int32Array.from(mesh.indices));
+  const offsetsOffset = blocks.add(offsets);
+  return blocks.wrap(
+    'PolyData',
+    `  <PolyData>\n    <Piece NumberOfPoints="${mesh.positions.length / 3}" NumberOfPolys="${triangles}">\n` +
+      `      <PointData Scalars="${mesh.scalarName}">${dataArray('Float32', mesh.scalarName, 1, scalarOffset)}</PointData>\n` +
+      `      <Points>${dataArray('Float32', 'Points', 3, pointOffset)}</Points>\n` +
+      `      <Polys>\n        ${dataArray('Int32', 'connectivity', 1, connectivityOffset)}\n` +
+      `        ${dataArray('Int32', 'offsets', 1, offsetsOffset)}\n      </Polys>\n` +
+      `    </Piece>\n  </PolyData>\n`
+  );
+}
+
+// --- Raw --------------------------------------------------------------------
+
+function nrrdHeader(grid: ExportGrid, dataFile: string, components: number): string {
+  const [sx, sy, sz] = grid.spacing;
+  const vector = components > 1;
+  return (
+    'NRRD0004\n' +
+    'type: float\n' +
+    `dimension: ${vector ? 4 : 3}\n` +
+    `sizes: ${vector ? `${components} ` : ''}${grid.dimensions.join(' ')}\n` +
+    `kinds: ${vector ? 'vector ' : ''}domain domain domain\n` +
+    'space dimension: 3\n' +
+    `space directions: ${vector ? 'none ' : ''}(${sx},0,0) (0,${sy},0) (0,0,${sz})\n` +
+    `space origin: (${grid.origin.join(',')})\n` +
+    'endian: little\n' +
+    'encoding: raw\n' +
+    `data file: ${dataFile}\n`
+  );
+}
+
+function buildRawExport({ grid, lines, mesh }: VtkExportRequest): TarEntry[] {
+  const entries: TarEntry[] = [];
+  const manifest: Record<string, unknown>[] = [];
+  const encoder = new TextEncoder();
+  const add = (name: string, array: Float32Array | Int32Array | Uint32Array, dtype: string, shape: number[]) => {
+    entries.push({ name, data: new Uint8Array(array.buffer, array.byteOffset, array.byteLength) });
+    manifest.push({ file: name, dtype, shape });
+  };
+
+  if (grid) {
+    const [nx, ny, nz] = grid.dimensions;
+    add(`${grid.fieldName}.raw`, grid.field, 'float32', [nz, ny, nx, 3]);
+    entries.push({ name: `${grid.fieldName}.nhdr`, data: encoder.encode(nrrdHeader(grid, `${grid.fieldName}.raw`, 3)) });
+    if (grid.potential) {
+      add('V.raw', grid.potential, 'float32', [nz, ny, nx]);
+      entries.push({ name: 'V.nhdr', data: encoder.encode(nrrdHeader(grid, 'V.raw', 1)) });
+    }
+  }
+  if (lines.length > 0) {
+    const { points, offsets } = flattenPolylines(lines);
+    add('field-lines.points.raw', points, 'float32', [points.length / 3, 3]);
+    add('field-lines.offsets.raw', offsets, 'int32', [offsets.length]);
+  }
+  if (mesh) {
+    add('surface.points.raw', mesh.positions, 'float32', [mesh.positions.length / 3, 3]);
+    add('surface.indices.raw', mesh.indices, 'uint32', [mesh.indices.length / 3, 3]);
+    add(`surface.${mesh.scalarName}.raw`, mesh.scalars, 'float32', [mesh.scalars.length]);
+  }
+
+  const description = {
+    format: 'electric-fields-raw',
+    version: 1,
+    byteOrder: 'little',
+    grid: grid && { dimensions: grid.dimensions, origin: grid.origin, spacing: grid.spacing, order: 'x-fastest' },
+    lineOffsets: 'end index (in points) of each polyline',
+    files: manifest,
+  };
+  entries.push({ name: 'manifest.json', data: encoder.encode(JSON.stringify(description, null, 2)) });
+  return entries;
+}
+
+// --- Helpers ----------------------------------------------------------------
+
+function flattenPolylines(lines: Float32Array[]) {
+  const total = lines.reduce((sum, line) => sum + line.length, 0);
+  const points = new Float32Array(total);
+  const connectivity = Int32Array.from({ length: total / 3 }, (_, i) => i);
+  const offsets = new Int32Array(lines.length);
+  let offset = 0;
+  lines.forEach((line, i) => {
+    points.set(line, offset);
+    offset += line.length;
+    offsets[i] = offset / 3;
+  });
+  return { points, connectivity, offsets };
+}
+
+function concatBytes(parts: Uint8Array[]): Uint8Array<ArrayBuffer> {
+  const result = new Uint8Array(parts.reduce((sum, part) => sum + part.length, 0));
+  let offset = 0;
+  for (const part of parts) {
+    result.set(part, offset);
+    offset += part.length;
+  }
+  return result;
+}
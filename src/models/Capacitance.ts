@@ -0,0 +1,351 @@
+import * as THREE from 'three';
+import { PHYSICS_CONSTANTS } from './Charge';
+import type { GaussSurface } from './GaussSurface';
+
+/**
+ * Conductors are closed surfaces of the same shapes as Gauss surfaces
+ */
+export type Conductor = GaussSurface;
+
+export interface CapacitanceOptions {
+  panelSize: number; // Target panel edge length (m)
+  maxPanels: number; // The dense system needs panels² doubles; refuse larger scenes
+  relativeTolerance: number; // Residual target relative to |rhs| for each solve
+  maxIterations: number;
+}
+
+/**
+ * Flat triangular panels over all conductors, each carrying a uniform charge
+ */
+export interface ConductorPanels {
+  count: number;
+  triangles: Float64Array; // 9 per panel
+  centroids: Float64Array; // 3 per panel
+  areas: Float64Array;
+  owners: Uint32Array; // Conductor index of each panel
+}
+
+export interface CapacitanceResult {
+  conductorCount: number;
+  panelCount: number;
+  matrix: Float64Array; // Maxwell capacitance matrix (F), row-major conductorCount²
+  iterations: number[]; // PCG iterations per conductor solve
+  recycledDirections: number; // Search directions carried into the last solve
+}
+
+/**
+ * Panels for one conductor at roughly `panelSize` resolution
+ */
+export function conductorTriangles(conductor: Conductor, panelSize: number): Float64Array {
+  if (conductor.kind === 'mesh') {
+    return Float64Array.from(conductor.triangles);
+  }
+
+  let geometry: THREE.BufferGeometry;
+  if (conductor.kind === 'sphere') {
+    // An icosahedron's edge is about 1.05 r; detail d splits it d + 1 times
+    const detail = Math.min(Math.max(Math.ceil((1.05 * conductor.radius) / panelSize) - 1, 1), 8);
+    geometry = new THREE.IcosahedronGeometry(conductor.radius, detail);
+  } else {
+    const segments = (length: number) => Math.min(Math.max(Math.ceil(length / panelSize), 1), 16);
+    const { x, y, z } = conductor.size;
+    geometry = new THREE.BoxGeometry(x, y, z, segments(x), segments(y), segments(z)).toNonIndexed();
+  }
+  geometry.translate(conductor.center.x, conductor.center.y, conductor.center.z);
+  const triangles = Float64Array.from(geometry.getAttribute('position').array);
+  geometry.dispose();
+  return triangles;
+}
+
+export function buildConductorPanels(conductors: Conductor[], panelSize: number): ConductorPanels {
+  const perConductor = conductors.map((conductor) => conductorTriangles(conductor, panelSize));
+  const count = perConductor.reduce((sum, triangles) => sum + triangles.length / 9, 0);
+  const panels: ConductorPanels = {
+    count,
+    triangles: new Float64Array(count * 9),
+    centroids: new Float64Array(count * 3),
+    areas: new Float64Array(count),
+    owners: new Uint32Array(count),
+  };
+
+  let panel = 0;
+  perConductor.forEach((triangles, owner) => {
+    panels.triangles.set(triangles, panel * 9);
+    for (let t = 0; t < triangles.length; t += 9, panel++) {
+      const ux = triangles[t + 3] - triangles[t];
+      const uy = triangles[t + 4] - triangles[t + 1];
+      const uz = triangles[t + 5] - triangles[t + 2];
+      const vx = triangles[t + 6] - triangles[t];
+      const vy = triangles[t + 7] - triangles[t + 1];
+      const vz = triangles[t + 8] - triangles[t + 2];
+      panels.areas[panel] =
+        0.5 * Math.hypot(uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx);
+      for (let axis = 0; axis < 3; axis++) {
+        panels.centroids[panel * 3 + axis] =
+          (triangles[t + axis] + triangles[t + 3 + axis] + triangles[t + 6 + axis]) / 3;
+      }
+      panels.owners[panel] = owner;
+    }
+  });
+  return panels;
+}
+
+/**
+ * ∫ dA / r over a flat triangle seen from its own centroid, summed edge by
+ * edge: each edge at perpendicular distance h contributes h (asinh(s_b/h) - asinh(s_a/h))
+ */
+function selfPotentialIntegral(triangles: Float64Array, t: number, centroid: number[]): number {
+  let total = 0;
+  for (let edge = 0; edge < 3; edge++) {
+    const a = t + edge * 3;
+    const b = t + ((edge + 1) % 3) * 3;
+    const ex = triangles[b] - triangles[a];
+    const ey = triangles[b + 1] - triangles[a + 1];
+    const ez = triangles[b + 2] - triangles[a + 2];
+    const length = Math.hypot(ex, ey, ez);
+    const ux = ex / length;
+    const uy = ey / length;
+    const uz = ez / length;
+    const sa = (triangles[a] - centroid[0]) * ux + (triangles[a + 1] - centroid[1]) * uy + (triangles[a + 2] - centroid[2]) * uz;
+    const h = Math.hypot(
+      triangles[a] - sa * ux - centroid[0],
+      triangles[a + 1] - sa * uy - centroid[1],
+      triangles[a + 2] - sa * uz - centroid[2]
+    );
+    total += h * (Math.asinh((sa + length) / h) - Math.asinh(sa / h));
+  }
+  return total;
+}
+
+/**
+ * Centroids of the four midpoint sub-triangles, for near-field quadrature
+ */
+function subCentroids(triangles: Float64Array, t: number): number[] {
+  const points: number[] = [];
+  const vertex = (i: number, axis: number) => triangles[t + i * 3 + axis];
+  for (let axis = 0; axis < 3; axis++) {
+    const a = vertex(0, axis);
+    const b = vertex(1, axis);
+    const c = vertex(2, axis);
+    points.push((4 * a + b + c) / 6, (a + 4 * b + c) / 6, (a + b + 4 * c) / 6, (a + b + c) / 3);
+  }
+  // Reorder from axis-major to point-major xyz
+  return [0, 1, 2, 3].flatMap((p) => [points[p], points[4 + p], points[8 + p]]);
+}
+
+/**
+ * Potential at panel i's centroid per coulomb on panel j (dense, symmetric).
+ * Unknowns are panel charges rather than densities, which keeps the matrix
+ * symmetric positive definite: exact self terms on the diagonal, a 4×4
+ * sub-triangle rule between neighbouring panels and 1/r beyond that.
+ */
+export function buildPanelMatrix(panels: ConductorPanels): Float64Array {
+  const n = panels.count;
+  const { centroids, areas, triangles } = panels;
+  const K = PHYSICS_CONSTANTS.K;
+  const matrix = new Float64Array(n * n);
+  const sizes = Array.from(areas, (area) => Math.sqrt(area));
+  const subPoints: (number[] | null)[] = new Array(n).fill(null);
+  const subPointsOf = (i: number): number[] => {
+    if (!subPoints[i]) subPoints[i] = subCentroids(triangles, i * 9);
+    return subPoints[i]!;
+  };
+
+  for (let i = 0; i < n; i++) {
+    const centroid = [centroids[i * 3], centroids[i * 3 + 1], centroids[i * 3 + 2]];
+    matrix[i * n + i] = (K * selfPotentialIntegral(triangles, i * 9, centroid)) / areas[i];
+
+    for (let j = i + 1; j < n; j++) {
+      const distance = Math.hypot(
+        centroids[j * 3] - centroid[0],
+        centroids[j * 3 + 1] - centroid[1],
+        centroids[j * 3 + 2] - centroid[2]
+      );
+      let inverseDistance = 1 / distance;
+      if (distance < 3 * Math.max(sizes[i], sizes[j])) {
+        const pi = subPointsOf(i);
+        const pj = subPointsOf(j);
+        inverseDistance = 0;
+        for (let a = 0; a < 12; a += 3) {
+          for (let b = 0; b < 12; b += 3) {
+            inverseDistance += 1 / Math.hypot(pi[a] - pj[b], pi[a + 1] - pj[b + 1], pi[a + 2] - pj[b + 2]);
+          }
+        }
+        inverseDistance /= 16;
+      }
+      matrix[i * n + j] = matrix[j * n + i] = K * inverseDistance;
+    }
+  }
+  return matrix;
+}
+
+/**
+ * Jacobi-preconditioned conjugate gradients on one SPD matrix for a sequence
+ * of right-hand sides. Search directions are kept as an A-orthonormal basis
+ * (with their images under A), so each new solve starts from the Galerkin
+ * projection onto everything explored so far and keeps its new directions
+ * A-conjugate to that basis (deflated CG). Later conductors therefore
+ * converge in far fewer iterations.
+ */
+export class RecycledPcgSolver {
+  private matrix: Float64Array;
+  private n: number;
+  private maxRecycled: number;
+  private inverseDiagonal: Float64Array;
+  private basis: Float64Array[] = []; // wᵀ A w = 1, mutually A-conjugate
+  private images: Float64Array[] = []; // A w for each basis vector
+
+  constructor(matrix: Float64Array, n: number, maxRecycled: number = 256) {
+    this.matrix = matrix;
+    this.n = n;
+    this.maxRecycled = maxRecycled;
+    this.inverseDiagonal = new Float64Array(n);
+    for (let i = 0; i < n; i++) this.inverseDiagonal[i] = 1 / matrix[i * n + i];
+  }
+
+  public get recycledCount(): number {
+    return this.basis.length;
+  }
+
+  private multiply(x: Float64Array, out: Float64Array) {
+    const { matrix, n } = this;
+    for (let i = 0; i < n; i++) {
+      let sum = 0;
+      const row = i * n;
+      for (let j = 0; j < n; j++) sum += matrix[row + j] * x[j];
+      out[i] = sum;
+    }
+  }
+
+  /**
+   * Remove the A-components of `v` along the recycled basis (and the same
+   * combination from its image, when given)
+   */
+  private deflate(v: Float64Array, image: Float64Array | null = null) {
+    for (let k = 0; k < this.basis.length; k++) {
+      const coefficient = dot(this.images[k], v);
+      axpy(-coefficient, this.basis[k], v);
+      if (image) axpy(-coefficient, this.images[k], image);
+    }
+  }
+
+  /**
+   * Add a direction to the basis after A-orthonormalising it (twice, for
+   * stability); directions that are nearly dependent on the basis are dropped,
+   * since dividing by their tiny A-norm would only amplify rounding error
+   */
+  private recycle(direction: Float64Array, image: Float64Array, curvature: number) {
+    if (this.basis.length >= this.maxRecycled) return;
+    this.deflate(direction, image);
+    this.deflate(direction, image);
+    const norm2 = dot(direction, image);
+    if (!(norm2 > 1e-12 * curvature)) return;
+    const scale = 1 / Math.sqrt(norm2);
+    for (let i = 0; i < this.n; i++) {
+      direction[i] *= scale;
+      image[i] *= scale;
+    }
+    this.basis.push(direction);
+    this.images.push(image);
+  }
+
+  public solve(rhs: Float64Array, relativeTolerance: number, maxIterations: number): { solution: Float64Array; iterations: number } {
+    const n = this.n;
+    const x = new Float64Array(n);
+    const r = Float64Array.from(rhs);
+
+    // Start from the projection onto the recycled subspace
+    for (let k = 0; k < this.basis.length; k++) {
+      const coefficient = dot(this.basis[k], rhs);
+      axpy(coefficient, this.basis[k], x);
+      axpy(-coefficient, this.images[k], r);
+    }
+
+    const target = relativeTolerance * Math.sqrt(dot(rhs, rhs));
+    const z = new Float64Array(n);
+    const p = new Float64Array(n);
+    const ap = new Float64Array(n);
+    const precondition = () => {
+      for (let i = 0; i < n; i++) z[i] = r[i] * this.inverseDiagonal[i];
+      this.deflate(z);
+    };
+
+    precondition();
+    p.set(z);
+    let rz = dot(r, z);
+    const fresh: { direction: Float64Array; image: Float64Array; curvature: number }[] = [];
+
+    let iterations = 0;
+    while (Math.sqrt(dot(r, r)) > target && iterations < maxIterations) {
+      this.multiply(p, ap);
+      const curvature = dot(p, ap);
+      if (!(curvature > 0)) break;
+      const alpha = rz / curvature;
+      axpy(alpha, p, x);
+      axpy(-alpha, ap, r);
+      fresh.push({ direction: Float64Array.from(p), image: Float64Array.from(ap), curvature });
+      iterations++;
+
+      precondition();
+      const rzNext = dot(r, z);
+      const beta = rzNext / rz;
+      rz = rzNext;
+      for (let i = 0; i < n; i++) p[i] = z[i] + beta * p[i];
+    }
+
+    for (const entry of fresh) this.recycle(entry.direction, entry.image, entry.curvature);
+    return { solution: x, iterations };
+  }
+}
+
+function dot(a: Float64Array, b: Float64Array): number {
+  let sum = 0;
+  for (let i = 0; i < a.length; i++) sum += a[i] * b[i];
+  return sum;
+}
+
+function axpy(alpha: number, x: Float64Array, y: Float64Array) {
+  for (let i = 0; i < x.length; i++) y[i] += alpha * x[i];
+}
+
+/**
+ * Maxwell capacitance matrix: column j holds the charge on every conductor
+ * with conductor j at 1 V and the rest grounded. The panel matrix and its
+ * preconditioner are built once and shared by all solves.
+ */
+export function computeCapacitanceMatrix(
+  conductors: Conductor[],
+  options: CapacitanceOptions = createDefaultCapacitanceOptions()
+): CapacitanceResult {
+  const panels = buildConductorPanels(conductors, options.panelSize);
+  if (panels.count > options.maxPanels) {
+    throw new Error(`${panels.count} panels exceeds the limit of ${options.maxPanels}; use a larger panel size`);
+  }
+
+  const m = conductors.length;
+  const n = panels.count;
+  const solver = new RecycledPcgSolver(buildPanelMatrix(panels), n);
+  const matrix = new Float64Array(m * m);
+  const iterations: number[] = [];
+  let recycledDirections = 0;
+
+  for (let j = 0; j < m; j++) {
+    const rhs = new Float64Array(n);
+    for (let i = 0; i < n; i++) rhs[i] = panels.owners[i] === j ? 1 : 0;
+    recycledDirections = solver.recycledCount;
+    const { solution, iterations: count } = solver.solve(rhs, options.relativeTolerance, options.maxIterations);
+    iterations.push(count);
+    for (let i = 0; i < n; i++) matrix[panels.owners[i] * m + j] += solution[i];
+  }
+
+  return { conductorCount: m, panelCount: n, matrix, iterations, recycledDirections };
+}
+
+export function createDefaultCapacitanceOptions(): CapacitanceOptions {
+  return {
+    panelSize: 0.25,
+    maxPanels: 3000,
+    relativeTolerance: 1e-8,
+    maxIterations: 500,
+  };
+}
@@ -15,6 +15,7 @@ export interface ElectricFieldResult {
 export const PHYSICS_CONSTANTS = {
   K: 8.9875517923e9, // Coulomb's constant (N⋅m²/C²)
   EPSILON_0: 8.854187817e-12, // Vacuum permittivity (F/m)
+  MU_0: 1.25663706212e-6, // Vacuum permeability (N/A²)
   SOFTENING_FACTOR: 0.1, // Small distance to avoid singularities
 } as const;
 
@@ -0,0 +1,278 @@
+import type { Charge } from './Charge';
+import { PHYSICS_CONSTANTS } from './Charge';
+import { buildChargeTree, chargeTreeFieldBatch } from './ChargeTree';
+import { packCharges } from './FieldKernel';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+
+export interface ChargeInteractionOptions {
+  treeThreshold: number; // Charge count at which forces switch from the direct sum to the tree
+  theta: number; // Barnes–Hut opening angle: cells with size / distance < theta are not opened
+  leafSize: number; // Maximum charges per tree leaf
+  maxIncrementalChanges: number; // More changed charges than this recompute everything from scratch
+  resyncInterval: number; // Incremental updates between full recomputes, bounding round-off drift
+}
+
+export interface ChargeInteractionResult {
+  ids: string[];
+  forces: Float64Array; // N, xyz interleaved, same order as ids
+  energy: number; // Total electrostatic energy of the configuration (J)
+  method: 'direct' | 'tree'; // How the last full recompute was done
+  update: 'incremental' | 'full';
+}
+
+/**
+ * Net force on every charge and the total energy by the O(N²) pair sum, with
+ * the field kernel's softening so F_i = q_i E_others(x_i)
+ */
+export function directInteractions(packed: PackedCharges, outForces: Float64Array): number {
+  const { count, positions, magnitudes } = packed;
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+  outForces.fill(0);
+  let energy = 0;
+
+  for (let i = 0; i < count; i++) {
+    for (let j = i + 1; j < count; j++) {
+      const rx = positions[i * 3] - positions[j * 3];
+      const ry = positions[i * 3 + 1] - positions[j * 3 + 1];
+      const rz = positions[i * 3 + 2] - positions[j * 3 + 2];
+      const distance = Math.sqrt(rx * rx + ry * ry + rz * rz);
+      const effectiveDistance = distance > softening ? distance : softening;
+      const kqq = K * magnitudes[i] * magnitudes[j];
+      energy += kqq / effectiveDistance;
+      if (distance === 0) continue;
+
+      // Newton's third law: j feels the opposite force
+      const scale = kqq / (effectiveDistance * effectiveDistance * distance);
+      outForces[i * 3] += rx * scale;
+      outForces[i * 3 + 1] += ry * scale;
+      outForces[i * 3 + 2] += rz * scale;
+      outForces[j * 3] -= rx * scale;
+      outForces[j * 3 + 1] -= ry * scale;
+      outForces[j * 3 + 2] -= rz * scale;
+    }
+  }
+  return energy;
+}
+
+/**
+ * Barnes–Hut forces and energy: the field of a ChargeTree over the charges,
+ * evaluated at the charges themselves. Costs O(N log N) for reasonably
+ * spread charges.
+ */
+export function treeInteractions(packed: PackedCharges, outForces: Float64Array, theta: number, leafSize: number): number {
+  const { count, positions, magnitudes } = packed;
+  const field = new Float64Array(count * 3);
+  const potential = new Float64Array(count);
+  chargeTreeFieldBatch(buildChargeTree(packed, { theta, leafSize }), positions, field, potential);
+
+  // Each charge meets itself in its own leaf at distance 0, which adds no
+  // field but K q / softening of potential
+  const selfPotential = PHYSICS_CONSTANTS.K / PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+  let doubledEnergy = 0; // Σ q_i V_others(x_i) counts each pair twice
+  for (let i = 0; i < count; i++) {
+    const q = magnitudes[i];
+    outForces[i * 3] = q * field[i * 3];
+    outForces[i * 3 + 1] = q * field[i * 3 + 1];
+    outForces[i * 3 + 2] = q * field[i * 3 + 2];
+    doubledEnergy += q * (potential[i] - selfPotential * q);
+  }
+  return 0.5 * doubledEnergy;
+}
+
+/**
+ * Net force and torque on a group of charges (indices into `packed`) about
+ * `pivot`. Forces between group members cancel in both, so the totals are
+ * the push and twist from everything outside the group.
+ */
+export function groupForceAndTorque(
+  packed: PackedCharges,
+  forces: Float64Array,
+  indices: number[],
+  pivot: Vec3Like
+): { force: Vec3Like; torque: Vec3Like } {
+  const force = { x: 0, y: 0, z: 0 };
+  const torque = { x: 0, y: 0, z: 0 };
+  for (const i of indices) {
+    const fx = forces[i * 3];
+    const fy = forces[i * 3 + 1];
+    const fz = forces[i * 3 + 2];
+    const rx = packed.positions[i * 3] - pivot.x;
+    const ry = packed.positions[i * 3 + 1] - pivot.y;
+    const rz = packed.positions[i * 3 + 2] - pivot.z;
+    force.x += fx;
+    force.y += fy;
+    force.z += fz;
+    torque.x += ry * fz - rz * fy;
+    torque.y += rz * fx - rx * fz;
+    torque.z += rx * fy - ry * fx;
+  }
+  return { force, torque };
+}
+
+interface TrackedCharge {
+  x: number;
+  y: number;
+  z: number;
+  q: number;
+  force: [number, number, number];
+}
+
+/**
+ * Forces and configuration energy for the live charges, kept incrementally.
+ * A full recompute (direct sum below `treeThreshold`, Barnes–Hut above) runs
+ * on the first update, when many charges changed at once, and every
+ * `resyncInterval` incremental updates. Otherwise each added, moved,
+ * re-valued or removed charge is taken out and put back: its pair terms with
+ * the rest give ΔU and the change in every other charge's force, O(N) per
+ * changed charge, and no full pass runs at all.
+ */
+export class ChargeInteractions {
+  private options: ChargeInteractionOptions;
+  private state = new Map<string, TrackedCharge>();
+  private energy = 0;
+  private method: 'direct' | 'tree' = 'direct';
+  private incrementalUpdates = 0;
+
+  constructor(options: ChargeInteractionOptions = createDefaultChargeInteractionOptions()) {
+    this.options = options;
+  }
+
+  public update(charges: Charge[]): ChargeInteractionResult {
+    const changed = this.changedCharges(charges);
+    let update: 'incremental' | 'full' = 'incremental';
+    if (
+      this.state.size === 0 ||
+      changed.length > this.options.maxIncrementalChanges ||
+      (changed.length > 0 && this.incrementalUpdates >= this.options.resyncInterval)
+    ) {
+      this.recompute(charges);
+      update = 'full';
+    } else if (changed.length > 0) {
+      const next = new Map(charges.map((charge) => [charge.id, charge]));
+      for (const id of changed) {
+        this.remove(id);
+        const charge = next.get(id);
+        if (charge) this.insert(id, charge);
+      }
+      this.incrementalUpdates++;
+    }
+
+    const forces = new Float64Array(charges.length * 3);
+    charges.forEach((charge, i) => forces.set(this.state.get(charge.id)!.force, i * 3));
+    return { ids: charges.map((charge) => charge.id), forces, energy: this.energy, method: this.method, update };
+  }
+
+  /**
+   * Ids added, moved, re-valued or removed since the last update
+   */
+  private changedCharges(charges: Charge[]): string[] {
+    const changed: string[] = [];
+    const present = new Set<string>();
+    for (const charge of charges) {
+      present.add(charge.id);
+      const previous = this.state.get(charge.id);
+      if (
+        !previous ||
+        previous.x !== charge.position.x ||
+        previous.y !== charge.position.y ||
+        previous.z !== charge.position.z ||
+        previous.q !== charge.magnitude
+      ) {
+        changed.push(charge.id);
+      }
+    }
+    for (const id of this.state.keys()) {
+      if (!present.has(id)) changed.push(id);
+    }
+    return changed;
+  }
+
+  private recompute(charges: Charge[]) {
+    const packed = packCharges(charges);
+    const forces = new Float64Array(packed.count * 3);
+    this.method = packed.count >= this.options.treeThreshold ? 'tree' : 'direct';
+    this.energy =
+      this.method === 'tree'
+        ? treeInteractions(packed, forces, this.options.theta, this.options.leafSize)
+        : directInteractions(packed, forces);
+    this.state = new Map(
+      charges.map((charge, i) => [
+        charge.id,
+        {
+          x: charge.position.x,
+          y: charge.position.y,
+          z: charge.position.z,
+          q: charge.magnitude,
+          force: [forces[i * 3], forces[i * 3 + 1], forces[i * 3 + 2]],
+        },
+      ])
+    );
+    this.incrementalUpdates = 0;
+  }
+
+  /**
+   * Take a charge out: its pair terms leave U and every other charge's force
+   */
+  private remove(id: string) {
+    const charge = this.state.get(id);
+    if (!charge) return;
+    this.state.delete(id);
+    this.energy -= this.applyPairs(charge, -1);
+  }
+
+  private insert(id: string, source: Charge) {
+    const charge: TrackedCharge = {
+      x: source.position.x,
+      y: source.position.y,
+      z: source.position.z,
+      q: source.magnitude,
+      force: [0, 0, 0],
+    };
+    this.energy += this.applyPairs(charge, 1);
+    this.state.set(id, charge);
+  }
+
+  /**
+   * Add `sign` × the force `charge` exerts to every tracked charge, set
+   * `charge`'s own force from them, and return the pair energy. Same softened
+   * pair terms as directInteractions.
+   */
+  private applyPairs(charge: TrackedCharge, sign: number): number {
+    const K = PHYSICS_CONSTANTS.K;
+    const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+    let energy = 0;
+    let fx = 0;
+    let fy = 0;
+    let fz = 0;
+    for (const other of this.state.values()) {
+      const rx = other.x - charge.x;
+      const ry = other.y - charge.y;
+      const rz = other.z - charge.z;
+      const distance = Math.sqrt(rx * rx + ry * ry + rz * rz);
+      const effectiveDistance = distance > softening ? distance : softening;
+      const kqq = K * charge.q * other.q;
+      energy += kqq / effectiveDistance;
+      if (distance === 0) continue;
+      const scale = kqq / (effectiveDistance * effectiveDistance * distance);
+      other.force[0] += sign * rx * scale;
+      other.force[1] += sign * ry * scale;
+      other.force[2] += sign * rz * scale;
+      fx -= rx * scale;
+      fy -= ry * scale;
+      fz -= rz * scale;
+    }
+    charge.force = [fx, fy, fz];
+    return energy;
+  }
+}
+
+export function createDefaultChargeInteractionOptions(): ChargeInteractionOptions {
+  return {
+    treeThreshold: 512,
+    theta: 0.5,
+    leafSize: 8,
+    maxIncrementalChanges: 4,
+    resyncInterval: 256,
+  };
+}
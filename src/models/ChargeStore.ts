@@ -0,0 +1,130 @@
+import * as THREE from 'three';
+import type { Charge } from './Charge';
+import { ChargeTreeBuilder } from './ChargeTree';
+import type { ChargeTree } from './ChargeTree';
+import type { PackedCharges } from './FieldKernel';
+
+/**
+ * Growable packed buffers for imported charge datasets, which can run to
+ * millions of charges and so never become Charge objects or meshes unless
+ * they are small. Capacity doubles as batches are appended. `version` is
+ * bumped by every change and `epoch` only when the contents are replaced
+ * rather than extended, so views can upload just the appended tail. An
+ * octree is grown alongside, one subtree per appended batch, so the field of
+ * the whole dataset can be evaluated without a pass over every charge.
+ */
+export class ChargeStore {
+  private positions = new Float64Array(0);
+  private magnitudes = new Float64Array(0);
+  private ids: string[] | null = null;
+  private view: PackedCharges | null = null;
+  private treeBuilder = new ChargeTreeBuilder();
+  private treeView: ChargeTree | null = null;
+  public count = 0;
+  public version = 0;
+  public epoch = 0;
+
+  public reserve(capacity: number) {
+    if (capacity <= this.magnitudes.length) return;
+    const size = Math.max(capacity, this.magnitudes.length * 2, 1024);
+    const positions = new Float64Array(size * 3);
+    const magnitudes = new Float64Array(size);
+    positions.set(this.positions.subarray(0, this.count * 3));
+    magnitudes.set(this.magnitudes.subarray(0, this.count));
+    this.positions = positions;
+    this.magnitudes = magnitudes;
+  }
+
+  /**
+   * Copy a batch onto the end of the store. Ids are kept only while every
+   * batch has them.
+   */
+  public append(positions: ArrayLike<number>, magnitudes: ArrayLike<number>, ids: string[] | null = null) {
+    const added = magnitudes.length;
+    this.reserve(this.count + added);
+    this.positions.set(positions, this.count * 3);
+    this.magnitudes.set(magnitudes, this.count);
+    if (ids && (this.count === 0 || this.ids)) {
+      if (this.count === 0) this.ids = [];
+      for (const id of ids) this.ids!.push(id);
+    } else {
+      this.ids = null;
+    }
+    this.count += added;
+    this.version++;
+    this.view = null;
+    this.treeView = null;
+    this.treeBuilder.append(this.packed(), this.count - added);
+  }
+
+  /**
+   * Take ownership of whole decoded arrays without copying
+   */
+  public adopt(positions: Float64Array, magnitudes: Float64Array, ids: string[] | null = null) {
+    this.positions = positions;
+    this.magnitudes = magnitudes;
+    this.ids = ids;
+    this.count = magnitudes.length;
+    this.version++;
+    this.epoch++;
+    this.view = null;
+    this.treeView = null;
+    this.treeBuilder.clear();
+    this.treeBuilder.append(this.packed(), 0);
+  }
+
+  public clear() {
+    this.positions = new Float64Array(0);
+    this.magnitudes = new Float64Array(0);
+    this.ids = null;
+    this.count = 0;
+    this.version++;
+    this.epoch++;
+    this.view = null;
+    this.treeView = null;
+    this.treeBuilder.clear();
+  }
+
+  /**
+   * Views of the filled part of the buffers, ready for the batch kernel. The
+   * same object is returned until the store changes, so views can tell a new
+   * dataset by identity.
+   */
+  public packed(): PackedCharges {
+    this.view ??= {
+      count: this.count,
+      positions: this.positions.subarray(0, this.count * 3),
+      magnitudes: this.magnitudes.subarray(0, this.count),
+    };
+    return this.view;
+  }
+
+  /**
+   * The dataset's octree, for field evaluation; like packed(), the same object
+   * until the store changes
+   */
+  public tree(): ChargeTree {
+    this.treeView ??= this.treeBuilder.tree(this.packed());
+    return this.treeView;
+  }
+
+  public getIds(): string[] | null {
+    return this.ids;
+  }
+
+  /**
+   * Charge objects for the editable scene; only sensible for small stores
+   */
+  public toCharges(): Charge[] {
+    const charges: Charge[] = [];
+    const stamp = Date.now();
+    for (let i = 0; i < this.count; i++) {
+      charges.push({
+        position: new THREE.Vector3(this.positions[i * 3], this.positions[i * 3 + 1], this.positions[i * 3 + 2]),
+        magnitude: this.magnitudes[i],
+        id: this.ids?.[i] ?? `charge-${stamp}-${i}`,
+      });
+    }
+    return charges;
+  }
+}
@@ -0,0 +1,396 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import type { FloatArray, PackedCharges } from './FieldKernel';
+
+// Per cell: centre x, y, z, half the cube's side, total charge, dipole x, y, z
+const CELL_STRIDE = 8;
+// Per cell: first child, child count, first entry in `order`, entry count
+const LINK_STRIDE = 4;
+
+/**
+ * Octree over packed charges, flattened into typed arrays so it can be posted
+ * to workers. Every cell carries its total charge and its dipole moment
+ * Σ q (x - centre); monopole + dipole keeps far-field errors small even when
+ * a cell holds charges of both signs. A cell's children are stored next to
+ * each other, and each cell covers a contiguous run of `order`. There is one
+ * root per appended batch.
+ */
+export interface ChargeTree {
+  charges: PackedCharges; // Indexed by `order`
+  theta: number; // Opening angle: cells with size / distance < theta are not opened
+  nodeCount: number;
+  cells: Float64Array;
+  links: Int32Array;
+  order: Uint32Array; // Charge indices, grouped by cell
+  roots: Int32Array;
+}
+
+export interface ChargeTreeOptions {
+  theta: number;
+  leafSize: number; // Maximum charges per leaf
+}
+
+export function createDefaultChargeTreeOptions(): ChargeTreeOptions {
+  return {
+    theta: 0.5,
+    leafSize: 16,
+  };
+}
+
+/**
+ * Growable ChargeTree for charge sets that arrive in batches. Each append
+ * builds a subtree over just the new charges and adds it as another root, so
+ * earlier batches are never revisited. Trees handed out stay valid: appends
+ * only write past them, and growing or clearing allocates new arrays.
+ */
+export class ChargeTreeBuilder {
+  private options: ChargeTreeOptions;
+  private cells = new Float64Array(0);
+  private links = new Int32Array(0);
+  private order = new Uint32Array(0);
+  private scratch = new Uint32Array(0);
+  private roots: number[] = [];
+  private nodeCount = 0;
+  private orderCount = 0;
+
+  constructor(options: ChargeTreeOptions = createDefaultChargeTreeOptions()) {
+    this.options = options;
+  }
+
+  public clear() {
+    this.cells = new Float64Array(0);
+    this.links = new Int32Array(0);
+    this.order = new Uint32Array(0);
+    this.roots = [];
+    this.nodeCount = 0;
+    this.orderCount = 0;
+  }
+
+  /**
+   * Add charges [start, packed.count) of `packed` as a new root
+   */
+  public append(packed: PackedCharges, start: number) {
+    const count = packed.count - start;
+    if (count <= 0) return;
+    const { positions } = packed;
+
+    if (this.orderCount + count > this.order.length) {
+      const order = new Uint32Array(Math.max(this.orderCount + count, this.order.length * 2));
+      order.set(this.order.subarray(0, this.orderCount));
+      this.order = order;
+    }
+    if (count > this.scratch.length) this.scratch = new Uint32Array(count);
+
+    const min = [Infinity, Infinity, Infinity];
+    const max = [-Infinity, -Infinity, -Infinity];
+    for (let i = start; i < packed.count; i++) {
+      this.order[this.orderCount + i - start] = i;
+      for (let a = 0; a < 3; a++) {
+        min[a] = Math.min(min[a], positions[i * 3 + a]);
+        max[a] = Math.max(max[a], positions[i * 3 + a]);
+      }
+    }
+    const half = 0.5 * Math.max(max[0] - min[0], max[1] - min[1], max[2] - min[2]) * 1.0001 + 1e-9;
+
+    const root = this.allocate(1);
+    this.buildNode(
+      packed,
+      root,
+      this.orderCount,
+      count,
+      0.5 * (min[0] + max[0]),
+      0.5 * (min[1] + max[1]),
+      0.5 * (min[2] + max[2]),
+      half
+    );
+    this.orderCount += count;
+    this.roots.push(root);
+  }
+
+  /**
+   * The tree so far, over `packed` (the same charges, possibly reallocated)
+   */
+  public tree(packed: PackedCharges): ChargeTree {
+    return {
+      charges: packed,
+      theta: this.options.theta,
+      nodeCount: this.nodeCount,
+      cells: this.cells.subarray(0, this.nodeCount * CELL_STRIDE),
+      links: this.links.subarray(0, this.nodeCount * LINK_STRIDE),
+      order: this.order.subarray(0, this.orderCount),
+      roots: Int32Array.from(this.roots),
+    };
+  }
+
+  /**
+   * Reserve `count` consecutive cells; returns the first
+   */
+  private allocate(count: number): number {
+    const first = this.nodeCount;
+    this.nodeCount += count;
+    if (this.nodeCount * LINK_STRIDE > this.links.length) {
+      const capacity = Math.max(this.nodeCount, (this.links.length / LINK_STRIDE) * 2, 64);
+      const cells = new Float64Array(capacity * CELL_STRIDE);
+      const links = new Int32Array(capacity * LINK_STRIDE);
+      cells.set(this.cells.subarray(0, first * CELL_STRIDE));
+      links.set(this.links.subarray(0, first * LINK_STRIDE));
+      this.cells = cells;
+      this.links = links;
+    }
+    return first;
+  }
+
+  private buildNode(
+    packed: PackedCharges,
+    node: number,
+    first: number,
+    count: number,
+    cx: number,
+    cy: number,
+    cz: number,
+    half: number
+  ) {
+    const { positions, magnitudes } = packed;
+    const end = first + count;
+    let charge = 0;
+    let dx = 0;
+    let dy = 0;
+    let dz = 0;
+    for (let e = first; e < end; e++) {
+      const i = this.order[e];
+      const q = magnitudes[i];
+      charge += q;
+      dx += q * (positions[i * 3] - cx);
+      dy += q * (positions[i * 3 + 1] - cy);
+      dz += q * (positions[i * 3 + 2] - cz);
+    }
+    this.cells.set([cx, cy, cz, half, charge, dx, dy, dz], node * CELL_STRIDE);
+    this.links.set([0, 0, first, count], node * LINK_STRIDE);
+
+    // Coincident charges cannot be split; keep them in one leaf
+    if (count <= this.options.leafSize || half < 1e-9) return;
+
+    // Counting sort of the run by octant, through the scratch buffer
+    const octantOf = (i: number) =>
+      (positions[i * 3] >= cx ? 1 : 0) | (positions[i * 3 + 1] >= cy ? 2 : 0) | (positions[i * 3 + 2] >= cz ? 4 : 0);
+    const counts = [0, 0, 0, 0, 0, 0, 0, 0];
+    for (let e = first; e < end; e++) counts[octantOf(this.order[e])]++;
+    const offsets = [0, 0, 0, 0, 0, 0, 0, 0];
+    for (let o = 1; o < 8; o++) offsets[o] = offsets[o - 1] + counts[o - 1];
+    for (let e = first; e < end; e++) {
+      const i = this.order[e];
+      this.scratch[offsets[octantOf(i)]++] = i;
+    }
+    this.order.set(this.scratch.subarray(0, count), first);
+
+    const occupied = counts.filter((members) => members > 0).length;
+    const firstChild = this.allocate(occupied);
+    this.links[node * LINK_STRIDE] = firstChild;
+    this.links[node * LINK_STRIDE + 1] = occupied;
+
+    const quarter = half / 2;
+    let child = firstChild;
+    let offset = first;
+    for (let octant = 0; octant < 8; octant++) {
+      if (counts[octant] === 0) continue;
+      this.buildNode(
+        packed,
+        child++,
+        offset,
+        counts[octant],
+        cx + (octant & 1 ? quarter : -quarter),
+        cy + (octant & 2 ? quarter : -quarter),
+        cz + (octant & 4 ? quarter : -quarter),
+        quarter
+      );
+      offset += counts[octant];
+    }
+  }
+}
+
+/**
+ * Tree over all of `packed` as a single root
+ */
+export function buildChargeTree(
+  packed: PackedCharges,
+  options: ChargeTreeOptions = createDefaultChargeTreeOptions()
+): ChargeTree {
+  const builder = new ChargeTreeBuilder(options);
+  builder.append(packed, 0);
+  return builder.tree(packed);
+}
+
+/**
+ * Index into `tree.charges` of the charge nearest (x, y, z) within `radius`,
+ * or -1. Only cells whose cube comes within `radius` are opened.
+ */
+export function chargeTreeNearest(tree: ChargeTree, x: number, y: number, z: number, radius: number): number {
+  const { cells, links, order, roots } = tree;
+  const { positions } = tree.charges;
+  const stack = Array.from(roots);
+  let nearest = -1;
+  let nearest2 = radius * radius;
+
+  while (stack.length > 0) {
+    const node = stack.pop()!;
+    const c = node * CELL_STRIDE;
+    const half = cells[c + 3];
+    const gx = Math.max(Math.abs(x - cells[c]) - half, 0);
+    const gy = Math.max(Math.abs(y - cells[c + 1]) - half, 0);
+    const gz = Math.max(Math.abs(z - cells[c + 2]) - half, 0);
+    if (gx * gx + gy * gy + gz * gz >= nearest2) continue;
+
+    const l = node * LINK_STRIDE;
+    const childCount = links[l + 1];
+    if (childCount > 0) {
+      for (let k = 0; k < childCount; k++) stack.push(links[l] + k);
+      continue;
+    }
+    const end = links[l + 2] + links[l + 3];
+    for (let e = links[l + 2]; e < end; e++) {
+      const i = order[e];
+      const dx = x - positions[i * 3];
+      const dy = y - positions[i * 3 + 1];
+      const dz = z - positions[i * 3 + 2];
+      const d2 = dx * dx + dy * dy + dz * dz;
+      if (d2 < nearest2) {
+        nearest = i;
+        nearest2 = d2;
+      }
+    }
+  }
+
+  return nearest;
+}
+
+/**
+ * Add the field of a charge tree at many points, and optionally its potential
+ * and field gradient (9 entries per point, row-major). Cells that look small
+ * from a point act through their monopole + dipole; the rest are opened down
+ * to exact pair terms with the batch kernel's softening. A point inside a
+ * cell always opens it, so a charge's own leaf is summed exactly.
+ */
+export function chargeTreeFieldBatch(
+  tree: ChargeTree,
+  points: FloatArray,
+  outField: FloatArray,
+  outPotential: FloatArray | null = null,
+  outGradient: FloatArray | null = null,
+  pointCount: number = points.length / 3
+): void {
+  if (tree.roots.length === 0) return;
+  const { cells, links, order, roots, theta } = tree;
+  const { positions, magnitudes } = tree.charges;
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+  const stack: number[] = [];
+
+  for (let p = 0; p < pointCount; p++) {
+    const px = points[p * 3];
+    const py = points[p * 3 + 1];
+    const pz = points[p * 3 + 2];
+    let ex = 0;
+    let ey = 0;
+    let ez = 0;
+    let potential = 0;
+    let gxx = 0;
+    let gxy = 0;
+    let gxz = 0;
+    let gyy = 0;
+    let gyz = 0;
+    let gzz = 0;
+
+    for (let r = 0; r < roots.length; r++) stack.push(roots[r]);
+    while (stack.length > 0) {
+      const node = stack.pop()!;
+      const c = node * CELL_STRIDE;
+      const rx = px - cells[c];
+      const ry = py - cells[c + 1];
+      const rz = pz - cells[c + 2];
+      const distance2 = rx * rx + ry * ry + rz * rz;
+      const distance = Math.sqrt(distance2);
+      const half = cells[c + 3];
+
+      // Far enough (and outside the cell) to use the multipole expansion
+      if (distance > half * 1.7321 && distance > softening && (2 * half) / distance < theta) {
+        const charge = cells[c + 4];
+        const dx = cells[c + 5];
+        const dy = cells[c + 6];
+        const dz = cells[c + 7];
+        const inverse3 = 1 / (distance2 * distance);
+        const dipoleRadial = dx * rx + dy * ry + dz * rz;
+        const radial = (3 * dipoleRadial) / distance2;
+        ex += K * inverse3 * (charge * rx + radial * rx - dx);
+        ey += K * inverse3 * (charge * ry + radial * ry - dy);
+        ez += K * inverse3 * (charge * rz + radial * rz - dz);
+        potential += K * (charge / distance + dipoleRadial * inverse3);
+        if (outGradient) {
+          // ∂E_i/∂x_j = K [(Q/r³ + 3 p·r/r⁵) δij - (3Q/r⁵ + 15 p·r/r⁷) r_i r_j
+          //                + 3 (p_i r_j + p_j r_i)/r⁵]
+          const inverse5 = inverse3 / distance2;
+          const diagonal = K * (charge * inverse3 + 3 * dipoleRadial * inverse5);
+          const cross = K * (3 * charge * inverse5 + (15 * dipoleRadial * inverse5) / distance2);
+          const mixed = 3 * K * inverse5;
+          gxx += diagonal - cross * rx * rx + mixed * 2 * dx * rx;
+          gyy += diagonal - cross * ry * ry + mixed * 2 * dy * ry;
+          gzz += diagonal - cross * rz * rz + mixed * 2 * dz * rz;
+          gxy += -cross * rx * ry + mixed * (dx * ry + dy * rx);
+          gxz += -cross * rx * rz + mixed * (dx * rz + dz * rx);
+          gyz += -cross * ry * rz + mixed * (dy * rz + dz * ry);
+        }
+        continue;
+      }
+
+      const l = node * LINK_STRIDE;
+      const childCount = links[l + 1];
+      if (childCount > 0) {
+        for (let k = 0; k < childCount; k++) stack.push(links[l] + k);
+        continue;
+      }
+
+      const end = links[l + 2] + links[l + 3];
+      for (let e = links[l + 2]; e < end; e++) {
+        const i = order[e];
+        const sx = px - positions[i * 3];
+        const sy = py - positions[i * 3 + 1];
+        const sz = pz - positions[i * 3 + 2];
+        const d2 = sx * sx + sy * sy + sz * sz;
+        const d = Math.sqrt(d2);
+        const outside = d > softening;
+        const effectiveDistance = outside ? d : softening;
+        const kq = K * magnitudes[i];
+        potential += kq / effectiveDistance;
+        if (d === 0) continue;
+        const scale = kq / (effectiveDistance * effectiveDistance * d);
+        ex += sx * scale;
+        ey += sy * scale;
+        ez += sz * scale;
+        if (outGradient) {
+          const cross = (outside ? -3 : -1) * (scale / d2);
+          gxx += scale + cross * sx * sx;
+          gyy += scale + cross * sy * sy;
+          gzz += scale + cross * sz * sz;
+          gxy += cross * sx * sy;
+          gxz += cross * sx * sz;
+          gyz += cross * sy * sz;
+        }
+      }
+    }
+
+    outField[p * 3] += ex;
+    outField[p * 3 + 1] += ey;
+    outField[p * 3 + 2] += ez;
+    if (outPotential) outPotential[p] += potential;
+    if (outGradient) {
+      const g = p * 9;
+      outGradient[g] += gxx;
+      outGradient[g + 1] += gxy;
+      outGradient[g + 2] += gxz;
+      outGradient[g + 3] += gxy;
+      outGradient[g + 4] += gyy;
+      outGradient[g + 5] += gyz;
+      outGradient[g + 6] += gxz;
+      outGradient[g + 7] += gyz;
+      outGradient[g + 8] += gzz;
+    }
+  }
+}
@@ -0,0 +1,161 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import type { FloatArray, Vec3Like } from './FieldKernel';
+
+/**
+ * Steady current sources. Plain data so they can be posted to workers.
+ * A loop is approximated by a regular polygon of straight segments, each of
+ * which has an exact closed-form field.
+ */
+export type CurrentSource =
+  | { id: string; kind: 'wire'; start: Vec3Like; end: Vec3Like; current: number }
+  | {
+      id: string;
+      kind: 'loop';
+      center: Vec3Like;
+      normal: Vec3Like; // Current circulates counter-clockwise about the normal
+      radius: number;
+      current: number; // in Amperes
+      segments: number;
+    };
+
+/**
+ * Straight current segments flattened into typed arrays, like PackedCharges
+ */
+export interface PackedSegments {
+  count: number;
+  starts: Float64Array; // x, y, z interleaved
+  ends: Float64Array;
+  currents: Float64Array; // in Amperes, flowing start -> end
+}
+
+/**
+ * Vertices of a source's path (xyz interleaved); loops repeat the first vertex
+ */
+export function currentSourcePath(source: CurrentSource): Float64Array {
+  if (source.kind === 'wire') {
+    const { start, end } = source;
+    return new Float64Array([start.x, start.y, start.z, end.x, end.y, end.z]);
+  }
+
+  const { center, radius, segments } = source;
+  const length = Math.hypot(source.normal.x, source.normal.y, source.normal.z) || 1;
+  const nx = source.normal.x / length;
+  const ny = source.normal.y / length;
+  const nz = source.normal.z / length;
+
+  // u = n × x̂ (or n × ŷ when n is close to x̂), v = n × u
+  let ux = 0;
+  let uy = nz;
+  let uz = -ny;
+  if (Math.abs(nx) >= 0.9) {
+    ux = -nz;
+    uy = 0;
+    uz = nx;
+  }
+  const uLength = Math.hypot(ux, uy, uz);
+  ux /= uLength;
+  uy /= uLength;
+  uz /= uLength;
+  const vx = ny * uz - nz * uy;
+  const vy = nz * ux - nx * uz;
+  const vz = nx * uy - ny * ux;
+
+  const path = new Float64Array((segments + 1) * 3);
+  for (let i = 0; i <= segments; i++) {
+    const angle = (2 * Math.PI * i) / segments;
+    const cos = radius * Math.cos(angle);
+    const sin = radius * Math.sin(angle);
+    path[i * 3] = center.x + cos * ux + sin * vx;
+    path[i * 3 + 1] = center.y + cos * uy + sin * vy;
+    path[i * 3 + 2] = center.z + cos * uz + sin * vz;
+  }
+  return path;
+}
+
+/**
+ * Break every source into straight segments for the batch kernel
+ */
+export function packCurrents(sources: CurrentSource[]): PackedSegments {
+  const paths = sources.map(currentSourcePath);
+  const count = paths.reduce((total, path) => total + path.length / 3 - 1, 0);
+  const starts = new Float64Array(count * 3);
+  const ends = new Float64Array(count * 3);
+  const currents = new Float64Array(count);
+
+  let segment = 0;
+  sources.forEach((source, s) => {
+    const path = paths[s];
+    for (let i = 0; i + 1 < path.length / 3; i++) {
+      starts.set(path.subarray(i * 3, i * 3 + 3), segment * 3);
+      ends.set(path.subarray(i * 3 + 3, i * 3 + 6), segment * 3);
+      currents[segment] = source.current;
+      segment++;
+    }
+  });
+
+  return { count, starts, ends, currents };
+}
+
+/**
+ * Magnetic field of straight current segments at many points (Biot–Savart).
+ *
+ * With a = A - P, b = B - P and L = B - A, a finite segment gives the closed form
+ *
+ *   B = μ0 I / 4π · (a × b) (L·b̂ - L·â) / |a × b|²
+ *
+ * where |a × b| = ρ|L| and ρ is the distance from P to the segment's line.
+ * Softening replaces ρ² with ρ² + s², using the same s as the electric kernel,
+ * so the field stays finite on the wire.
+ */
+export function magneticFieldBatch(
+  packed: PackedSegments,
+  points: FloatArray,
+  outField: FloatArray,
+  pointCount: number = points.length / 3
+): void {
+  const { count, starts, ends, currents } = packed;
+  const muOver4Pi = PHYSICS_CONSTANTS.MU_0 / (4 * Math.PI);
+  const softening2 = PHYSICS_CONSTANTS.SOFTENING_FACTOR * PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+
+  for (let p = 0; p < pointCount; p++) {
+    const px = points[p * 3];
+    const py = points[p * 3 + 1];
+    const pz = points[p * 3 + 2];
+    let bx = 0;
+    let by = 0;
+    let bz = 0;
+
+    for (let i = 0; i < count; i++) {
+      const ax = starts[i * 3] - px;
+      const ay = starts[i * 3 + 1] - py;
+      const az = starts[i * 3 + 2] - pz;
+      const cx = ends[i * 3] - px;
+      const cy = ends[i * 3 + 1] - py;
+      const cz = ends[i * 3 + 2] - pz;
+      const lx = cx - ax;
+      const ly = cy - ay;
+      const lz = cz - az;
+      const aLength = Math.sqrt(ax * ax + ay * ay + az * az);
+      const cLength = Math.sqrt(cx * cx + cy * cy + cz * cz);
+      if (aLength === 0 || cLength === 0) continue;
+
+      // a × b
+      const nx = ay * cz - az * cy;
+      const ny = az * cx - ax * cz;
+      const nz = ax * cy - ay * cx;
+      const length2 = lx * lx + ly * ly + lz * lz;
+      const denominator = nx * nx + ny * ny + nz * nz + softening2 * length2;
+      if (denominator === 0) continue;
+
+      const projection = (lx * cx + ly * cy + lz * cz) / cLength - (lx * ax + ly * ay + lz * az) / aLength;
+      const scale = (muOver4Pi * currents[i] * projection) / denominator;
+      bx += nx * scale;
+      by += ny * scale;
+      bz += nz * scale;
+    }
+
+    outField[p * 3] = bx;
+    outField[p * 3 + 1] = by;
+    outField[p * 3 + 2] = bz;
+  }
+}
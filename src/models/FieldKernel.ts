@@ -0,0 +1,263 @@
+import type { Charge } from './Charge';
+import { PHYSICS_CONSTANTS } from './Charge';
+
+export type FloatArray = Float32Array | Float64Array;
+
+/**
+ * Which field the visualisations draw: E from charges or B from currents
+ */
+export type FieldKind = 'electric' | 'magnetic';
+
+/**
+ * Plain xyz triple; THREE.Vector3 satisfies it, and so does a Vector3 after
+ * structured cloning into a worker.
+ */
+export interface Vec3Like {
+  x: number;
+  y: number;
+  z: number;
+}
+
+/**
+ * Charges flattened into typed arrays, so field evaluation can run in tight
+ * loops and be posted to workers without THREE.Vector3 objects.
+ */
+export interface PackedCharges {
+  count: number;
+  positions: Float64Array; // x, y, z interleaved
+  magnitudes: Float64Array; // in Coulombs
+}
+
+/**
+ * Regular grid of sample points (xyz interleaved, z fastest) starting at `min`
+ * with spacing (max.x - min.x) / gridSize, as used by the vector field arrows
+ */
+export function generateGridPositions(min: Vec3Like, max: Vec3Like, gridSize: number): Float32Array {
+  const points = new Float32Array(gridSize * gridSize * gridSize * 3);
+  const step = (max.x - min.x) / gridSize;
+  let offset = 0;
+
+  for (let x = 0; x < gridSize; x++) {
+    for (let y = 0; y < gridSize; y++) {
+      for (let z = 0; z < gridSize; z++) {
+        points[offset++] = min.x + x * step;
+        points[offset++] = min.y + y * step;
+        points[offset++] = min.z + z * step;
+      }
+    }
+  }
+
+  return points;
+}
+
+/**
+ * Pack charges for the batch kernel
+ */
+export function packCharges(charges: Charge[]): PackedCharges {
+  const count = charges.length;
+  const positions = new Float64Array(count * 3);
+  const magnitudes = new Float64Array(count);
+
+  for (let i = 0; i < count; i++) {
+    const charge = charges[i];
+    positions[i * 3] = charge.position.x;
+    positions[i * 3 + 1] = charge.position.y;
+    positions[i * 3 + 2] = charge.position.z;
+    magnitudes[i] = charge.magnitude;
+  }
+
+  return { count, positions, magnitudes };
+}
+
+/**
+ * Calculate the electric field (and optionally the potential) at many points in
+ * one pass. Uses the same softening as electricFieldFromCharge, so results
+ * match electricFieldAt point for point.
+ *
+ * `points` and `outField` are xyz interleaved; `outPotential` has one entry per point.
+ */
+export function electricFieldBatch(
+  packed: PackedCharges,
+  points: FloatArray,
+  outField: FloatArray,
+  outPotential: FloatArray | null = null,
+  pointCount: number = points.length / 3
+): void {
+  const { count, positions, magnitudes } = packed;
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+
+  for (let p = 0; p < pointCount; p++) {
+    const px = points[p * 3];
+    const py = points[p * 3 + 1];
+    const pz = points[p * 3 + 2];
+    let ex = 0;
+    let ey = 0;
+    let ez = 0;
+    let potential = 0;
+
+    for (let i = 0; i < count; i++) {
+      const rx = px - positions[i * 3];
+      const ry = py - positions[i * 3 + 1];
+      const rz = pz - positions[i * 3 + 2];
+      const distance = Math.sqrt(rx * rx + ry * ry + rz * rz);
+      const effectiveDistance = distance > softening ? distance : softening;
+      const kq = K * magnitudes[i];
+
+      potential += kq / effectiveDistance;
+      if (distance > 0) {
+        const scale = kq / (effectiveDistance * effectiveDistance * distance);
+        ex += rx * scale;
+        ey += ry * scale;
+        ez += rz * scale;
+      }
+    }
+
+    outField[p * 3] = ex;
+    outField[p * 3 + 1] = ey;
+    outField[p * 3 + 2] = ez;
+    if (outPotential) {
+      outPotential[p] = potential;
+    }
+  }
+}
+
+/**
+ * electricFieldBatch plus the field gradient ∂E_i/∂x_j (9 entries per point,
+ * row-major) from the same distance computation. Outside the softening
+ * radius ∂E_i/∂x_j = Kq (δij - 3 r_i r_j / r²) / r³; inside it the softened
+ * field Kq r / (s² r) gives Kq (δij - r_i r_j / r²) / (s² r).
+ */
+export function electricFieldGradientBatch(
+  packed: PackedCharges,
+  points: FloatArray,
+  outField: FloatArray,
+  outGradient: FloatArray,
+  outPotential: FloatArray | null = null,
+  pointCount: number = points.length / 3
+): void {
+  const { count, positions, magnitudes } = packed;
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+
+  for (let p = 0; p < pointCount; p++) {
+    const px = points[p * 3];
+    const py = points[p * 3 + 1];
+    const pz = points[p * 3 + 2];
+    let ex = 0;
+    let ey = 0;
+    let ez = 0;
+    let potential = 0;
+    let gxx = 0;
+    let gxy = 0;
+    let gxz = 0;
+    let gyy = 0;
+    let gyz = 0;
+    let gzz = 0;
+
+    for (let i = 0; i < count; i++) {
+      const rx = px - positions[i * 3];
+      const ry = py - positions[i * 3 + 1];
+      const rz = pz - positions[i * 3 + 2];
+      const distance2 = rx * rx + ry * ry + rz * rz;
+      const distance = Math.sqrt(distance2);
+      const outside = distance > softening;
+      const effectiveDistance = outside ? distance : softening;
+      const kq = K * magnitudes[i];
+
+      potential += kq / effectiveDistance;
+      if (distance > 0) {
+        const scale = kq / (effectiveDistance * effectiveDistance * distance);
+        ex += rx * scale;
+        ey += ry * scale;
+        ez += rz * scale;
+
+        const cross = (outside ? -3 : -1) * (scale / distance2);
+        gxx += scale + cross * rx * rx;
+        gyy += scale + cross * ry * ry;
+        gzz += scale + cross * rz * rz;
+        gxy += cross * rx * ry;
+        gxz += cross * rx * rz;
+        gyz += cross * ry * rz;
+      }
+    }
+
+    outField[p * 3] = ex;
+    outField[p * 3 + 1] = ey;
+    outField[p * 3 + 2] = ez;
+    // E is curl-free, so the gradient is symmetric
+    const g = p * 9;
+    outGradient[g] = gxx;
+    outGradient[g + 1] = gxy;
+    outGradient[g + 2] = gxz;
+    outGradient[g + 3] = gxy;
+    outGradient[g + 4] = gyy;
+    outGradient[g + 5] = gyz;
+    outGradient[g + 6] = gxz;
+    outGradient[g + 7] = gyz;
+    outGradient[g + 8] = gzz;
+    if (outPotential) {
+      outPotential[p] = potential;
+    }
+  }
+}
+
+/**
+ * Curvature (1/m) of the field line through a point, from E and its gradient
+ * at that point: κ = |(∇E ê)⊥| / |E|, the part of the change of E along the
+ * line that turns it rather than stretches it. `offset` indexes the point.
+ */
+export function fieldLineCurvature(field: FloatArray, gradient: FloatArray, offset: number = 0): number {
+  const f = offset * 3;
+  const g = offset * 9;
+  const magnitude = Math.hypot(field[f], field[f + 1], field[f + 2]);
+  if (magnitude === 0) return 0;
+  const ux = field[f] / magnitude;
+  const uy = field[f + 1] / magnitude;
+  const uz = field[f + 2] / magnitude;
+  const dx = gradient[g] * ux + gradient[g + 1] * uy + gradient[g + 2] * uz;
+  const dy = gradient[g + 3] * ux + gradient[g + 4] * uy + gradient[g + 5] * uz;
+  const dz = gradient[g + 6] * ux + gradient[g + 7] * uy + gradient[g + 8] * uz;
+  const along = dx * ux + dy * uy + dz * uz;
+  return Math.hypot(dx - along * ux, dy - along * uy, dz - along * uz) / magnitude;
+}
+
+/**
+ * Add `scale` times the field of a point dipole (moment in C·m) at many points.
+ * Distances are softened like electricFieldFromCharge.
+ */
+export function addDipoleFieldBatch(
+  points: FloatArray,
+  position: Vec3Like,
+  moment: Vec3Like,
+  scale: number,
+  outField: FloatArray,
+  pointCount: number = points.length / 3
+): void {
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+
+  for (let p = 0; p < pointCount; p++) {
+    const rx = points[p * 3] - position.x;
+    const ry = points[p * 3 + 1] - position.y;
+    const rz = points[p * 3 + 2] - position.z;
+    const distance = Math.sqrt(rx * rx + ry * ry + rz * rz);
+    const effectiveDistance = distance > softening ? distance : softening;
+    const k = (K * scale) / (effectiveDistance * effectiveDistance * effectiveDistance);
+
+    // E = K (3 (p·r̂) r̂ - p) / r³
+    let radial = 0;
+    let ux = 0;
+    let uy = 0;
+    let uz = 0;
+    if (distance > 0) {
+      ux = rx / distance;
+      uy = ry / distance;
+      uz = rz / distance;
+      radial = 3 * (moment.x * ux + moment.y * uy + moment.z * uz);
+    }
+    outField[p * 3] += k * (radial * ux - moment.x);
+    outField[p * 3 + 1] += k * (radial * uy - moment.y);
+    outField[p * 3 + 2] += k * (radial * uz - moment.z);
+  }
+}
@@ -0,0 +1,184 @@
+import type { FloatArray, Vec3Like } from './FieldKernel';
+import { sourcesFieldBatch, sourcesFieldGradientBatch } from './FieldSources';
+import type { FieldSources } from './FieldSources';
+
+export interface LatticeBounds {
+  min: Vec3Like;
+  max: Vec3Like;
+}
+
+/**
+ * Electric field cached on a regular lattice. Sampling is a trilinear lookup,
+ * so consumers that need millions of evaluations per second (particle swarms,
+ * animated glyphs) never touch the charges directly. A lattice built with
+ * gradients samples by tricubic Hermite interpolation instead, which follows
+ * the 1/r² falloff far more closely at the same resolution.
+ */
+export class FieldLattice {
+  public readonly resolution: number;
+  public readonly field: Float32Array; // xyz interleaved, x fastest
+  public readonly gradient: Float32Array | null; // ∂E_i/∂x_j per node, row-major
+  private readonly minX: number;
+  private readonly minY: number;
+  private readonly minZ: number;
+  private readonly cellX: number;
+  private readonly cellY: number;
+  private readonly cellZ: number;
+
+  constructor(bounds: LatticeBounds, resolution: number, field?: Float32Array, gradient: Float32Array | null = null) {
+    this.resolution = resolution;
+    this.minX = bounds.min.x;
+    this.minY = bounds.min.y;
+    this.minZ = bounds.min.z;
+    this.cellX = (bounds.max.x - bounds.min.x) / (resolution - 1);
+    this.cellY = (bounds.max.y - bounds.min.y) / (resolution - 1);
+    this.cellZ = (bounds.max.z - bounds.min.z) / (resolution - 1);
+    this.field = field ?? new Float32Array(resolution * resolution * resolution * 3);
+    this.gradient = gradient;
+  }
+
+  /**
+   * Sample the field of `sources` at every lattice node, with its gradient
+   * from the same kernel pass when `withGradient` is set
+   */
+  public static build(
+    sources: FieldSources,
+    bounds: LatticeBounds,
+    resolution: number,
+    withGradient: boolean = false
+  ): FieldLattice {
+    const nodeCount = resolution * resolution * resolution;
+    const lattice = new FieldLattice(
+      bounds,
+      resolution,
+      undefined,
+      withGradient ? new Float32Array(nodeCount * 9) : null
+    );
+    if (lattice.gradient) {
+      sourcesFieldGradientBatch(sources, lattice.nodePositions(), lattice.field, lattice.gradient);
+    } else {
+      sourcesFieldBatch(sources, lattice.nodePositions(), lattice.field);
+    }
+    return lattice;
+  }
+
+  /**
+   * Node positions in lattice order (xyz interleaved)
+   */
+  public nodePositions(): Float32Array {
+    const n = this.resolution;
+    const points = new Float32Array(n * n * n * 3);
+    let offset = 0;
+    for (let z = 0; z < n; z++) {
+      for (let y = 0; y < n; y++) {
+        for (let x = 0; x < n; x++) {
+          points[offset++] = this.minX + x * this.cellX;
+          points[offset++] = this.minY + y * this.cellY;
+          points[offset++] = this.minZ + z * this.cellZ;
+        }
+      }
+    }
+    return points;
+  }
+
+  /**
+   * Interpolate the field at (x, y, z) into `out` at `offset`: tricubic
+   * Hermite when the lattice has gradients, trilinear otherwise.
+   * Returns false (and leaves `out` untouched) outside the lattice.
+   */
+  public sample(x: number, y: number, z: number, out: FloatArray, offset: number = 0): boolean {
+    const n = this.resolution;
+    const fx = (x - this.minX) / this.cellX;
+    const fy = (y - this.minY) / this.cellY;
+    const fz = (z - this.minZ) / this.cellZ;
+    if (!(fx >= 0 && fy >= 0 && fz >= 0 && fx <= n - 1 && fy <= n - 1 && fz <= n - 1)) {
+      return false;
+    }
+
+    const ix = Math.min(Math.floor(fx), n - 2);
+    const iy = Math.min(Math.floor(fy), n - 2);
+    const iz = Math.min(Math.floor(fz), n - 2);
+    const tx = fx - ix;
+    const ty = fy - iy;
+    const tz = fz - iz;
+
+    if (this.gradient) {
+      this.sampleHermite(ix, iy, iz, tx, ty, tz, out, offset);
+      return true;
+    }
+
+    const strideY = n * 3;
+    const strideZ = n * n * 3;
+    const base = iz * strideZ + iy * strideY + ix * 3;
+    const field = this.field;
+
+    for (let c = 0; c < 3; c++) {
+      const i000 = base + c;
+      const c00 = field[i000] + (field[i000 + 3] - field[i000]) * tx;
+      const c10 = field[i000 + strideY] + (field[i000 + strideY + 3] - field[i000 + strideY]) * tx;
+      const c01 = field[i000 + strideZ] + (field[i000 + strideZ + 3] - field[i000 + strideZ]) * tx;
+      const c11 =
+        field[i000 + strideZ + strideY] +
+        (field[i000 + strideZ + strideY + 3] - field[i000 + strideZ + strideY]) * tx;
+      const c0 = c00 + (c10 - c00) * ty;
+      const c1 = c01 + (c11 - c01) * ty;
+      out[offset + c] = c0 + (c1 - c0) * tz;
+    }
+    return true;
+  }
+
+  /**
+   * Tensor-product cubic Hermite over the cell at (ix, iy, iz) from node values
+   * and first derivatives. The mixed (twist) derivatives are taken as zero,
+   * which keeps the interpolant C¹ across cells and exact at the nodes.
+   */
+  private sampleHermite(
+    ix: number,
+    iy: number,
+    iz: number,
+    tx: number,
+    ty: number,
+    tz: number,
+    out: FloatArray,
+    offset: number
+  ) {
+    const n = this.resolution;
+    const field = this.field;
+    const gradient = this.gradient!;
+    // Value and (cell-scaled) derivative weights for the lower and upper node on each axis
+    const vx0 = 2 * tx * tx * tx - 3 * tx * tx + 1;
+    const vy0 = 2 * ty * ty * ty - 3 * ty * ty + 1;
+    const vz0 = 2 * tz * tz * tz - 3 * tz * tz + 1;
+    const value = [vx0, 1 - vx0, vy0, 1 - vy0, vz0, 1 - vz0];
+    const slope = [
+      (tx * tx * tx - 2 * tx * tx + tx) * this.cellX,
+      (tx * tx * tx - tx * tx) * this.cellX,
+      (ty * ty * ty - 2 * ty * ty + ty) * this.cellY,
+      (ty * ty * ty - ty * ty) * this.cellY,
+      (tz * tz * tz - 2 * tz * tz + tz) * this.cellZ,
+      (tz * tz * tz - tz * tz) * this.cellZ,
+    ];
+
+    let ex = 0;
+    let ey = 0;
+    let ez = 0;
+    for (let corner = 0; corner < 8; corner++) {
+      const bx = corner & 1;
+      const by = (corner >> 1) & 1;
+      const bz = (corner >> 2) & 1;
+      const node = (iz + bz) * n * n + (iy + by) * n + ix + bx;
+      const wv = value[bx] * value[2 + by] * value[4 + bz];
+      const wx = slope[bx] * value[2 + by] * value[4 + bz];
+      const wy = value[bx] * slope[2 + by] * value[4 + bz];
+      const wz = value[bx] * value[2 + by] * slope[4 + bz];
+      const f = node * 3;
+      const g = node * 9;
+      ex += wv * field[f] + wx * gradient[g] + wy * gradient[g + 1] + wz * gradient[g + 2];
+      ey += wv * field[f + 1] + wx * gradient[g + 3] + wy * gradient[g + 4] + wz * gradient[g + 5];
+      ez += wv * field[f + 2] + wx * gradient[g + 6] + wy * gradient[g + 7] + wz * gradient[g + 8];
+    }
+    out[offset] = ex;
+    out[offset + 1] = ey;
+    out[offset + 2] = ez;
+  }
+}
@@ -0,0 +1,156 @@
+import { chargeTreeFieldBatch, chargeTreeNearest } from './ChargeTree';
+import type { ChargeTree } from './ChargeTree';
+import { fieldLineCurvature } from './FieldKernel';
+import type { PackedCharges } from './FieldKernel';
+import type { LatticeBounds } from './FieldLattice';
+
+export interface FieldLineTraceConfig {
+  stepSize: number;
+  minStepSize: number;
+  maxSteps: number;
+  bounds: LatticeBounds;
+  linesPerCharge: number;
+}
+
+const SEED_RADIUS = 0.3; // Lines start this far from each positive charge
+const CAPTURE_RADIUS = 0.2; // A line ends once it gets this close to a charge
+const MAX_TURN = 0.1; // rad; steps are sized so a line turns at most this much per step
+// Most dataset charges that seed E lines, spread evenly through the dataset
+export const DATASET_SEED_CHARGES = 32;
+
+/**
+ * Indices of up to `limit` positive charges, evenly spaced through `packed`,
+ * so a large dataset still gets a bounded number of field lines
+ */
+export function spacedPositiveCharges(packed: PackedCharges, limit: number): number[] {
+  const { count, magnitudes } = packed;
+  let positive = 0;
+  for (let i = 0; i < count; i++) if (magnitudes[i] > 0) positive++;
+  const stride = Math.max(1, Math.ceil(positive / limit));
+  const seeds: number[] = [];
+  let seen = 0;
+  for (let i = 0; i < count; i++) {
+    if (magnitudes[i] > 0 && seen++ % stride === 0) seeds.push(i);
+  }
+  return seeds;
+}
+
+/**
+ * DOM-free version of FieldLineRenderer's electric tracing (same seeds, RK4
+ * steps and stopping rules) over a charge tree, for workers and the Node
+ * exporter. Lines start from at most `seedLimit` positive charges. Returns
+ * one xyz polyline per line.
+ */
+export function traceFieldLines(
+  tree: ChargeTree,
+  config: FieldLineTraceConfig,
+  seedLimit: number = Infinity
+): Float32Array[] {
+  const lines: Float32Array[] = [];
+  const { positions, magnitudes } = tree.charges;
+  const point = new Float64Array(3);
+  const field = new Float64Array(3);
+  const gradient = new Float64Array(9);
+
+  // The tree kernel adds to its outputs
+  const sample = (x: number, y: number, z: number, withGradient: boolean) => {
+    point[0] = x;
+    point[1] = y;
+    point[2] = z;
+    field.fill(0);
+    if (withGradient) gradient.fill(0);
+    chargeTreeFieldBatch(tree, point, field, null, withGradient ? gradient : null, 1);
+  };
+
+  const direction = (x: number, y: number, z: number, out: Float64Array): number => {
+    sample(x, y, z, false);
+    const magnitude = Math.hypot(field[0], field[1], field[2]);
+    const inverse = magnitude > 0 ? 1 / magnitude : 0;
+    out[0] = field[0] * inverse;
+    out[1] = field[1] * inverse;
+    out[2] = field[2] * inverse;
+    return magnitude;
+  };
+
+  const { min, max } = config.bounds;
+  const k1 = new Float64Array(3);
+  const k2 = new Float64Array(3);
+  const k3 = new Float64Array(3);
+  const k4 = new Float64Array(3);
+
+  const trace = (sx: number, sy: number, sz: number, forward: boolean): number[] => {
+    const out = [sx, sy, sz];
+    let x = sx;
+    let y = sy;
+    let z = sz;
+    for (let step = 0; step < config.maxSteps; step++) {
+      if (x < min.x || x > max.x || y < min.y || y > max.y || z < min.z || z > max.z) break;
+
+      const near = chargeTreeNearest(tree, x, y, z, CAPTURE_RADIUS);
+      if (near >= 0) {
+        if (magnitudes[near] < 0 && forward) {
+          out.push(positions[near * 3], positions[near * 3 + 1], positions[near * 3 + 2]);
+          break;
+        }
+        if (magnitudes[near] > 0 && !forward) break;
+      }
+
+      // Step from the line's curvature at this point, taken from the same
+      // kernel pass as the field that seeds the RK4 stage
+      sample(x, y, z, true);
+      const magnitude = Math.hypot(field[0], field[1], field[2]);
+      if (magnitude === 0) break;
+      k1[0] = field[0] / magnitude;
+      k1[1] = field[1] / magnitude;
+      k1[2] = field[2] / magnitude;
+      const curvature = fieldLineCurvature(field, gradient);
+      const stepSize = Math.min(
+        config.stepSize * 2,
+        Math.max(config.minStepSize, curvature > 0 ? MAX_TURN / curvature : Infinity)
+      );
+      const h = forward ? stepSize : -stepSize;
+      direction(x + k1[0] * h * 0.5, y + k1[1] * h * 0.5, z + k1[2] * h * 0.5, k2);
+      direction(x + k2[0] * h * 0.5, y + k2[1] * h * 0.5, z + k2[2] * h * 0.5, k3);
+      direction(x + k3[0] * h, y + k3[1] * h, z + k3[2] * h, k4);
+      const dx = (h / 6) * (k1[0] + 2 * k2[0] + 2 * k3[0] + k4[0]);
+      const dy = (h / 6) * (k1[1] + 2 * k2[1] + 2 * k3[1] + k4[1]);
+      const dz = (h / 6) * (k1[2] + 2 * k2[2] + 2 * k3[2] + k4[2]);
+
+      if (dx * dx + dy * dy + dz * dz < 1e-12) break;
+      x += dx;
+      y += dy;
+      z += dz;
+      out.push(x, y, z);
+    }
+
+    return out;
+  };
+
+  for (const c of spacedPositiveCharges(tree.charges, seedLimit)) {
+    for (let i = 0; i < config.linesPerCharge; i++) {
+      // Golden-angle spiral on a small sphere, as in FieldLineRenderer
+      const theta = Math.acos(1 - (2 * i) / config.linesPerCharge);
+      const phi = Math.PI * (1 + Math.sqrt(5)) * i;
+      const sx = positions[c * 3] + SEED_RADIUS * Math.sin(theta) * Math.cos(phi);
+      const sy = positions[c * 3 + 1] + SEED_RADIUS * Math.sin(theta) * Math.sin(phi);
+      const sz = positions[c * 3 + 2] + SEED_RADIUS * Math.cos(theta);
+
+      const forwardPoints = trace(sx, sy, sz, true);
+      const backwardPoints = trace(sx, sy, sz, false);
+      const vertexCount = backwardPoints.length / 3 + forwardPoints.length / 3 - 1;
+      if (vertexCount < 2) continue;
+
+      const line = new Float32Array(vertexCount * 3);
+      let offset = 0;
+      for (let v = backwardPoints.length / 3 - 1; v >= 0; v--) {
+        line[offset++] = backwardPoints[v * 3];
+        line[offset++] = backwardPoints[v * 3 + 1];
+        line[offset++] = backwardPoints[v * 3 + 2];
+      }
+      line.set(forwardPoints.slice(3), offset);
+      lines.push(line);
+    }
+  }
+
+  return lines;
+}
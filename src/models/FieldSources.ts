@@ -0,0 +1,92 @@
+import { buildChargeTree, chargeTreeFieldBatch } from './ChargeTree';
+import type { ChargeTree } from './ChargeTree';
+import { electricFieldBatch, electricFieldGradientBatch, packCharges } from './FieldKernel';
+import type { FloatArray, PackedCharges } from './FieldKernel';
+
+/**
+ * Everything the field views evaluate: the editable charges plus the imported
+ * point-cloud dataset held by ChargeStore. The two stay separate sources, so
+ * dragging one editable charge never repacks or copies the dataset. The
+ * editable charges are summed directly; the dataset, which can run to
+ * millions of charges, goes through its octree.
+ */
+export interface FieldSources {
+  charges: PackedCharges;
+  dataset: ChargeTree;
+}
+
+/**
+ * Sent to a worker whenever the dataset changes. Workers keep the last one,
+ * so their per-request messages carry only the editable charges.
+ */
+export interface DatasetMessage {
+  type: 'dataset';
+  dataset: ChargeTree;
+}
+
+export function emptyFieldSources(): FieldSources {
+  return { charges: packCharges([]), dataset: buildChargeTree(packCharges([])) };
+}
+
+const sharedTrees = new WeakMap<ChargeTree, ChargeTree>();
+
+/**
+ * The tree to post in a DatasetMessage. On a cross-origin isolated page its
+ * arrays are copied once into shared memory that every worker reads, and
+ * the copy is cached per tree. Otherwise the tree is returned as is, and
+ * each worker it is posted to gets its own copy.
+ */
+export function shareChargeTree(tree: ChargeTree): ChargeTree {
+  if (!globalThis.crossOriginIsolated) return tree;
+  let shared = sharedTrees.get(tree);
+  if (!shared) {
+    const share = (array: ArrayBufferView) => {
+      const buffer = new SharedArrayBuffer(array.byteLength);
+      new Uint8Array(buffer).set(new Uint8Array(array.buffer, array.byteOffset, array.byteLength));
+      return buffer;
+    };
+    const { charges } = tree;
+    shared = {
+      ...tree,
+      charges: {
+        count: charges.count,
+        positions: new Float64Array(share(charges.positions)),
+        magnitudes: new Float64Array(share(charges.magnitudes)),
+      },
+      cells: new Float64Array(share(tree.cells)),
+      links: new Int32Array(share(tree.links)),
+      order: new Uint32Array(share(tree.order)),
+    };
+    sharedTrees.set(tree, shared);
+  }
+  return shared;
+}
+
+/**
+ * electricFieldBatch over both sources
+ */
+export function sourcesFieldBatch(
+  sources: FieldSources,
+  points: FloatArray,
+  outField: FloatArray,
+  outPotential: FloatArray | null = null,
+  pointCount: number = points.length / 3
+): void {
+  electricFieldBatch(sources.charges, points, outField, outPotential, pointCount);
+  chargeTreeFieldBatch(sources.dataset, points, outField, outPotential, null, pointCount);
+}
+
+/**
+ * electricFieldGradientBatch over both sources
+ */
+export function sourcesFieldGradientBatch(
+  sources: FieldSources,
+  points: FloatArray,
+  outField: FloatArray,
+  outGradient: FloatArray,
+  outPotential: FloatArray | null = null,
+  pointCount: number = points.length / 3
+): void {
+  electricFieldGradientBatch(sources.charges, points, outField, outGradient, outPotential, pointCount);
+  chargeTreeFieldBatch(sources.dataset, points, outField, outPotential, outGradient, pointCount);
+}
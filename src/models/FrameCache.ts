@@ -0,0 +1,156 @@
+import { buildChargeTree } from './ChargeTree';
+import { electricFieldBatch } from './FieldKernel';
+import { traceFieldLines } from './FieldLineTracer';
+import type { FieldLineTraceConfig } from './FieldLineTracer';
+import { chargesAtTime } from './Timeline';
+import type { Timeline } from './Timeline';
+
+/**
+ * One precomputed animation frame. In a decoded frame every array is a view
+ * into the frame's binary buffer, so reading a frame copies nothing.
+ */
+export interface CachedFrame {
+  time: number;
+  charges: Float32Array; // x, y, z, q per charge
+  field: Float32Array; // E at each grid point, xyz interleaved
+  lineLengths: Uint32Array; // Vertex count of each field line
+  lineVertices: Float32Array; // All lines' vertices back to back, xyz interleaved
+}
+
+// Frame: [chargeCount, pointCount, lineCount, vertexCount] u32, time f32, then the arrays
+const FRAME_HEADER_BYTES = 20;
+
+/**
+ * Compute one frame: interpolated charges, E on the grid and traced field lines
+ */
+export function computeFrame(
+  timeline: Timeline,
+  time: number,
+  gridPositions: Float32Array,
+  lineConfig: FieldLineTraceConfig
+): CachedFrame {
+  const packed = chargesAtTime(timeline, time);
+  const charges = new Float32Array(packed.count * 4);
+  for (let i = 0; i < packed.count; i++) {
+    charges[i * 4] = packed.positions[i * 3];
+    charges[i * 4 + 1] = packed.positions[i * 3 + 1];
+    charges[i * 4 + 2] = packed.positions[i * 3 + 2];
+    charges[i * 4 + 3] = packed.magnitudes[i];
+  }
+
+  const field = new Float32Array(gridPositions.length);
+  electricFieldBatch(packed, gridPositions, field);
+
+  const lines = traceFieldLines(buildChargeTree(packed), lineConfig);
+  const lineLengths = new Uint32Array(lines.length);
+  let vertexCount = 0;
+  lines.forEach((line, i) => {
+    lineLengths[i] = line.length / 3;
+    vertexCount += lineLengths[i];
+  });
+  const lineVertices = new Float32Array(vertexCount * 3);
+  let offset = 0;
+  for (const line of lines) {
+    lineVertices.set(line, offset);
+    offset += line.length;
+  }
+
+  return { time, charges, field, lineLengths, lineVertices };
+}
+
+/**
+ * Pack a frame into a single buffer (every section is 4-byte aligned)
+ */
+export function encodeFrame(frame: CachedFrame): ArrayBuffer {
+  const byteLength =
+    FRAME_HEADER_BYTES +
+    (frame.charges.length + frame.field.length + frame.lineLengths.length + frame.lineVertices.length) * 4;
+  const buffer = new ArrayBuffer(byteLength);
+  const header = new DataView(buffer, 0, FRAME_HEADER_BYTES);
+  header.setUint32(0, frame.charges.length / 4, true);
+  header.setUint32(4, frame.field.length / 3, true);
+  header.setUint32(8, frame.lineLengths.length, true);
+  header.setUint32(12, frame.lineVertices.length / 3, true);
+  header.setFloat32(16, frame.time, true);
+
+  let offset = FRAME_HEADER_BYTES;
+  new Float32Array(buffer, offset, frame.charges.length).set(frame.charges);
+  offset += frame.charges.byteLength;
+  new Float32Array(buffer, offset, frame.field.length).set(frame.field);
+  offset += frame.field.byteLength;
+  new Uint32Array(buffer, offset, frame.lineLengths.length).set(frame.lineLengths);
+  offset += frame.lineLengths.byteLength;
+  new Float32Array(buffer, offset, frame.lineVertices.length).set(frame.lineVertices);
+  return buffer;
+}
+
+/**
+ * View an encoded frame without copying
+ */
+export function decodeFrame(buffer: ArrayBuffer, byteOffset: number = 0): CachedFrame {
+  const header = new DataView(buffer, byteOffset, FRAME_HEADER_BYTES);
+  const chargeCount = header.getUint32(0, true);
+  const pointCount = header.getUint32(4, true);
+  const lineCount = header.getUint32(8, true);
+  const vertexCount = header.getUint32(12, true);
+  const time = header.getFloat32(16, true);
+
+  let offset = byteOffset + FRAME_HEADER_BYTES;
+  const charges = new Float32Array(buffer, offset, chargeCount * 4);
+  offset += charges.byteLength;
+  const field = new Float32Array(buffer, offset, pointCount * 3);
+  offset += field.byteLength;
+  const lineLengths = new Uint32Array(buffer, offset, lineCount);
+  offset += lineLengths.byteLength;
+  const lineVertices = new Float32Array(buffer, offset, vertexCount * 3);
+
+  return { time, charges, field, lineLengths, lineVertices };
+}
+
+/**
+ * Encoded frames for a whole timeline over one grid. Frames arrive in any
+ * order (from several workers) and are decoded only when played.
+ */
+export class FrameCache {
+  public readonly fps: number;
+  public readonly gridPositions: Float32Array;
+  private frames: (ArrayBuffer | null)[];
+
+  constructor(fps: number, gridPositions: Float32Array, frameCount: number) {
+    this.fps = fps;
+    this.gridPositions = gridPositions;
+    this.frames = new Array(frameCount).fill(null);
+  }
+
+  get frameCount(): number {
+    return this.frames.length;
+  }
+
+  get readyCount(): number {
+    return this.frames.reduce((total, frame) => total + (frame ? 1 : 0), 0);
+  }
+
+  get byteLength(): number {
+    return this.frames.reduce((total, frame) => total + (frame ? frame.byteLength : 0), 0);
+  }
+
+  public setFrame(index: number, buffer: ArrayBuffer) {
+    this.frames[index] = buffer;
+  }
+
+  public hasFrame(index: number): boolean {
+    return this.frames[index] != null;
+  }
+
+  public getFrame(index: number): CachedFrame | null {
+    const buffer = this.frames[index];
+    return buffer ? decodeFrame(buffer) : null;
+  }
+
+  /**
+   * Encoded frame bytes, e.g. for writing one file per frame
+   */
+  public getFrameBuffer(index: number): ArrayBuffer | null {
+    return this.frames[index];
+  }
+}
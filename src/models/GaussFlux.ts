@@ -0,0 +1,236 @@
+import type { Charge } from './Charge';
+import { PHYSICS_CONSTANTS } from './Charge';
+import { electricFieldBatch } from './FieldKernel';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+import { surfaceTriangles, triangleBounds, windingNumber } from './GaussSurface';
+import type { GaussSurface } from './GaussSurface';
+
+export interface GaussFluxOptions {
+  relativeTolerance: number; // Allowed flux error as a fraction of |q|/ε0, per charge
+  maxDepth: number; // Midpoint subdivisions allowed per base triangle
+  farFactor: number; // Charges beyond farFactor × bounding radius skip refinement
+}
+
+export interface GaussFluxResult {
+  flux: number; // Numerically integrated ∮ E·dA (N·m²/C)
+  enclosedCharge: number; // Σ q inside the surface (C), from winding numbers
+  evaluations: number; // Field evaluations this update needed (0 when nothing moved)
+}
+
+/**
+ * Flux through the triangles from a unit charge at `position`, by adaptive
+ * quadrature. Each triangle uses the degree-2 edge-midpoint rule; a triangle
+ * is split into its four midpoint children until the children's sum agrees
+ * with the parent to within the triangle's share (by area) of the tolerance.
+ * Refinement runs breadth-first, so every level is one batch-kernel call.
+ */
+export function unitChargeFlux(
+  triangles: Float64Array,
+  position: Vec3Like,
+  maxDepth: number,
+  tolerance: number
+): { flux: number; evaluations: number } {
+  const packed: PackedCharges = {
+    count: 1,
+    positions: new Float64Array([position.x, position.y, position.z]),
+    magnitudes: new Float64Array([1]),
+  };
+
+  let totalArea = 0;
+  const baseCount = triangles.length / 9;
+  for (let t = 0; t < baseCount; t++) totalArea += triangleArea(triangles, t);
+
+  let active = triangles;
+  let estimates = ruleEstimates(packed, active);
+  let evaluations = baseCount * 3;
+  let flux = 0;
+
+  for (let depth = 0; depth < maxDepth && active.length > 0; depth++) {
+    const children = subdivide(active);
+    const childEstimates = ruleEstimates(packed, children);
+    evaluations += (children.length / 9) * 3;
+
+    const refine: number[] = [];
+    for (let t = 0; t < active.length / 9; t++) {
+      const childSum =
+        childEstimates[t * 4] + childEstimates[t * 4 + 1] + childEstimates[t * 4 + 2] + childEstimates[t * 4 + 3];
+      const allowed = (tolerance * triangleArea(active, t)) / totalArea;
+      if (Math.abs(childSum - estimates[t]) <= allowed || depth === maxDepth - 1) {
+        flux += childSum;
+      } else {
+        refine.push(t);
+      }
+    }
+
+    active = new Float64Array(refine.length * 36);
+    estimates = new Float64Array(refine.length * 4);
+    refine.forEach((t, i) => {
+      active.set(children.subarray(t * 36, t * 36 + 36), i * 36);
+      estimates.set(childEstimates.subarray(t * 4, t * 4 + 4), i * 4);
+    });
+  }
+
+  // Triangles still active here were never refined (maxDepth 0)
+  for (let t = 0; t < estimates.length; t++) flux += estimates[t];
+  return { flux, evaluations };
+}
+
+function triangleArea(triangles: Float64Array, t: number): number {
+  const o = t * 9;
+  const ux = triangles[o + 3] - triangles[o];
+  const uy = triangles[o + 4] - triangles[o + 1];
+  const uz = triangles[o + 5] - triangles[o + 2];
+  const vx = triangles[o + 6] - triangles[o];
+  const vy = triangles[o + 7] - triangles[o + 1];
+  const vz = triangles[o + 8] - triangles[o + 2];
+  return 0.5 * Math.hypot(uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx);
+}
+
+/**
+ * ∫ E·n dA over each triangle with the edge-midpoint rule (exact for
+ * quadratics): area/3 × Σ E(m)·n̂, i.e. (1/6) Σ E(m)·(u × v)
+ */
+function ruleEstimates(packed: PackedCharges, triangles: Float64Array): Float64Array {
+  const count = triangles.length / 9;
+  const points = new Float64Array(count * 9);
+  for (let t = 0; t < count; t++) {
+    const o = t * 9;
+    for (let axis = 0; axis < 3; axis++) {
+      const a = triangles[o + axis];
+      const b = triangles[o + 3 + axis];
+      const c = triangles[o + 6 + axis];
+      points[o + axis] = 0.5 * (a + b);
+      points[o + 3 + axis] = 0.5 * (b + c);
+      points[o + 6 + axis] = 0.5 * (c + a);
+    }
+  }
+
+  const field = new Float64Array(points.length);
+  electricFieldBatch(packed, points, field);
+
+  const estimates = new Float64Array(count);
+  for (let t = 0; t < count; t++) {
+    const o = t * 9;
+    const ux = triangles[o + 3] - triangles[o];
+    const uy = triangles[o + 4] - triangles[o + 1];
+    const uz = triangles[o + 5] - triangles[o + 2];
+    const vx = triangles[o + 6] - triangles[o];
+    const vy = triangles[o + 7] - triangles[o + 1];
+    const vz = triangles[o + 8] - triangles[o + 2];
+    const nx = uy * vz - uz * vy;
+    const ny = uz * vx - ux * vz;
+    const nz = ux * vy - uy * vx;
+    const ex = field[o] + field[o + 3] + field[o + 6];
+    const ey = field[o + 1] + field[o + 4] + field[o + 7];
+    const ez = field[o + 2] + field[o + 5] + field[o + 8];
+    estimates[t] = (ex * nx + ey * ny + ez * nz) / 6;
+  }
+  return estimates;
+}
+
+/**
+ * Split each triangle into four at its edge midpoints (children keep the winding)
+ */
+function subdivide(triangles: Float64Array): Float64Array {
+  const count = triangles.length / 9;
+  const children = new Float64Array(count * 36);
+  const a = new Float64Array(3);
+  const b = new Float64Array(3);
+  const c = new Float64Array(3);
+  const ab = new Float64Array(3);
+  const bc = new Float64Array(3);
+  const ca = new Float64Array(3);
+
+  for (let t = 0; t < count; t++) {
+    const o = t * 9;
+    for (let axis = 0; axis < 3; axis++) {
+      a[axis] = triangles[o + axis];
+      b[axis] = triangles[o + 3 + axis];
+      c[axis] = triangles[o + 6 + axis];
+      ab[axis] = 0.5 * (a[axis] + b[axis]);
+      bc[axis] = 0.5 * (b[axis] + c[axis]);
+      ca[axis] = 0.5 * (c[axis] + a[axis]);
+    }
+    let offset = t * 36;
+    for (const vertex of [a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca]) {
+      children.set(vertex, offset);
+      offset += 3;
+    }
+  }
+  return children;
+}
+
+interface CachedContribution {
+  x: number;
+  y: number;
+  z: number;
+  unitFlux: number;
+  winding: number;
+}
+
+/**
+ * Flux and enclosed charge for one surface, updated incrementally. Flux is
+ * linear in the charges, so each charge's flux per coulomb is cached against
+ * its position: an update integrates only the charges that moved, and
+ * changing a magnitude just rescales. Charges far from the surface see a
+ * smooth integrand and use the base rule without refinement.
+ */
+export class GaussFluxIntegrator {
+  private triangles: Float64Array;
+  private center: Vec3Like;
+  private radius: number;
+  private options: GaussFluxOptions;
+  private cache = new Map<string, CachedContribution>();
+
+  constructor(surface: GaussSurface, options: GaussFluxOptions = createDefaultGaussFluxOptions()) {
+    this.triangles = surfaceTriangles(surface);
+    const bounds = triangleBounds(this.triangles);
+    this.center = bounds.center;
+    this.radius = bounds.radius;
+    this.options = options;
+  }
+
+  public getTriangles(): Float64Array {
+    return this.triangles;
+  }
+
+  public evaluate(charges: Charge[]): GaussFluxResult {
+    const unitTolerance = this.options.relativeTolerance * 4 * Math.PI * PHYSICS_CONSTANTS.K; // × 1/ε0
+    const seen = new Set<string>();
+    let flux = 0;
+    let enclosedCharge = 0;
+    let evaluations = 0;
+
+    for (const charge of charges) {
+      seen.add(charge.id);
+      const { x, y, z } = charge.position;
+      let entry = this.cache.get(charge.id);
+
+      if (!entry || entry.x !== x || entry.y !== y || entry.z !== z) {
+        const distance = Math.hypot(x - this.center.x, y - this.center.y, z - this.center.z);
+        const depth = distance > this.options.farFactor * this.radius ? 0 : this.options.maxDepth;
+        const result = unitChargeFlux(this.triangles, charge.position, depth, unitTolerance);
+        evaluations += result.evaluations;
+        entry = { x, y, z, unitFlux: result.flux, winding: windingNumber(this.triangles, x, y, z) };
+        this.cache.set(charge.id, entry);
+      }
+
+      flux += charge.magnitude * entry.unitFlux;
+      enclosedCharge += charge.magnitude * entry.winding;
+    }
+
+    for (const id of Array.from(this.cache.keys())) {
+      if (!seen.has(id)) this.cache.delete(id);
+    }
+
+    return { flux, enclosedCharge, evaluations };
+  }
+}
+
+export function createDefaultGaussFluxOptions(): GaussFluxOptions {
+  return {
+    relativeTolerance: 1e-3,
+    maxDepth: 6,
+    farFactor: 3,
+  };
+}
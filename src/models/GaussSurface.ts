@@ -0,0 +1,113 @@
+import * as THREE from 'three';
+import type { Vec3Like } from './FieldKernel';
+
+/**
+ * Closed surfaces for Gauss's-law measurements. Meshes are triangle soups
+ * (9 floats per triangle) wound counter-clockwise seen from outside.
+ */
+export type GaussSurface =
+  | { id: string; kind: 'sphere'; center: Vec3Like; radius: number }
+  | { id: string; kind: 'box'; center: Vec3Like; size: Vec3Like }
+  | { id: string; kind: 'mesh'; name: string; triangles: Float32Array };
+
+const SPHERE_DETAIL = 3; // Icosphere subdivision level (1280 triangles)
+
+/**
+ * Outward-wound triangles of a surface (xyz of a, b, c per triangle)
+ */
+export function surfaceTriangles(surface: GaussSurface): Float64Array {
+  if (surface.kind === 'mesh') {
+    return Float64Array.from(surface.triangles);
+  }
+
+  const geometry = surface.kind === 'sphere'
+    ? new THREE.IcosahedronGeometry(surface.radius, SPHERE_DETAIL)
+    : new THREE.BoxGeometry(surface.size.x, surface.size.y, surface.size.z).toNonIndexed();
+  geometry.translate(surface.center.x, surface.center.y, surface.center.z);
+  const triangles = Float64Array.from(geometry.getAttribute('position').array);
+  geometry.dispose();
+  return triangles;
+}
+
+/**
+ * Bounding sphere of a triangle set: centre of the bounding box and the
+ * largest vertex distance from it
+ */
+export function triangleBounds(triangles: Float64Array): { center: Vec3Like; radius: number } {
+  const min = [Infinity, Infinity, Infinity];
+  const max = [-Infinity, -Infinity, -Infinity];
+  for (let i = 0; i < triangles.length; i += 3) {
+    for (let axis = 0; axis < 3; axis++) {
+      min[axis] = Math.min(min[axis], triangles[i + axis]);
+      max[axis] = Math.max(max[axis], triangles[i + axis]);
+    }
+  }
+  const center = { x: (min[0] + max[0]) / 2, y: (min[1] + max[1]) / 2, z: (min[2] + max[2]) / 2 };
+  let radius = 0;
+  for (let i = 0; i < triangles.length; i += 3) {
+    radius = Math.max(
+      radius,
+      Math.hypot(triangles[i] - center.x, triangles[i + 1] - center.y, triangles[i + 2] - center.z)
+    );
+  }
+  return { center, radius };
+}
+
+/**
+ * Generalized winding number of a closed surface around a point: 1 inside, 0
+ * outside, 1/2 on the surface. Sums signed solid angles (Van Oosterom–Strackee),
+ * so it also works for meshes that are not convex.
+ */
+export function windingNumber(triangles: Float64Array, px: number, py: number, pz: number): number {
+  let solidAngle = 0;
+  for (let t = 0; t < triangles.length; t += 9) {
+    const ax = triangles[t] - px;
+    const ay = triangles[t + 1] - py;
+    const az = triangles[t + 2] - pz;
+    const bx = triangles[t + 3] - px;
+    const by = triangles[t + 4] - py;
+    const bz = triangles[t + 5] - pz;
+    const cx = triangles[t + 6] - px;
+    const cy = triangles[t + 7] - py;
+    const cz = triangles[t + 8] - pz;
+    const a = Math.sqrt(ax * ax + ay * ay + az * az);
+    const b = Math.sqrt(bx * bx + by * by + bz * bz);
+    const c = Math.sqrt(cx * cx + cy * cy + cz * cz);
+    const determinant = ax * (by * cz - bz * cy) - ay * (bx * cz - bz * cx) + az * (bx * cy - by * cx);
+    const denominator =
+      a * b * c + (ax * bx + ay * by + az * bz) * c + (ax * cx + ay * cy + az * cz) * b + (bx * cx + by * cy + bz * cz) * a;
+    solidAngle += 2 * Math.atan2(determinant, denominator);
+  }
+  return solidAngle / (4 * Math.PI);
+}
+
+/**
+ * Triangles of a Wavefront OBJ file (v and f records; polygons are fanned,
+ * negative indices count from the end)
+ */
+export function parseObjTriangles(text: string): Float32Array {
+  const vertices: number[] = [];
+  const triangles: number[] = [];
+
+  for (const rawLine of text.split('\n')) {
+    const parts = rawLine.trim().split(/\s+/);
+    if (parts[0] === 'v') {
+      vertices.push(parseFloat(parts[1]), parseFloat(parts[2]), parseFloat(parts[3]));
+    } else if (parts[0] === 'f') {
+      const indices = parts.slice(1).map((part) => {
+        const index = parseInt(part.split('/')[0], 10);
+        return index < 0 ? vertices.length / 3 + index : index - 1;
+      });
+      for (let i = 1; i + 1 < indices.length; i++) {
+        for (const index of [indices[0], indices[i], indices[i + 1]]) {
+          triangles.push(vertices[index * 3], vertices[index * 3 + 1], vertices[index * 3 + 2]);
+        }
+      }
+    }
+  }
+
+  if (triangles.length === 0) {
+    throw new Error('No faces found in OBJ file');
+  }
+  return new Float32Array(triangles);
+}
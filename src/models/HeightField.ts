@@ -0,0 +1,175 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+import { sourcesFieldBatch } from './FieldSources';
+import type { FieldSources } from './FieldSources';
+import { slicePlaneBasis } from './PotentialSlice';
+import type { SlicePlane } from './PotentialSlice';
+
+/**
+ * Potential on a plane as heights over a (cells + 1)² vertex grid, split
+ * into square tiles of `tileCells` cells. `cells` must be a multiple of
+ * `tileCells`, and `tileCells` a power of two.
+ */
+export interface HeightFieldSpec {
+  plane: SlicePlane;
+  cells: number;
+  tileCells: number;
+  maxHeight: number; // Heights approach ±maxHeight near charges
+  referencePotential: number; // V at which a height reaches tanh(1) · maxHeight
+  lodTolerance: number; // Largest height error a coarser tessellation may add
+}
+
+export interface HeightTile {
+  tile: number;
+  heights: Float32Array; // (tileCells + 1)² vertices, row-major (j * (tileCells + 1) + i)
+  step: number; // Vertex stride of the tile's tessellation
+}
+
+export function heightFieldTilesPerSide(spec: HeightFieldSpec): number {
+  return spec.cells / spec.tileCells;
+}
+
+/**
+ * Height for a potential: linear for small V and clamped smoothly to
+ * ±maxHeight, so the sheet stays finite at the charges
+ */
+export function heightFromPotential(potential: number, spec: HeightFieldSpec): number {
+  return spec.maxHeight * Math.tanh(potential / spec.referencePotential);
+}
+
+/**
+ * Position on the flat plane of grid vertex (gi, gj)
+ */
+export function heightFieldVertex(spec: HeightFieldSpec, gi: number, gj: number, out: Vec3Like): Vec3Like {
+  const { origin, u, v } = slicePlaneBasis(spec.plane);
+  const a = gi / spec.cells;
+  const b = gj / spec.cells;
+  out.x = origin.x + u.x * a + v.x * b;
+  out.y = origin.y + u.y * a + v.y * b;
+  out.z = origin.z + u.z * a + v.z * b;
+  return out;
+}
+
+/**
+ * Heights of one tile from a single batch-kernel call, plus the coarsest
+ * tessellation step that stays within lodTolerance
+ */
+export function computeHeightTile(sources: FieldSources, spec: HeightFieldSpec, tile: number): HeightTile {
+  const tiles = heightFieldTilesPerSide(spec);
+  const n = spec.tileCells + 1;
+  const i0 = (tile % tiles) * spec.tileCells;
+  const j0 = Math.floor(tile / tiles) * spec.tileCells;
+  const points = new Float64Array(n * n * 3);
+  const vertex = { x: 0, y: 0, z: 0 };
+  for (let j = 0; j < n; j++) {
+    for (let i = 0; i < n; i++) {
+      heightFieldVertex(spec, i0 + i, j0 + j, vertex);
+      const offset = (j * n + i) * 3;
+      points[offset] = vertex.x;
+      points[offset + 1] = vertex.y;
+      points[offset + 2] = vertex.z;
+    }
+  }
+  const field = new Float64Array(n * n * 3);
+  const potential = new Float64Array(n * n);
+  sourcesFieldBatch(sources, points, field, potential);
+  const heights = new Float32Array(n * n);
+  for (let k = 0; k < heights.length; k++) heights[k] = heightFromPotential(potential[k], spec);
+  return { tile, heights, step: tessellationStep(heights, n, spec.lodTolerance) };
+}
+
+/**
+ * Largest power-of-two step whose triangles (split along the (0,0)-(1,1)
+ * diagonal of each cell) reproduce every skipped vertex within `tolerance`.
+ * Flat regions get a handful of triangles; steep wells near charges keep
+ * full resolution.
+ */
+export function tessellationStep(heights: Float32Array, n: number, tolerance: number): number {
+  for (let step = n - 1; step > 1; step /= 2) {
+    if (tessellationError(heights, n, step) <= tolerance) return step;
+  }
+  return 1;
+}
+
+function tessellationError(heights: Float32Array, n: number, step: number): number {
+  let error = 0;
+  for (let cj = 0; cj < n - 1; cj += step) {
+    for (let ci = 0; ci < n - 1; ci += step) {
+      const h00 = heights[cj * n + ci];
+      const h10 = heights[cj * n + ci + step];
+      const h01 = heights[(cj + step) * n + ci];
+      const h11 = heights[(cj + step) * n + ci + step];
+      for (let y = 0; y <= step; y++) {
+        for (let x = 0; x <= step; x++) {
+          const a = x / step;
+          const b = y / step;
+          const planar = a >= b ? h00 + (h10 - h00) * a + (h11 - h10) * b : h00 + (h11 - h01) * a + (h01 - h00) * b;
+          error = Math.max(error, Math.abs(heights[(cj + y) * n + ci + x] - planar));
+        }
+      }
+    }
+  }
+  return error;
+}
+
+/**
+ * Distance from a point to a tile's rectangle on the flat plane
+ */
+export function tileDistance(spec: HeightFieldSpec, tile: number, point: Vec3Like): number {
+  const tiles = heightFieldTilesPerSide(spec);
+  const corner = heightFieldVertex(spec, (tile % tiles) * spec.tileCells, Math.floor(tile / tiles) * spec.tileCells, {
+    x: 0,
+    y: 0,
+    z: 0,
+  });
+  const { u, v } = slicePlaneBasis(spec.plane);
+  const fraction = spec.tileCells / spec.cells;
+  const dx = point.x - corner.x;
+  const dy = point.y - corner.y;
+  const dz = point.z - corner.z;
+  const a = Math.min(Math.max((dx * u.x + dy * u.y + dz * u.z) / ((u.x * u.x + u.y * u.y + u.z * u.z) * fraction), 0), 1);
+  const b = Math.min(Math.max((dx * v.x + dy * v.y + dz * v.z) / ((v.x * v.x + v.y * v.y + v.z * v.z) * fraction), 0), 1);
+  return Math.hypot(
+    dx - (u.x * a + v.x * b) * fraction,
+    dy - (u.y * a + v.y * b) * fraction,
+    dz - (u.z * a + v.z * b) * fraction
+  );
+}
+
+/**
+ * Upper bound on how far any height in a tile moves between two charge
+ * sets. Only charges that changed contribute: each adds at most
+ * K|q| / d for its old and its new state, d being its distance to the tile,
+ * and the height map's slope never exceeds maxHeight / referencePotential.
+ * Returns Infinity when charges were added or removed.
+ */
+export function tileHeightChangeBound(
+  spec: HeightFieldSpec,
+  tile: number,
+  before: PackedCharges,
+  after: PackedCharges
+): number {
+  if (before.count !== after.count) return Infinity;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+  const position = { x: 0, y: 0, z: 0 };
+  let bound = 0;
+  for (let i = 0; i < after.count; i++) {
+    const o = i * 3;
+    if (
+      before.magnitudes[i] === after.magnitudes[i] &&
+      before.positions[o] === after.positions[o] &&
+      before.positions[o + 1] === after.positions[o + 1] &&
+      before.positions[o + 2] === after.positions[o + 2]
+    ) {
+      continue;
+    }
+    for (const charges of [before, after]) {
+      position.x = charges.positions[o];
+      position.y = charges.positions[o + 1];
+      position.z = charges.positions[o + 2];
+      const distance = Math.max(tileDistance(spec, tile, position), softening);
+      bound += (PHYSICS_CONSTANTS.K * Math.abs(charges.magnitudes[i])) / distance;
+    }
+  }
+  return (bound * spec.maxHeight) / spec.referencePotential;
+}
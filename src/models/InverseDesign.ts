@@ -0,0 +1,251 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+
+/**
+ * A probe whose potential should equal `target` (V). `background` is the
+ * potential there from sources the designer does not set, such as a loaded
+ * dataset; the charges only have to make up the difference.
+ */
+export interface InverseProbe {
+  id: string;
+  position: Vec3Like;
+  target: number;
+  background?: number; // V
+}
+
+export interface InverseDesignOptions {
+  regularization: number; // Tikhonov weight relative to the mean diagonal of AᵀA
+  minMagnitude: number | null; // Lower bound on every magnitude (C), or none
+  maxMagnitude: number | null; // Upper bound (C), or none
+}
+
+export interface InverseDesignResult {
+  magnitudes: Float64Array; // Solved charge magnitudes (C), in charge order
+  achieved: Record<string, number>; // Potential at each probe with those magnitudes, background included, by probe id
+  rmsError: number; // RMS of achieved - target over the probes (V)
+  activeBounds: number; // Magnitudes held at a bound
+}
+
+/**
+ * Charge magnitudes that best reproduce target probe potentials. V is linear
+ * in the magnitudes, V_p = Σ_k A_pk q_k, so this is a bounded, Tikhonov-
+ * regularised least-squares problem. The normal equations AᵀA and Aᵀv are kept
+ * as running sums of per-probe rank-one terms: adding, removing or retargeting
+ * a probe costs O(N²) for N charges instead of rebuilding from every probe.
+ */
+export class InverseDesigner {
+  private positions: Float64Array; // x, y, z per charge
+  private n: number;
+  // `target` here is the probe's target less its background
+  private rows = new Map<string, { row: Float64Array; target: number; background: number; position: Vec3Like }>();
+  private normal: Float64Array; // AᵀA, n×n row-major
+  private rhs: Float64Array; // Aᵀv
+
+  /**
+   * `charges` fixes the positions; the magnitudes in it are ignored
+   */
+  constructor(charges: PackedCharges) {
+    this.n = charges.count;
+    this.positions = charges.positions;
+    this.normal = new Float64Array(this.n * this.n);
+    this.rhs = new Float64Array(this.n);
+  }
+
+  public get probeCount(): number {
+    return this.rows.size;
+  }
+
+  /**
+   * Potential at `position` per coulomb on each charge, K / max(d, softening)
+   * as in electricFieldBatch
+   */
+  private influenceRow(position: Vec3Like): Float64Array {
+    const K = PHYSICS_CONSTANTS.K;
+    const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+    const positions = this.positions;
+    const row = new Float64Array(this.n);
+    for (let k = 0; k < this.n; k++) {
+      const dx = position.x - positions[k * 3];
+      const dy = position.y - positions[k * 3 + 1];
+      const dz = position.z - positions[k * 3 + 2];
+      const distance = Math.sqrt(dx * dx + dy * dy + dz * dz);
+      row[k] = K / (distance > softening ? distance : softening);
+    }
+    return row;
+  }
+
+  private accumulate(row: Float64Array, target: number, sign: 1 | -1) {
+    const n = this.n;
+    for (let i = 0; i < n; i++) {
+      this.rhs[i] += sign * row[i] * target;
+      for (let j = 0; j < n; j++) this.normal[i * n + j] += sign * row[i] * row[j];
+    }
+  }
+
+  /**
+   * Bring the normal equations in line with `probes`: new probes are added,
+   * missing ones subtracted, and retargeted ones (or ones whose background
+   * changed) only touch Aᵀv. Probes are matched by id; a probe that moved is
+   * treated as removed and re-added.
+   */
+  public syncProbes(probes: InverseProbe[]) {
+    const seen = new Set<string>();
+    for (const probe of probes) {
+      seen.add(probe.id);
+      const background = probe.background ?? 0;
+      const target = probe.target - background;
+      let existing = this.rows.get(probe.id);
+      const { x, y, z } = probe.position;
+      if (existing && (existing.position.x !== x || existing.position.y !== y || existing.position.z !== z)) {
+        this.accumulate(existing.row, existing.target, -1);
+        this.rows.delete(probe.id);
+        existing = undefined;
+      }
+      if (existing) {
+        existing.background = background;
+        if (existing.target === target) continue;
+        for (let i = 0; i < this.n; i++) this.rhs[i] += existing.row[i] * (target - existing.target);
+        existing.target = target;
+        continue;
+      }
+      const row = this.influenceRow(probe.position);
+      this.accumulate(row, target, 1);
+      this.rows.set(probe.id, { row, target, background, position: { x, y, z } });
+    }
+    for (const [id, entry] of Array.from(this.rows)) {
+      if (seen.has(id)) continue;
+      this.accumulate(entry.row, entry.target, -1);
+      this.rows.delete(id);
+    }
+  }
+
+  /**
+   * Solve with the current probes. Bounds are handled by an active-set loop:
+   * violated magnitudes are pinned to their bound and the rest re-solved,
+   * and pinned ones are released when the gradient says they want to move
+   * back inside.
+   */
+  public solve(options: InverseDesignOptions = createDefaultInverseDesignOptions()): InverseDesignResult {
+    const n = this.n;
+    let trace = 0;
+    for (let i = 0; i < n; i++) trace += this.normal[i * n + i];
+    const lambda = n > 0 ? (options.regularization * trace) / n : 0;
+    const lower = options.minMagnitude ?? -Infinity;
+    const upper = options.maxMagnitude ?? Infinity;
+
+    // Regularised normal matrix H = AᵀA + λI; the objective's gradient is Hq - Aᵀv
+    const hessian = Float64Array.from(this.normal);
+    for (let i = 0; i < n; i++) hessian[i * n + i] += lambda;
+
+    const pinned = new Float64Array(n).fill(NaN); // Bound value for pinned magnitudes
+    let magnitudes = new Float64Array(n);
+    for (let round = 0; round < 2 * n + 2; round++) {
+      magnitudes = this.solveFree(hessian, pinned);
+
+      let changed = false;
+      for (let i = 0; i < n; i++) {
+        if (!Number.isNaN(pinned[i])) continue;
+        if (magnitudes[i] < lower) {
+          pinned[i] = lower;
+          changed = true;
+        } else if (magnitudes[i] > upper) {
+          pinned[i] = upper;
+          changed = true;
+        }
+      }
+      if (changed) continue;
+
+      // Release pinned magnitudes whose gradient points into the feasible range
+      for (let i = 0; i < n; i++) {
+        if (Number.isNaN(pinned[i])) continue;
+        let gradient = -this.rhs[i];
+        for (let j = 0; j < n; j++) gradient += hessian[i * n + j] * magnitudes[j];
+        if ((pinned[i] === lower && gradient < 0) || (pinned[i] === upper && gradient > 0)) {
+          pinned[i] = NaN;
+          changed = true;
+        }
+      }
+      if (!changed) break;
+    }
+
+    const achieved: Record<string, number> = {};
+    let squaredError = 0;
+    for (const [id, { row, target, background }] of this.rows) {
+      let value = 0;
+      for (let k = 0; k < n; k++) value += row[k] * magnitudes[k];
+      achieved[id] = value + background;
+      squaredError += (value - target) ** 2;
+    }
+    let activeBounds = 0;
+    for (let i = 0; i < n; i++) if (!Number.isNaN(pinned[i])) activeBounds++;
+
+    return {
+      magnitudes,
+      achieved,
+      rmsError: this.rows.size > 0 ? Math.sqrt(squaredError / this.rows.size) : 0,
+      activeBounds,
+    };
+  }
+
+  /**
+   * Minimise over the unpinned magnitudes with the pinned ones fixed, by
+   * Cholesky on the free block of H
+   */
+  private solveFree(hessian: Float64Array, pinned: Float64Array): Float64Array {
+    const n = this.n;
+    const free: number[] = [];
+    const q = new Float64Array(n);
+    for (let i = 0; i < n; i++) {
+      if (Number.isNaN(pinned[i])) free.push(i);
+      else q[i] = pinned[i];
+    }
+
+    const m = free.length;
+    const block = new Float64Array(m * m);
+    const b = new Float64Array(m);
+    for (let a = 0; a < m; a++) {
+      const i = free[a];
+      b[a] = this.rhs[i];
+      for (let j = 0; j < n; j++) {
+        if (!Number.isNaN(pinned[j])) b[a] -= hessian[i * n + j] * q[j];
+      }
+      for (let c = 0; c < m; c++) block[a * m + c] = hessian[i * n + free[c]];
+    }
+
+    // In-place Cholesky (lower triangle), then forward and back substitution
+    for (let j = 0; j < m; j++) {
+      let diagonal = block[j * m + j];
+      for (let k = 0; k < j; k++) diagonal -= block[j * m + k] * block[j * m + k];
+      diagonal = Math.sqrt(Math.max(diagonal, 1e-300));
+      block[j * m + j] = diagonal;
+      for (let i = j + 1; i < m; i++) {
+        let sum = block[i * m + j];
+        for (let k = 0; k < j; k++) sum -= block[i * m + k] * block[j * m + k];
+        block[i * m + j] = sum / diagonal;
+      }
+    }
+    for (let i = 0; i < m; i++) {
+      let sum = b[i];
+      for (let k = 0; k < i; k++) sum -= block[i * m + k] * b[k];
+      b[i] = sum / block[i * m + i];
+    }
+    for (let i = m - 1; i >= 0; i--) {
+      let sum = b[i];
+      for (let k = i + 1; k < m; k++) sum -= block[k * m + i] * b[k];
+      b[i] = sum / block[i * m + i];
+    }
+
+    free.forEach((i, a) => {
+      q[i] = b[a];
+    });
+    return q;
+  }
+}
+
+export function createDefaultInverseDesignOptions(): InverseDesignOptions {
+  return {
+    regularization: 1e-6,
+    minMagnitude: null,
+    maxMagnitude: null,
+  };
+}
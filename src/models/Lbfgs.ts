@@ -0,0 +1,145 @@
+export interface LbfgsOptions {
+  maxIterations: number;
+  history: number; // Correction pairs kept (m)
+  gradientTolerance: number; // Stop when |g|∞ falls below this
+  valueTolerance: number; // Stop when f improves by less than this (relative)
+  maxStep: number; // Largest change of any variable in one iteration
+}
+
+export interface LbfgsIterate {
+  iteration: number;
+  x: Float64Array;
+  value: number;
+  gradientNorm: number;
+}
+
+export type LbfgsStopReason = 'converged' | 'stalled' | 'max-iterations' | 'cancelled';
+
+/**
+ * f and its gradient at x; writes the gradient into `gradient` and returns f
+ */
+export type ObjectiveWithGradient = (x: Float64Array, gradient: Float64Array) => number;
+
+function dot(a: Float64Array, b: Float64Array): number {
+  let sum = 0;
+  for (let i = 0; i < a.length; i++) sum += a[i] * b[i];
+  return sum;
+}
+
+function maxAbs(a: Float64Array): number {
+  let max = 0;
+  for (let i = 0; i < a.length; i++) max = Math.max(max, Math.abs(a[i]));
+  return max;
+}
+
+/**
+ * Limited-memory BFGS with a backtracking (Armijo) line search. The search
+ * direction comes from the standard two-loop recursion over the last `history`
+ * step/gradient-change pairs; pairs with non-positive curvature are skipped so
+ * the implied Hessian stays positive definite. `onIterate` sees every accepted
+ * iterate and can return false to stop early.
+ */
+export function minimizeLbfgs(
+  objective: ObjectiveWithGradient,
+  x0: Float64Array,
+  options: LbfgsOptions = createDefaultLbfgsOptions(),
+  onIterate: (iterate: LbfgsIterate) => boolean = () => true
+): { x: Float64Array; value: number; iterations: number; reason: LbfgsStopReason } {
+  const n = x0.length;
+  const x = Float64Array.from(x0);
+  const gradient = new Float64Array(n);
+  let value = objective(x, gradient);
+
+  const steps: Float64Array[] = [];
+  const changes: Float64Array[] = [];
+  const inverseCurvatures: number[] = [];
+  const direction = new Float64Array(n);
+  const trial = new Float64Array(n);
+  const trialGradient = new Float64Array(n);
+  const alphas = new Float64Array(options.history);
+
+  for (let iteration = 1; iteration <= options.maxIterations; iteration++) {
+    if (maxAbs(gradient) < options.gradientTolerance) {
+      return { x, value, iterations: iteration - 1, reason: 'converged' };
+    }
+
+    // Two-loop recursion: direction = -H g
+    for (let i = 0; i < n; i++) direction[i] = -gradient[i];
+    for (let k = steps.length - 1; k >= 0; k--) {
+      alphas[k] = inverseCurvatures[k] * dot(steps[k], direction);
+      for (let i = 0; i < n; i++) direction[i] -= alphas[k] * changes[k][i];
+    }
+    if (steps.length > 0) {
+      const last = steps.length - 1;
+      const gamma = dot(steps[last], changes[last]) / dot(changes[last], changes[last]);
+      for (let i = 0; i < n; i++) direction[i] *= gamma;
+    }
+    for (let k = 0; k < steps.length; k++) {
+      const beta = inverseCurvatures[k] * dot(changes[k], direction);
+      for (let i = 0; i < n; i++) direction[i] += (alphas[k] - beta) * steps[k][i];
+    }
+
+    let slope = dot(direction, gradient);
+    if (!(slope < 0)) {
+      // Lost descent (e.g. after skipped pairs): restart from steepest descent
+      steps.length = changes.length = inverseCurvatures.length = 0;
+      for (let i = 0; i < n; i++) direction[i] = -gradient[i];
+      slope = dot(direction, gradient);
+    }
+
+    // Cap the step so no variable moves further than maxStep
+    let step = Math.min(1, options.maxStep / Math.max(maxAbs(direction), 1e-300));
+    let trialValue = Infinity;
+    for (let backtrack = 0; backtrack < 30; backtrack++) {
+      for (let i = 0; i < n; i++) trial[i] = x[i] + step * direction[i];
+      trialValue = objective(trial, trialGradient);
+      if (trialValue <= value + 1e-4 * step * slope) break;
+      step *= 0.5;
+    }
+    if (!(trialValue < value)) {
+      return { x, value, iterations: iteration - 1, reason: 'stalled' };
+    }
+
+    const s = new Float64Array(n);
+    const y = new Float64Array(n);
+    for (let i = 0; i < n; i++) {
+      s[i] = trial[i] - x[i];
+      y[i] = trialGradient[i] - gradient[i];
+    }
+    const curvature = dot(s, y);
+    if (curvature > 1e-12 * Math.sqrt(dot(s, s) * dot(y, y))) {
+      steps.push(s);
+      changes.push(y);
+      inverseCurvatures.push(1 / curvature);
+      if (steps.length > options.history) {
+        steps.shift();
+        changes.shift();
+        inverseCurvatures.shift();
+      }
+    }
+
+    const improvement = value - trialValue;
+    x.set(trial);
+    gradient.set(trialGradient);
+    value = trialValue;
+
+    if (!onIterate({ iteration, x: Float64Array.from(x), value, gradientNorm: maxAbs(gradient) })) {
+      return { x, value, iterations: iteration, reason: 'cancelled' };
+    }
+    if (improvement <= options.valueTolerance * Math.max(Math.abs(value), 1e-12)) {
+      return { x, value, iterations: iteration, reason: 'converged' };
+    }
+  }
+
+  return { x, value, iterations: options.maxIterations, reason: 'max-iterations' };
+}
+
+export function createDefaultLbfgsOptions(): LbfgsOptions {
+  return {
+    maxIterations: 200,
+    history: 8,
+    gradientTolerance: 1e-9,
+    valueTolerance: 1e-10,
+    maxStep: 0.25,
+  };
+}
@@ -0,0 +1,231 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import type { FloatArray, Vec3Like } from './FieldKernel';
+
+/**
+ * Prescribed trajectories. Plain data (no closures) so they can be posted to workers.
+ */
+export type Trajectory =
+  | { kind: 'linear'; start: Vec3Like; velocity: Vec3Like }
+  | { kind: 'circular'; center: Vec3Like; radius: number; angularSpeed: number; phase: number }
+  | { kind: 'oscillating'; center: Vec3Like; amplitude: Vec3Like; angularFrequency: number };
+
+export interface MovingCharge {
+  id: string;
+  magnitude: number; // in Coulombs
+  trajectory: Trajectory;
+}
+
+/**
+ * Position, velocity and acceleration at time t, written to out[0..8]
+ */
+export function trajectoryState(trajectory: Trajectory, t: number, out: FloatArray): void {
+  switch (trajectory.kind) {
+    case 'linear': {
+      const { start, velocity } = trajectory;
+      out[0] = start.x + velocity.x * t;
+      out[1] = start.y + velocity.y * t;
+      out[2] = start.z + velocity.z * t;
+      out[3] = velocity.x;
+      out[4] = velocity.y;
+      out[5] = velocity.z;
+      out[6] = 0;
+      out[7] = 0;
+      out[8] = 0;
+      break;
+    }
+    case 'circular': {
+      // Circle in the horizontal (xz) plane, matching the grid helper
+      const { center, radius, angularSpeed, phase } = trajectory;
+      const angle = angularSpeed * t + phase;
+      const cos = Math.cos(angle);
+      const sin = Math.sin(angle);
+      out[0] = center.x + radius * cos;
+      out[1] = center.y;
+      out[2] = center.z + radius * sin;
+      out[3] = -radius * angularSpeed * sin;
+      out[4] = 0;
+      out[5] = radius * angularSpeed * cos;
+      out[6] = -radius * angularSpeed * angularSpeed * cos;
+      out[7] = 0;
+      out[8] = -radius * angularSpeed * angularSpeed * sin;
+      break;
+    }
+    case 'oscillating': {
+      const { center, amplitude, angularFrequency } = trajectory;
+      const sin = Math.sin(angularFrequency * t);
+      const cos = Math.cos(angularFrequency * t);
+      const w2 = angularFrequency * angularFrequency;
+      out[0] = center.x + amplitude.x * sin;
+      out[1] = center.y + amplitude.y * sin;
+      out[2] = center.z + amplitude.z * sin;
+      out[3] = amplitude.x * angularFrequency * cos;
+      out[4] = amplitude.y * angularFrequency * cos;
+      out[5] = amplitude.z * angularFrequency * cos;
+      out[6] = -amplitude.x * w2 * sin;
+      out[7] = -amplitude.y * w2 * sin;
+      out[8] = -amplitude.z * w2 * sin;
+      break;
+    }
+  }
+}
+
+/**
+ * Upper bound on the speed along a trajectory (used to bracket the retarded time)
+ */
+export function maxTrajectorySpeed(trajectory: Trajectory): number {
+  switch (trajectory.kind) {
+    case 'linear':
+      return Math.hypot(trajectory.velocity.x, trajectory.velocity.y, trajectory.velocity.z);
+    case 'circular':
+      return Math.abs(trajectory.radius * trajectory.angularSpeed);
+    case 'oscillating':
+      return (
+        Math.hypot(trajectory.amplitude.x, trajectory.amplitude.y, trajectory.amplitude.z) *
+        Math.abs(trajectory.angularFrequency)
+      );
+  }
+}
+
+/**
+ * The retarded-time solution is unique, and the field finite, only while
+ * the charge stays slower than light for its whole trajectory
+ */
+export function isSubluminal(trajectory: Trajectory, speedOfLight: number): boolean {
+  return maxTrajectorySpeed(trajectory) < speedOfLight;
+}
+
+const MAX_RETARDED_ITERATIONS = 50;
+
+/**
+ * Solve c (t - t_r) = |r - x(t_r)| for the retarded time t_r.
+ *
+ * g(t_r) = c (t - t_r) - |r - x(t_r)| is strictly decreasing for subluminal
+ * motion, g(t) <= 0, and g(t - d / (c - v_max)) >= 0 with d = |r - x(t)|, so the
+ * root is bracketed. Newton steps start from `guess` (the previous frame's
+ * solution) and fall back to bisection whenever they leave the bracket.
+ * `state` receives the trajectory state at the returned time. Requires
+ * maxSpeed < speedOfLight (see isSubluminal).
+ */
+export function solveRetardedTime(
+  trajectory: Trajectory,
+  px: number,
+  py: number,
+  pz: number,
+  t: number,
+  speedOfLight: number,
+  maxSpeed: number,
+  guess: number,
+  state: FloatArray
+): number {
+  trajectoryState(trajectory, t, state);
+  const presentDistance = Math.hypot(px - state[0], py - state[1], pz - state[2]);
+  let hi = t;
+  let lo = t - presentDistance / (speedOfLight - maxSpeed) - 1e-12;
+  const tolerance = 1e-9 * Math.max(1, presentDistance / speedOfLight);
+
+  let tr = guess > lo && guess < hi ? guess : t - presentDistance / speedOfLight;
+  for (let iteration = 0; iteration < MAX_RETARDED_ITERATIONS; iteration++) {
+    trajectoryState(trajectory, tr, state);
+    const rx = px - state[0];
+    const ry = py - state[1];
+    const rz = pz - state[2];
+    const distance = Math.sqrt(rx * rx + ry * ry + rz * rz);
+    const g = speedOfLight * (t - tr) - distance;
+
+    if (g > 0) lo = tr;
+    else hi = tr;
+
+    // g'(t_r) = -c + n̂·v  (strictly negative)
+    const radialSpeed = distance > 0 ? (rx * state[3] + ry * state[4] + rz * state[5]) / distance : 0;
+    const slope = -speedOfLight + radialSpeed;
+    let next = tr - g / slope;
+    if (!(next > lo && next < hi)) {
+      next = 0.5 * (lo + hi);
+    }
+    if (Math.abs(next - tr) < tolerance || hi - lo < tolerance) {
+      tr = next;
+      break;
+    }
+    tr = next;
+  }
+
+  trajectoryState(trajectory, tr, state);
+  return tr;
+}
+
+/**
+ * Liénard–Wiechert electric field of moving charges at many points and time t.
+ *
+ * E = Kq [ (n̂ - β)(1 - β²) / (κ³ R²) + n̂ × ((n̂ - β) × β̇) / (c κ³ R) ],  κ = 1 - n̂·β
+ *
+ * `retardedTimes` (charge-major, one entry per charge/point pair) carries the
+ * previous solutions in and the new ones out, so consecutive frames need only
+ * one or two Newton steps per pair. Charges that reach the speed of light
+ * somewhere on their trajectory have no well-defined field and are skipped.
+ */
+export function lienardWiechertFieldBatch(
+  charges: MovingCharge[],
+  points: FloatArray,
+  t: number,
+  speedOfLight: number,
+  retardedTimes: Float64Array,
+  outField: FloatArray,
+  pointCount: number = points.length / 3
+): void {
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+  const state = new Float64Array(9);
+  outField.fill(0, 0, pointCount * 3);
+
+  charges.forEach((charge, c) => {
+    const maxSpeed = maxTrajectorySpeed(charge.trajectory);
+    if (maxSpeed >= speedOfLight) return;
+    const kq = K * charge.magnitude;
+
+    for (let p = 0; p < pointCount; p++) {
+      const px = points[p * 3];
+      const py = points[p * 3 + 1];
+      const pz = points[p * 3 + 2];
+      const slot = c * pointCount + p;
+      retardedTimes[slot] = solveRetardedTime(
+        charge.trajectory, px, py, pz, t, speedOfLight, maxSpeed, retardedTimes[slot], state
+      );
+
+      const rx = px - state[0];
+      const ry = py - state[1];
+      const rz = pz - state[2];
+      const distance = Math.sqrt(rx * rx + ry * ry + rz * rz);
+      if (distance === 0) continue;
+      const R = distance > softening ? distance : softening;
+      const nx = rx / distance;
+      const ny = ry / distance;
+      const nz = rz / distance;
+      const bx = state[3] / speedOfLight;
+      const by = state[4] / speedOfLight;
+      const bz = state[5] / speedOfLight;
+      const ax = state[6] / speedOfLight;
+      const ay = state[7] / speedOfLight;
+      const az = state[8] / speedOfLight;
+
+      const kappa = 1 - (nx * bx + ny * by + nz * bz);
+      const kappa3 = kappa * kappa * kappa;
+      const beta2 = bx * bx + by * by + bz * bz;
+
+      // Velocity (generalized Coulomb) term
+      const ux = nx - bx;
+      const uy = ny - by;
+      const uz = nz - bz;
+      const velocityScale = (kq * (1 - beta2)) / (kappa3 * R * R);
+
+      // Acceleration (radiation) term: n̂ × (u × β̇)
+      const wx = uy * az - uz * ay;
+      const wy = uz * ax - ux * az;
+      const wz = ux * ay - uy * ax;
+      const radiationScale = kq / (speedOfLight * kappa3 * R);
+
+      outField[p * 3] += velocityScale * ux + radiationScale * (ny * wz - nz * wy);
+      outField[p * 3 + 1] += velocityScale * uy + radiationScale * (nz * wx - nx * wz);
+      outField[p * 3 + 2] += velocityScale * uz + radiationScale * (nx * wy - ny * wx);
+    }
+  });
+}
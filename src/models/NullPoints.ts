@@ -0,0 +1,240 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import { electricFieldGradientBatch } from './FieldKernel';
+import type { FloatArray, PackedCharges, Vec3Like } from './FieldKernel';
+import type { LatticeBounds } from './FieldLattice';
+
+export interface NullPoint {
+  position: Vec3Like;
+  // Sign of det ∇E. Outside charges ∇E is symmetric and traceless, so a null
+  // always has mixed eigenvalues: det > 0 means one outgoing and two incoming
+  // directions, det < 0 two outgoing and one incoming.
+  determinantSign: 1 | -1;
+  residual: number; // |E| at the returned position
+}
+
+export interface NullPointSearchOptions {
+  bounds: LatticeBounds;
+  minBoxSize: number; // Boxes smaller than this become Newton starting points
+  maxBoxes: number; // Safety cap on boxes examined per scan
+  newtonIterations: number;
+  relativeTolerance: number; // Accept when |E| < tolerance × K Σ|q| / (bounds diagonal)²
+  mergeDistance: number; // Nulls closer than this are the same null
+}
+
+/**
+ * Range of each E component over a box, by interval arithmetic per charge.
+ * Returns false when some component cannot vanish anywhere in the box.
+ */
+function boxMayContainNull(packed: PackedCharges, min: number[], max: number[]): boolean {
+  const { count, positions, magnitudes } = packed;
+  const K = PHYSICS_CONSTANTS.K;
+  const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+  const low = [0, 0, 0];
+  const high = [0, 0, 0];
+
+  for (let i = 0; i < count; i++) {
+    const kq = K * magnitudes[i];
+    const rMin = [0, 0, 0];
+    const rMax = [0, 0, 0];
+    let nearest = 0;
+    let farthest = 0;
+    for (let a = 0; a < 3; a++) {
+      rMin[a] = min[a] - positions[i * 3 + a];
+      rMax[a] = max[a] - positions[i * 3 + a];
+      const closest = rMin[a] > 0 ? rMin[a] : rMax[a] < 0 ? rMax[a] : 0;
+      nearest += closest * closest;
+      farthest += Math.max(rMin[a] * rMin[a], rMax[a] * rMax[a]);
+    }
+    const dMin = Math.max(Math.sqrt(nearest), softening);
+    const dMax = Math.max(Math.sqrt(farthest), softening);
+    const bound = Math.abs(kq) / (dMin * dMin); // |E_i| ≤ K|q| / d_min²
+
+    for (let a = 0; a < 3; a++) {
+      let lo = -bound;
+      let hi = bound;
+      if (Math.sqrt(nearest) > softening) {
+        // r_a × [1/d_max³, 1/d_min³], then scaled by kq
+        const u = 1 / (dMax * dMax * dMax);
+        const v = 1 / (dMin * dMin * dMin);
+        const p0 = Math.min(rMin[a] * u, rMin[a] * v);
+        const p1 = Math.max(rMax[a] * u, rMax[a] * v);
+        lo = kq >= 0 ? kq * p0 : kq * p1;
+        hi = kq >= 0 ? kq * p1 : kq * p0;
+      }
+      low[a] += lo;
+      high[a] += hi;
+    }
+  }
+
+  return low[0] <= 0 && high[0] >= 0 && low[1] <= 0 && high[1] >= 0 && low[2] <= 0 && high[2] >= 0;
+}
+
+/**
+ * Newton's method on E(x) = 0 with step halving; null if it fails to converge.
+ * Each trial point gets E and its Jacobian from one gradient-kernel pass.
+ */
+function newtonRefine(
+  packed: PackedCharges,
+  start: Vec3Like,
+  options: NullPointSearchOptions,
+  tolerance: number
+): NullPoint | null {
+  const point = new Float64Array(3);
+  const field = new Float64Array(3);
+  const jacobian = new Float64Array(9);
+  const trialField = new Float64Array(3);
+  const fieldAndJacobian = (px: number, py: number, pz: number, outField: FloatArray) => {
+    point[0] = px;
+    point[1] = py;
+    point[2] = pz;
+    electricFieldGradientBatch(packed, point, outField, jacobian, null, 1);
+  };
+  const { min, max } = options.bounds;
+  let x = start.x;
+  let y = start.y;
+  let z = start.z;
+
+  fieldAndJacobian(x, y, z, field);
+  let residual = Math.hypot(field[0], field[1], field[2]);
+
+  for (let iteration = 0; iteration < options.newtonIterations && residual > tolerance; iteration++) {
+    const step = solve3(jacobian, field);
+    if (!step) return null;
+
+    let scale = 1;
+    let accepted = false;
+    for (let halving = 0; halving < 8; halving++) {
+      const nx = x - step[0] * scale;
+      const ny = y - step[1] * scale;
+      const nz = z - step[2] * scale;
+      fieldAndJacobian(nx, ny, nz, trialField);
+      const trialResidual = Math.hypot(trialField[0], trialField[1], trialField[2]);
+      if (trialResidual < residual) {
+        x = nx;
+        y = ny;
+        z = nz;
+        field.set(trialField);
+        residual = trialResidual;
+        accepted = true;
+        break;
+      }
+      scale *= 0.5;
+    }
+    if (!accepted) return null;
+  }
+
+  if (residual > tolerance) return null;
+  if (x < min.x || x > max.x || y < min.y || y > max.y || z < min.z || z > max.z) return null;
+
+  // The softened field also vanishes at each charge; those are not nulls
+  const { count, positions } = packed;
+  for (let i = 0; i < count; i++) {
+    const d = Math.hypot(x - positions[i * 3], y - positions[i * 3 + 1], z - positions[i * 3 + 2]);
+    if (d < 1.5 * PHYSICS_CONSTANTS.SOFTENING_FACTOR) return null;
+  }
+
+  fieldAndJacobian(x, y, z, field);
+  const determinant = det3(jacobian);
+  return { position: { x, y, z }, determinantSign: determinant >= 0 ? 1 : -1, residual };
+}
+
+function det3(m: FloatArray): number {
+  return (
+    m[0] * (m[4] * m[8] - m[5] * m[7]) -
+    m[1] * (m[3] * m[8] - m[5] * m[6]) +
+    m[2] * (m[3] * m[7] - m[4] * m[6])
+  );
+}
+
+/**
+ * Solve m x = b for a 3×3 matrix by Cramer's rule; null when singular
+ */
+function solve3(m: FloatArray, b: FloatArray): number[] | null {
+  const determinant = det3(m);
+  const scale = Math.abs(m[0]) + Math.abs(m[4]) + Math.abs(m[8]);
+  if (!(Math.abs(determinant) > 1e-14 * scale * scale * scale)) return null;
+  const inverse = 1 / determinant;
+  return [
+    inverse * (b[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (b[1] * m[8] - m[5] * b[2]) + m[2] * (b[1] * m[7] - m[4] * b[2])),
+    inverse * (m[0] * (b[1] * m[8] - m[5] * b[2]) - b[0] * (m[3] * m[8] - m[5] * m[6]) + m[2] * (m[3] * b[2] - b[1] * m[6])),
+    inverse * (m[0] * (m[4] * b[2] - b[1] * m[7]) - m[1] * (m[3] * b[2] - b[1] * m[6]) + b[0] * (m[3] * m[7] - m[4] * m[6])),
+  ];
+}
+
+/**
+ * Find every null of E inside the bounds. Boxes are subdivided breadth-first
+ * and discarded as soon as interval bounds show some component of E cannot
+ * vanish in them; the surviving small boxes seed Newton iterations. `seeds`
+ * (typically the previous scan's nulls) are refined first, so nulls that
+ * moved slightly with an edited charge are found again in a few iterations.
+ */
+export function findNullPoints(
+  packed: PackedCharges,
+  options: NullPointSearchOptions = createDefaultNullPointSearchOptions(),
+  seeds: Vec3Like[] = []
+): NullPoint[] {
+  if (packed.count < 2) return [];
+
+  const { min, max } = options.bounds;
+  const diagonal2 = (max.x - min.x) ** 2 + (max.y - min.y) ** 2 + (max.z - min.z) ** 2;
+  let chargeSum = 0;
+  for (let i = 0; i < packed.count; i++) chargeSum += Math.abs(packed.magnitudes[i]);
+  const tolerance = (options.relativeTolerance * PHYSICS_CONSTANTS.K * chargeSum) / diagonal2;
+
+  const nulls: NullPoint[] = [];
+  const addNull = (candidate: NullPoint | null) => {
+    if (!candidate) return;
+    const { x, y, z } = candidate.position;
+    const duplicate = nulls.some(
+      (existing) =>
+        Math.hypot(existing.position.x - x, existing.position.y - y, existing.position.z - z) <
+        options.mergeDistance
+    );
+    if (!duplicate) nulls.push(candidate);
+  };
+
+  for (const seed of seeds) addNull(newtonRefine(packed, seed, options, tolerance));
+
+  let boxes: number[][] = [[min.x, min.y, min.z, max.x, max.y, max.z]];
+  let examined = 0;
+  while (boxes.length > 0 && examined < options.maxBoxes) {
+    const next: number[][] = [];
+    for (const box of boxes) {
+      examined++;
+      const boxMin = box.slice(0, 3);
+      const boxMax = box.slice(3, 6);
+      if (!boxMayContainNull(packed, boxMin, boxMax)) continue;
+
+      const size = Math.max(boxMax[0] - boxMin[0], boxMax[1] - boxMin[1], boxMax[2] - boxMin[2]);
+      const center = [0, 1, 2].map((a) => 0.5 * (boxMin[a] + boxMax[a]));
+      if (size <= options.minBoxSize) {
+        addNull(newtonRefine(packed, { x: center[0], y: center[1], z: center[2] }, options, tolerance));
+        continue;
+      }
+
+      for (let octant = 0; octant < 8; octant++) {
+        const child = [0, 0, 0, 0, 0, 0];
+        for (let a = 0; a < 3; a++) {
+          const upper = (octant >> a) & 1;
+          child[a] = upper ? center[a] : boxMin[a];
+          child[a + 3] = upper ? boxMax[a] : center[a];
+        }
+        next.push(child);
+      }
+    }
+    boxes = next;
+  }
+
+  return nulls;
+}
+
+export function createDefaultNullPointSearchOptions(): NullPointSearchOptions {
+  return {
+    bounds: { min: { x: -5, y: -5, z: -5 }, max: { x: 5, y: 5, z: 5 } },
+    minBoxSize: 0.3,
+    maxBoxes: 200000,
+    newtonIterations: 30,
+    relativeTolerance: 1e-9,
+    mergeDistance: 0.05,
+  };
+}
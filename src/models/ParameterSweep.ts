@@ -0,0 +1,338 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import { electricFieldBatch } from './FieldKernel';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+import { createDefaultGaussFluxOptions, unitChargeFlux } from './GaussFlux';
+import { surfaceTriangles, triangleBounds } from './GaussSurface';
+import type { GaussSurface } from './GaussSurface';
+import type { KeyframeCharge } from './Timeline';
+
+/**
+ * A scene parameter that a sweep can vary
+ */
+export type SweepParameter =
+  | { kind: 'magnitude'; chargeId: string } // Charge magnitude (C)
+  | { kind: 'separation'; chargeId: string; anchorId: string } // Distance from the anchor charge (m), along their current direction
+  | { kind: 'coordinate'; chargeId: string; axis: 'x' | 'y' | 'z' }; // One position coordinate (m)
+
+export interface SweepAxis {
+  parameter: SweepParameter;
+  from: number;
+  to: number;
+  steps: number; // Values from `from` to `to` inclusive
+}
+
+/**
+ * Plain-data sweep description, so it can be posted to workers and read by
+ * the Node CLI
+ */
+export interface SweepSpec {
+  charges: KeyframeCharge[];
+  probes: { id: string; position: Vec3Like }[];
+  surfaces: GaussSurface[];
+  axes: SweepAxis[]; // One or two
+}
+
+export interface SweepResult {
+  axisValues: number[][]; // Parameter values per axis
+  axisLabels: string[]; // e.g. q(charge-1), d(charge-1,charge-2)
+  metrics: string[]; // Column names: V(probe), Phi(surface), U
+  values: Float64Array; // Row-major [configuration][metric]; axis 0 varies slowest
+}
+
+export function sweepAxisValues(axis: SweepAxis): number[] {
+  const steps = Math.max(axis.steps, 1);
+  if (steps === 1) return [axis.from];
+  return Array.from({ length: steps }, (_, i) => axis.from + ((axis.to - axis.from) * i) / (steps - 1));
+}
+
+export function sweepConfigurationCount(spec: SweepSpec): number {
+  return spec.axes.reduce((count, axis) => count * Math.max(axis.steps, 1), 1);
+}
+
+export function sweepMetricNames(spec: SweepSpec): string[] {
+  return [
+    ...spec.probes.map((probe) => `V(${probe.id})`),
+    ...spec.surfaces.map((surface) => `Phi(${surface.id})`),
+    'U',
+  ];
+}
+
+const isGeometric = (parameter: SweepParameter) => parameter.kind !== 'magnitude';
+
+/**
+ * Evaluation order of the configurations: geometric axes vary slowest, so
+ * consecutive configurations share positions and the evaluator only
+ * recomputes influence columns when a charge actually moves. Returns
+ * configuration indices in the result's row-major layout.
+ */
+export function sweepEvaluationOrder(spec: SweepSpec): Uint32Array {
+  const sizes = spec.axes.map((axis) => Math.max(axis.steps, 1));
+  const axisOrder = spec.axes
+    .map((axis, index) => ({ index, geometric: isGeometric(axis.parameter) }))
+    .sort((a, b) => Number(b.geometric) - Number(a.geometric) || a.index - b.index)
+    .map((entry) => entry.index);
+  const strides = sizes.map((_, i) => sizes.slice(i + 1).reduce((product, size) => product * size, 1));
+
+  const total = sweepConfigurationCount(spec);
+  const order = new Uint32Array(total);
+  const counters = new Array(sizes.length).fill(0);
+  for (let n = 0; n < total; n++) {
+    let index = 0;
+    for (let a = 0; a < sizes.length; a++) index += counters[a] * strides[a];
+    order[n] = index;
+    // Odometer over axisOrder, last entry fastest
+    for (let k = axisOrder.length - 1; k >= 0; k--) {
+      const a = axisOrder[k];
+      if (++counters[a] < sizes[a]) break;
+      counters[a] = 0;
+    }
+  }
+  return order;
+}
+
+interface InfluenceColumn {
+  x: number;
+  y: number;
+  z: number;
+  potentials: Float64Array; // Probe potential per coulomb
+  fluxes: Float64Array; // Surface flux per coulomb
+}
+
+/**
+ * Evaluates sweep configurations using linearity in the magnitudes: every
+ * metric is Aq (probe potentials, fluxes) or ½qᵀPq (energy) for per-charge
+ * unit columns that depend only on positions. Columns and the rows of the
+ * pair matrix P are cached per charge against its position, so a magnitude
+ * sweep computes them once and a position sweep only recomputes the charges
+ * it moves; the energy of each configuration is then a multiply-add over P.
+ */
+export class SweepEvaluator {
+  private spec: SweepSpec;
+  private axisValues: number[][];
+  private surfaces: { triangles: Float64Array; center: Vec3Like; radius: number }[];
+  private columns: (InfluenceColumn | null)[];
+  private pairs: Float64Array; // P_ij = K / max(d_ij, softening), n×n symmetric
+  private pairPositions: Float64Array; // Position each charge's row of P was computed at
+  private probePoints: Float64Array;
+  private probeField: Float64Array;
+  private probePotential: Float64Array;
+  private single: PackedCharges;
+  private positions: Float64Array;
+  private magnitudes: Float64Array;
+  private chargeIndex: Map<string, number>;
+  public metricCount: number;
+
+  constructor(spec: SweepSpec) {
+    this.spec = spec;
+    this.axisValues = spec.axes.map(sweepAxisValues);
+    this.surfaces = spec.surfaces.map((surface) => {
+      const triangles = surfaceTriangles(surface);
+      return { triangles, ...triangleBounds(triangles) };
+    });
+    this.columns = spec.charges.map(() => null);
+    this.pairs = new Float64Array(spec.charges.length * spec.charges.length);
+    this.pairPositions = new Float64Array(spec.charges.length * 3).fill(NaN);
+    this.probePoints = new Float64Array(spec.probes.length * 3);
+    spec.probes.forEach((probe, i) => {
+      this.probePoints[i * 3] = probe.position.x;
+      this.probePoints[i * 3 + 1] = probe.position.y;
+      this.probePoints[i * 3 + 2] = probe.position.z;
+    });
+    this.probeField = new Float64Array(spec.probes.length * 3);
+    this.probePotential = new Float64Array(spec.probes.length);
+    this.single = { count: 1, positions: new Float64Array(3), magnitudes: new Float64Array([1]) };
+    this.positions = new Float64Array(spec.charges.length * 3);
+    this.magnitudes = new Float64Array(spec.charges.length);
+    this.chargeIndex = new Map(spec.charges.map((charge, i) => [charge.id, i]));
+    this.metricCount = spec.probes.length + spec.surfaces.length + 1;
+  }
+
+  /**
+   * Apply the parameter values of configuration `index` (row-major over the
+   * axes) to a copy of the base charges
+   */
+  private configure(index: number) {
+    const { charges, axes } = this.spec;
+    charges.forEach((charge, i) => {
+      this.positions[i * 3] = charge.position.x;
+      this.positions[i * 3 + 1] = charge.position.y;
+      this.positions[i * 3 + 2] = charge.position.z;
+      this.magnitudes[i] = charge.magnitude;
+    });
+
+    let remainder = index;
+    for (let a = axes.length - 1; a >= 0; a--) {
+      const size = this.axisValues[a].length;
+      const value = this.axisValues[a][remainder % size];
+      remainder = Math.floor(remainder / size);
+      const parameter = axes[a].parameter;
+      const k = this.chargeIndex.get(parameter.chargeId);
+      if (k === undefined) continue;
+
+      if (parameter.kind === 'magnitude') {
+        this.magnitudes[k] = value;
+      } else if (parameter.kind === 'coordinate') {
+        this.positions[k * 3 + 'xyz'.indexOf(parameter.axis)] = value;
+      } else {
+        const anchor = this.chargeIndex.get(parameter.anchorId);
+        if (anchor === undefined || anchor === k) continue;
+        let dx = this.positions[k * 3] - this.positions[anchor * 3];
+        let dy = this.positions[k * 3 + 1] - this.positions[anchor * 3 + 1];
+        let dz = this.positions[k * 3 + 2] - this.positions[anchor * 3 + 2];
+        const length = Math.hypot(dx, dy, dz);
+        if (length === 0) {
+          dx = 1;
+          dy = dz = 0;
+        } else {
+          dx /= length;
+          dy /= length;
+          dz /= length;
+        }
+        this.positions[k * 3] = this.positions[anchor * 3] + dx * value;
+        this.positions[k * 3 + 1] = this.positions[anchor * 3 + 1] + dy * value;
+        this.positions[k * 3 + 2] = this.positions[anchor * 3 + 2] + dz * value;
+      }
+    }
+  }
+
+  private column(k: number): InfluenceColumn {
+    const x = this.positions[k * 3];
+    const y = this.positions[k * 3 + 1];
+    const z = this.positions[k * 3 + 2];
+    const cached = this.columns[k];
+    if (cached && cached.x === x && cached.y === y && cached.z === z) return cached;
+
+    this.single.positions[0] = x;
+    this.single.positions[1] = y;
+    this.single.positions[2] = z;
+    electricFieldBatch(this.single, this.probePoints, this.probeField, this.probePotential);
+
+    const fluxOptions = createDefaultGaussFluxOptions();
+    const tolerance = fluxOptions.relativeTolerance * 4 * Math.PI * PHYSICS_CONSTANTS.K;
+    const fluxes = new Float64Array(this.surfaces.length);
+    this.surfaces.forEach((surface, s) => {
+      const distance = Math.hypot(x - surface.center.x, y - surface.center.y, z - surface.center.z);
+      const depth = distance > fluxOptions.farFactor * surface.radius ? 0 : fluxOptions.maxDepth;
+      fluxes[s] = unitChargeFlux(surface.triangles, { x, y, z }, depth, tolerance).flux;
+    });
+
+    const column = { x, y, z, potentials: Float64Array.from(this.probePotential), fluxes };
+    this.columns[k] = column;
+    return column;
+  }
+
+  /**
+   * Bring P up to date with the current positions: a charge that moved gets
+   * its row and column recomputed, with the field kernel's softening as in
+   * directInteractions
+   */
+  private updatePairs() {
+    const n = this.magnitudes.length;
+    const K = PHYSICS_CONSTANTS.K;
+    const softening = PHYSICS_CONSTANTS.SOFTENING_FACTOR;
+    const positions = this.positions;
+    for (let k = 0; k < n; k++) {
+      const x = positions[k * 3];
+      const y = positions[k * 3 + 1];
+      const z = positions[k * 3 + 2];
+      const cached = this.pairPositions;
+      if (cached[k * 3] === x && cached[k * 3 + 1] === y && cached[k * 3 + 2] === z) continue;
+      for (let j = 0; j < n; j++) {
+        if (j === k) continue;
+        const distance = Math.hypot(x - positions[j * 3], y - positions[j * 3 + 1], z - positions[j * 3 + 2]);
+        const pair = K / Math.max(distance, softening);
+        this.pairs[k * n + j] = pair;
+        this.pairs[j * n + k] = pair;
+      }
+      this.pairPositions.set(positions.subarray(k * 3, k * 3 + 3), k * 3);
+    }
+  }
+
+  /**
+   * Metrics of configuration `index`, written to out[offset ..]
+   */
+  public evaluate(index: number, out: Float64Array, offset: number = 0) {
+    this.configure(index);
+    const n = this.magnitudes.length;
+    const probeCount = this.spec.probes.length;
+    const surfaceCount = this.surfaces.length;
+    out.fill(0, offset, offset + this.metricCount);
+
+    for (let k = 0; k < n; k++) {
+      const q = this.magnitudes[k];
+      if (q === 0) continue;
+      const column = this.column(k);
+      for (let p = 0; p < probeCount; p++) out[offset + p] += q * column.potentials[p];
+      for (let s = 0; s < surfaceCount; s++) out[offset + probeCount + s] += q * column.fluxes[s];
+    }
+
+    // U = ½qᵀPq over the cached pair matrix
+    this.updatePairs();
+    let energy = 0;
+    for (let i = 0; i < n; i++) {
+      const qi = this.magnitudes[i];
+      if (qi === 0) continue;
+      let row = 0;
+      for (let j = i + 1; j < n; j++) row += this.pairs[i * n + j] * this.magnitudes[j];
+      energy += qi * row;
+    }
+    out[offset + this.metricCount - 1] = energy;
+  }
+}
+
+/**
+ * Evaluate positions [start, end) of the evaluation order; returns one row of
+ * metrics per evaluated configuration, in that order
+ */
+export function evaluateSweepRange(spec: SweepSpec, order: Uint32Array, start: number, end: number): Float64Array {
+  const evaluator = new SweepEvaluator(spec);
+  const rows = new Float64Array((end - start) * evaluator.metricCount);
+  for (let n = start; n < end; n++) {
+    evaluator.evaluate(order[n], rows, (n - start) * evaluator.metricCount);
+  }
+  return rows;
+}
+
+/**
+ * Whole sweep on the calling thread (the Node CLI; the browser splits the
+ * evaluation order across a worker pool instead)
+ */
+export function runSweep(spec: SweepSpec): SweepResult {
+  const order = sweepEvaluationOrder(spec);
+  const metrics = sweepMetricNames(spec);
+  const rows = evaluateSweepRange(spec, order, 0, order.length);
+  return {
+    axisValues: spec.axes.map(sweepAxisValues),
+    axisLabels: spec.axes.map((axis) => sweepParameterLabel(axis.parameter)),
+    metrics,
+    values: scatterSweepRows(order, 0, rows, metrics.length),
+  };
+}
+
+/**
+ * Place rows evaluated in evaluation order at their row-major positions
+ */
+export function scatterSweepRows(
+  order: Uint32Array,
+  start: number,
+  rows: Float64Array,
+  metricCount: number,
+  out: Float64Array = new Float64Array(order.length * metricCount)
+): Float64Array {
+  const count = rows.length / metricCount;
+  for (let i = 0; i < count; i++) {
+    out.set(rows.subarray(i * metricCount, (i + 1) * metricCount), order[start + i] * metricCount);
+  }
+  return out;
+}
+
+export function sweepParameterLabel(parameter: SweepParameter): string {
+  switch (parameter.kind) {
+    case 'magnitude':
+      return `q(${parameter.chargeId})`;
+    case 'separation':
+      return `d(${parameter.anchorId},${parameter.chargeId})`;
+    case 'coordinate':
+      return `${parameter.axis}(${parameter.chargeId})`;
+  }
+}
@@ -0,0 +1,142 @@
+import { electricFieldBatch } from './FieldKernel';
+import type { FloatArray, PackedCharges } from './FieldKernel';
+
+export interface PathIntegralOptions {
+  relativeTolerance: number; // Target error relative to the largest |V| at the path's vertices
+  maxIntervals: number; // Cap on subintervals across the whole path
+}
+
+export interface PathIntegralResult {
+  lineIntegral: number; // ∫ E·dl along the path (V)
+  potentialDifference: number; // V(start) - V(end) from the potentials directly (V)
+  errorEstimate: number; // Σ |K15 - G7| over accepted intervals
+  evaluations: number;
+  intervals: number;
+}
+
+// Gauss–Kronrod 7/15 nodes on [-1, 1] (non-negative half; node 7 is the centre)
+const KRONROD_NODES = [
+  0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+  0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+  0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+  0.207784955007898467600689403773245, 0,
+];
+const KRONROD_WEIGHTS = [
+  0.02293532201052922496373200805897, 0.063092092629978553290700663189204,
+  0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+  0.16900472663926790282658342659855, 0.190350578064785409913256402421014,
+  0.204432940075298892414161999234649, 0.209482141084727828012999174891714,
+];
+// 7-point Gauss weights for the odd Kronrod nodes (1, 3, 5 and the centre)
+const GAUSS_WEIGHTS = [
+  0.129484966168869693270611432679082, 0.27970539148927666790146777142378,
+  0.381830050505118944950369775488975, 0.417959183673469387755102040816327,
+];
+
+// Offsets in [0, 1] of the 15 nodes, in the order -x0..-x6, 0, x6..x0
+const UNIT_NODES = [
+  ...KRONROD_NODES.slice(0, 7).map((x) => 0.5 * (1 - x)),
+  0.5,
+  ...KRONROD_NODES.slice(0, 7).reverse().map((x) => 0.5 * (1 + x)),
+];
+
+interface Interval {
+  segment: number; // Polyline segment index
+  t0: number;
+  t1: number;
+}
+
+/**
+ * ∫ E·dl along a polyline by adaptive Gauss–Kronrod (G7/K15) quadrature.
+ * Every round evaluates the 15 nodes of all unfinished intervals in one
+ * batch-kernel call; an interval is accepted when |K15 - G7| is within its
+ * share (by parameter length) of the tolerance, otherwise it is bisected.
+ */
+export function pathLineIntegral(
+  packed: PackedCharges,
+  path: FloatArray,
+  options: PathIntegralOptions = createDefaultPathIntegralOptions()
+): PathIntegralResult {
+  const vertexCount = path.length / 3;
+  const segmentCount = Math.max(vertexCount - 1, 0);
+
+  // Potentials at the vertices: the analytic answer and the error scale
+  const vertexField = new Float64Array(path.length);
+  const vertexPotential = new Float64Array(vertexCount);
+  electricFieldBatch(packed, path, vertexField, vertexPotential);
+  let potentialScale = 0;
+  for (let i = 0; i < vertexCount; i++) {
+    potentialScale = Math.max(potentialScale, Math.abs(vertexPotential[i]));
+  }
+  const tolerance = options.relativeTolerance * Math.max(potentialScale, 1e-12);
+
+  let pending: Interval[] = [];
+  for (let s = 0; s < segmentCount; s++) pending.push({ segment: s, t0: 0, t1: 1 });
+
+  let lineIntegral = 0;
+  let errorEstimate = 0;
+  let evaluations = vertexCount;
+  let intervals = pending.length;
+
+  while (pending.length > 0) {
+    const points = new Float64Array(pending.length * 45);
+    pending.forEach((interval, i) => {
+      const o = interval.segment * 3;
+      for (let k = 0; k < 15; k++) {
+        const t = interval.t0 + (interval.t1 - interval.t0) * UNIT_NODES[k];
+        for (let axis = 0; axis < 3; axis++) {
+          points[i * 45 + k * 3 + axis] = path[o + axis] + (path[o + 3 + axis] - path[o + axis]) * t;
+        }
+      }
+    });
+    const field = new Float64Array(points.length);
+    electricFieldBatch(packed, points, field);
+    evaluations += pending.length * 15;
+
+    const next: Interval[] = [];
+    const atCap = intervals + pending.length > options.maxIntervals;
+    pending.forEach((interval, i) => {
+      const o = interval.segment * 3;
+      const dx = path[o + 3] - path[o];
+      const dy = path[o + 4] - path[o + 1];
+      const dz = path[o + 5] - path[o + 2];
+      const halfWidth = 0.5 * (interval.t1 - interval.t0);
+
+      let kronrod = 0;
+      let gauss = 0;
+      for (let k = 0; k < 15; k++) {
+        const f = i * 45 + k * 3;
+        const value = field[f] * dx + field[f + 1] * dy + field[f + 2] * dz; // E · dl/dt
+        const node = k < 7 ? k : 14 - k; // Index into the symmetric tables
+        kronrod += KRONROD_WEIGHTS[node] * value;
+        if (node % 2 === 1) gauss += GAUSS_WEIGHTS[(node - 1) / 2] * value;
+      }
+      kronrod *= halfWidth;
+      gauss *= halfWidth;
+
+      const error = Math.abs(kronrod - gauss);
+      const allowed = (tolerance * 2 * halfWidth) / Math.max(segmentCount, 1);
+      if (error <= allowed || atCap) {
+        lineIntegral += kronrod;
+        errorEstimate += error;
+      } else {
+        const middle = 0.5 * (interval.t0 + interval.t1);
+        next.push({ segment: interval.segment, t0: interval.t0, t1: middle });
+        next.push({ segment: interval.segment, t0: middle, t1: interval.t1 });
+      }
+    });
+
+    intervals += next.length / 2;
+    pending = next;
+  }
+
+  const potentialDifference = vertexCount > 0 ? vertexPotential[0] - vertexPotential[vertexCount - 1] : 0;
+  return { lineIntegral, potentialDifference, errorEstimate, evaluations, intervals };
+}
+
+export function createDefaultPathIntegralOptions(): PathIntegralOptions {
+  return {
+    relativeTolerance: 1e-8,
+    maxIntervals: 4096,
+  };
+}
@@ -0,0 +1,112 @@
+import { addDipoleFieldBatch, electricFieldBatch } from './FieldKernel';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+
+/**
+ * A source whose strength oscillates as amplitude · cos(2π f t + phase), in the
+ * quasi-static limit (no retardation: the field follows the source instantly).
+ */
+export interface OscillatingSource {
+  id: string;
+  kind: 'charge' | 'dipole';
+  position: Vec3Like;
+  amplitude: number; // Coulombs for a charge, C·m for a dipole
+  axis: Vec3Like; // Unit dipole axis (ignored for charges)
+  frequency: number; // in Hz
+  phase: number; // in radians
+}
+
+/**
+ * Complex field amplitude Ẽ on a set of points for one angular frequency
+ */
+export interface PhasorComponent {
+  angularFrequency: number;
+  real: Float32Array; // xyz interleaved
+  imaginary: Float32Array;
+}
+
+export interface PhasorField {
+  pointCount: number;
+  components: PhasorComponent[];
+}
+
+/**
+ * Compute Ẽ for every distinct frequency once. Sources sharing a frequency are
+ * superposed into one component, so per-frame cost scales with the number of
+ * frequencies rather than the number of sources.
+ */
+export function buildPhasorField(points: Float32Array, sources: OscillatingSource[]): PhasorField {
+  const pointCount = points.length / 3;
+  const components: Map<number, PhasorComponent> = new Map();
+  const unitField = new Float32Array(pointCount * 3);
+  const unitCharge: PackedCharges = {
+    count: 1,
+    positions: new Float64Array(3),
+    magnitudes: Float64Array.of(1),
+  };
+
+  for (const source of sources) {
+    const angularFrequency = 2 * Math.PI * source.frequency;
+    let component = components.get(angularFrequency);
+    if (!component) {
+      component = {
+        angularFrequency,
+        real: new Float32Array(pointCount * 3),
+        imaginary: new Float32Array(pointCount * 3),
+      };
+      components.set(angularFrequency, component);
+    }
+
+    // Field of the source at unit amplitude
+    if (source.kind === 'charge') {
+      unitCharge.positions[0] = source.position.x;
+      unitCharge.positions[1] = source.position.y;
+      unitCharge.positions[2] = source.position.z;
+      electricFieldBatch(unitCharge, points, unitField);
+    } else {
+      unitField.fill(0);
+      addDipoleFieldBatch(points, source.position, source.axis, 1, unitField);
+    }
+
+    // Ẽ += amplitude · e^{iφ} · E_unit
+    const re = source.amplitude * Math.cos(source.phase);
+    const im = source.amplitude * Math.sin(source.phase);
+    for (let i = 0; i < unitField.length; i++) {
+      component.real[i] += re * unitField[i];
+      component.imaginary[i] += im * unitField[i];
+    }
+  }
+
+  return { pointCount, components: Array.from(components.values()) };
+}
+
+/**
+ * out = base + Σ Re(Ẽ_k e^{iω_k t}) = base + Σ (cos ω_k t · Re Ẽ_k − sin ω_k t · Im Ẽ_k)
+ */
+export function evaluatePhasorField(
+  phasor: PhasorField,
+  time: number,
+  base: Float32Array | null,
+  out: Float32Array
+): void {
+  if (base) {
+    out.set(base);
+  } else {
+    out.fill(0);
+  }
+
+  for (const component of phasor.components) {
+    const c = Math.cos(component.angularFrequency * time);
+    const s = Math.sin(component.angularFrequency * time);
+    const { real, imaginary } = component;
+    for (let i = 0; i < out.length; i++) {
+      out[i] += c * real[i] - s * imaginary[i];
+    }
+  }
+}
+
+/**
+ * Instantaneous strength factor of a source: cos(ωt + φ)
+ */
+export function oscillationFactor(source: OscillatingSource, time: number): number {
+  return Math.cos(2 * Math.PI * source.frequency * time + source.phase);
+}
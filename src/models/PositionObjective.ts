@@ -0,0 +1,229 @@
+import { PHYSICS_CONSTANTS } from './Charge';
+import { electricFieldGradientBatch } from './FieldKernel';
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+import type { LatticeBounds } from './FieldLattice';
+
+/**
+ * What the charge positions are optimised for
+ */
+export type PositionObjective =
+  | { kind: 'uniform-field'; min: Vec3Like; max: Vec3Like; samples: number; target: Vec3Like }
+  | { kind: 'zero-field'; point: Vec3Like }
+  | { kind: 'max-field'; start: Vec3Like; end: Vec3Like; samples: number };
+
+export interface PositionPenalties {
+  bounds: LatticeBounds; // Charges are pushed back inside this box
+  clearance: number; // Minimum distance from sample points and between charges (m)
+  weight: number;
+}
+
+/**
+ * Sample points of an objective (xyz interleaved)
+ */
+export function objectiveSamples(objective: PositionObjective): Float64Array {
+  switch (objective.kind) {
+    case 'zero-field':
+      return new Float64Array([objective.point.x, objective.point.y, objective.point.z]);
+    case 'max-field': {
+      const n = Math.max(objective.samples, 2);
+      const points = new Float64Array(n * 3);
+      for (let i = 0; i < n; i++) {
+        const t = i / (n - 1);
+        points[i * 3] = objective.start.x + (objective.end.x - objective.start.x) * t;
+        points[i * 3 + 1] = objective.start.y + (objective.end.y - objective.start.y) * t;
+        points[i * 3 + 2] = objective.start.z + (objective.end.z - objective.start.z) * t;
+      }
+      return points;
+    }
+    case 'uniform-field': {
+      const n = Math.max(objective.samples, 2);
+      const points = new Float64Array(n * n * n * 3);
+      const { min, max } = objective;
+      let offset = 0;
+      for (let x = 0; x < n; x++) {
+        for (let y = 0; y < n; y++) {
+          for (let z = 0; z < n; z++) {
+            points[offset++] = min.x + ((max.x - min.x) * x) / (n - 1);
+            points[offset++] = min.y + ((max.y - min.y) * y) / (n - 1);
+            points[offset++] = min.z + ((max.z - min.z) * z) / (n - 1);
+          }
+        }
+      }
+      return points;
+    }
+  }
+}
+
+/**
+ * Objective over charge positions (magnitudes fixed) with its analytic
+ * gradient. Moving charge k by δ changes the field at s by -J_k(s) δ, where
+ * J_k is that charge's field Jacobian at s, so one gradient-kernel pass per
+ * charge over the sample points gives both the field and every position
+ * derivative. Values are dimensionless: field terms are scaled by the target
+ * field or by K Σ|q| / (1 m)², and the maximum-field term saturates at -1.
+ */
+export class PositionObjectiveEvaluator {
+  private objective: PositionObjective;
+  private penalties: PositionPenalties;
+  private magnitudes: Float64Array;
+  private samples: Float64Array;
+  private sampleCount: number;
+  private single: PackedCharges;
+  private chargeFields: Float64Array[]; // Per charge, xyz per sample
+  private chargeGradients: Float64Array[]; // Per charge, 9 per sample
+  private total: Float64Array; // Summed field per sample
+  private fieldScale2: number;
+  public evaluations = 0;
+
+  constructor(charges: PackedCharges, objective: PositionObjective, penalties: PositionPenalties) {
+    this.objective = objective;
+    this.penalties = penalties;
+    this.magnitudes = Float64Array.from(charges.magnitudes);
+    this.samples = objectiveSamples(objective);
+    this.sampleCount = this.samples.length / 3;
+    this.single = { count: 1, positions: new Float64Array(3), magnitudes: new Float64Array(1) };
+    this.chargeFields = Array.from({ length: charges.count }, () => new Float64Array(this.sampleCount * 3));
+    this.chargeGradients = Array.from({ length: charges.count }, () => new Float64Array(this.sampleCount * 9));
+    this.total = new Float64Array(this.sampleCount * 3);
+
+    let chargeSum = 0;
+    for (let i = 0; i < charges.count; i++) chargeSum += Math.abs(charges.magnitudes[i]);
+    const reference = objective.kind === 'uniform-field'
+      ? Math.hypot(objective.target.x, objective.target.y, objective.target.z)
+      : 0;
+    const scale = reference > 0 ? reference : PHYSICS_CONSTANTS.K * Math.max(chargeSum, 1e-30);
+    this.fieldScale2 = scale * scale;
+  }
+
+  public getSamples(): Float64Array {
+    return this.samples;
+  }
+
+  /**
+   * f(x) for positions x (xyz per charge); writes ∂f/∂x into `gradient`
+   */
+  public evaluate = (x: Float64Array, gradient: Float64Array): number => {
+    const count = this.magnitudes.length;
+    const S = this.sampleCount;
+    this.evaluations++;
+    this.total.fill(0);
+    gradient.fill(0);
+
+    for (let k = 0; k < count; k++) {
+      this.single.positions.set(x.subarray(k * 3, k * 3 + 3));
+      this.single.magnitudes[0] = this.magnitudes[k];
+      electricFieldGradientBatch(this.single, this.samples, this.chargeFields[k], this.chargeGradients[k]);
+      const field = this.chargeFields[k];
+      for (let i = 0; i < S * 3; i++) this.total[i] += field[i];
+    }
+
+    // Field objective as Σ_s w |E_s - T_s|², or for the maximum field the
+    // saturating -(1/S) Σ_s u/(1 + u) with u = |E_s|²/scale², which stays in
+    // [-1, 0] so the bounded penalties can always outweigh it. ∂f/∂E_s is
+    // 2 w (E_s - T_s) in both cases, with w = -1/(S scale² (1 + u)²) for the
+    // latter.
+    let value = 0;
+    const residual = new Float64Array(S * 3);
+    const objective = this.objective;
+    for (let s = 0; s < S; s++) {
+      const ex = this.total[s * 3];
+      const ey = this.total[s * 3 + 1];
+      const ez = this.total[s * 3 + 2];
+      let weight: number;
+      let tx = 0;
+      let ty = 0;
+      let tz = 0;
+      if (objective.kind === 'uniform-field') {
+        weight = 1 / (S * this.fieldScale2);
+        tx = objective.target.x;
+        ty = objective.target.y;
+        tz = objective.target.z;
+      } else if (objective.kind === 'zero-field') {
+        weight = 1 / this.fieldScale2;
+      } else {
+        const u = (ex * ex + ey * ey + ez * ez) / this.fieldScale2;
+        weight = -1 / (S * this.fieldScale2 * (1 + u) * (1 + u));
+        value -= u / (1 + u) / S;
+      }
+      const rx = ex - tx;
+      const ry = ey - ty;
+      const rz = ez - tz;
+      if (objective.kind !== 'max-field') value += weight * (rx * rx + ry * ry + rz * rz);
+      residual[s * 3] = 2 * weight * rx;
+      residual[s * 3 + 1] = 2 * weight * ry;
+      residual[s * 3 + 2] = 2 * weight * rz;
+    }
+
+    // ∂f/∂c_k = Σ_s (∂E_s/∂c_k)ᵀ ∂f/∂E_s = -Σ_s J_k(s) ∂f/∂E_s (J is symmetric)
+    for (let k = 0; k < count; k++) {
+      const jacobian = this.chargeGradients[k];
+      for (let s = 0; s < S; s++) {
+        const g = s * 9;
+        const r0 = residual[s * 3];
+        const r1 = residual[s * 3 + 1];
+        const r2 = residual[s * 3 + 2];
+        gradient[k * 3] -= jacobian[g] * r0 + jacobian[g + 1] * r1 + jacobian[g + 2] * r2;
+        gradient[k * 3 + 1] -= jacobian[g + 3] * r0 + jacobian[g + 4] * r1 + jacobian[g + 5] * r2;
+        gradient[k * 3 + 2] -= jacobian[g + 6] * r0 + jacobian[g + 7] * r1 + jacobian[g + 8] * r2;
+      }
+    }
+
+    return value + this.addPenalties(x, gradient);
+  };
+
+  /**
+   * Quadratic penalties keeping charges inside the bounds, away from the
+   * sample points (where the softened field would make the objective
+   * degenerate) and away from each other
+   */
+  private addPenalties(x: Float64Array, gradient: Float64Array): number {
+    const { bounds, clearance, weight } = this.penalties;
+    const count = this.magnitudes.length;
+    const min = [bounds.min.x, bounds.min.y, bounds.min.z];
+    const max = [bounds.max.x, bounds.max.y, bounds.max.z];
+    let value = 0;
+
+    const pushApart = (k: number, px: number, py: number, pz: number, both: number) => {
+      const dx = x[k * 3] - px;
+      const dy = x[k * 3 + 1] - py;
+      const dz = x[k * 3 + 2] - pz;
+      const distance = Math.hypot(dx, dy, dz);
+      if (distance >= clearance || distance === 0) return;
+      const gap = (clearance - distance) / clearance;
+      value += weight * gap * gap;
+      const scale = (-2 * weight * gap) / (clearance * distance);
+      gradient[k * 3] += scale * dx;
+      gradient[k * 3 + 1] += scale * dy;
+      gradient[k * 3 + 2] += scale * dz;
+      if (both >= 0) {
+        gradient[both * 3] -= scale * dx;
+        gradient[both * 3 + 1] -= scale * dy;
+        gradient[both * 3 + 2] -= scale * dz;
+      }
+    };
+
+    for (let k = 0; k < count; k++) {
+      for (let axis = 0; axis < 3; axis++) {
+        const c = x[k * 3 + axis];
+        const excess = c < min[axis] ? c - min[axis] : c > max[axis] ? c - max[axis] : 0;
+        value += weight * excess * excess;
+        gradient[k * 3 + axis] += 2 * weight * excess;
+      }
+      for (let s = 0; s < this.sampleCount; s++) {
+        pushApart(k, this.samples[s * 3], this.samples[s * 3 + 1], this.samples[s * 3 + 2], -1);
+      }
+      for (let j = k + 1; j < count; j++) {
+        pushApart(k, x[j * 3], x[j * 3 + 1], x[j * 3 + 2], j);
+      }
+    }
+    return value;
+  }
+}
+
+export function createDefaultPositionPenalties(): PositionPenalties {
+  return {
+    bounds: { min: { x: -5, y: -5, z: -5 }, max: { x: 5, y: 5, z: 5 } },
+    clearance: 0.5,
+    weight: 10,
+  };
+}
@@ -0,0 +1,89 @@
+import type { Vec3Like } from './FieldKernel';
+import { sourcesFieldBatch } from './FieldSources';
+import type { FieldSources } from './FieldSources';
+
+export type SliceAxis = 'x' | 'y' | 'z';
+
+/**
+ * Square plane perpendicular to `axis` at `offset`, centred on that axis
+ */
+export interface SlicePlane {
+  axis: SliceAxis;
+  offset: number;
+  halfSize: number;
+}
+
+const MIN_SLICE_LEVEL = 64;
+
+/**
+ * Corner and edge vectors of a slice. Texel (i, j) covers
+ * origin + u (i + ½) / n + v (j + ½) / n, so the texture maps onto the quad
+ * origin → origin + u → origin + u + v → origin + v with plain 0..1 UVs.
+ */
+export function slicePlaneBasis(plane: SlicePlane): { origin: Vec3Like; u: Vec3Like; v: Vec3Like } {
+  const h = plane.halfSize;
+  const size = 2 * h;
+  switch (plane.axis) {
+    case 'x':
+      return { origin: { x: plane.offset, y: -h, z: h }, u: { x: 0, y: 0, z: -size }, v: { x: 0, y: size, z: 0 } };
+    case 'y':
+      return { origin: { x: -h, y: plane.offset, z: h }, u: { x: size, y: 0, z: 0 }, v: { x: 0, y: 0, z: -size } };
+    default:
+      return { origin: { x: -h, y: -h, z: plane.offset }, u: { x: size, y: 0, z: 0 }, v: { x: 0, y: size, z: 0 } };
+  }
+}
+
+/**
+ * Progressive refinement passes: texture sizes doubling from 64 up to
+ * `resolution`
+ */
+export function sliceLevels(resolution: number): number[] {
+  const levels: number[] = [];
+  for (let n = Math.max(1, Math.round(resolution)); n >= MIN_SLICE_LEVEL; n = Math.floor(n / 2)) {
+    levels.unshift(n);
+  }
+  return levels.length > 0 ? levels : [MIN_SLICE_LEVEL];
+}
+
+/**
+ * Potential at texel rows [rowStart, rowEnd) of an n × n slice texture,
+ * row-major (j * n + i), in one batch-kernel call
+ */
+export function sampleSliceRows(
+  sources: FieldSources,
+  plane: SlicePlane,
+  resolution: number,
+  rowStart: number,
+  rowEnd: number
+): Float32Array {
+  const { origin, u, v } = slicePlaneBasis(plane);
+  const n = resolution;
+  const count = (rowEnd - rowStart) * n;
+  const points = new Float64Array(count * 3);
+  let offset = 0;
+  for (let j = rowStart; j < rowEnd; j++) {
+    const b = (j + 0.5) / n;
+    for (let i = 0; i < n; i++) {
+      const a = (i + 0.5) / n;
+      points[offset++] = origin.x + u.x * a + v.x * b;
+      points[offset++] = origin.y + u.y * a + v.y * b;
+      points[offset++] = origin.z + u.z * a + v.z * b;
+    }
+  }
+  const field = new Float64Array(count * 3);
+  const potential = new Float64Array(count);
+  sourcesFieldBatch(sources, points, field, potential);
+  return Float32Array.from(potential);
+}
+
+/**
+ * Colour-scale range for a slice: the given quantile of |V|, so the huge
+ * potentials right next to charges do not wash out the rest of the plane
+ */
+export function slicePotentialRange(values: ArrayLike<number>, quantile: number = 0.99): number {
+  const magnitudes = Float64Array.from(values, Math.abs).filter(Number.isFinite);
+  if (magnitudes.length === 0) return 1;
+  magnitudes.sort();
+  const range = magnitudes[Math.min(magnitudes.length - 1, Math.floor(quantile * magnitudes.length))];
+  return range > 0 ? range : 1;
+}
@@ -0,0 +1,101 @@
+import type { Vec3Like } from './FieldKernel';
+import { sourcesFieldBatch } from './FieldSources';
+import type { FieldSources } from './FieldSources';
+
+export const MAX_PROBE_SAMPLES = 10000;
+
+/**
+ * A line from `start` to `end`, or a rectangle spanned by the edge vectors
+ * `u` and `v` from `origin`
+ */
+export type ProbeShape =
+  | { kind: 'line'; start: Vec3Like; end: Vec3Like; samples: number }
+  | { kind: 'rect'; origin: Vec3Like; u: Vec3Like; v: Vec3Like; samplesU: number; samplesV: number };
+
+export interface ProbeSamples {
+  shape: ProbeShape;
+  coordinates: Float64Array[]; // Arc length along the line, or distances along u and v (m)
+  potential: Float64Array; // V per sample; rectangles are u-major (i * samplesV + j)
+  fieldMagnitude: Float64Array; // |E| per sample (V/m)
+}
+
+/**
+ * Sample counts per direction, clamped so the total stays within MAX_PROBE_SAMPLES
+ */
+export function probeShapeDimensions(shape: ProbeShape): number[] {
+  if (shape.kind === 'line') {
+    return [Math.min(Math.max(Math.round(shape.samples), 2), MAX_PROBE_SAMPLES)];
+  }
+  let nu = Math.max(Math.round(shape.samplesU), 2);
+  let nv = Math.max(Math.round(shape.samplesV), 2);
+  if (nu * nv > MAX_PROBE_SAMPLES) {
+    const shrink = Math.sqrt(MAX_PROBE_SAMPLES / (nu * nv));
+    nu = Math.max(2, Math.floor(nu * shrink));
+    nv = Math.max(2, Math.floor(nv * shrink));
+  }
+  return [nu, nv];
+}
+
+const lerp = (a: number, b: number, t: number) => a + (b - a) * t;
+
+/**
+ * Sample positions of a shape (xyz interleaved) and the coordinates along
+ * each of its directions
+ */
+export function probeShapePoints(shape: ProbeShape): { points: Float64Array; coordinates: Float64Array[] } {
+  const dimensions = probeShapeDimensions(shape);
+  if (shape.kind === 'line') {
+    const n = dimensions[0];
+    const points = new Float64Array(n * 3);
+    const coordinate = new Float64Array(n);
+    const length = Math.hypot(shape.end.x - shape.start.x, shape.end.y - shape.start.y, shape.end.z - shape.start.z);
+    for (let i = 0; i < n; i++) {
+      const t = i / (n - 1);
+      points[i * 3] = lerp(shape.start.x, shape.end.x, t);
+      points[i * 3 + 1] = lerp(shape.start.y, shape.end.y, t);
+      points[i * 3 + 2] = lerp(shape.start.z, shape.end.z, t);
+      coordinate[i] = length * t;
+    }
+    return { points, coordinates: [coordinate] };
+  }
+
+  const [nu, nv] = dimensions;
+  const { origin, u, v } = shape;
+  const points = new Float64Array(nu * nv * 3);
+  let offset = 0;
+  for (let i = 0; i < nu; i++) {
+    const a = i / (nu - 1);
+    for (let j = 0; j < nv; j++) {
+      const b = j / (nv - 1);
+      points[offset++] = origin.x + u.x * a + v.x * b;
+      points[offset++] = origin.y + u.y * a + v.y * b;
+      points[offset++] = origin.z + u.z * a + v.z * b;
+    }
+  }
+  const lengthU = Math.hypot(u.x, u.y, u.z);
+  const lengthV = Math.hypot(v.x, v.y, v.z);
+  return {
+    points,
+    coordinates: [
+      Float64Array.from({ length: nu }, (_, i) => (lengthU * i) / (nu - 1)),
+      Float64Array.from({ length: nv }, (_, j) => (lengthV * j) / (nv - 1)),
+    ],
+  };
+}
+
+/**
+ * Potential and field magnitude at every sample of the shape, in one
+ * batch-kernel call
+ */
+export function sampleProbeShape(sources: FieldSources, shape: ProbeShape): ProbeSamples {
+  const { points, coordinates } = probeShapePoints(shape);
+  const count = points.length / 3;
+  const field = new Float64Array(count * 3);
+  const potential = new Float64Array(count);
+  sourcesFieldBatch(sources, points, field, potential);
+  const fieldMagnitude = new Float64Array(count);
+  for (let i = 0; i < count; i++) {
+    fieldMagnitude[i] = Math.hypot(field[i * 3], field[i * 3 + 1], field[i * 3 + 2]);
+  }
+  return { shape, coordinates, potential, fieldMagnitude };
+}
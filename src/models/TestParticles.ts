@@ -0,0 +1,139 @@
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+import type { FieldLattice } from './FieldLattice';
+
+export interface ParticleSwarmConfig {
+  count: number;
+  charge: number; // in Coulombs
+  mass: number; // in kg
+  origin: Vec3Like;
+  spread: number; // Radius of the sphere particles are spawned in
+  velocity: Vec3Like; // Initial velocity (m/s)
+  velocitySpread: number; // Random jitter added to each velocity component (m/s)
+}
+
+/**
+ * Struct-of-arrays particle state, so a whole swarm can be stepped in one
+ * loop and its positions posted out of a worker as a single buffer.
+ */
+export interface ParticleState {
+  count: number;
+  capacity: number;
+  positions: Float32Array;
+  velocities: Float32Array;
+  chargeToMass: Float32Array;
+  alive: Uint8Array;
+}
+
+export function createParticleState(capacity: number): ParticleState {
+  return {
+    count: 0,
+    capacity,
+    positions: new Float32Array(capacity * 3),
+    velocities: new Float32Array(capacity * 3),
+    chargeToMass: new Float32Array(capacity),
+    alive: new Uint8Array(capacity),
+  };
+}
+
+/**
+ * Add a swarm, reusing dead slots before growing. Returns how many particles
+ * were spawned (fewer than requested once capacity is reached).
+ */
+export function spawnParticles(state: ParticleState, config: ParticleSwarmConfig): number {
+  const chargeToMass = config.mass > 0 ? config.charge / config.mass : 0;
+  let spawned = 0;
+  let slot = 0;
+
+  while (spawned < config.count) {
+    while (slot < state.count && state.alive[slot]) slot++;
+    if (slot >= state.capacity) break;
+    if (slot === state.count) state.count++;
+
+    // Uniform point in a sphere by rejection sampling
+    let dx = 0;
+    let dy = 0;
+    let dz = 0;
+    do {
+      dx = Math.random() * 2 - 1;
+      dy = Math.random() * 2 - 1;
+      dz = Math.random() * 2 - 1;
+    } while (dx * dx + dy * dy + dz * dz > 1);
+
+    const i = slot * 3;
+    state.positions[i] = config.origin.x + dx * config.spread;
+    state.positions[i + 1] = config.origin.y + dy * config.spread;
+    state.positions[i + 2] = config.origin.z + dz * config.spread;
+    state.velocities[i] = config.velocity.x + (Math.random() * 2 - 1) * config.velocitySpread;
+    state.velocities[i + 1] = config.velocity.y + (Math.random() * 2 - 1) * config.velocitySpread;
+    state.velocities[i + 2] = config.velocity.z + (Math.random() * 2 - 1) * config.velocitySpread;
+    state.chargeToMass[slot] = chargeToMass;
+    state.alive[slot] = 1;
+    spawned++;
+    slot++;
+  }
+
+  return spawned;
+}
+
+// Lattice sample scratch, shared by every stepParticles call
+const sampledField = new Float32Array(3);
+
+/**
+ * Advance every live particle by `dt` with a drift-kick-drift leapfrog step.
+ * The field comes from the lattice (one trilinear lookup per particle), so the
+ * cost is independent of the number of charges. Particles leaving the lattice
+ * or hitting a charge are retired.
+ */
+export function stepParticles(
+  state: ParticleState,
+  lattice: FieldLattice,
+  charges: PackedCharges,
+  dt: number,
+  captureRadius: number
+): void {
+  const { positions, velocities, chargeToMass, alive } = state;
+  const halfDt = dt * 0.5;
+  const captureRadiusSq = captureRadius * captureRadius;
+  const field = sampledField;
+
+  for (let p = 0; p < state.count; p++) {
+    if (!alive[p]) continue;
+    const i = p * 3;
+
+    let x = positions[i] + velocities[i] * halfDt;
+    let y = positions[i + 1] + velocities[i + 1] * halfDt;
+    let z = positions[i + 2] + velocities[i + 2] * halfDt;
+
+    if (!lattice.sample(x, y, z, field)) {
+      alive[p] = 0;
+      continue;
+    }
+
+    const qm = chargeToMass[p];
+    velocities[i] += qm * field[0] * dt;
+    velocities[i + 1] += qm * field[1] * dt;
+    velocities[i + 2] += qm * field[2] * dt;
+
+    x += velocities[i] * halfDt;
+    y += velocities[i + 1] * halfDt;
+    z += velocities[i + 2] * halfDt;
+    positions[i] = x;
+    positions[i + 1] = y;
+    positions[i + 2] = z;
+
+    for (let c = 0; c < charges.count; c++) {
+      const rx = x - charges.positions[c * 3];
+      const ry = y - charges.positions[c * 3 + 1];
+      const rz = z - charges.positions[c * 3 + 2];
+      if (rx * rx + ry * ry + rz * rz < captureRadiusSq) {
+        alive[p] = 0;
+        break;
+      }
+    }
+  }
+
+  // Trim trailing dead slots so the live range stays compact
+  while (state.count > 0 && !alive[state.count - 1]) {
+    state.count--;
+  }
+}
@@ -0,0 +1,85 @@
+import type { PackedCharges, Vec3Like } from './FieldKernel';
+
+/**
+ * A charge as stored in a keyframe: plain data, so timelines can be saved as
+ * JSON, posted to workers and read by the Node exporter
+ */
+export interface KeyframeCharge {
+  id: string;
+  position: Vec3Like;
+  magnitude: number; // in Coulombs
+}
+
+export interface ChargeKeyframe {
+  time: number; // Seconds from the start of the timeline
+  charges: KeyframeCharge[];
+}
+
+export interface Timeline {
+  fps: number;
+  keyframes: ChargeKeyframe[]; // Sorted by time
+}
+
+export function timelineDuration(timeline: Timeline): number {
+  const { keyframes } = timeline;
+  return keyframes.length > 0 ? keyframes[keyframes.length - 1].time : 0;
+}
+
+export function timelineFrameCount(timeline: Timeline): number {
+  return Math.floor(timelineDuration(timeline) * timeline.fps) + 1;
+}
+
+/**
+ * Insert (or replace) the keyframe at `keyframe.time`, keeping the list sorted
+ */
+export function setKeyframe(timeline: Timeline, keyframe: ChargeKeyframe): Timeline {
+  const keyframes = timeline.keyframes.filter((existing) => existing.time !== keyframe.time);
+  keyframes.push(keyframe);
+  keyframes.sort((a, b) => a.time - b.time);
+  return { ...timeline, keyframes };
+}
+
+/**
+ * Charges at `time`, packed for the batch kernel. Positions and magnitudes are
+ * interpolated linearly between the surrounding keyframes for charges (matched
+ * by id) present in both; a charge in only one of them fades in or out through
+ * its magnitude, so the field changes continuously.
+ */
+export function chargesAtTime(timeline: Timeline, time: number): PackedCharges {
+  const { keyframes } = timeline;
+  if (keyframes.length === 0) {
+    return { count: 0, positions: new Float64Array(0), magnitudes: new Float64Array(0) };
+  }
+
+  let next = keyframes.findIndex((keyframe) => keyframe.time > time);
+  if (next === -1) next = keyframes.length - 1;
+  const previous = Math.max(next - 1, 0);
+  const from = keyframes[previous];
+  const to = keyframes[next];
+  const span = to.time - from.time;
+  const t = span > 0 ? Math.min(Math.max((time - from.time) / span, 0), 1) : 1;
+
+  const ids = new Set<string>();
+  for (const charge of from.charges) ids.add(charge.id);
+  for (const charge of to.charges) ids.add(charge.id);
+
+  const count = ids.size;
+  const positions = new Float64Array(count * 3);
+  const magnitudes = new Float64Array(count);
+  let i = 0;
+  for (const id of ids) {
+    const a = from.charges.find((charge) => charge.id === id);
+    const b = to.charges.find((charge) => charge.id === id);
+    const start = a ?? b!;
+    const end = b ?? a!;
+    positions[i * 3] = start.position.x + (end.position.x - start.position.x) * t;
+    positions[i * 3 + 1] = start.position.y + (end.position.y - start.position.y) * t;
+    positions[i * 3 + 2] = start.position.z + (end.position.z - start.position.z) * t;
+    const startMagnitude = a ? a.magnitude : 0;
+    const endMagnitude = b ? b.magnitude : 0;
+    magnitudes[i] = startMagnitude + (endMagnitude - startMagnitude) * t;
+    i++;
+  }
+
+  return { count, positions, magnitudes };
+}
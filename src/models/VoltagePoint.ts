@@ -1,20 +1,21 @@
 import * as THREE from 'three';
 
+/**
+ * A voltage probe. Its live potential is kept in VoltageProbeRenderer's probe
+ * buffer rather than here, so charge edits never rewrite these objects.
+ */
 export interface VoltagePoint {
   position: THREE.Vector3;
-  voltage: number; 
   id: string;
+  target?: number; // Pinned target potential for inverse design (V)
 }
 
 export function createVoltagePoint(
   position: THREE.Vector3,
-  voltage: number = 0,
   id: string = `voltage-${Date.now()}`
 ): VoltagePoint {
   return {
     position: position.clone(),
-    voltage,
     id,
   };
 }
-
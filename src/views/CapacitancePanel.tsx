@@ -0,0 +1,204 @@
+import React, { useState } from 'react';
+import type { CapacitanceResult, Conductor } from '../models/Capacitance';
+
+interface CapacitancePanelProps {
+  conductors: Conductor[];
+  panelSize: number;
+  result: CapacitanceResult | null;
+  status: string | null; // Progress or error text
+  onAddConductor: (conductor: Conductor) => void;
+  onRemoveConductor: (conductorId: string) => void;
+  onPanelSizeChange: (size: number) => void;
+  onCompute: () => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const conductorLabel = (conductor: Conductor): string => {
+  switch (conductor.kind) {
+    case 'sphere':
+      return `Sphere r=${conductor.radius} at (${conductor.center.x}, ${conductor.center.y}, ${conductor.center.z})`;
+    case 'box':
+      return `Box ${conductor.size.x}×${conductor.size.y}×${conductor.size.z} at (${conductor.center.x}, ${conductor.center.y}, ${conductor.center.z})`;
+    case 'mesh':
+      return `Mesh ${conductor.name}`;
+  }
+};
+
+const CapacitancePanel: React.FC<CapacitancePanelProps> = ({
+  conductors,
+  panelSize,
+  result,
+  status,
+  onAddConductor,
+  onRemoveConductor,
+  onPanelSizeChange,
+  onCompute,
+}) => {
+  const [kind, setKind] = useState<'sphere' | 'box'>('sphere');
+  const [center, setCenter] = useState({ x: 0, y: 0, z: 0 });
+  const [size, setSize] = useState(1); // Radius or box side
+
+  const addConductor = () => {
+    const id = `conductor-${Date.now()}`;
+    if (kind === 'sphere') {
+      onAddConductor({ id, kind, center: { ...center }, radius: size });
+    } else {
+      onAddConductor({ id, kind, center: { ...center }, size: { x: size, y: size, z: size } });
+    }
+  };
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  const showResult = result && result.conductorCount === conductors.length;
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Capacitance ({conductors.length} conductors)
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Shape
+          <select
+            value={kind}
+            onChange={(e) => setKind(e.target.value as 'sphere' | 'box')}
+            style={inputStyle}
+          >
+            <option value="sphere">Sphere</option>
+            <option value="box">Box</option>
+          </select>
+        </label>
+        <label>
+          {kind === 'sphere' ? 'Radius' : 'Side'}
+          {numberInput(size, setSize)}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          X
+          {numberInput(center.x, (x) => setCenter((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(center.y, (y) => setCenter((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(center.z, (z) => setCenter((prev) => ({ ...prev, z })))}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <button onClick={addConductor} style={{ ...buttonStyle, background: '#4CAF50', alignSelf: 'end' }}>
+          + Add
+        </button>
+        <label>
+          Panel (m)
+          {numberInput(panelSize, onPanelSizeChange)}
+        </label>
+        <button
+          onClick={onCompute}
+          disabled={conductors.length === 0}
+          style={{ ...buttonStyle, background: '#2196F3', alignSelf: 'end' }}
+        >
+          Compute
+        </button>
+      </div>
+
+      {conductors.map((conductor, index) => (
+        <div
+          key={conductor.id}
+          style={{
+            display: 'flex',
+            justifyContent: 'space-between',
+            alignItems: 'center',
+            fontSize: '10px',
+            marginBottom: '3px',
+          }}
+        >
+          <span>
+            {index + 1}: {conductorLabel(conductor)}
+          </span>
+          <button
+            onClick={() => onRemoveConductor(conductor.id)}
+            style={{
+              padding: '2px 6px',
+              background: '#f44336',
+              color: 'white',
+              border: 'none',
+              borderRadius: '3px',
+              cursor: 'pointer',
+              fontSize: '10px',
+            }}
+          >
+            Remove
+          </button>
+        </div>
+      ))}
+
+      {status && <div style={{ fontSize: '10px', color: '#aaa', marginTop: '5px' }}>{status}</div>}
+
+      {showResult && (
+        <div style={{ fontSize: '10px', marginTop: '5px' }}>
+          <div>Maxwell capacitance matrix (pF):</div>
+          <table style={{ borderCollapse: 'collapse', marginTop: '3px' }}>
+            <tbody>
+              {conductors.map((_, i) => (
+                <tr key={i}>
+                  {conductors.map((__, j) => (
+                    <td key={j} style={{ padding: '1px 6px', textAlign: 'right' }}>
+                      {(result.matrix[i * result.conductorCount + j] * 1e12).toFixed(3)}
+                    </td>
+                  ))}
+                </tr>
+              ))}
+            </tbody>
+          </table>
+          <div style={{ color: '#aaa', marginTop: '3px' }}>
+            {result.panelCount} panels, PCG iterations per conductor: {result.iterations.join(', ')}
+          </div>
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default CapacitancePanel;
@@ -0,0 +1,98 @@
+import * as THREE from 'three';
+import type { ChargeStore } from '../models/ChargeStore';
+
+export interface ChargeCloudConfig {
+  pointSize: number;
+  positiveColor: number;
+  negativeColor: number;
+}
+
+/**
+ * Charge store drawn as one point cloud, coloured by sign. sync() uploads
+ * only the charges appended since the last call, so a store that grows
+ * batch by batch is drawn as it fills; buffers double when they run out.
+ */
+export class ChargeCloudRenderer {
+  private scene: THREE.Scene;
+  private geometry: THREE.BufferGeometry;
+  private material: THREE.PointsMaterial;
+  private points: THREE.Points;
+  private drawn = 0;
+  private storeVersion = -1;
+  private storeEpoch = -1;
+  private positive: THREE.Color;
+  private negative: THREE.Color;
+
+  constructor(scene: THREE.Scene, config: ChargeCloudConfig = createDefaultChargeCloudConfig()) {
+    this.scene = scene;
+    this.positive = new THREE.Color(config.positiveColor);
+    this.negative = new THREE.Color(config.negativeColor);
+    this.geometry = new THREE.BufferGeometry();
+    this.allocate(0);
+    this.material = new THREE.PointsMaterial({ size: config.pointSize, vertexColors: true });
+    this.points = new THREE.Points(this.geometry, this.material);
+    this.points.frustumCulled = false;
+    this.scene.add(this.points);
+  }
+
+  private allocate(capacity: number) {
+    this.geometry.setAttribute('position', new THREE.BufferAttribute(new Float32Array(capacity * 3), 3));
+    this.geometry.setAttribute('color', new THREE.BufferAttribute(new Float32Array(capacity * 3), 3));
+    this.geometry.setDrawRange(0, 0);
+    this.drawn = 0;
+  }
+
+  /**
+   * Bring the cloud up to date with the store
+   */
+  public sync(store: ChargeStore) {
+    if (store.version === this.storeVersion) return;
+    this.storeVersion = store.version;
+    // Replaced contents are redrawn from the start
+    if (store.epoch !== this.storeEpoch) {
+      this.storeEpoch = store.epoch;
+      this.drawn = 0;
+    }
+    const capacity = this.geometry.getAttribute('position').count;
+    if (store.count > capacity) this.allocate(Math.max(store.count, capacity * 2));
+
+    const { positions, magnitudes } = store.packed();
+    const positionAttribute = this.geometry.getAttribute('position') as THREE.BufferAttribute;
+    const colorAttribute = this.geometry.getAttribute('color') as THREE.BufferAttribute;
+    const target = positionAttribute.array as Float32Array;
+    const colors = colorAttribute.array as Float32Array;
+    const start = this.drawn;
+    target.set(positions.subarray(start * 3), start * 3);
+    for (let i = start; i < store.count; i++) {
+      const color = magnitudes[i] >= 0 ? this.positive : this.negative;
+      colors[i * 3] = color.r;
+      colors[i * 3 + 1] = color.g;
+      colors[i * 3 + 2] = color.b;
+    }
+    for (const attribute of [positionAttribute, colorAttribute]) {
+      attribute.clearUpdateRanges();
+      attribute.addUpdateRange(start * 3, (store.count - start) * 3);
+      attribute.needsUpdate = true;
+    }
+    this.drawn = store.count;
+    this.geometry.setDrawRange(0, store.count);
+  }
+
+  public setVisible(visible: boolean) {
+    this.points.visible = visible;
+  }
+
+  public dispose() {
+    this.scene.remove(this.points);
+    this.geometry.dispose();
+    this.material.dispose();
+  }
+}
+
+export function createDefaultChargeCloudConfig(): ChargeCloudConfig {
+  return {
+    pointSize: 0.05,
+    positiveColor: 0xff4444,
+    negativeColor: 0x4444ff,
+  };
+}
@@ -0,0 +1,69 @@
+import * as THREE from 'three';
+import { currentSourcePath } from '../models/Current';
+import type { CurrentSource } from '../models/Current';
+
+/**
+ * Wires and loops drawn as polylines, with a cone on each marking the
+ * direction of conventional current
+ */
+export class CurrentSourceRenderer {
+  private scene: THREE.Scene;
+  private group: THREE.Group;
+  private lineMaterial: THREE.LineBasicMaterial;
+  private arrowGeometry: THREE.ConeGeometry;
+  private arrowMaterial: THREE.MeshBasicMaterial;
+  private readonly upVector: THREE.Vector3 = new THREE.Vector3(0, 1, 0);
+
+  constructor(scene: THREE.Scene) {
+    this.scene = scene;
+    this.group = new THREE.Group();
+    this.scene.add(this.group);
+    this.lineMaterial = new THREE.LineBasicMaterial({ color: 0xffa040 });
+    this.arrowGeometry = new THREE.ConeGeometry(0.08, 0.25, 12);
+    this.arrowMaterial = new THREE.MeshBasicMaterial({ color: 0xffa040 });
+  }
+
+  public updateSources(sources: CurrentSource[]) {
+    this.clear();
+
+    for (const source of sources) {
+      const path = currentSourcePath(source);
+      const geometry = new THREE.BufferGeometry();
+      geometry.setAttribute('position', new THREE.BufferAttribute(new Float32Array(path), 3));
+      this.group.add(new THREE.Line(geometry, this.lineMaterial));
+
+      // Arrow halfway along the path, pointing with the current
+      const vertexCount = path.length / 3;
+      const i = Math.floor((vertexCount - 1) / 2);
+      const from = new THREE.Vector3().fromArray(path, i * 3);
+      const to = new THREE.Vector3().fromArray(path, (i + 1) * 3);
+      const direction = to.clone().sub(from).multiplyScalar(Math.sign(source.current));
+      if (direction.lengthSq() === 0) continue;
+      const arrow = new THREE.Mesh(this.arrowGeometry, this.arrowMaterial);
+      arrow.position.copy(from).add(to).multiplyScalar(0.5);
+      arrow.quaternion.setFromUnitVectors(this.upVector, direction.normalize());
+      this.group.add(arrow);
+    }
+  }
+
+  private clear() {
+    for (const child of [...this.group.children]) {
+      if (child instanceof THREE.Line) {
+        child.geometry.dispose();
+      }
+      this.group.remove(child);
+    }
+  }
+
+  public setVisible(visible: boolean) {
+    this.group.visible = visible;
+  }
+
+  public dispose() {
+    this.clear();
+    this.scene.remove(this.group);
+    this.lineMaterial.dispose();
+    this.arrowGeometry.dispose();
+    this.arrowMaterial.dispose();
+  }
+}
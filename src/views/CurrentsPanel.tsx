@@ -0,0 +1,207 @@
+import React, { useState } from 'react';
+import type { CurrentSource } from '../models/Current';
+import type { FieldKind } from '../models/FieldKernel';
+
+interface CurrentsPanelProps {
+  currents: CurrentSource[];
+  fieldKind: FieldKind;
+  onAddCurrent: (source: CurrentSource) => void;
+  onRemoveCurrent: (sourceId: string) => void;
+  onFieldKindChange: (kind: FieldKind) => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const AXES = {
+  x: { x: 1, y: 0, z: 0 },
+  y: { x: 0, y: 1, z: 0 },
+  z: { x: 0, y: 0, z: 1 },
+};
+
+const CurrentsPanel: React.FC<CurrentsPanelProps> = ({
+  currents,
+  fieldKind,
+  onAddCurrent,
+  onRemoveCurrent,
+  onFieldKindChange,
+}) => {
+  const [kind, setKind] = useState<'wire' | 'loop'>('loop');
+  const [current, setCurrent] = useState(5);
+  const [center, setCenter] = useState({ x: 0, y: 0, z: 0 });
+  const [axis, setAxis] = useState<'x' | 'y' | 'z'>('y');
+  const [size, setSize] = useState(2); // Wire length or loop radius
+
+  const addCurrent = () => {
+    const id = `current-${Date.now()}`;
+    const direction = AXES[axis];
+    if (kind === 'wire') {
+      const half = size / 2;
+      onAddCurrent({
+        id,
+        kind,
+        start: {
+          x: center.x - direction.x * half,
+          y: center.y - direction.y * half,
+          z: center.z - direction.z * half,
+        },
+        end: {
+          x: center.x + direction.x * half,
+          y: center.y + direction.y * half,
+          z: center.z + direction.z * half,
+        },
+        current,
+      });
+    } else {
+      onAddCurrent({ id, kind, center: { ...center }, normal: direction, radius: size, current, segments: 48 });
+    }
+  };
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Currents ({currents.length})
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '10px' }}>
+        <button
+          onClick={() => onFieldKindChange('electric')}
+          style={{ ...buttonStyle, background: fieldKind === 'electric' ? '#4CAF50' : '#607D8B' }}
+        >
+          Show E
+        </button>
+        <button
+          onClick={() => onFieldKindChange('magnetic')}
+          style={{ ...buttonStyle, background: fieldKind === 'magnetic' ? '#4CAF50' : '#607D8B' }}
+        >
+          Show B
+        </button>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Type
+          <select
+            value={kind}
+            onChange={(e) => setKind(e.target.value as 'wire' | 'loop')}
+            style={inputStyle}
+          >
+            <option value="wire">Wire</option>
+            <option value="loop">Loop</option>
+          </select>
+        </label>
+        <label>
+          {kind === 'wire' ? 'Along' : 'Normal'}
+          <select
+            value={axis}
+            onChange={(e) => setAxis(e.target.value as 'x' | 'y' | 'z')}
+            style={inputStyle}
+          >
+            <option value="x">X</option>
+            <option value="y">Y</option>
+            <option value="z">Z</option>
+          </select>
+        </label>
+        <label>
+          I (A)
+          {numberInput(current, setCurrent)}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          X
+          {numberInput(center.x, (x) => setCenter((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(center.y, (y) => setCenter((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(center.z, (z) => setCenter((prev) => ({ ...prev, z })))}
+        </label>
+        <label>
+          {kind === 'wire' ? 'Length' : 'Radius'}
+          {numberInput(size, setSize)}
+        </label>
+      </div>
+
+      <button
+        onClick={addCurrent}
+        style={{ ...buttonStyle, width: '100%', background: '#4CAF50', marginBottom: '10px' }}
+      >
+        + Add {kind === 'wire' ? 'Wire' : 'Loop'}
+      </button>
+
+      {currents.map((source) => (
+        <div
+          key={source.id}
+          style={{
+            display: 'flex',
+            justifyContent: 'space-between',
+            alignItems: 'center',
+            fontSize: '10px',
+            marginBottom: '4px',
+          }}
+        >
+          <span>
+            {source.kind} I={source.current} A
+          </span>
+          <button
+            onClick={() => onRemoveCurrent(source.id)}
+            style={{
+              padding: '2px 6px',
+              background: '#f44336',
+              color: 'white',
+              border: 'none',
+              borderRadius: '3px',
+              cursor: 'pointer',
+              fontSize: '10px',
+            }}
+          >
+            Remove
+          </button>
+        </div>
+      ))}
+    </div>
+  );
+};
+
+export default CurrentsPanel;
@@ -0,0 +1,260 @@
+import * as THREE from 'three';
+import { MeshBasicNodeMaterial } from 'three/webgpu';
+import type { TextureNode } from 'three/webgpu';
+import {
+  abs,
+  attribute,
+  cross,
+  float,
+  floor,
+  fract,
+  ivec2,
+  min,
+  mix,
+  normalize,
+  positionLocal,
+  select,
+  textureLoad,
+  uniform,
+  vec3,
+} from 'three/tsl';
+
+export interface FieldLineFlowConfig {
+  samplesPerLine: number; // Resolution of each line's travel-time table
+  glyphsPerLine: number;
+  baseSpeed: number; // Glyph speed (units/s) where |E| equals referenceField
+  referenceField: number; // N/C
+  referenceMagneticField: number; // T, used in place of referenceField for B lines
+  minSpeedFactor: number; // Clamp on |E| / referenceField
+  maxSpeedFactor: number;
+  glyphRadius: number;
+  glyphLength: number;
+  color: number;
+}
+
+export interface FlowPath {
+  samples: Float32Array; // samplesPerLine xyz positions, evenly spaced in travel time
+  period: number; // Seconds for one glyph to traverse the whole line
+}
+
+/**
+ * Build a line's arc-length table and turn it into a travel-time table: with
+ * speed proportional to |E| (clamped), each segment takes ds / v seconds.
+ * Resampling the polyline at equal time steps means the shader only has to
+ * advance a phase linearly to get glyphs that speed up where the field is strong.
+ */
+export function buildFlowPath(
+  points: Float32Array,
+  fieldMagnitudes: Float32Array,
+  config: FieldLineFlowConfig
+): FlowPath {
+  const count = points.length / 3;
+  const travelTime = new Float64Array(count);
+
+  for (let i = 1; i < count; i++) {
+    const dx = points[i * 3] - points[i * 3 - 3];
+    const dy = points[i * 3 + 1] - points[i * 3 - 2];
+    const dz = points[i * 3 + 2] - points[i * 3 - 1];
+    const arcLength = Math.sqrt(dx * dx + dy * dy + dz * dz);
+    const averageField = 0.5 * (fieldMagnitudes[i] + fieldMagnitudes[i - 1]);
+    const speedFactor = Math.min(
+      Math.max(averageField / config.referenceField, config.minSpeedFactor),
+      config.maxSpeedFactor
+    );
+    travelTime[i] = travelTime[i - 1] + arcLength / (config.baseSpeed * speedFactor);
+  }
+
+  const period = travelTime[count - 1];
+  const sampleCount = config.samplesPerLine;
+  const samples = new Float32Array(sampleCount * 3);
+  let segment = 1;
+
+  for (let k = 0; k < sampleCount; k++) {
+    const target = (period * k) / (sampleCount - 1);
+    while (segment < count - 1 && travelTime[segment] < target) segment++;
+
+    const t0 = travelTime[segment - 1];
+    const t1 = travelTime[segment];
+    const t = t1 > t0 ? Math.min(Math.max((target - t0) / (t1 - t0), 0), 1) : 0;
+    for (let c = 0; c < 3; c++) {
+      const a = points[(segment - 1) * 3 + c];
+      const b = points[segment * 3 + c];
+      samples[k * 3 + c] = a + (b - a) * t;
+    }
+  }
+
+  return { samples, period };
+}
+
+/**
+ * Glyphs that flow along traced field lines. Every line's travel-time table
+ * lives in one float texture (one row per line); the vertex shader advances
+ * each glyph from a single time uniform, so animating costs no CPU work
+ * beyond bumping that uniform. The glyph mesh and its geometry live as long
+ * as the renderer: a retrace only rewrites the per-glyph attribute, which
+ * grows by doubling, so the cone's shared vertex and index buffers are
+ * uploaded once.
+ */
+export class FieldLineFlowRenderer {
+  private config: FieldLineFlowConfig;
+  private group: THREE.Group;
+  private mesh: THREE.Mesh;
+  private baseGeometry: THREE.ConeGeometry;
+  private geometry: THREE.InstancedBufferGeometry;
+  private flowData: THREE.InstancedBufferAttribute;
+  private material: MeshBasicNodeMaterial;
+  private pathTexture: THREE.DataTexture;
+  private startSample: TextureNode;
+  private endSample: TextureNode;
+  private time = uniform(0);
+
+  constructor(parent: THREE.Object3D, config: FieldLineFlowConfig) {
+    this.group = new THREE.Group();
+    parent.add(this.group);
+    this.config = config;
+    this.baseGeometry = new THREE.ConeGeometry(config.glyphRadius, config.glyphLength, 6);
+    this.pathTexture = this.createPathTexture(new Float32Array(config.samplesPerLine * 4), 1);
+
+    // flowData: x = texture row (line), y = phase offset, z = line period (s)
+    const flowData = attribute('flowData', 'vec4');
+    const lastSegment = config.samplesPerLine - 2;
+    const u = fract(flowData.y.add(this.time.div(flowData.z))).mul(config.samplesPerLine - 1);
+    const index = min(floor(u), float(lastSegment));
+    const blend = u.sub(index);
+
+    const startSample = textureLoad(this.pathTexture, ivec2(index, flowData.x));
+    const endSample = textureLoad(this.pathTexture, ivec2(index.add(1), flowData.x));
+    this.startSample = startSample;
+    this.endSample = endSample;
+    const start = startSample.xyz;
+    const end = endSample.xyz;
+
+    // Orient the cone's +Y axis along the local line tangent
+    const tangent = normalize(end.sub(start).add(vec3(0, 1e-6, 0)));
+    const helper = select(abs(tangent.y).greaterThan(0.99), vec3(1, 0, 0), vec3(0, 1, 0));
+    const binormal = normalize(cross(helper, tangent));
+    const normal = cross(tangent, binormal);
+
+    this.material = new MeshBasicNodeMaterial({ color: config.color });
+    this.material.positionNode = mix(start, end, blend)
+      .add(binormal.mul(positionLocal.x))
+      .add(tangent.mul(positionLocal.y))
+      .add(normal.mul(positionLocal.z));
+
+    this.geometry = new THREE.InstancedBufferGeometry();
+    this.geometry.index = this.baseGeometry.index;
+    this.geometry.setAttribute('position', this.baseGeometry.getAttribute('position'));
+    this.flowData = this.createFlowData(0);
+    this.geometry.instanceCount = 0;
+    this.mesh = new THREE.Mesh(this.geometry, this.material);
+    this.mesh.frustumCulled = false;
+    this.mesh.visible = false;
+    this.group.add(this.mesh);
+  }
+
+  private createFlowData(capacity: number): THREE.InstancedBufferAttribute {
+    const flowData = new THREE.InstancedBufferAttribute(new Float32Array(capacity * 4), 4);
+    flowData.setUsage(THREE.DynamicDrawUsage);
+    this.geometry.setAttribute('flowData', flowData);
+    return flowData;
+  }
+
+  private createPathTexture(data: Float32Array, lineCount: number): THREE.DataTexture {
+    const texture = new THREE.DataTexture(
+      data,
+      this.config.samplesPerLine,
+      lineCount,
+      THREE.RGBAFormat,
+      THREE.FloatType
+    );
+    texture.minFilter = THREE.NearestFilter;
+    texture.magFilter = THREE.NearestFilter;
+    texture.needsUpdate = true;
+    return texture;
+  }
+
+  /**
+   * Upload the flow paths of freshly traced lines
+   */
+  public setPaths(paths: FlowPath[]) {
+    this.clear();
+    const lines = paths.filter((path) => path.period > 0);
+    if (lines.length === 0) return;
+
+    const samplesPerLine = this.config.samplesPerLine;
+    const texels = new Float32Array(samplesPerLine * lines.length * 4);
+    lines.forEach((path, row) => {
+      for (let k = 0; k < samplesPerLine; k++) {
+        const t = (row * samplesPerLine + k) * 4;
+        texels[t] = path.samples[k * 3];
+        texels[t + 1] = path.samples[k * 3 + 1];
+        texels[t + 2] = path.samples[k * 3 + 2];
+      }
+    });
+
+    this.pathTexture.dispose();
+    this.pathTexture = this.createPathTexture(texels, lines.length);
+    this.startSample.value = this.pathTexture;
+    this.endSample.value = this.pathTexture;
+
+    const glyphsPerLine = this.config.glyphsPerLine;
+    const instanceCount = lines.length * glyphsPerLine;
+    if (instanceCount > this.flowData.count) {
+      this.flowData = this.createFlowData(Math.max(instanceCount, this.flowData.count * 2));
+    }
+    const flowData = this.flowData.array as Float32Array;
+    lines.forEach((path, row) => {
+      for (let g = 0; g < glyphsPerLine; g++) {
+        const i = (row * glyphsPerLine + g) * 4;
+        flowData[i] = row;
+        flowData[i + 1] = g / glyphsPerLine;
+        flowData[i + 2] = path.period;
+      }
+    });
+
+    this.flowData.clearUpdateRanges();
+    this.flowData.addUpdateRange(0, instanceCount * 4);
+    this.flowData.needsUpdate = true;
+    this.geometry.instanceCount = instanceCount;
+    this.mesh.visible = true;
+  }
+
+  public clear() {
+    this.mesh.visible = false;
+    this.geometry.instanceCount = 0;
+  }
+
+  /**
+   * Advance the shared time uniform (the only per-frame work)
+   */
+  public update(deltaSeconds: number) {
+    this.time.value += deltaSeconds;
+  }
+
+  public setVisible(visible: boolean) {
+    this.group.visible = visible;
+  }
+
+  public dispose() {
+    this.group.removeFromParent();
+    this.geometry.dispose();
+    this.baseGeometry.dispose();
+    this.material.dispose();
+    this.pathTexture.dispose();
+  }
+}
+
+export function createDefaultFieldLineFlowConfig(): FieldLineFlowConfig {
+  return {
+    samplesPerLine: 256,
+    glyphsPerLine: 6,
+    baseSpeed: 1.0,
+    referenceField: 1e4,
+    referenceMagneticField: 1e-6,
+    minSpeedFactor: 0.1,
+    maxSpeedFactor: 5,
+    glyphRadius: 0.04,
+    glyphLength: 0.14,
+    color: 0xffaa00,
+  };
+}
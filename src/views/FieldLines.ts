@@ -1,6 +1,21 @@
 import * as THREE from 'three';
-import { electricFieldAt } from '../models/Charge';
 import type { Charge } from '../models/Charge';
+import { buildChargeTree } from '../models/ChargeTree';
+import type { ChargeTree } from '../models/ChargeTree';
+import { fieldLineCurvature, packCharges } from '../models/FieldKernel';
+import type { FieldKind, FloatArray } from '../models/FieldKernel';
+import { DATASET_SEED_CHARGES, spacedPositiveCharges } from '../models/FieldLineTracer';
+import { emptyFieldSources, sourcesFieldBatch, sourcesFieldGradientBatch } from '../models/FieldSources';
+import type { FieldSources } from '../models/FieldSources';
+import { currentSourcePath, magneticFieldBatch, packCurrents } from '../models/Current';
+import type { CurrentSource, PackedSegments } from '../models/Current';
+import {
+  FieldLineFlowRenderer,
+  buildFlowPath,
+  createDefaultFieldLineFlowConfig,
+} from './FieldLineFlow';
+import { gltfGeometryFromPolylines } from '../export/GltfExport';
+import type { GltfNodeSource } from '../export/GltfExport';
 
 export interface FieldLineConfig {
   stepSize: number; // Step size for numerical integration
@@ -10,21 +25,41 @@ export interface FieldLineConfig {
   lineWidth: number;
   color: number;
   opacity: number;
-  linesPerCharge: number; // Number of field lines to start from each positive charge
+  linesPerCharge: number; // Number of field lines to start from each positive charge (or current source)
 }
 
+// E lines size each step from their curvature so they turn at most this much (rad)
+const MAX_TURN = 0.1;
+// B has no gradient kernel: |B| above which steps shrink and below which they grow (T)
+const MAGNETIC_STEP_THRESHOLDS = { strong: 1e-5, weak: 1e-8 };
+
 export class FieldLineRenderer {
   private scene: THREE.Scene;
   private fieldLines: THREE.Line[] = [];
   private config: FieldLineConfig;
   private charges: Charge[] = [];
+  private dataset: ChargeTree = buildChargeTree(packCharges([]));
+  private currents: CurrentSource[] = [];
+  private fieldKind: FieldKind = 'electric';
+  // Sources packed once per trace; single-point samples go through the batch kernels
+  private sources: FieldSources = emptyFieldSources();
+  private packedCurrents: PackedSegments = packCurrents([]);
+  private samplePoint = new Float64Array(3);
+  private sampleField = new Float64Array(3);
+  private sampleGradient = new Float64Array(9);
   private lineGroup: THREE.Group;
+  private tracedLines: Float32Array[] = []; // xyz polylines from the last trace
+  private flowConfig = createDefaultFieldLineFlowConfig();
+  private flow: FieldLineFlowRenderer;
+  private animated = false;
 
   constructor(scene: THREE.Scene, config: FieldLineConfig) {
     this.scene = scene;
     this.config = config;
     this.lineGroup = new THREE.Group();
     this.scene.add(this.lineGroup);
+    this.flow = new FieldLineFlowRenderer(this.lineGroup, this.flowConfig);
+    this.flow.setVisible(false);
     this.createFieldLines();
   }
 
@@ -32,22 +67,19 @@ export class FieldLineRenderer {
    * Runge-Kutta 4th order integration step
    * Traces one step along the field line
    */
-  private rk4Step(
-    position: THREE.Vector3,
-    charges: Charge[],
-    stepSize: number
-  ): THREE.Vector3 {
-    const k1 = this.getFieldDirection(position, charges);
+  private rk4Step(position: THREE.Vector3, stepSize: number, field: THREE.Vector3): THREE.Vector3 {
+    // k1 comes from the field the caller already evaluated at `position`
+    const k1 = field.lengthSq() > 0 ? field.clone().normalize() : new THREE.Vector3();
     if (k1.lengthSq() < 1e-12) return position.clone();
 
     const k2Pos = position.clone().add(k1.clone().multiplyScalar(stepSize * 0.5));
-    const k2 = this.getFieldDirection(k2Pos, charges);
+    const k2 = this.getFieldDirection(k2Pos);
 
     const k3Pos = position.clone().add(k2.clone().multiplyScalar(stepSize * 0.5));
-    const k3 = this.getFieldDirection(k3Pos, charges);
+    const k3 = this.getFieldDirection(k3Pos);
 
     const k4Pos = position.clone().add(k3.clone().multiplyScalar(stepSize));
-    const k4 = this.getFieldDirection(k4Pos, charges);
+    const k4 = this.getFieldDirection(k4Pos);
 
     // Weighted average (clone vectors to avoid mutation)
     const weightedDirection = k1
@@ -60,15 +92,34 @@ export class FieldLineRenderer {
     return position.clone().add(weightedDirection);
   }
 
+  /**
+   * Evaluate the current field kind at many points
+   */
+  private evaluateField(points: FloatArray, outField: FloatArray) {
+    if (this.fieldKind === 'magnetic') {
+      magneticFieldBatch(this.packedCurrents, points, outField);
+    } else {
+      sourcesFieldBatch(this.sources, points, outField);
+    }
+  }
+
+  /**
+   * Field at a single point
+   */
+  private fieldAt(position: THREE.Vector3): THREE.Vector3 {
+    position.toArray(this.samplePoint);
+    this.evaluateField(this.samplePoint, this.sampleField);
+    return new THREE.Vector3().fromArray(this.sampleField);
+  }
+
   /**
    * Get normalized field direction at a point
    */
-  private getFieldDirection(position: THREE.Vector3, charges: Charge[]): THREE.Vector3 {
-    const fieldResult = electricFieldAt(position, charges);
-    const field = fieldResult.field;
+  private getFieldDirection(position: THREE.Vector3): THREE.Vector3 {
+    const field = this.fieldAt(position);
     const magnitude = field.length();
     
-    if (magnitude < 1e-6) {
+    if (magnitude === 0) {
       return new THREE.Vector3(0, 0, 0);
     }
     
@@ -106,7 +157,8 @@ export class FieldLineRenderer {
   private traceFieldLine(
     startPosition: THREE.Vector3,
     charges: Charge[],
-    forward: boolean = true
+    forward: boolean = true,
+    closeTo: THREE.Vector3 | null = null // Stop once the line returns here (closed B lines)
   ): THREE.Vector3[] {
     const points: THREE.Vector3[] = [];
     let currentPos = startPosition.clone();
@@ -135,19 +187,33 @@ export class FieldLineRenderer {
         }
       }
 
+      let field: THREE.Vector3;
+      if (this.fieldKind === 'electric') {
+        // Curvature-aware step: E and ∇E come from one kernel pass, and that
+        // E is also the first RK4 stage
+        currentPos.toArray(this.samplePoint);
+        sourcesFieldGradientBatch(this.sources, this.samplePoint, this.sampleField, this.sampleGradient);
+        field = new THREE.Vector3().fromArray(this.sampleField);
+        const curvature = fieldLineCurvature(this.sampleField, this.sampleGradient);
+        stepSize = Math.min(
+          this.config.stepSize * 2,
+          Math.max(this.config.minStepSize, curvature > 0 ? MAX_TURN / curvature : Infinity)
+        );
+      } else {
+        field = this.fieldAt(currentPos);
+      }
+
       // Take a step
-      const nextPos = this.rk4Step(currentPos, charges, stepSize * direction);
-      
-      // Adaptive step sizing based on field strength
-      const fieldResult = electricFieldAt(currentPos, charges);
-      const fieldMagnitude = fieldResult.field.length();
-      
-      if (fieldMagnitude > 1e6) {
-        // Strong field - use smaller steps
-        stepSize = Math.max(this.config.minStepSize, stepSize * 0.5);
-      } else if (fieldMagnitude < 1e3) {
-        // Weak field - can use larger steps
-        stepSize = Math.min(this.config.stepSize * 2, stepSize * 1.1);
+      const nextPos = this.rk4Step(currentPos, stepSize * direction, field);
+
+      if (this.fieldKind === 'magnetic') {
+        // Adaptive step sizing based on field strength
+        const fieldMagnitude = field.length();
+        if (fieldMagnitude > MAGNETIC_STEP_THRESHOLDS.strong) {
+          stepSize = Math.max(this.config.minStepSize, stepSize * 0.5);
+        } else if (fieldMagnitude < MAGNETIC_STEP_THRESHOLDS.weak) {
+          stepSize = Math.min(this.config.stepSize * 2, stepSize * 1.1);
+        }
       }
 
       // Check if step is too small (converged or stuck)
@@ -157,6 +223,11 @@ export class FieldLineRenderer {
 
       currentPos = nextPos;
       points.push(currentPos.clone());
+
+      if (closeTo && step > 10 && currentPos.distanceTo(closeTo) < stepSize) {
+        points.push(closeTo.clone());
+        break;
+      }
     }
 
     return points;
@@ -186,18 +257,34 @@ export class FieldLineRenderer {
     return startPoints;
   }
 
+  /**
+   * Up to DATASET_SEED_CHARGES positive dataset charges, evenly spaced
+   * through the store order, so a large import still gets field lines
+   */
+  private datasetSeeds(): Charge[] {
+    const { positions, magnitudes } = this.dataset.charges;
+    return spacedPositiveCharges(this.dataset.charges, DATASET_SEED_CHARGES).map((i) => ({
+      id: `dataset-${i}`,
+      magnitude: magnitudes[i],
+      position: new THREE.Vector3().fromArray(positions, i * 3),
+    }));
+  }
+
   /**
    * Create all field lines
    */
   private createFieldLines() {
     this.clearFieldLines();
 
-    if (this.charges.length === 0) {
+    if (this.fieldKind === 'magnetic') {
+      this.createMagneticFieldLines();
       return;
     }
 
+    this.sources = { charges: packCharges(this.charges), dataset: this.dataset };
+
     // Find positive charges (field lines start from positive charges)
-    const positiveCharges = this.charges.filter(c => c.magnitude > 0);
+    const positiveCharges = this.charges.filter(c => c.magnitude > 0).concat(this.datasetSeeds());
 
     if (positiveCharges.length === 0) {
       return;
@@ -218,24 +305,108 @@ export class FieldLineRenderer {
         // Combine backward and forward points
         const allPoints = [...backwardPoints, ...forwardPoints.slice(1)];
 
-        if (allPoints.length < 2) {
-          continue; // Need at least 2 points for a line
+        this.addFieldLine(allPoints);
+      }
+    }
+
+    if (this.animated) {
+      this.updateFlowPaths();
+    }
+  }
+
+  /**
+   * B lines have no sources or sinks. Seed them on a radial line out from the
+   * middle of each wire (giving concentric rings) and across the diameter of
+   * each loop, and trace until the line closes or leaves the bounds.
+   */
+  private createMagneticFieldLines() {
+    this.packedCurrents = packCurrents(this.currents);
+    const count = this.config.linesPerCharge;
+
+    for (const source of this.currents) {
+      const path = currentSourcePath(source);
+      const seeds: THREE.Vector3[] = [];
+
+      if (source.kind === 'wire') {
+        const start = new THREE.Vector3().fromArray(path, 0);
+        const end = new THREE.Vector3().fromArray(path, 3);
+        const axis = end.clone().sub(start).normalize();
+        const middle = start.clone().add(end).multiplyScalar(0.5);
+        const helper = Math.abs(axis.x) < 0.9 ? new THREE.Vector3(1, 0, 0) : new THREE.Vector3(0, 1, 0);
+        const radial = helper.cross(axis).normalize();
+        for (let i = 0; i < count; i++) {
+          seeds.push(middle.clone().addScaledVector(radial, 0.3 + 0.5 * i));
+        }
+      } else {
+        const center = new THREE.Vector3(source.center.x, source.center.y, source.center.z);
+        const rim = new THREE.Vector3().fromArray(path, 0);
+        for (let i = 0; i < count; i++) {
+          // Skip the rim itself, where the field is softened
+          const fraction = -0.85 + (1.7 * i) / Math.max(count - 1, 1);
+          seeds.push(center.clone().lerp(rim, fraction));
         }
+      }
 
-        // Create the curve
-        const geometry = new THREE.BufferGeometry().setFromPoints(allPoints);
-        const material = new THREE.LineBasicMaterial({
-          color: this.config.color,
-          linewidth: this.config.lineWidth,
-          transparent: true,
-          opacity: this.config.opacity,
-        });
-
-        const line = new THREE.Line(geometry, material);
-        this.fieldLines.push(line);
-        this.lineGroup.add(line);
+      for (const seed of seeds) {
+        const forwardPoints = this.traceFieldLine(seed, [], true, seed);
+        const closed = forwardPoints.length > 2 &&
+          forwardPoints[forwardPoints.length - 1].equals(seed);
+        if (closed) {
+          this.addFieldLine(forwardPoints);
+          continue;
+        }
+        const backwardPoints = this.traceFieldLine(seed, [], false);
+        backwardPoints.reverse();
+        this.addFieldLine([...backwardPoints, ...forwardPoints.slice(1)]);
       }
     }
+
+    if (this.animated) {
+      this.updateFlowPaths();
+    }
+  }
+
+  private addFieldLine(allPoints: THREE.Vector3[]) {
+    if (allPoints.length < 2) {
+      return; // Need at least 2 points for a line
+    }
+
+    const packedPoints = new Float32Array(allPoints.length * 3);
+    allPoints.forEach((point, i) => point.toArray(packedPoints, i * 3));
+    this.tracedLines.push(packedPoints);
+
+    // Create the curve
+    const geometry = new THREE.BufferGeometry().setFromPoints(allPoints);
+    const material = new THREE.LineBasicMaterial({
+      color: this.config.color,
+      linewidth: this.config.lineWidth,
+      transparent: true,
+      opacity: this.config.opacity,
+    });
+
+    const line = new THREE.Line(geometry, material);
+    this.fieldLines.push(line);
+    this.lineGroup.add(line);
+  }
+
+  /**
+   * Build travel-time tables for the traced lines (|E| or |B| from one batch
+   * call per line) and hand them to the flow glyphs. Runs once per trace, never per frame.
+   */
+  private updateFlowPaths() {
+    const flowConfig = this.fieldKind === 'magnetic'
+      ? { ...this.flowConfig, referenceField: this.flowConfig.referenceMagneticField }
+      : this.flowConfig;
+    const paths = this.tracedLines.map((points) => {
+      const fields = new Float32Array(points.length);
+      this.evaluateField(points, fields);
+      const magnitudes = new Float32Array(points.length / 3);
+      for (let i = 0; i < magnitudes.length; i++) {
+        magnitudes[i] = Math.hypot(fields[i * 3], fields[i * 3 + 1], fields[i * 3 + 2]);
+      }
+      return buildFlowPath(points, magnitudes, flowConfig);
+    });
+    this.flow.setPaths(paths);
   }
 
   /**
@@ -248,13 +419,56 @@ export class FieldLineRenderer {
       (line.material as THREE.Material).dispose();
     }
     this.fieldLines = [];
+    this.tracedLines = [];
+    this.flow.clear();
+  }
+
+  /**
+   * Polylines (xyz) from the last trace
+   */
+  public getTracedLines(): Float32Array[] {
+    return this.tracedLines;
+  }
+
+  /**
+   * The traced lines as one line list, for glTF export
+   */
+  public getGltfNode(): GltfNodeSource | null {
+    if (this.tracedLines.length === 0 || !this.lineGroup.visible) return null;
+    const color = new THREE.Color(this.config.color);
+    return {
+      name: 'Field lines',
+      geometry: gltfGeometryFromPolylines(this.tracedLines),
+      material: { color: [color.r, color.g, color.b, this.config.opacity], unlit: true, doubleSided: false },
+      instances: null,
+    };
   }
 
   /**
    * Update charges and regenerate field lines
    */
-  public updateCharges(charges: Charge[]) {
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
     this.charges = charges;
+    this.dataset = dataset;
+    this.createFieldLines();
+  }
+
+  /**
+   * Update current sources; lines are retraced only when B is shown
+   */
+  public updateCurrents(currents: CurrentSource[]) {
+    this.currents = currents;
+    if (this.fieldKind === 'magnetic') {
+      this.createFieldLines();
+    }
+  }
+
+  /**
+   * Trace E lines from the charges or B lines around the currents
+   */
+  public setFieldKind(kind: FieldKind) {
+    if (kind === this.fieldKind) return;
+    this.fieldKind = kind;
     this.createFieldLines();
   }
 
@@ -265,6 +479,28 @@ export class FieldLineRenderer {
     this.lineGroup.visible = visible;
   }
 
+  /**
+   * Toggle glyphs flowing along the lines at speeds proportional to |E|
+   */
+  public setAnimated(animated: boolean) {
+    this.animated = animated;
+    this.flow.setVisible(animated);
+    if (animated) {
+      this.updateFlowPaths();
+    } else {
+      this.flow.clear();
+    }
+  }
+
+  /**
+   * Advance the flow animation
+   */
+  public update(deltaSeconds: number) {
+    if (this.animated && this.lineGroup.visible) {
+      this.flow.update(deltaSeconds);
+    }
+  }
+
   /**
    * Update configuration
    */
@@ -278,6 +514,7 @@ export class FieldLineRenderer {
    */
   public dispose() {
     this.clearFieldLines();
+    this.flow.dispose();
     this.scene.remove(this.lineGroup);
   }
 }
@@ -0,0 +1,96 @@
+import * as THREE from 'three';
+
+export interface ForceArrowConfig {
+  maxLength: number; // Length of the arrow for the largest force
+  minLength: number;
+  color: number;
+}
+
+/**
+ * Net force on each charge as one instanced arrow per charge, starting at the
+ * charge and scaled relative to the largest force in the scene
+ */
+export class ForceArrowRenderer {
+  private scene: THREE.Scene;
+  private config: ForceArrowConfig;
+  private geometry: THREE.ConeGeometry;
+  private material: THREE.MeshBasicMaterial;
+  private mesh: THREE.InstancedMesh | null = null;
+  private upVector = new THREE.Vector3(0, 1, 0);
+  private visible = true;
+
+  constructor(scene: THREE.Scene, config: ForceArrowConfig = createDefaultForceArrowConfig()) {
+    this.scene = scene;
+    this.config = config;
+    // Unit-height cone with its base at the origin, stretched per instance
+    this.geometry = new THREE.ConeGeometry(0.06, 1, 8);
+    this.geometry.translate(0, 0.5, 0);
+    this.material = new THREE.MeshBasicMaterial({ color: config.color, transparent: true, opacity: 0.9 });
+  }
+
+  /**
+   * `positions` and `forces` are xyz interleaved, one entry per charge
+   */
+  public updateForces(positions: Float64Array, forces: Float64Array) {
+    const count = forces.length / 3;
+    if (!this.mesh || this.mesh.instanceMatrix.count < count) {
+      if (this.mesh) {
+        this.scene.remove(this.mesh);
+        this.mesh.dispose();
+      }
+      this.mesh = new THREE.InstancedMesh(this.geometry, this.material, Math.max(count, 16));
+      this.mesh.frustumCulled = false;
+      this.mesh.visible = this.visible;
+      this.scene.add(this.mesh);
+    }
+
+    let maxForce = 0;
+    for (let i = 0; i < count; i++) {
+      maxForce = Math.max(maxForce, Math.hypot(forces[i * 3], forces[i * 3 + 1], forces[i * 3 + 2]));
+    }
+
+    const matrix = new THREE.Matrix4();
+    const position = new THREE.Vector3();
+    const direction = new THREE.Vector3();
+    const quaternion = new THREE.Quaternion();
+    const scale = new THREE.Vector3();
+    const { maxLength, minLength } = this.config;
+
+    for (let i = 0; i < count; i++) {
+      direction.fromArray(forces, i * 3);
+      const magnitude = direction.length();
+      if (magnitude === 0 || maxForce === 0) {
+        matrix.makeScale(0, 0, 0);
+      } else {
+        const length = minLength + (maxLength - minLength) * (magnitude / maxForce);
+        quaternion.setFromUnitVectors(this.upVector, direction.normalize());
+        matrix.compose(position.fromArray(positions, i * 3), quaternion, scale.set(1, length, 1));
+      }
+      this.mesh.setMatrixAt(i, matrix);
+    }
+    this.mesh.count = count;
+    this.mesh.instanceMatrix.needsUpdate = true;
+  }
+
+  public setVisible(visible: boolean) {
+    this.visible = visible;
+    if (this.mesh) this.mesh.visible = visible;
+  }
+
+  public dispose() {
+    if (this.mesh) {
+      this.scene.remove(this.mesh);
+      this.mesh.dispose();
+    }
+    this.geometry.dispose();
+    this.material.dispose();
+  }
+}
+
+export function createDefaultForceArrowConfig(): ForceArrowConfig {
+  return {
+    maxLength: 1.5,
+    minLength: 0.2,
+    color: 0xff9800, // Orange
+  };
+}
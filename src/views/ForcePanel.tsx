@@ -0,0 +1,98 @@
+import React from 'react';
+import type { ChargeInteractionResult } from '../models/ChargeForces';
+import type { Vec3Like } from '../models/FieldKernel';
+
+interface ForcePanelProps {
+  enabled: boolean;
+  result: ChargeInteractionResult | null;
+  group: string[]; // Charge ids whose combined force and torque are shown
+  groupResult: { force: Vec3Like; torque: Vec3Like } | null;
+  onToggle: () => void;
+  onToggleGroupMember: (chargeId: string) => void;
+}
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const MAX_LISTED = 20; // Longer scenes list only the first charges
+
+const formatVector = (v: Vec3Like) =>
+  `(${v.x.toExponential(2)}, ${v.y.toExponential(2)}, ${v.z.toExponential(2)})`;
+
+const ForcePanel: React.FC<ForcePanelProps> = ({
+  enabled,
+  result,
+  group,
+  groupResult,
+  onToggle,
+  onToggleGroupMember,
+}) => {
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>Forces & Energy</div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '10px' }}>
+        <button onClick={onToggle} style={{ ...buttonStyle, background: enabled ? '#f44336' : '#4CAF50' }}>
+          {enabled ? 'Hide Forces' : 'Show Forces'}
+        </button>
+      </div>
+
+      {enabled && result && (
+        <div style={{ fontSize: '10px' }}>
+          <div style={{ fontSize: '11px' }}>U = {result.energy.toExponential(4)} J</div>
+          <div style={{ color: '#aaa', marginBottom: '5px' }}>
+            Base: {result.method === 'tree' ? 'tree code' : 'direct sum'}, last update: {result.update}
+          </div>
+
+          {result.ids.slice(0, MAX_LISTED).map((id, i) => {
+            const force = { x: result.forces[i * 3], y: result.forces[i * 3 + 1], z: result.forces[i * 3 + 2] };
+            return (
+              <label key={id} style={{ display: 'flex', gap: '5px', alignItems: 'center' }}>
+                <input
+                  type="checkbox"
+                  checked={group.includes(id)}
+                  onChange={() => onToggleGroupMember(id)}
+                />
+                <span>
+                  #{i + 1} |F| = {Math.hypot(force.x, force.y, force.z).toExponential(3)} N
+                </span>
+              </label>
+            );
+          })}
+          {result.ids.length > MAX_LISTED && (
+            <div style={{ color: '#aaa' }}>…and {result.ids.length - MAX_LISTED} more</div>
+          )}
+
+          {groupResult ? (
+            <div style={{ borderTop: '1px solid #444', marginTop: '5px', paddingTop: '5px' }}>
+              <div>Group of {group.length} (about its centroid)</div>
+              <div>F = {formatVector(groupResult.force)} N</div>
+              <div>τ = {formatVector(groupResult.torque)} N·m</div>
+            </div>
+          ) : (
+            <div style={{ color: '#aaa', marginTop: '5px' }}>Tick charges to see a group's force and torque.</div>
+          )}
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default ForcePanel;
@@ -0,0 +1,187 @@
+import React, { useState } from 'react';
+import { PHYSICS_CONSTANTS } from '../models/Charge';
+import type { GaussFluxResult } from '../models/GaussFlux';
+import type { GaussSurface } from '../models/GaussSurface';
+
+interface GaussPanelProps {
+  surfaces: GaussSurface[];
+  results: Record<string, GaussFluxResult>;
+  onAddSurface: (surface: GaussSurface) => void;
+  onImportMesh: (file: File) => void;
+  onRemoveSurface: (surfaceId: string) => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const surfaceLabel = (surface: GaussSurface): string => {
+  switch (surface.kind) {
+    case 'sphere':
+      return `Sphere r=${surface.radius}`;
+    case 'box':
+      return `Box ${surface.size.x}×${surface.size.y}×${surface.size.z}`;
+    case 'mesh':
+      return `Mesh ${surface.name}`;
+  }
+};
+
+const GaussPanel: React.FC<GaussPanelProps> = ({
+  surfaces,
+  results,
+  onAddSurface,
+  onImportMesh,
+  onRemoveSurface,
+}) => {
+  const [kind, setKind] = useState<'sphere' | 'box'>('sphere');
+  const [center, setCenter] = useState({ x: 0, y: 0, z: 0 });
+  const [size, setSize] = useState(1.5); // Radius or box side
+
+  const addSurface = () => {
+    const id = `gauss-${Date.now()}`;
+    if (kind === 'sphere') {
+      onAddSurface({ id, kind, center: { ...center }, radius: size });
+    } else {
+      onAddSurface({ id, kind, center: { ...center }, size: { x: size, y: size, z: size } });
+    }
+  };
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Gauss Surfaces ({surfaces.length})
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Shape
+          <select
+            value={kind}
+            onChange={(e) => setKind(e.target.value as 'sphere' | 'box')}
+            style={inputStyle}
+          >
+            <option value="sphere">Sphere</option>
+            <option value="box">Box</option>
+          </select>
+        </label>
+        <label>
+          {kind === 'sphere' ? 'Radius' : 'Side'}
+          {numberInput(size, setSize)}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          X
+          {numberInput(center.x, (x) => setCenter((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(center.y, (y) => setCenter((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(center.z, (z) => setCenter((prev) => ({ ...prev, z })))}
+        </label>
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '10px' }}>
+        <button onClick={addSurface} style={{ ...buttonStyle, background: '#4CAF50' }}>
+          + Add
+        </button>
+        <label style={{ ...buttonStyle, background: '#2196F3', textAlign: 'center' }}>
+          Import OBJ
+          <input
+            type="file"
+            accept=".obj"
+            style={{ display: 'none' }}
+            onChange={(e) => {
+              const file = e.target.files?.[0];
+              if (file) onImportMesh(file);
+              e.target.value = '';
+            }}
+          />
+        </label>
+      </div>
+
+      {surfaces.map((surface) => {
+        const result = results[surface.id];
+        return (
+          <div
+            key={surface.id}
+            style={{
+              borderTop: '1px solid #444',
+              paddingTop: '5px',
+              marginBottom: '5px',
+              fontSize: '10px',
+            }}
+          >
+            <div style={{ display: 'flex', justifyContent: 'space-between', alignItems: 'center' }}>
+              <span>{surfaceLabel(surface)}</span>
+              <button
+                onClick={() => onRemoveSurface(surface.id)}
+                style={{
+                  padding: '2px 6px',
+                  background: '#f44336',
+                  color: 'white',
+                  border: 'none',
+                  borderRadius: '3px',
+                  cursor: 'pointer',
+                  fontSize: '10px',
+                }}
+              >
+                Remove
+              </button>
+            </div>
+            {result && (
+              <>
+                <div>∮E·dA = {result.flux.toExponential(4)} N·m²/C</div>
+                <div>
+                  Q_enc/ε₀ = {(result.enclosedCharge / PHYSICS_CONSTANTS.EPSILON_0).toExponential(4)} N·m²/C
+                </div>
+                <div>Q_enc = {(result.enclosedCharge * 1e6).toFixed(3)} μC</div>
+              </>
+            )}
+          </div>
+        );
+      })}
+    </div>
+  );
+};
+
+export default GaussPanel;
@@ -0,0 +1,63 @@
+import * as THREE from 'three';
+
+/**
+ * Translucent Gauss surfaces with a wireframe overlay, drawn from the same
+ * triangles the flux integrator uses (also used for conductor panels)
+ */
+export class GaussSurfaceRenderer {
+  private scene: THREE.Scene;
+  private group: THREE.Group;
+  private surfaceMaterial: THREE.MeshBasicMaterial;
+  private wireMaterial: THREE.LineBasicMaterial;
+
+  constructor(scene: THREE.Scene, color: number = 0x00bcd4) {
+    this.scene = scene;
+    this.group = new THREE.Group();
+    this.scene.add(this.group);
+    this.surfaceMaterial = new THREE.MeshBasicMaterial({
+      color,
+      transparent: true,
+      opacity: 0.12,
+      side: THREE.DoubleSide,
+      depthWrite: false,
+    });
+    this.wireMaterial = new THREE.LineBasicMaterial({
+      color,
+      transparent: true,
+      opacity: 0.35,
+    });
+  }
+
+  /**
+   * One entry per surface: its triangle soup (9 floats per triangle)
+   */
+  public updateSurfaces(surfaces: Float64Array[]) {
+    this.clear();
+    for (const triangles of surfaces) {
+      const geometry = new THREE.BufferGeometry();
+      geometry.setAttribute('position', new THREE.BufferAttribute(new Float32Array(triangles), 3));
+      this.group.add(new THREE.Mesh(geometry, this.surfaceMaterial));
+      this.group.add(new THREE.LineSegments(new THREE.WireframeGeometry(geometry), this.wireMaterial));
+    }
+  }
+
+  private clear() {
+    for (const child of [...this.group.children]) {
+      if (child instanceof THREE.Mesh || child instanceof THREE.LineSegments) {
+        child.geometry.dispose();
+      }
+      this.group.remove(child);
+    }
+  }
+
+  public setVisible(visible: boolean) {
+    this.group.visible = visible;
+  }
+
+  public dispose() {
+    this.clear();
+    this.scene.remove(this.group);
+    this.surfaceMaterial.dispose();
+    this.wireMaterial.dispose();
+  }
+}
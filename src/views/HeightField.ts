@@ -0,0 +1,393 @@
+import * as THREE from 'three';
+import type { ExportMesh } from '../export/VtkExport';
+import type { GltfNodeSource } from '../export/GltfExport';
+import type { Charge } from '../models/Charge';
+import type { ChargeTree } from '../models/ChargeTree';
+import { packCharges } from '../models/FieldKernel';
+import { emptyFieldSources, shareChargeTree } from '../models/FieldSources';
+import type { FieldSources } from '../models/FieldSources';
+import { heightFieldTilesPerSide, heightFieldVertex, tileHeightChangeBound } from '../models/HeightField';
+import type { HeightFieldSpec, HeightTile } from '../models/HeightField';
+import { slicePlaneBasis } from '../models/PotentialSlice';
+import type { SlicePlane } from '../models/PotentialSlice';
+import type { HeightFieldWorkerRequest, HeightFieldWorkerResult } from '../workers/heightField.worker';
+
+export interface HeightFieldConfig {
+  cells: number; // Grid cells per side; a multiple of tileCells
+  tileCells: number; // Cells per tile side; a power of two
+  maxHeight: number;
+  referencePotential: number; // V
+  lodTolerance: number; // Height error allowed by coarser tessellation
+  updateTolerance: number; // Height change below which a tile keeps its old heights
+  wireframe: boolean;
+}
+
+export interface HeightFieldStats {
+  tilesUpdated: number; // Tiles recomputed by the last worker reply
+  tiles: number;
+  triangles: number;
+}
+
+const NEGATIVE = new THREE.Color(0.23, 0.3, 0.75);
+const NEUTRAL = new THREE.Color(1, 1, 1);
+const POSITIVE = new THREE.Color(0.7, 0.02, 0.15);
+
+/**
+ * Potential on a plane drawn as a displaced "rubber sheet" surface, one
+ * mesh per tile. Heights come from a worker; on charge edits each tile
+ * accumulates a bound on how far its heights may have moved, and only tiles
+ * whose bound passes updateTolerance are recomputed. Requests coalesce the
+ * same way as the probe shapes: while one is in flight, newly dirty tiles
+ * wait for the reply.
+ *
+ * Every tile picks its own tessellation step. Tiles read heights from one
+ * shared vertex grid, and an edge shared with a coarser neighbour is
+ * interpolated at that neighbour's step, so adjacent tiles meet without
+ * gaps.
+ */
+export class HeightFieldRenderer {
+  private scene: THREE.Scene;
+  private config: HeightFieldConfig;
+  private onStats: (stats: HeightFieldStats | null) => void;
+  private worker: Worker;
+  private group: THREE.Group;
+  private material: THREE.MeshStandardMaterial;
+  private meshes: (THREE.Mesh | null)[] = [];
+  private plane: SlicePlane | null = null;
+  private spec: HeightFieldSpec | null = null;
+  private sources: FieldSources = emptyFieldSources();
+  private grid = new Float32Array(0); // Heights of every vertex, (cells + 1)²
+  private steps = new Int32Array(0); // Tessellation step per tile; 0 until computed
+  private drift = new Float64Array(0); // Height change bound accumulated since each tile's last request
+  private dirty = new Set<number>();
+  private generation = 0;
+  private inFlight = false;
+
+  constructor(
+    scene: THREE.Scene,
+    onStats: (stats: HeightFieldStats | null) => void,
+    config: HeightFieldConfig = createDefaultHeightFieldConfig()
+  ) {
+    this.scene = scene;
+    this.onStats = onStats;
+    this.config = config;
+    this.group = new THREE.Group();
+    this.scene.add(this.group);
+    this.material = new THREE.MeshStandardMaterial({
+      vertexColors: true,
+      side: THREE.DoubleSide,
+      roughness: 0.7,
+      wireframe: config.wireframe,
+    });
+
+    this.worker = new Worker(new URL('../workers/heightField.worker.ts', import.meta.url), { type: 'module' });
+    this.worker.onmessage = (event: MessageEvent<HeightFieldWorkerResult>) => {
+      this.inFlight = false;
+      if (event.data.generation === this.generation) this.applyTiles(event.data.tiles);
+      this.request();
+    };
+  }
+
+  public setPlane(plane: SlicePlane | null) {
+    this.plane = plane;
+    this.reset();
+  }
+
+  public setConfig(config: HeightFieldConfig) {
+    const previous = this.config;
+    this.config = config;
+    this.material.wireframe = config.wireframe;
+    if (
+      config.cells !== previous.cells ||
+      config.tileCells !== previous.tileCells ||
+      config.maxHeight !== previous.maxHeight ||
+      config.referencePotential !== previous.referencePotential ||
+      config.lodTolerance !== previous.lodTolerance
+    ) {
+      this.reset();
+    }
+  }
+
+  /**
+   * Mark the tiles a charge edit may have moved by more than updateTolerance;
+   * a new dataset marks them all, and is sent to the worker once
+   */
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
+    const next = packCharges(charges);
+    const spec = this.spec;
+    const datasetChanged = dataset !== this.sources.dataset;
+    if (datasetChanged) {
+      const message: HeightFieldWorkerRequest = { type: 'dataset', dataset: shareChargeTree(dataset) };
+      this.worker.postMessage(message);
+    }
+    if (spec) {
+      for (let tile = 0; tile < this.drift.length; tile++) {
+        this.drift[tile] += datasetChanged ? Infinity : tileHeightChangeBound(spec, tile, this.sources.charges, next);
+        if (this.drift[tile] > this.config.updateTolerance) this.dirty.add(tile);
+      }
+    }
+    this.sources = { charges: next, dataset };
+    this.request();
+  }
+
+  /**
+   * Drop every tile and recompute the whole surface
+   */
+  private reset() {
+    this.generation++;
+    this.clearMeshes();
+    if (!this.plane) {
+      this.spec = null;
+      this.dirty.clear();
+      this.onStats(null);
+      return;
+    }
+    const { cells, tileCells, maxHeight, referencePotential, lodTolerance } = this.config;
+    this.spec = { plane: this.plane, cells, tileCells, maxHeight, referencePotential, lodTolerance };
+    const tiles = heightFieldTilesPerSide(this.spec) ** 2;
+    this.grid = new Float32Array((cells + 1) * (cells + 1));
+    this.steps = new Int32Array(tiles);
+    this.drift = new Float64Array(tiles);
+    this.meshes = new Array(tiles).fill(null);
+    this.dirty = new Set(Array.from({ length: tiles }, (_, tile) => tile));
+    this.request();
+  }
+
+  private request() {
+    if (this.inFlight || !this.spec || this.dirty.size === 0) return;
+    const tiles = Array.from(this.dirty);
+    this.dirty.clear();
+    for (const tile of tiles) this.drift[tile] = 0;
+    const message: HeightFieldWorkerRequest = {
+      type: 'tiles',
+      generation: this.generation,
+      charges: this.sources.charges,
+      spec: this.spec,
+      tiles,
+    };
+    this.inFlight = true;
+    this.worker.postMessage(message);
+  }
+
+  private applyTiles(computed: HeightTile[]) {
+    const spec = this.spec!;
+    const tiles = heightFieldTilesPerSide(spec);
+    const n = spec.tileCells + 1;
+    const stride = spec.cells + 1;
+    const rebuild = new Set<number>();
+    for (const { tile, heights, step } of computed) {
+      const i0 = (tile % tiles) * spec.tileCells;
+      const j0 = Math.floor(tile / tiles) * spec.tileCells;
+      for (let j = 0; j < n; j++) {
+        this.grid.set(heights.subarray(j * n, (j + 1) * n), (j0 + j) * stride + i0);
+      }
+      this.steps[tile] = step;
+      // Neighbours share edge vertices, and their edges follow this tile's step
+      const tx = tile % tiles;
+      const ty = Math.floor(tile / tiles);
+      for (let y = Math.max(0, ty - 1); y <= Math.min(tiles - 1, ty + 1); y++) {
+        for (let x = Math.max(0, tx - 1); x <= Math.min(tiles - 1, tx + 1); x++) rebuild.add(y * tiles + x);
+      }
+    }
+    for (const tile of rebuild) {
+      if (this.steps[tile] > 0) this.buildTile(tile);
+    }
+
+    let triangles = 0;
+    for (const mesh of this.meshes) {
+      if (mesh) triangles += mesh.geometry.index!.count / 3;
+    }
+    this.onStats({ tilesUpdated: computed.length, tiles: this.meshes.length, triangles });
+  }
+
+  /**
+   * Height of the shared grid at (gi, gj) as seen along a tile edge
+   * tessellated with `step`: linear between that step's vertices
+   */
+  private edgeHeight(gi: number, gj: number, alongI: boolean, step: number): number {
+    const stride = this.spec!.cells + 1;
+    const along = alongI ? gi : gj;
+    const below = Math.floor(along / step) * step;
+    if (below === along) return this.grid[gj * stride + gi];
+    const t = (along - below) / step;
+    const a = alongI ? this.grid[gj * stride + below] : this.grid[below * stride + gi];
+    const b = alongI ? this.grid[gj * stride + below + step] : this.grid[(below + step) * stride + gi];
+    return a + (b - a) * t;
+  }
+
+  private buildTile(tile: number) {
+    const spec = this.spec!;
+    const tiles = heightFieldTilesPerSide(spec);
+    const tx = tile % tiles;
+    const ty = Math.floor(tile / tiles);
+    const step = this.steps[tile];
+    const cells = spec.tileCells;
+    const side = cells / step + 1;
+    const i0 = tx * cells;
+    const j0 = ty * cells;
+    const stride = spec.cells + 1;
+    // Step of each edge: the coarser of this tile and the neighbour across it
+    const neighbourStep = (x: number, y: number) =>
+      x < 0 || y < 0 || x >= tiles || y >= tiles ? step : Math.max(step, this.steps[y * tiles + x]);
+    const bottom = neighbourStep(tx, ty - 1);
+    const top = neighbourStep(tx, ty + 1);
+    const left = neighbourStep(tx - 1, ty);
+    const right = neighbourStep(tx + 1, ty);
+
+    const { u, v } = slicePlaneBasis(spec.plane);
+    const normal = new THREE.Vector3(u.x, u.y, u.z).cross(new THREE.Vector3(v.x, v.y, v.z)).normalize();
+    const positions = new Float32Array(side * side * 3);
+    const colors = new Float32Array(side * side * 3);
+    const heights = new Float32Array(side * side);
+    const vertex = { x: 0, y: 0, z: 0 };
+    const color = new THREE.Color();
+    for (let j = 0; j < side; j++) {
+      for (let i = 0; i < side; i++) {
+        const gi = i0 + i * step;
+        const gj = j0 + j * step;
+        let height = this.grid[gj * stride + gi];
+        if (j === 0) height = this.edgeHeight(gi, gj, true, bottom);
+        else if (j === side - 1) height = this.edgeHeight(gi, gj, true, top);
+        else if (i === 0) height = this.edgeHeight(gi, gj, false, left);
+        else if (i === side - 1) height = this.edgeHeight(gi, gj, false, right);
+
+        heightFieldVertex(spec, gi, gj, vertex);
+        heights[j * side + i] = height;
+        const k = (j * side + i) * 3;
+        positions[k] = vertex.x + normal.x * height;
+        positions[k + 1] = vertex.y + normal.y * height;
+        positions[k + 2] = vertex.z + normal.z * height;
+        const t = Math.max(-1, Math.min(1, height / spec.maxHeight));
+        if (t < 0) color.lerpColors(NEUTRAL, NEGATIVE, -t);
+        else color.lerpColors(NEUTRAL, POSITIVE, t);
+        colors[k] = color.r;
+        colors[k + 1] = color.g;
+        colors[k + 2] = color.b;
+      }
+    }
+
+    // Two triangles per cell, split along its (0,0)-(1,1) diagonal as in tessellationStep
+    const indices: number[] = [];
+    for (let j = 0; j < side - 1; j++) {
+      for (let i = 0; i < side - 1; i++) {
+        const a = j * side + i;
+        indices.push(a, a + 1, a + side + 1, a, a + side + 1, a + side);
+      }
+    }
+
+    const geometry = new THREE.BufferGeometry();
+    geometry.setAttribute('position', new THREE.Float32BufferAttribute(positions, 3));
+    geometry.setAttribute('color', new THREE.Float32BufferAttribute(colors, 3));
+    geometry.setAttribute('height', new THREE.Float32BufferAttribute(heights, 1));
+    geometry.setIndex(indices);
+    geometry.computeVertexNormals();
+
+    const previous = this.meshes[tile];
+    if (previous) {
+      this.group.remove(previous);
+      previous.geometry.dispose();
+    }
+    const mesh = new THREE.Mesh(geometry, this.material);
+    this.meshes[tile] = mesh;
+    this.group.add(mesh);
+  }
+
+  /**
+   * All tiles merged into one indexed mesh, as drawn, with heights as the
+   * vertex scalar; null until the surface has been computed
+   */
+  public getMesh(): ExportMesh | null {
+    const merged = this.mergeTiles(['position', 'height']);
+    if (!merged) return null;
+    const { attributes, indices } = merged;
+    return { positions: attributes.position, indices, scalarName: 'height', scalars: attributes.height };
+  }
+
+  /**
+   * The merged surface with its normals and colours, for glTF export
+   */
+  public getGltfNode(): GltfNodeSource | null {
+    if (!this.group.visible) return null;
+    const merged = this.mergeTiles(['position', 'normal', 'color']);
+    if (!merged) return null;
+    const { attributes, indices } = merged;
+    return {
+      name: 'Potential surface',
+      geometry: {
+        mode: 'triangles',
+        positions: attributes.position,
+        normals: attributes.normal,
+        colors: attributes.color,
+        indices,
+      },
+      material: { color: [1, 1, 1, 1], unlit: false, doubleSided: true },
+      instances: null,
+    };
+  }
+
+  /**
+   * Concatenate the named attributes of every built tile, with indices
+   * offset to match
+   */
+  private mergeTiles(names: string[]): { attributes: Record<string, Float32Array>; indices: Uint32Array } | null {
+    const meshes = this.meshes.filter((mesh): mesh is THREE.Mesh => mesh !== null);
+    if (meshes.length === 0) return null;
+    let vertexCount = 0;
+    let indexCount = 0;
+    for (const mesh of meshes) {
+      vertexCount += mesh.geometry.getAttribute('position').count;
+      indexCount += mesh.geometry.index!.count;
+    }
+    const attributes: Record<string, Float32Array> = {};
+    for (const name of names) {
+      attributes[name] = new Float32Array(vertexCount * meshes[0].geometry.getAttribute(name).itemSize);
+    }
+    const indices = new Uint32Array(indexCount);
+    let vertexOffset = 0;
+    let indexOffset = 0;
+    for (const mesh of meshes) {
+      const geometry = mesh.geometry;
+      for (const name of names) {
+        const attribute = geometry.getAttribute(name);
+        attributes[name].set(attribute.array as Float32Array, vertexOffset * attribute.itemSize);
+      }
+      const index = geometry.index!.array;
+      for (let i = 0; i < index.length; i++) indices[indexOffset + i] = index[i] + vertexOffset;
+      vertexOffset += geometry.getAttribute('position').count;
+      indexOffset += index.length;
+    }
+    return { attributes, indices };
+  }
+
+  private clearMeshes() {
+    for (const mesh of this.meshes) {
+      if (!mesh) continue;
+      this.group.remove(mesh);
+      mesh.geometry.dispose();
+    }
+    this.meshes = [];
+  }
+
+  public setVisible(visible: boolean) {
+    this.group.visible = visible;
+  }
+
+  public dispose() {
+    this.worker.terminate();
+    this.clearMeshes();
+    this.scene.remove(this.group);
+    this.material.dispose();
+  }
+}
+
+export function createDefaultHeightFieldConfig(): HeightFieldConfig {
+  return {
+    cells: 256,
+    tileCells: 32,
+    maxHeight: 2.5,
+    referencePotential: 2e4,
+    lodTolerance: 0.01,
+    updateTolerance: 0.005,
+    wireframe: false,
+  };
+}
@@ -0,0 +1,169 @@
+import React, { useState } from 'react';
+import type { SliceAxis, SlicePlane } from '../models/PotentialSlice';
+import type { HeightFieldConfig, HeightFieldStats } from './HeightField';
+
+interface HeightFieldPanelProps {
+  config: HeightFieldConfig;
+  stats: HeightFieldStats | null;
+  onPlaneChange: (plane: SlicePlane | null) => void;
+  onConfigChange: (config: HeightFieldConfig) => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const HeightFieldPanel: React.FC<HeightFieldPanelProps> = ({ config, stats, onPlaneChange, onConfigChange }) => {
+  const [shown, setShown] = useState(false);
+  const [plane, setPlane] = useState<SlicePlane>({ axis: 'y', offset: 0, halfSize: 5 });
+
+  const updatePlane = (next: SlicePlane) => {
+    setPlane(next);
+    if (shown) onPlaneChange(next);
+  };
+
+  const toggle = () => {
+    setShown(!shown);
+    onPlaneChange(shown ? null : plane);
+  };
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>Potential Surface</div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Normal
+          <select
+            value={plane.axis}
+            onChange={(e) => updatePlane({ ...plane, axis: e.target.value as SliceAxis })}
+            style={inputStyle}
+          >
+            <option value="x">X</option>
+            <option value="y">Y</option>
+            <option value="z">Z</option>
+          </select>
+        </label>
+        <label>
+          Offset
+          <input
+            type="number"
+            step={0.5}
+            value={plane.offset}
+            onChange={(e) => updatePlane({ ...plane, offset: parseFloat(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Half size
+          <input
+            type="number"
+            min={0.5}
+            step={0.5}
+            value={plane.halfSize}
+            onChange={(e) => updatePlane({ ...plane, halfSize: Math.max(0.5, parseFloat(e.target.value) || 0) })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Grid
+          <select
+            value={config.cells}
+            onChange={(e) => onConfigChange({ ...config, cells: parseInt(e.target.value) })}
+            style={inputStyle}
+          >
+            <option value={128}>128²</option>
+            <option value={256}>256²</option>
+            <option value={512}>512²</option>
+          </select>
+        </label>
+        <label>
+          Max height
+          <input
+            type="number"
+            min={0.1}
+            step={0.5}
+            value={config.maxHeight}
+            onChange={(e) => onConfigChange({ ...config, maxHeight: Math.max(0.1, parseFloat(e.target.value) || 0) })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Ref V
+          <input
+            type="number"
+            value={config.referencePotential}
+            onChange={(e) =>
+              onConfigChange({ ...config, referencePotential: Math.max(1, parseFloat(e.target.value) || 0) })
+            }
+            style={inputStyle}
+          />
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Detail tol.
+          <input
+            type="number"
+            min={0.001}
+            step={0.005}
+            value={config.lodTolerance}
+            onChange={(e) =>
+              onConfigChange({ ...config, lodTolerance: Math.max(0.001, parseFloat(e.target.value) || 0) })
+            }
+            style={inputStyle}
+          />
+        </label>
+        <label style={{ display: 'flex', alignItems: 'flex-end', gap: '5px' }}>
+          <input
+            type="checkbox"
+            checked={config.wireframe}
+            onChange={(e) => onConfigChange({ ...config, wireframe: e.target.checked })}
+          />
+          Wireframe
+        </label>
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <button onClick={toggle} style={{ ...buttonStyle, background: shown ? '#f44336' : '#4CAF50' }}>
+          {shown ? 'Hide Surface' : 'Show Surface'}
+        </button>
+      </div>
+
+      {shown && stats && (
+        <div style={{ fontSize: '10px', color: '#aaa' }}>
+          {stats.triangles} triangles, last update {stats.tilesUpdated}/{stats.tiles} tiles
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default HeightFieldPanel;
@@ -0,0 +1,44 @@
+import * as THREE from 'three';
+import type { Vec3Like } from '../models/FieldKernel';
+
+/**
+ * The polyline used for line integrals, with a dot at each waypoint
+ */
+export class IntegrationPathRenderer {
+  private scene: THREE.Scene;
+  private geometry: THREE.BufferGeometry;
+  private line: THREE.Line;
+  private points: THREE.Points;
+  private lineMaterial: THREE.LineBasicMaterial;
+  private pointMaterial: THREE.PointsMaterial;
+
+  constructor(scene: THREE.Scene) {
+    this.scene = scene;
+    this.geometry = new THREE.BufferGeometry();
+    this.lineMaterial = new THREE.LineBasicMaterial({ color: 0xff00ff });
+    this.pointMaterial = new THREE.PointsMaterial({ color: 0xff00ff, size: 0.15 });
+    this.line = new THREE.Line(this.geometry, this.lineMaterial);
+    this.points = new THREE.Points(this.geometry, this.pointMaterial);
+    this.scene.add(this.line);
+    this.scene.add(this.points);
+  }
+
+  public setPath(path: Vec3Like[]) {
+    const positions = new Float32Array(path.length * 3);
+    path.forEach((point, i) => {
+      positions[i * 3] = point.x;
+      positions[i * 3 + 1] = point.y;
+      positions[i * 3 + 2] = point.z;
+    });
+    this.geometry.setAttribute('position', new THREE.BufferAttribute(positions, 3));
+    this.geometry.computeBoundingSphere();
+  }
+
+  public dispose() {
+    this.scene.remove(this.line);
+    this.scene.remove(this.points);
+    this.geometry.dispose();
+    this.lineMaterial.dispose();
+    this.pointMaterial.dispose();
+  }
+}
@@ -0,0 +1,169 @@
+import React from 'react';
+import type { Charge } from '../models/Charge';
+import type { InverseDesignOptions, InverseDesignResult } from '../models/InverseDesign';
+import type { VoltagePoint } from '../models/VoltagePoint';
+
+interface InverseDesignPanelProps {
+  voltagePoints: VoltagePoint[];
+  charges: Charge[];
+  options: InverseDesignOptions;
+  result: InverseDesignResult | null; // From the last Solve; null once charges, targets or options change
+  status: string | null; // Progress or error text
+  probeVoltage: (pointId: string) => number; // Live potential, used as the initial target when pinning
+  probeLabel: (pointId: string) => number; // Placement number, as in the voltage point list
+  onTargetChange: (pointId: string, target: number | undefined) => void;
+  onOptionsChange: (options: InverseDesignOptions) => void;
+  onSolve: () => void;
+  onApply: () => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const InverseDesignPanel: React.FC<InverseDesignPanelProps> = ({
+  voltagePoints,
+  charges,
+  options,
+  result,
+  status,
+  probeVoltage,
+  probeLabel,
+  onTargetChange,
+  onOptionsChange,
+  onSolve,
+  onApply,
+}) => {
+  const pinnedCount = voltagePoints.filter((point) => point.target !== undefined).length;
+
+  // Bounds are edited in μC; an empty field means unbounded
+  const boundInput = (value: number | null, onChange: (value: number | null) => void) => (
+    <input
+      type="number"
+      value={value === null ? '' : value * 1e6}
+      placeholder="none"
+      onChange={(e) => onChange(e.target.value === '' ? null : (parseFloat(e.target.value) || 0) * 1e-6)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Inverse Design ({pinnedCount} targets)
+      </div>
+
+      {voltagePoints.length === 0 && (
+        <div style={{ fontSize: '10px', color: '#aaa', marginBottom: '5px' }}>
+          Add voltage points, then pin target potentials on them.
+        </div>
+      )}
+
+      {voltagePoints.map((point) => (
+        <div
+          key={point.id}
+          style={{ display: 'grid', gridTemplateColumns: 'auto 1fr 1fr', gap: '5px', alignItems: 'center', fontSize: '10px' }}
+        >
+          <input
+            type="checkbox"
+            checked={point.target !== undefined}
+            onChange={(e) => onTargetChange(point.id, e.target.checked ? probeVoltage(point.id) : undefined)}
+          />
+          <span>
+            P{probeLabel(point.id)}
+            {result && point.target !== undefined && result.achieved[point.id] !== undefined && (
+              <> → {result.achieved[point.id].toExponential(2)} V</>
+            )}
+          </span>
+          <input
+            type="number"
+            value={point.target ?? ''}
+            placeholder="target V"
+            disabled={point.target === undefined}
+            onChange={(e) => onTargetChange(point.id, parseFloat(e.target.value) || 0)}
+            style={inputStyle}
+          />
+        </div>
+      ))}
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', margin: '10px 0' }}>
+        <label>
+          λ
+          <input
+            type="number"
+            value={options.regularization}
+            onChange={(e) => onOptionsChange({ ...options, regularization: parseFloat(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Min (μC)
+          {boundInput(options.minMagnitude, (minMagnitude) => onOptionsChange({ ...options, minMagnitude }))}
+        </label>
+        <label>
+          Max (μC)
+          {boundInput(options.maxMagnitude, (maxMagnitude) => onOptionsChange({ ...options, maxMagnitude }))}
+        </label>
+      </div>
+
+      {result && pinnedCount > 0 && (
+        <div style={{ fontSize: '10px', marginBottom: '10px' }}>
+          <div>RMS error: {result.rmsError.toExponential(3)} V</div>
+          {charges.map((charge, i) => (
+            <div key={charge.id}>
+              Charge {i + 1}: {(charge.magnitude * 1e6).toFixed(3)} → {(result.magnitudes[i] * 1e6).toFixed(3)} μC
+            </div>
+          ))}
+          {result.activeBounds > 0 && <div style={{ color: '#aaa' }}>{result.activeBounds} at a bound</div>}
+        </div>
+      )}
+
+      {status && <div style={{ fontSize: '10px', color: '#aaa', marginBottom: '5px' }}>{status}</div>}
+
+      <div style={{ display: 'flex', gap: '5px' }}>
+        <button
+          onClick={onSolve}
+          disabled={pinnedCount === 0 || charges.length === 0}
+          style={{ ...buttonStyle, background: '#2196F3' }}
+        >
+          Solve
+        </button>
+        <button
+          onClick={onApply}
+          disabled={!result || pinnedCount === 0 || charges.length === 0}
+          style={{ ...buttonStyle, background: '#4CAF50' }}
+        >
+          Apply Magnitudes
+        </button>
+      </div>
+    </div>
+  );
+};
+
+export default InverseDesignPanel;
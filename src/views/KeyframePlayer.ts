@@ -0,0 +1,260 @@
+import * as THREE from 'three';
+import { FrameCache } from '../models/FrameCache';
+import type { CachedFrame } from '../models/FrameCache';
+import type { FieldLineTraceConfig } from '../models/FieldLineTracer';
+import { timelineFrameCount } from '../models/Timeline';
+import type { Timeline } from '../models/Timeline';
+import { WorkerPool } from '../workers/WorkerPool';
+import type { FrameCacheWorkerRequest, FrameCacheWorkerResult } from '../workers/frameCache.worker';
+import type { VectorFieldRenderer } from './VectorField';
+
+export interface KeyframePlayerConfig {
+  framesPerTask: number; // Frames computed per worker message
+  lineConfig: FieldLineTraceConfig;
+  lineColor: number;
+}
+
+/**
+ * Plays a keyframed charge animation from a precomputed FrameCache. Frames
+ * are computed by a worker pool; playback only decodes the current frame
+ * (zero-copy views) and copies its buffers into the arrows, the line segments
+ * and the charge instances, so the frame rate doesn't depend on scene complexity.
+ */
+export class KeyframePlayer {
+  private scene: THREE.Scene;
+  private vectorField: VectorFieldRenderer;
+  private config: KeyframePlayerConfig;
+  private pool: WorkerPool<FrameCacheWorkerRequest, FrameCacheWorkerResult> | null = null;
+  private cache: FrameCache | null = null;
+  private generation = 0;
+  private time = 0;
+  private playing = false;
+  private shownFrame = -1;
+  private group: THREE.Group;
+  private lineGeometry: THREE.BufferGeometry;
+  private lineMaterial: THREE.LineBasicMaterial;
+  private lines: THREE.LineSegments;
+  private linePositions: Float32Array = new Float32Array(0);
+  private chargeGeometry: THREE.SphereGeometry;
+  private chargeMaterial: THREE.MeshStandardMaterial;
+  private chargeMesh: THREE.InstancedMesh | null = null;
+  private readonly positiveColor = new THREE.Color(0xff4444);
+  private readonly negativeColor = new THREE.Color(0x4444ff);
+
+  constructor(scene: THREE.Scene, vectorField: VectorFieldRenderer, config: KeyframePlayerConfig) {
+    this.scene = scene;
+    this.vectorField = vectorField;
+    this.config = config;
+    this.group = new THREE.Group();
+    this.group.visible = false;
+    this.scene.add(this.group);
+
+    this.lineGeometry = new THREE.BufferGeometry();
+    this.lineMaterial = new THREE.LineBasicMaterial({
+      color: config.lineColor,
+      transparent: true,
+      opacity: 0.8,
+    });
+    this.lines = new THREE.LineSegments(this.lineGeometry, this.lineMaterial);
+    this.lines.frustumCulled = false;
+    this.group.add(this.lines);
+
+    this.chargeGeometry = new THREE.SphereGeometry(0.2, 16, 16);
+    this.chargeMaterial = new THREE.MeshStandardMaterial({ color: 0xffffff });
+  }
+
+  /**
+   * Compute every frame of `timeline` on the vector-field grid. Resolves with
+   * the finished cache; a later call (or dispose) supersedes an unfinished one.
+   */
+  public async precompute(
+    timeline: Timeline,
+    onProgress: (ready: number, total: number) => void = () => {}
+  ): Promise<FrameCache | null> {
+    const generation = ++this.generation;
+    if (!this.pool) {
+      this.pool = new WorkerPool<FrameCacheWorkerRequest, FrameCacheWorkerResult>(
+        () => new Worker(new URL('../workers/frameCache.worker.ts', import.meta.url), { type: 'module' })
+      );
+    }
+    this.pool.cancelPending();
+
+    const gridPositions = this.vectorField.getGridPositions().slice();
+    const frameCount = timelineFrameCount(timeline);
+    const cache = new FrameCache(timeline.fps, gridPositions, frameCount);
+    const tasks: Promise<void>[] = [];
+
+    for (let first = 0; first < frameCount; first += this.config.framesPerTask) {
+      const frames: number[] = [];
+      for (let i = first; i < Math.min(first + this.config.framesPerTask, frameCount); i++) frames.push(i);
+      const request: FrameCacheWorkerRequest = {
+        timeline,
+        gridPositions,
+        lineConfig: this.config.lineConfig,
+        frames,
+      };
+      tasks.push(
+        this.pool.run(request).then((result) => {
+          if (generation !== this.generation) return;
+          result.frames.forEach((frame, i) => cache.setFrame(frame, result.buffers[i]));
+          onProgress(cache.readyCount, frameCount);
+        })
+      );
+    }
+
+    try {
+      await Promise.all(tasks);
+    } catch {
+      return null; // Cancelled by a newer precompute
+    }
+    if (generation !== this.generation) return null;
+    this.setCache(cache);
+    return cache;
+  }
+
+  public setCache(cache: FrameCache | null) {
+    this.cache = cache;
+    this.shownFrame = -1;
+    this.time = 0;
+    if (cache && this.group.visible) this.showFrame(0);
+  }
+
+  public getCache(): FrameCache | null {
+    return this.cache;
+  }
+
+  /**
+   * Take over the view (arrows, lines, charges) from the live scene, or hand it back
+   */
+  public setActive(active: boolean) {
+    this.group.visible = active;
+    this.shownFrame = -1;
+    if (active) {
+      this.seek(this.time);
+    } else {
+      this.playing = false;
+      this.vectorField.setFrameField(null);
+    }
+  }
+
+  public setPlaying(playing: boolean) {
+    this.playing = playing;
+  }
+
+  public isPlaying(): boolean {
+    return this.playing;
+  }
+
+  public getTime(): number {
+    return this.time;
+  }
+
+  public seek(time: number) {
+    this.time = time;
+    if (!this.cache || !this.group.visible) return;
+    const index = Math.min(Math.max(Math.floor(time * this.cache.fps), 0), this.cache.frameCount - 1);
+    this.showFrame(index);
+  }
+
+  public update(deltaSeconds: number) {
+    if (!this.playing || !this.cache) return;
+    const duration = this.cache.frameCount / this.cache.fps;
+    this.seek((this.time + deltaSeconds) % duration);
+  }
+
+  private showFrame(index: number) {
+    if (!this.cache || index === this.shownFrame) return;
+    const frame = this.cache.getFrame(index);
+    if (!frame) return;
+    this.shownFrame = index;
+    this.vectorField.setFrameField(frame.field);
+    this.showLines(frame);
+    this.showCharges(frame);
+  }
+
+  /**
+   * Expand the frame's polylines into segment pairs in a reusable buffer
+   */
+  private showLines(frame: CachedFrame) {
+    const { lineLengths, lineVertices } = frame;
+    const segmentCount = lineVertices.length / 3 - lineLengths.length;
+    const needed = Math.max(segmentCount, 0) * 6;
+
+    if (needed > this.linePositions.length) {
+      this.linePositions = new Float32Array(Math.ceil(needed * 1.5));
+      this.lineGeometry.setAttribute('position', new THREE.BufferAttribute(this.linePositions, 3));
+    }
+
+    let vertex = 0;
+    let offset = 0;
+    for (const length of lineLengths) {
+      for (let i = 0; i + 1 < length; i++) {
+        const a = (vertex + i) * 3;
+        this.linePositions.set(lineVertices.subarray(a, a + 6), offset);
+        offset += 6;
+      }
+      vertex += length;
+    }
+
+    const attribute = this.lineGeometry.getAttribute('position') as THREE.BufferAttribute | undefined;
+    if (attribute) {
+      attribute.clearUpdateRanges();
+      attribute.addUpdateRange(0, offset);
+      attribute.needsUpdate = true;
+    }
+    this.lineGeometry.setDrawRange(0, offset / 3);
+  }
+
+  private showCharges(frame: CachedFrame) {
+    const count = frame.charges.length / 4;
+    if (!this.chargeMesh || this.chargeMesh.instanceMatrix.count < count) {
+      if (this.chargeMesh) {
+        this.group.remove(this.chargeMesh);
+        this.chargeMesh.dispose();
+      }
+      this.chargeMesh = new THREE.InstancedMesh(this.chargeGeometry, this.chargeMaterial, Math.max(count, 8));
+      this.chargeMesh.frustumCulled = false;
+      this.group.add(this.chargeMesh);
+    }
+
+    const matrix = new THREE.Matrix4();
+    for (let i = 0; i < count; i++) {
+      const magnitude = frame.charges[i * 4 + 3];
+      // Charges fading in or out between keyframes shrink with their magnitude
+      const scale = Math.min(1, Math.abs(magnitude) / 1e-7);
+      matrix.makeScale(scale, scale, scale);
+      matrix.setPosition(frame.charges[i * 4], frame.charges[i * 4 + 1], frame.charges[i * 4 + 2]);
+      this.chargeMesh.setMatrixAt(i, matrix);
+      this.chargeMesh.setColorAt(i, magnitude >= 0 ? this.positiveColor : this.negativeColor);
+    }
+    this.chargeMesh.count = count;
+    this.chargeMesh.instanceMatrix.needsUpdate = true;
+    if (this.chargeMesh.instanceColor) this.chargeMesh.instanceColor.needsUpdate = true;
+  }
+
+  public dispose() {
+    this.generation++;
+    this.pool?.dispose();
+    this.vectorField.setFrameField(null);
+    this.scene.remove(this.group);
+    this.lineGeometry.dispose();
+    this.lineMaterial.dispose();
+    this.chargeMesh?.dispose();
+    this.chargeGeometry.dispose();
+    this.chargeMaterial.dispose();
+  }
+}
+
+export function createDefaultKeyframePlayerConfig(): KeyframePlayerConfig {
+  return {
+    framesPerTask: 4,
+    lineConfig: {
+      stepSize: 0.1,
+      minStepSize: 0.01,
+      maxSteps: 1000,
+      bounds: { min: { x: -5, y: -5, z: -5 }, max: { x: 5, y: 5, z: 5 } },
+      linesPerCharge: 8,
+    },
+    lineColor: 0xffff00,
+  };
+}
@@ -0,0 +1,183 @@
+import * as THREE from 'three';
+import { trajectoryState } from '../models/LienardWiechert';
+import type { MovingCharge } from '../models/LienardWiechert';
+import type { VectorFieldRenderer } from './VectorField';
+import type {
+  LienardWiechertWorkerRequest,
+  LienardWiechertWorkerResult,
+} from '../workers/lienardWiechert.worker';
+
+export interface MovingChargeConfig {
+  workerCount: number;
+  speedOfLight: number; // Scene units per second; small values make retardation visible
+}
+
+/**
+ * Charges on prescribed trajectories. Their Liénard–Wiechert field on the
+ * vector-field grid is evaluated by a few workers (each owning a slice of the
+ * grid and its warm-start retarded times) and added to the arrows.
+ */
+export class MovingChargeRenderer {
+  private scene: THREE.Scene;
+  private vectorField: VectorFieldRenderer;
+  private config: MovingChargeConfig;
+  private workers: Worker[] = [];
+  private sliceOffsets: number[] = []; // First float of each worker's slice
+  private spareSlices: (Float32Array | null)[] = [];
+  private pending = 0;
+  private generation = 0; // Bumped whenever the workers are reconfigured
+  private combinedField: Float32Array = new Float32Array(0);
+  private configuredGrid: Float32Array | null = null; // Grid the workers were last given
+  private charges: MovingCharge[] = [];
+  private time = 0;
+  private markers: THREE.Mesh[] = [];
+  private markerGeometry: THREE.SphereGeometry;
+  private positiveMaterial: THREE.MeshStandardMaterial;
+  private negativeMaterial: THREE.MeshStandardMaterial;
+  private state = new Float64Array(9);
+
+  constructor(scene: THREE.Scene, vectorField: VectorFieldRenderer, config: MovingChargeConfig) {
+    this.scene = scene;
+    this.vectorField = vectorField;
+    this.config = config;
+    this.markerGeometry = new THREE.SphereGeometry(0.2, 16, 16);
+    this.positiveMaterial = new THREE.MeshStandardMaterial({ color: 0xff8844 });
+    this.negativeMaterial = new THREE.MeshStandardMaterial({ color: 0x44aaff });
+
+    for (let w = 0; w < config.workerCount; w++) {
+      const worker = new Worker(
+        new URL('../workers/lienardWiechert.worker.ts', import.meta.url),
+        { type: 'module' }
+      );
+      worker.onmessage = (event: MessageEvent<LienardWiechertWorkerResult>) => {
+        this.receiveSlice(w, event.data);
+      };
+      this.workers.push(worker);
+    }
+  }
+
+  private sliceEnd(workerIndex: number): number {
+    return workerIndex + 1 < this.sliceOffsets.length
+      ? this.sliceOffsets[workerIndex + 1]
+      : this.combinedField.length;
+  }
+
+  private receiveSlice(workerIndex: number, result: LienardWiechertWorkerResult) {
+    this.spareSlices[workerIndex] = result.field;
+    const current = result.generation === this.generation;
+    if (current) {
+      this.combinedField.set(result.field, this.sliceOffsets[workerIndex]);
+    }
+    this.pending--;
+    if (this.pending === 0 && current && this.charges.length > 0) {
+      this.vectorField.setDynamicField(this.combinedField);
+      this.placeMarkers(result.time);
+    }
+  }
+
+  private placeMarkers(time: number) {
+    this.charges.forEach((charge, i) => {
+      trajectoryState(charge.trajectory, time, this.state);
+      this.markers[i].position.set(this.state[0], this.state[1], this.state[2]);
+    });
+  }
+
+  /**
+   * Split the current grid across the workers and hand them the charges
+   */
+  public setCharges(charges: MovingCharge[]) {
+    this.charges = charges;
+    for (const marker of this.markers) this.scene.remove(marker);
+    this.markers = charges.map((charge) => {
+      const mesh = new THREE.Mesh(
+        this.markerGeometry,
+        charge.magnitude >= 0 ? this.positiveMaterial : this.negativeMaterial
+      );
+      this.scene.add(mesh);
+      return mesh;
+    });
+    this.configureWorkers();
+    if (charges.length === 0) {
+      this.vectorField.setDynamicField(null);
+    } else {
+      this.placeMarkers(this.time);
+    }
+  }
+
+  public setSpeedOfLight(speedOfLight: number) {
+    this.config = { ...this.config, speedOfLight };
+    this.configureWorkers();
+  }
+
+  private configureWorkers() {
+    const points = this.vectorField.getGridPositions();
+    this.configuredGrid = points;
+    const pointCount = points.length / 3;
+    const perWorker = Math.ceil(pointCount / this.workers.length);
+    this.generation++;
+    this.combinedField = new Float32Array(points.length);
+    this.sliceOffsets = [];
+
+    this.workers.forEach((worker, w) => {
+      const start = Math.min(w * perWorker, pointCount) * 3;
+      const end = Math.min((w + 1) * perWorker, pointCount) * 3;
+      this.sliceOffsets.push(start);
+      const message: LienardWiechertWorkerRequest = {
+        type: 'configure',
+        charges: this.charges,
+        points: points.slice(start, end),
+        speedOfLight: this.config.speedOfLight,
+      };
+      worker.postMessage(message);
+    });
+  }
+
+  public resetTime() {
+    this.time = 0;
+  }
+
+  /**
+   * Advance the clock and request the next field if the last one has arrived.
+   * A new vector-field grid (a resize or new bounds) reconfigures the workers
+   * first, so they never sample the old points.
+   */
+  public update(deltaSeconds: number) {
+    this.time += deltaSeconds;
+    if (this.charges.length === 0) return;
+    if (this.vectorField.getGridPositions() !== this.configuredGrid) this.configureWorkers();
+    if (this.pending > 0) return;
+
+    this.workers.forEach((worker, w) => {
+      const length = this.sliceEnd(w) - this.sliceOffsets[w];
+      let field = this.spareSlices[w];
+      if (!field || field.length !== length) {
+        field = new Float32Array(length);
+      }
+      this.spareSlices[w] = null;
+      const message: LienardWiechertWorkerRequest = {
+        type: 'evaluate',
+        time: this.time,
+        generation: this.generation,
+        field,
+      };
+      worker.postMessage(message, [field.buffer as ArrayBuffer]);
+    });
+    this.pending = this.workers.length;
+  }
+
+  public dispose() {
+    for (const worker of this.workers) worker.terminate();
+    for (const marker of this.markers) this.scene.remove(marker);
+    this.vectorField.setDynamicField(null);
+    this.markerGeometry.dispose();
+    this.positiveMaterial.dispose();
+    this.negativeMaterial.dispose();
+  }
+}
+
+export function createDefaultMovingChargeConfig(): MovingChargeConfig {
+  return {
+    workerCount: Math.max(1, Math.min(4, (navigator.hardwareConcurrency || 2) - 1)),
+    speedOfLight: 5,
+  };
+}
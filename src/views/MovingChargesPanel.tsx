@@ -0,0 +1,211 @@
+import React, { useState } from 'react';
+import { isSubluminal, maxTrajectorySpeed } from '../models/LienardWiechert';
+import type { MovingCharge, Trajectory } from '../models/LienardWiechert';
+
+interface MovingChargesPanelProps {
+  charges: MovingCharge[];
+  speedOfLight: number;
+  playing: boolean;
+  onAddCharge: (charge: MovingCharge) => void;
+  onRemoveCharge: (chargeId: string) => void;
+  onSpeedOfLightChange: (speedOfLight: number) => void;
+  onTogglePlaying: () => void;
+  onResetTime: () => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+type TrajectoryKind = Trajectory['kind'];
+
+const MovingChargesPanel: React.FC<MovingChargesPanelProps> = ({
+  charges,
+  speedOfLight,
+  playing,
+  onAddCharge,
+  onRemoveCharge,
+  onSpeedOfLightChange,
+  onTogglePlaying,
+  onResetTime,
+}) => {
+  const [kind, setKind] = useState<TrajectoryKind>('circular');
+  const [magnitude, setMagnitude] = useState(1);
+  const [center, setCenter] = useState({ x: 0, y: 0, z: 0 });
+  const [size, setSize] = useState(1); // Radius, amplitude or speed
+  const [frequency, setFrequency] = useState(0.3);
+
+  const buildTrajectory = (): Trajectory => {
+    const omega = 2 * Math.PI * frequency;
+    switch (kind) {
+      case 'linear':
+        return { kind, start: { ...center }, velocity: { x: size, y: 0, z: 0 } };
+      case 'circular':
+        return { kind, center: { ...center }, radius: size, angularSpeed: omega, phase: 0 };
+      case 'oscillating':
+        return { kind, center: { ...center }, amplitude: { x: size, y: 0, z: 0 }, angularFrequency: omega };
+    }
+  };
+
+  const trajectory = buildTrajectory();
+  const tooFast = !isSubluminal(trajectory, speedOfLight);
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Moving Charges ({charges.length})
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Path
+          <select
+            value={kind}
+            onChange={(e) => setKind(e.target.value as TrajectoryKind)}
+            style={inputStyle}
+          >
+            <option value="circular">Circle</option>
+            <option value="oscillating">Oscillate</option>
+            <option value="linear">Line</option>
+          </select>
+        </label>
+        <label>
+          q (μC)
+          {numberInput(magnitude, setMagnitude)}
+        </label>
+        <label>
+          c (u/s)
+          {numberInput(speedOfLight, (c) => onSpeedOfLightChange(Math.max(c, 0.1)))}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          X
+          {numberInput(center.x, (x) => setCenter((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(center.y, (y) => setCenter((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(center.z, (z) => setCenter((prev) => ({ ...prev, z })))}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          {kind === 'linear' ? 'Speed' : kind === 'circular' ? 'Radius' : 'Amplitude'}
+          {numberInput(size, setSize)}
+        </label>
+        <label>
+          f (Hz)
+          {numberInput(frequency, setFrequency)}
+        </label>
+      </div>
+
+      {tooFast && (
+        <div style={{ fontSize: '10px', color: '#ff9800', marginBottom: '5px' }}>
+          Top speed {maxTrajectorySpeed(trajectory).toFixed(2)} u/s reaches c; lower it or raise c
+        </div>
+      )}
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '10px' }}>
+        <button
+          onClick={() =>
+            onAddCharge({
+              id: `moving-${Date.now()}`,
+              magnitude: magnitude * 1e-6,
+              trajectory,
+            })
+          }
+          disabled={tooFast}
+          style={{ ...buttonStyle, background: tooFast ? '#555' : '#4CAF50' }}
+        >
+          + Add
+        </button>
+        <button
+          onClick={onTogglePlaying}
+          style={{ ...buttonStyle, background: playing ? '#f44336' : '#2196F3' }}
+        >
+          {playing ? 'Pause' : 'Play'}
+        </button>
+        <button onClick={onResetTime} style={{ ...buttonStyle, background: '#607D8B' }}>
+          Reset
+        </button>
+      </div>
+
+      {charges.map((charge) => (
+        <div
+          key={charge.id}
+          style={{
+            display: 'flex',
+            justifyContent: 'space-between',
+            alignItems: 'center',
+            fontSize: '10px',
+            marginBottom: '4px',
+          }}
+        >
+          <span>
+            {charge.trajectory.kind} q={(charge.magnitude * 1e6).toFixed(2)} μC
+            {!isSubluminal(charge.trajectory, speedOfLight) && (
+              <span style={{ color: '#ff9800' }}> v ≥ c, not drawn</span>
+            )}
+          </span>
+          <button
+            onClick={() => onRemoveCharge(charge.id)}
+            style={{
+              padding: '2px 6px',
+              background: '#f44336',
+              color: 'white',
+              border: 'none',
+              borderRadius: '3px',
+              cursor: 'pointer',
+              fontSize: '10px',
+            }}
+          >
+            Remove
+          </button>
+        </div>
+      ))}
+    </div>
+  );
+};
+
+export default MovingChargesPanel;
@@ -0,0 +1,63 @@
+import React from 'react';
+import type { NullPoint } from '../models/NullPoints';
+
+interface NullPointPanelProps {
+  enabled: boolean;
+  nulls: NullPoint[];
+  scanTime: number; // ms for the last scan
+  onToggle: () => void;
+  onRescan: () => void;
+}
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const NullPointPanel: React.FC<NullPointPanelProps> = ({ enabled, nulls, scanTime, onToggle, onRescan }) => {
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Null Points {enabled && `(${nulls.length})`}
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '10px' }}>
+        <button onClick={onToggle} style={{ ...buttonStyle, background: enabled ? '#f44336' : '#4CAF50' }}>
+          {enabled ? 'Hide' : 'Find E = 0'}
+        </button>
+        <button onClick={onRescan} disabled={!enabled} style={{ ...buttonStyle, background: '#2196F3' }}>
+          Full Rescan
+        </button>
+      </div>
+
+      {enabled && (
+        <div style={{ fontSize: '10px' }}>
+          {nulls.map((nullPoint, index) => (
+            <div key={index} style={{ color: nullPoint.determinantSign > 0 ? '#ffeb3b' : '#00e5ff' }}>
+              ({nullPoint.position.x.toFixed(3)}, {nullPoint.position.y.toFixed(3)},{' '}
+              {nullPoint.position.z.toFixed(3)}) |E| = {nullPoint.residual.toExponential(1)}
+            </div>
+          ))}
+          <div style={{ color: '#aaa', marginTop: '5px' }}>Scan: {scanTime.toFixed(1)} ms</div>
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default NullPointPanel;
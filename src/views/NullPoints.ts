@@ -0,0 +1,58 @@
+import * as THREE from 'three';
+import type { NullPoint } from '../models/NullPoints';
+
+/**
+ * Octahedron markers at the field's null points, coloured by the sign of
+ * det ∇E so the two kinds of null can be told apart
+ */
+export class NullPointRenderer {
+  private scene: THREE.Scene;
+  private group: THREE.Group;
+  private geometry: THREE.OctahedronGeometry;
+  private material: THREE.MeshBasicMaterial;
+  private mesh: THREE.InstancedMesh | null = null;
+  private positiveColor = new THREE.Color(0xffeb3b);
+  private negativeColor = new THREE.Color(0x00e5ff);
+
+  constructor(scene: THREE.Scene) {
+    this.scene = scene;
+    this.group = new THREE.Group();
+    this.scene.add(this.group);
+    this.geometry = new THREE.OctahedronGeometry(0.12);
+    this.material = new THREE.MeshBasicMaterial({ color: 0xffffff, wireframe: true });
+  }
+
+  public updateNullPoints(nulls: NullPoint[]) {
+    const count = nulls.length;
+    if (!this.mesh || this.mesh.instanceMatrix.count < count) {
+      if (this.mesh) {
+        this.group.remove(this.mesh);
+        this.mesh.dispose();
+      }
+      this.mesh = new THREE.InstancedMesh(this.geometry, this.material, Math.max(count, 8));
+      this.mesh.frustumCulled = false;
+      this.group.add(this.mesh);
+    }
+
+    const matrix = new THREE.Matrix4();
+    nulls.forEach((nullPoint, i) => {
+      matrix.makeTranslation(nullPoint.position.x, nullPoint.position.y, nullPoint.position.z);
+      this.mesh!.setMatrixAt(i, matrix);
+      this.mesh!.setColorAt(i, nullPoint.determinantSign > 0 ? this.positiveColor : this.negativeColor);
+    });
+    this.mesh.count = count;
+    this.mesh.instanceMatrix.needsUpdate = true;
+    if (this.mesh.instanceColor) this.mesh.instanceColor.needsUpdate = true;
+  }
+
+  public setVisible(visible: boolean) {
+    this.group.visible = visible;
+  }
+
+  public dispose() {
+    this.scene.remove(this.group);
+    this.mesh?.dispose();
+    this.geometry.dispose();
+    this.material.dispose();
+  }
+}
@@ -0,0 +1,263 @@
+import * as THREE from 'three';
+import type {
+  PositionOptimizerMessage,
+  PositionOptimizerRequest,
+} from '../workers/positionOptimizer.worker';
+
+export interface OptimizationPathConfig {
+  markerRadius: number;
+  markerColor: number;
+  trailColor: number;
+  sampleColor: number;
+  iterationsPerSecond: number; // Replay speed
+}
+
+export interface OptimizerProgress {
+  running: boolean;
+  iteration: number;
+  value: number;
+  gradientNorm: number;
+  reason: string | null; // Stop reason once the run has finished
+  evaluations: number;
+}
+
+/**
+ * Runs the position optimiser in a worker and animates its path: one trail
+ * segment per charge per iteration (iteration-major, so the draw range reveals
+ * the path up to the playhead), ghost markers at the interpolated positions,
+ * and the objective's sample points.
+ */
+export class OptimizationPathRenderer {
+  private scene: THREE.Scene;
+  private config: OptimizationPathConfig;
+  private worker: Worker | null = null;
+  private path: Float64Array[] = []; // Positions per iteration, xyz per charge
+  private chargeCount = 0;
+  private playhead = 0; // Fractional iteration shown by the ghosts
+  private replaying = false;
+  private visible = true;
+  private trailGeometry: THREE.BufferGeometry;
+  private trailMaterial: THREE.LineBasicMaterial;
+  private trails: THREE.LineSegments;
+  private markerGeometry: THREE.SphereGeometry;
+  private markerMaterial: THREE.MeshBasicMaterial;
+  private markers: THREE.InstancedMesh | null = null;
+  private sampleGeometry: THREE.BufferGeometry;
+  private sampleMaterial: THREE.PointsMaterial;
+  private samples: THREE.Points;
+
+  constructor(scene: THREE.Scene, config: OptimizationPathConfig = createDefaultOptimizationPathConfig()) {
+    this.scene = scene;
+    this.config = config;
+
+    this.trailGeometry = new THREE.BufferGeometry();
+    this.trailMaterial = new THREE.LineBasicMaterial({ color: config.trailColor, transparent: true, opacity: 0.8 });
+    this.trails = new THREE.LineSegments(this.trailGeometry, this.trailMaterial);
+    this.trails.frustumCulled = false;
+
+    this.markerGeometry = new THREE.SphereGeometry(config.markerRadius, 12, 12);
+    this.markerMaterial = new THREE.MeshBasicMaterial({
+      color: config.markerColor,
+      transparent: true,
+      opacity: 0.5,
+      wireframe: true,
+    });
+
+    this.sampleGeometry = new THREE.BufferGeometry();
+    this.sampleMaterial = new THREE.PointsMaterial({ color: config.sampleColor, size: 0.08 });
+    this.samples = new THREE.Points(this.sampleGeometry, this.sampleMaterial);
+    this.samples.frustumCulled = false;
+
+    this.scene.add(this.trails);
+    this.scene.add(this.samples);
+  }
+
+  /**
+   * Start a fresh run, cancelling any run in progress. `samples` are the
+   * objective's sample points (xyz interleaved), drawn for reference.
+   */
+  public start(
+    request: PositionOptimizerRequest,
+    samples: Float64Array,
+    onProgress: (progress: OptimizerProgress) => void
+  ) {
+    this.stop();
+    this.path = [];
+    this.chargeCount = request.charges.count;
+    this.playhead = 0;
+    this.replaying = false;
+    this.sampleGeometry.setAttribute('position', new THREE.BufferAttribute(new Float32Array(samples), 3));
+    this.ensureMarkers(this.chargeCount);
+
+    let evaluations = 0;
+    let last = { iteration: 0, value: NaN, gradientNorm: NaN };
+    const worker = new Worker(
+      new URL('../workers/positionOptimizer.worker.ts', import.meta.url),
+      { type: 'module' }
+    );
+    worker.onmessage = (event: MessageEvent<PositionOptimizerMessage>) => {
+      const message = event.data;
+      if (message.type === 'iteration') {
+        this.path.push(message.positions);
+        this.playhead = this.path.length - 1;
+        this.rebuildTrails();
+        last = { iteration: message.iteration, value: message.value, gradientNorm: message.gradientNorm };
+        onProgress({ running: true, ...last, reason: null, evaluations });
+      } else {
+        evaluations = message.evaluations;
+        worker.terminate();
+        if (this.worker === worker) this.worker = null;
+        onProgress({ running: false, ...last, value: message.value, reason: message.reason, evaluations });
+      }
+    };
+    // The worker copies the request, so the caller's arrays stay usable
+    worker.postMessage(request);
+    this.worker = worker;
+  }
+
+  /**
+   * Cancel the running optimisation; the path so far is kept
+   */
+  public stop() {
+    if (!this.worker) return;
+    this.worker.terminate();
+    this.worker = null;
+  }
+
+  public get running(): boolean {
+    return this.worker !== null;
+  }
+
+  /**
+   * Animate the recorded path again from its first iterate
+   */
+  public replay() {
+    if (this.path.length < 2) return;
+    this.playhead = 0;
+    this.replaying = true;
+    this.updateDrawRange();
+  }
+
+  /**
+   * Positions of the latest iterate, or null before the first one arrives
+   */
+  public getFinalPositions(): Float64Array | null {
+    return this.path.length > 0 ? this.path[this.path.length - 1] : null;
+  }
+
+  public tick(deltaSeconds: number) {
+    if (this.replaying) {
+      this.playhead += deltaSeconds * this.config.iterationsPerSecond;
+      if (this.playhead >= this.path.length - 1) {
+        this.playhead = this.path.length - 1;
+        this.replaying = false;
+      }
+      this.updateDrawRange();
+    }
+    this.placeMarkers();
+  }
+
+  private ensureMarkers(count: number) {
+    if (this.markers && this.markers.instanceMatrix.count >= count) return;
+    if (this.markers) {
+      this.scene.remove(this.markers);
+      this.markers.dispose();
+    }
+    this.markers = new THREE.InstancedMesh(this.markerGeometry, this.markerMaterial, Math.max(count, 16));
+    this.markers.instanceMatrix.setUsage(THREE.DynamicDrawUsage);
+    this.markers.frustumCulled = false;
+    this.markers.count = 0;
+    this.markers.visible = this.visible;
+    this.scene.add(this.markers);
+  }
+
+  private rebuildTrails() {
+    const n = this.chargeCount;
+    const steps = this.path.length - 1;
+    const vertices = new Float32Array(Math.max(steps, 0) * n * 6);
+    for (let step = 0; step < steps; step++) {
+      const from = this.path[step];
+      const to = this.path[step + 1];
+      for (let k = 0; k < n; k++) {
+        const offset = (step * n + k) * 6;
+        vertices[offset] = from[k * 3];
+        vertices[offset + 1] = from[k * 3 + 1];
+        vertices[offset + 2] = from[k * 3 + 2];
+        vertices[offset + 3] = to[k * 3];
+        vertices[offset + 4] = to[k * 3 + 1];
+        vertices[offset + 5] = to[k * 3 + 2];
+      }
+    }
+    this.trailGeometry.setAttribute('position', new THREE.BufferAttribute(vertices, 3));
+    this.updateDrawRange();
+  }
+
+  private updateDrawRange() {
+    this.trailGeometry.setDrawRange(0, Math.ceil(this.playhead) * this.chargeCount * 2);
+  }
+
+  private placeMarkers() {
+    if (!this.markers || this.path.length === 0) return;
+    const index = Math.min(Math.floor(this.playhead), this.path.length - 1);
+    const from = this.path[index];
+    const to = this.path[Math.min(index + 1, this.path.length - 1)];
+    const t = this.playhead - index;
+    const matrix = new THREE.Matrix4();
+    for (let k = 0; k < this.chargeCount; k++) {
+      matrix.makeTranslation(
+        from[k * 3] + (to[k * 3] - from[k * 3]) * t,
+        from[k * 3 + 1] + (to[k * 3 + 1] - from[k * 3 + 1]) * t,
+        from[k * 3 + 2] + (to[k * 3 + 2] - from[k * 3 + 2]) * t
+      );
+      this.markers.setMatrixAt(k, matrix);
+    }
+    this.markers.count = this.chargeCount;
+    this.markers.instanceMatrix.needsUpdate = true;
+  }
+
+  /**
+   * Drop the recorded path and sample points
+   */
+  public clear() {
+    this.stop();
+    this.path = [];
+    this.playhead = 0;
+    this.replaying = false;
+    this.trailGeometry.deleteAttribute('position');
+    this.sampleGeometry.deleteAttribute('position');
+    if (this.markers) this.markers.count = 0;
+  }
+
+  public setVisible(visible: boolean) {
+    this.visible = visible;
+    this.trails.visible = visible;
+    this.samples.visible = visible;
+    if (this.markers) this.markers.visible = visible;
+  }
+
+  public dispose() {
+    this.stop();
+    this.scene.remove(this.trails);
+    this.scene.remove(this.samples);
+    this.trailGeometry.dispose();
+    this.trailMaterial.dispose();
+    this.sampleGeometry.dispose();
+    this.sampleMaterial.dispose();
+    if (this.markers) {
+      this.scene.remove(this.markers);
+      this.markers.dispose();
+    }
+    this.markerGeometry.dispose();
+    this.markerMaterial.dispose();
+  }
+}
+
+export function createDefaultOptimizationPathConfig(): OptimizationPathConfig {
+  return {
+    markerRadius: 0.22,
+    markerColor: 0xffeb3b,
+    trailColor: 0xffc107,
+    sampleColor: 0x8bc34a,
+    iterationsPerSecond: 20,
+  };
+}
@@ -0,0 +1,166 @@
+import React, { useState } from 'react';
+import type { PositionObjective } from '../models/PositionObjective';
+import type { OptimizerProgress } from './OptimizationPath';
+
+interface OptimizerPanelProps {
+  chargeCount: number;
+  progress: OptimizerProgress | null;
+  onStart: (objective: PositionObjective) => void;
+  onStop: () => void;
+  onReplay: () => void;
+  onApply: () => void;
+}
+
+type ObjectiveKind = PositionObjective['kind'];
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const OptimizerPanel: React.FC<OptimizerPanelProps> = ({
+  chargeCount,
+  progress,
+  onStart,
+  onStop,
+  onReplay,
+  onApply,
+}) => {
+  const [kind, setKind] = useState<ObjectiveKind>('zero-field');
+  // Point A is the zero-field point, the line start or the region's min corner;
+  // point B is the line end or the region's max corner
+  const [pointA, setPointA] = useState({ x: 0, y: 0, z: 0 });
+  const [pointB, setPointB] = useState({ x: 1, y: 1, z: 1 });
+  const [target, setTarget] = useState({ x: 1000, y: 0, z: 0 }); // V/m
+  const [samples, setSamples] = useState(4);
+
+  const buildObjective = (): PositionObjective => {
+    switch (kind) {
+      case 'zero-field':
+        return { kind, point: { ...pointA } };
+      case 'max-field':
+        return { kind, start: { ...pointA }, end: { ...pointB }, samples };
+      case 'uniform-field':
+        return { kind, min: { ...pointA }, max: { ...pointB }, samples, target: { ...target } };
+    }
+  };
+
+  const vectorInputs = (
+    label: string,
+    value: { x: number; y: number; z: number },
+    onChange: (value: { x: number; y: number; z: number }) => void
+  ) => (
+    <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+      {(['x', 'y', 'z'] as const).map((axis) => (
+        <label key={axis}>
+          {label} {axis.toUpperCase()}
+          <input
+            type="number"
+            value={value[axis]}
+            onChange={(e) => onChange({ ...value, [axis]: parseFloat(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+      ))}
+    </div>
+  );
+
+  const running = progress?.running ?? false;
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Position Optimizer ({chargeCount} charges)
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '2fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Objective
+          <select value={kind} onChange={(e) => setKind(e.target.value as ObjectiveKind)} style={inputStyle}>
+            <option value="zero-field">Zero field at a point</option>
+            <option value="max-field">Maximum field on a line</option>
+            <option value="uniform-field">Uniform field in a region</option>
+          </select>
+        </label>
+        {kind !== 'zero-field' && (
+          <label>
+            Samples
+            <input
+              type="number"
+              min={2}
+              value={samples}
+              onChange={(e) => setSamples(Math.max(2, parseInt(e.target.value) || 2))}
+              style={inputStyle}
+            />
+          </label>
+        )}
+      </div>
+
+      {vectorInputs(kind === 'zero-field' ? 'P' : kind === 'max-field' ? 'From' : 'Min', pointA, setPointA)}
+      {kind !== 'zero-field' && vectorInputs(kind === 'max-field' ? 'To' : 'Max', pointB, setPointB)}
+      {kind === 'uniform-field' && vectorInputs('E', target, setTarget)}
+
+      <div style={{ display: 'flex', gap: '5px', marginTop: '5px', marginBottom: '5px' }}>
+        {running ? (
+          <button onClick={onStop} style={{ ...buttonStyle, background: '#f44336' }}>
+            Stop
+          </button>
+        ) : (
+          <button
+            onClick={() => onStart(buildObjective())}
+            disabled={chargeCount === 0}
+            style={{ ...buttonStyle, background: '#4CAF50' }}
+          >
+            Start
+          </button>
+        )}
+        <button onClick={onReplay} disabled={!progress || running} style={{ ...buttonStyle, background: '#2196F3' }}>
+          Replay
+        </button>
+        <button onClick={onApply} disabled={!progress || running} style={{ ...buttonStyle, background: '#2196F3' }}>
+          Apply
+        </button>
+      </div>
+
+      {progress && (
+        <div style={{ fontSize: '10px' }}>
+          <div>Iteration: {progress.iteration}</div>
+          <div>Objective: {progress.value.toExponential(4)}</div>
+          <div>|∇f|∞: {progress.gradientNorm.toExponential(3)}</div>
+          {progress.reason && (
+            <div style={{ color: '#aaa' }}>
+              Stopped: {progress.reason} after {progress.evaluations} evaluations
+            </div>
+          )}
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default OptimizerPanel;
@@ -0,0 +1,65 @@
+import * as THREE from 'three';
+import { oscillationFactor } from '../models/PhasorField';
+import type { OscillatingSource } from '../models/PhasorField';
+
+/**
+ * Markers for oscillating sources. A charge is a sphere that pulses and turns
+ * red/blue with the sign of its instantaneous charge; a dipole is a pair of
+ * spheres along its axis whose polarity flips each half period.
+ */
+export class OscillatingSourceRenderer {
+  private scene: THREE.Scene;
+  private group: THREE.Group;
+  private sources: OscillatingSource[] = [];
+  private markers: THREE.Mesh[][] = [];
+  private geometry: THREE.SphereGeometry;
+  private positiveMaterial: THREE.MeshStandardMaterial;
+  private negativeMaterial: THREE.MeshStandardMaterial;
+
+  constructor(scene: THREE.Scene) {
+    this.scene = scene;
+    this.group = new THREE.Group();
+    this.scene.add(this.group);
+    this.geometry = new THREE.SphereGeometry(0.15, 16, 16);
+    this.positiveMaterial = new THREE.MeshStandardMaterial({ color: 0xff4444, emissive: 0x441111 });
+    this.negativeMaterial = new THREE.MeshStandardMaterial({ color: 0x4444ff, emissive: 0x111144 });
+  }
+
+  public updateSources(sources: OscillatingSource[]) {
+    this.sources = sources;
+    this.group.clear();
+    this.markers = sources.map((source) => {
+      const poles = source.kind === 'charge' ? [0] : [1, -1];
+      return poles.map((pole) => {
+        const mesh = new THREE.Mesh(this.geometry, this.positiveMaterial);
+        mesh.position.set(
+          source.position.x + source.axis.x * 0.25 * pole,
+          source.position.y + source.axis.y * 0.25 * pole,
+          source.position.z + source.axis.z * 0.25 * pole
+        );
+        mesh.userData = { pole: pole === 0 ? 1 : pole };
+        this.group.add(mesh);
+        return mesh;
+      });
+    });
+  }
+
+  public setTime(time: number) {
+    this.sources.forEach((source, i) => {
+      const factor = oscillationFactor(source, time);
+      for (const mesh of this.markers[i]) {
+        const sign = factor * mesh.userData.pole;
+        mesh.material = sign >= 0 ? this.positiveMaterial : this.negativeMaterial;
+        mesh.scale.setScalar(0.4 + 0.6 * Math.abs(factor));
+      }
+    });
+  }
+
+  public dispose() {
+    this.group.clear();
+    this.scene.remove(this.group);
+    this.geometry.dispose();
+    this.positiveMaterial.dispose();
+    this.negativeMaterial.dispose();
+  }
+}
@@ -0,0 +1,205 @@
+import React, { useState } from 'react';
+import type { OscillatingSource } from '../models/PhasorField';
+
+interface OscillatorPanelProps {
+  sources: OscillatingSource[];
+  playing: boolean;
+  onAddSource: (source: OscillatingSource) => void;
+  onRemoveSource: (sourceId: string) => void;
+  onTogglePlaying: () => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const AXES = {
+  x: { x: 1, y: 0, z: 0 },
+  y: { x: 0, y: 1, z: 0 },
+  z: { x: 0, y: 0, z: 1 },
+};
+
+const OscillatorPanel: React.FC<OscillatorPanelProps> = ({
+  sources,
+  playing,
+  onAddSource,
+  onRemoveSource,
+  onTogglePlaying,
+}) => {
+  const [kind, setKind] = useState<'charge' | 'dipole'>('dipole');
+  const [position, setPosition] = useState({ x: 0, y: 0, z: 0 });
+  const [amplitude, setAmplitude] = useState(1);
+  const [axis, setAxis] = useState<'x' | 'y' | 'z'>('y');
+  const [frequency, setFrequency] = useState(0.5);
+  const [phaseDegrees, setPhaseDegrees] = useState(0);
+
+  const addSource = () => {
+    onAddSource({
+      id: `oscillator-${Date.now()}`,
+      kind,
+      position: { ...position },
+      // Charges in μC; dipoles in μC·m
+      amplitude: amplitude * 1e-6,
+      axis: AXES[axis],
+      frequency,
+      phase: (phaseDegrees * Math.PI) / 180,
+    });
+  };
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Oscillating Sources ({sources.length})
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Type
+          <select
+            value={kind}
+            onChange={(e) => setKind(e.target.value as 'charge' | 'dipole')}
+            style={inputStyle}
+          >
+            <option value="charge">Charge</option>
+            <option value="dipole">Dipole</option>
+          </select>
+        </label>
+        <label>
+          Axis
+          <select
+            value={axis}
+            disabled={kind === 'charge'}
+            onChange={(e) => setAxis(e.target.value as 'x' | 'y' | 'z')}
+            style={inputStyle}
+          >
+            <option value="x">X</option>
+            <option value="y">Y</option>
+            <option value="z">Z</option>
+          </select>
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          X
+          {numberInput(position.x, (x) => setPosition((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(position.y, (y) => setPosition((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(position.z, (z) => setPosition((prev) => ({ ...prev, z })))}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          {kind === 'charge' ? 'q₀ (μC)' : 'p₀ (μC·m)'}
+          {numberInput(amplitude, setAmplitude)}
+        </label>
+        <label>
+          f (Hz)
+          {numberInput(frequency, setFrequency)}
+        </label>
+        <label>
+          φ (°)
+          {numberInput(phaseDegrees, setPhaseDegrees)}
+        </label>
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '10px' }}>
+        <button
+          onClick={addSource}
+          style={{
+            flex: 1,
+            padding: '8px 12px',
+            background: '#4CAF50',
+            color: 'white',
+            border: 'none',
+            borderRadius: '4px',
+            cursor: 'pointer',
+            fontSize: '11px',
+          }}
+        >
+          + Add Source
+        </button>
+        <button
+          onClick={onTogglePlaying}
+          style={{
+            flex: 1,
+            padding: '8px 12px',
+            background: playing ? '#f44336' : '#2196F3',
+            color: 'white',
+            border: 'none',
+            borderRadius: '4px',
+            cursor: 'pointer',
+            fontSize: '11px',
+          }}
+        >
+          {playing ? 'Pause' : 'Play'}
+        </button>
+      </div>
+
+      {sources.map((source) => (
+        <div
+          key={source.id}
+          style={{
+            display: 'flex',
+            justifyContent: 'space-between',
+            alignItems: 'center',
+            fontSize: '10px',
+            marginBottom: '4px',
+          }}
+        >
+          <span>
+            {source.kind === 'charge' ? 'q' : 'p'} {(source.amplitude * 1e6).toFixed(2)} @{' '}
+            {source.frequency} Hz ({source.position.x}, {source.position.y}, {source.position.z})
+          </span>
+          <button
+            onClick={() => onRemoveSource(source.id)}
+            style={{
+              padding: '2px 6px',
+              background: '#f44336',
+              color: 'white',
+              border: 'none',
+              borderRadius: '3px',
+              cursor: 'pointer',
+              fontSize: '10px',
+            }}
+          >
+            Remove
+          </button>
+        </div>
+      ))}
+    </div>
+  );
+};
+
+export default OscillatorPanel;
@@ -0,0 +1,297 @@
+import * as THREE from 'three';
+import { packCharges } from '../models/FieldKernel';
+import type { Charge } from '../models/Charge';
+import { buildChargeTree } from '../models/ChargeTree';
+import type { ChargeTree } from '../models/ChargeTree';
+import { shareChargeTree } from '../models/FieldSources';
+import type { ParticleSwarmConfig } from '../models/TestParticles';
+import type {
+  ParticleWorkerRequest,
+  ParticleWorkerResult,
+  ParticleWorkerStepResult,
+} from '../workers/particleTracer.worker';
+
+export interface ParticleTracerConfig {
+  maxParticles: number;
+  trailLength: number; // Number of frames each trail remembers
+  latticeResolution: number; // Nodes per axis of the cached field lattice
+  bounds: { min: THREE.Vector3; max: THREE.Vector3 };
+  substeps: number; // Integration steps per rendered frame
+  timeScale: number; // Simulated seconds per real second
+  captureRadius: number; // Particles closer than this to a charge are absorbed
+  particleRadius: number;
+  particleColor: number;
+  trailColor: number;
+  trailOpacity: number;
+}
+
+/**
+ * Test-particle swarms integrated in a worker against a cached field lattice.
+ * Particles are one InstancedMesh; trails are one LineSegments ring buffer in
+ * which each frame writes a single contiguous slot of segments.
+ */
+export class ParticleTracerRenderer {
+  private scene: THREE.Scene;
+  private config: ParticleTracerConfig;
+  private worker: Worker;
+  private particleGeometry: THREE.OctahedronGeometry;
+  private particleMaterial: THREE.MeshBasicMaterial;
+  private particleMesh: THREE.InstancedMesh;
+  private trailGeometry: THREE.BufferGeometry;
+  private trailAttribute: THREE.BufferAttribute;
+  private trailMaterial: THREE.LineBasicMaterial;
+  private trails: THREE.LineSegments;
+  private trailHead = 0;
+  private previousPositions: Float32Array;
+  private hasPrevious: Uint8Array;
+  private renderedCount = 0;
+  private particleCount = 0;
+  // Set by launch() until a step request that includes the spawn goes out
+  private launchPending = false;
+  // Set by clear() while a step is in flight, so its stale result is dropped
+  private discardInFlight = false;
+  // Buffers owned by this side while no step is in flight
+  private spareBuffers: { positions: Float32Array; alive: Uint8Array } | null;
+  private dataset: ChargeTree = buildChargeTree(packCharges([]));
+  // Set while the worker rebuilds its lattice; only the latest layout sent
+  // meanwhile is kept, and it goes out when the rebuild finishes
+  private latticeBusy = false;
+  private pendingCharges: Charge[] | null = null;
+
+  constructor(scene: THREE.Scene, config: ParticleTracerConfig) {
+    this.scene = scene;
+    this.config = config;
+    const capacity = config.maxParticles;
+
+    this.particleGeometry = new THREE.OctahedronGeometry(config.particleRadius, 0);
+    this.particleMaterial = new THREE.MeshBasicMaterial({ color: config.particleColor });
+    this.particleMesh = new THREE.InstancedMesh(
+      this.particleGeometry,
+      this.particleMaterial,
+      capacity
+    );
+    this.particleMesh.instanceMatrix.setUsage(THREE.DynamicDrawUsage);
+    this.particleMesh.frustumCulled = false;
+    this.particleMesh.count = 0;
+
+    // Slot-major layout: [frame slot][particle][segment start, end][xyz]
+    this.trailAttribute = new THREE.BufferAttribute(
+      new Float32Array(config.trailLength * capacity * 6),
+      3
+    );
+    this.trailAttribute.setUsage(THREE.DynamicDrawUsage);
+    this.trailGeometry = new THREE.BufferGeometry();
+    this.trailGeometry.setAttribute('position', this.trailAttribute);
+    this.trailMaterial = new THREE.LineBasicMaterial({
+      color: config.trailColor,
+      transparent: true,
+      opacity: config.trailOpacity,
+    });
+    this.trails = new THREE.LineSegments(this.trailGeometry, this.trailMaterial);
+    this.trails.frustumCulled = false;
+
+    this.previousPositions = new Float32Array(capacity * 3);
+    this.hasPrevious = new Uint8Array(capacity);
+    this.spareBuffers = {
+      positions: new Float32Array(capacity * 3),
+      alive: new Uint8Array(capacity),
+    };
+
+    this.scene.add(this.particleMesh);
+    this.scene.add(this.trails);
+
+    this.worker = new Worker(
+      new URL('../workers/particleTracer.worker.ts', import.meta.url),
+      { type: 'module' }
+    );
+    this.worker.onmessage = (event: MessageEvent<ParticleWorkerResult>) => {
+      if (event.data.type === 'step') {
+        this.applyStep(event.data);
+        return;
+      }
+      this.latticeBusy = false;
+      const pending = this.pendingCharges;
+      this.pendingCharges = null;
+      if (pending) this.postCharges(pending);
+    };
+    this.post({
+      type: 'configure',
+      capacity,
+      bounds: config.bounds,
+      resolution: config.latticeResolution,
+      captureRadius: config.captureRadius,
+    });
+  }
+
+  private post(message: ParticleWorkerRequest, transfer: Transferable[] = []) {
+    this.worker.postMessage(message, transfer);
+  }
+
+  /**
+   * Write the worker's positions into the instance matrices and append one
+   * frame of trail segments at the ring-buffer head.
+   */
+  private applyStep(result: ParticleWorkerStepResult) {
+    const { count, positions, alive } = result;
+    if (this.discardInFlight) {
+      this.discardInFlight = false;
+      this.spareBuffers = { positions, alive };
+      return;
+    }
+
+    const matrices = this.particleMesh.instanceMatrix.array as Float32Array;
+    const trail = this.trailAttribute.array as Float32Array;
+    const previous = this.previousPositions;
+    const slotStart = this.trailHead * this.config.maxParticles * 6;
+
+    for (let p = 0; p < count; p++) {
+      const i = p * 3;
+      const m = p * 16;
+      const t = slotStart + p * 6;
+      const scale = alive[p] ? 1 : 0;
+
+      matrices[m] = scale;
+      matrices[m + 5] = scale;
+      matrices[m + 10] = scale;
+      matrices[m + 12] = positions[i];
+      matrices[m + 13] = positions[i + 1];
+      matrices[m + 14] = positions[i + 2];
+
+      const from = alive[p] && this.hasPrevious[p] ? previous : positions;
+      trail[t] = from[i];
+      trail[t + 1] = from[i + 1];
+      trail[t + 2] = from[i + 2];
+      trail[t + 3] = positions[i];
+      trail[t + 4] = positions[i + 1];
+      trail[t + 5] = positions[i + 2];
+
+      previous[i] = positions[i];
+      previous[i + 1] = positions[i + 1];
+      previous[i + 2] = positions[i + 2];
+      this.hasPrevious[p] = alive[p];
+    }
+
+    // Collapse segments left over from particles beyond the live range
+    trail.fill(0, slotStart + count * 6, slotStart + this.renderedCount * 6);
+    this.hasPrevious.fill(0, count, this.renderedCount);
+
+    this.particleMesh.count = count;
+    this.particleMesh.instanceMatrix.needsUpdate = true;
+    this.trailAttribute.clearUpdateRanges();
+    this.trailAttribute.addUpdateRange(slotStart, Math.max(count, this.renderedCount) * 6);
+    this.trailAttribute.needsUpdate = true;
+
+    this.trailHead = (this.trailHead + 1) % this.config.trailLength;
+    this.renderedCount = count;
+    this.particleCount = this.launchPending ? Math.max(count, 1) : count;
+    this.spareBuffers = { positions, alive };
+  }
+
+  /**
+   * Request the next integration step; called once per rendered frame
+   */
+  public update(deltaSeconds: number) {
+    if (!this.spareBuffers || this.particleCount === 0) return;
+
+    const { positions, alive } = this.spareBuffers;
+    this.spareBuffers = null;
+    this.launchPending = false;
+    this.post(
+      {
+        type: 'step',
+        dt: Math.min(deltaSeconds, 1 / 30) * this.config.timeScale,
+        substeps: this.config.substeps,
+        positions,
+        alive,
+      },
+      [positions.buffer as ArrayBuffer, alive.buffer as ArrayBuffer]
+    );
+  }
+
+  public launch(swarm: ParticleSwarmConfig) {
+    this.post({ type: 'spawn', swarm });
+    // The real count arrives with the next step result; non-zero starts stepping
+    this.launchPending = true;
+    this.particleCount = Math.max(this.particleCount, 1);
+  }
+
+  public clear() {
+    this.post({ type: 'clear' });
+    this.discardInFlight = this.spareBuffers === null;
+    this.particleMesh.count = 0;
+    (this.trailAttribute.array as Float32Array).fill(0);
+    this.trailAttribute.clearUpdateRanges();
+    this.trailAttribute.needsUpdate = true;
+    this.hasPrevious.fill(0);
+    this.renderedCount = 0;
+    this.particleCount = 0;
+    this.launchPending = false;
+  }
+
+  public getParticleCount(): number {
+    return this.particleCount;
+  }
+
+  /**
+   * Rebuild the worker's field lattice for the new charge layout. Layouts
+   * that arrive during a rebuild replace each other, so a drag costs at most
+   * one rebuild behind the pointer. The dataset is posted only when it
+   * changes, and copied rather than transferred, since the charge store
+   * keeps it.
+   */
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
+    if (dataset !== this.dataset) {
+      this.dataset = dataset;
+      this.post({ type: 'dataset', dataset: shareChargeTree(dataset) });
+    }
+    if (this.latticeBusy) {
+      this.pendingCharges = charges;
+      return;
+    }
+    this.postCharges(charges);
+  }
+
+  private postCharges(charges: Charge[]) {
+    this.latticeBusy = true;
+    const packed = packCharges(charges);
+    this.post({ type: 'charges', charges: packed }, [
+      packed.positions.buffer as ArrayBuffer,
+      packed.magnitudes.buffer as ArrayBuffer,
+    ]);
+  }
+
+  public setVisible(visible: boolean) {
+    this.particleMesh.visible = visible;
+    this.trails.visible = visible;
+  }
+
+  public dispose() {
+    this.worker.terminate();
+    this.scene.remove(this.particleMesh);
+    this.scene.remove(this.trails);
+    this.particleMesh.dispose();
+    this.particleGeometry.dispose();
+    this.particleMaterial.dispose();
+    this.trailGeometry.dispose();
+    this.trailMaterial.dispose();
+  }
+}
+
+export function createDefaultParticleTracerConfig(): ParticleTracerConfig {
+  return {
+    maxParticles: 10000,
+    trailLength: 24,
+    latticeResolution: 48,
+    bounds: {
+      min: new THREE.Vector3(-6, -6, -6),
+      max: new THREE.Vector3(6, 6, 6)
+    },
+    substeps: 4,
+    timeScale: 1,
+    captureRadius: 0.2,
+    particleRadius: 0.04,
+    particleColor: 0xff66ff,
+    trailColor: 0xff99ff,
+    trailOpacity: 0.5,
+  };
+}
@@ -0,0 +1,154 @@
+import React, { useState } from 'react';
+import type { ParticleSwarmConfig } from '../models/TestParticles';
+
+interface ParticleTracerPanelProps {
+  particleCount: number;
+  onLaunch: (swarm: ParticleSwarmConfig) => void;
+  onClear: () => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const ParticleTracerPanel: React.FC<ParticleTracerPanelProps> = ({
+  particleCount,
+  onLaunch,
+  onClear,
+}) => {
+  const [count, setCount] = useState(2000);
+  const [chargeMicroCoulombs, setChargeMicroCoulombs] = useState(0.1);
+  const [massGrams, setMassGrams] = useState(0.01);
+  const [origin, setOrigin] = useState({ x: -4, y: 0, z: 0 });
+  const [velocity, setVelocity] = useState({ x: 2, y: 0, z: 0 });
+  const [spread, setSpread] = useState(0.5);
+
+  const launch = () => {
+    onLaunch({
+      count,
+      charge: chargeMicroCoulombs * 1e-6,
+      mass: massGrams * 1e-3,
+      origin,
+      spread,
+      velocity,
+      velocitySpread: 0.2,
+    });
+  };
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Test Particles ({particleCount})
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Count
+          {numberInput(count, (v) => setCount(Math.max(0, Math.round(v))))}
+        </label>
+        <label>
+          q (μC)
+          {numberInput(chargeMicroCoulombs, setChargeMicroCoulombs)}
+        </label>
+        <label>
+          m (g)
+          {numberInput(massGrams, setMassGrams)}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Origin X
+          {numberInput(origin.x, (x) => setOrigin((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(origin.y, (y) => setOrigin((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(origin.z, (z) => setOrigin((prev) => ({ ...prev, z })))}
+        </label>
+        <label>
+          Radius
+          {numberInput(spread, setSpread)}
+        </label>
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          Vx (m/s)
+          {numberInput(velocity.x, (x) => setVelocity((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Vy
+          {numberInput(velocity.y, (y) => setVelocity((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Vz
+          {numberInput(velocity.z, (z) => setVelocity((prev) => ({ ...prev, z })))}
+        </label>
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px' }}>
+        <button
+          onClick={launch}
+          style={{
+            flex: 1,
+            padding: '8px 12px',
+            background: '#4CAF50',
+            color: 'white',
+            border: 'none',
+            borderRadius: '4px',
+            cursor: 'pointer',
+            fontSize: '11px',
+          }}
+        >
+          Launch
+        </button>
+        <button
+          onClick={onClear}
+          style={{
+            flex: 1,
+            padding: '8px 12px',
+            background: '#f44336',
+            color: 'white',
+            border: 'none',
+            borderRadius: '4px',
+            cursor: 'pointer',
+            fontSize: '11px',
+          }}
+        >
+          Clear
+        </button>
+      </div>
+    </div>
+  );
+};
+
+export default ParticleTracerPanel;
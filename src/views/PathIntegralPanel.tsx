@@ -0,0 +1,147 @@
+import React, { useState } from 'react';
+import type { Vec3Like } from '../models/FieldKernel';
+import type { PathIntegralResult } from '../models/PathIntegral';
+import type { VoltagePoint } from '../models/VoltagePoint';
+
+interface PathIntegralPanelProps {
+  path: Vec3Like[];
+  voltagePoints: VoltagePoint[];
+  testCharge: number; // in Coulombs
+  result: PathIntegralResult | null;
+  onAddPoint: (point: Vec3Like) => void;
+  onClearPath: () => void;
+  onTestChargeChange: (charge: number) => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const PathIntegralPanel: React.FC<PathIntegralPanelProps> = ({
+  path,
+  voltagePoints,
+  testCharge,
+  result,
+  onAddPoint,
+  onClearPath,
+  onTestChargeChange,
+}) => {
+  const [point, setPoint] = useState({ x: 0, y: 0, z: 0 });
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Path Integral ({path.length} points)
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr auto', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          X
+          {numberInput(point.x, (x) => setPoint((prev) => ({ ...prev, x })))}
+        </label>
+        <label>
+          Y
+          {numberInput(point.y, (y) => setPoint((prev) => ({ ...prev, y })))}
+        </label>
+        <label>
+          Z
+          {numberInput(point.z, (z) => setPoint((prev) => ({ ...prev, z })))}
+        </label>
+        <button
+          onClick={() => onAddPoint({ ...point })}
+          style={{ ...buttonStyle, background: '#4CAF50', alignSelf: 'end' }}
+        >
+          +
+        </button>
+      </div>
+
+      {voltagePoints.length > 0 && (
+        <select
+          value=""
+          onChange={(e) => {
+            const probe = voltagePoints.find((p) => p.id === e.target.value);
+            if (probe) {
+              onAddPoint({ x: probe.position.x, y: probe.position.y, z: probe.position.z });
+            }
+          }}
+          style={{ ...inputStyle, marginBottom: '5px' }}
+        >
+          <option value="">Add voltage point…</option>
+          {voltagePoints.map((probe, index) => (
+            <option key={probe.id} value={probe.id}>
+              Point {index + 1} ({probe.position.x.toFixed(2)}, {probe.position.y.toFixed(2)},{' '}
+              {probe.position.z.toFixed(2)})
+            </option>
+          ))}
+        </select>
+      )}
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          Test q (μC)
+          {numberInput(testCharge * 1e6, (q) => onTestChargeChange(q * 1e-6))}
+        </label>
+        <button
+          onClick={onClearPath}
+          disabled={path.length === 0}
+          style={{ ...buttonStyle, background: '#f44336', alignSelf: 'end' }}
+        >
+          Clear Path
+        </button>
+      </div>
+
+      {result ? (
+        <div style={{ fontSize: '11px' }}>
+          <div>∫E·dl = {result.lineIntegral.toExponential(6)} V</div>
+          <div>V(a)−V(b) = {result.potentialDifference.toExponential(6)} V</div>
+          <div>
+            Difference: {Math.abs(result.lineIntegral - result.potentialDifference).toExponential(2)} V
+          </div>
+          <div>Work on q = {(testCharge * result.lineIntegral).toExponential(4)} J</div>
+          <div style={{ color: '#aaa', fontSize: '10px' }}>
+            {result.intervals} intervals, {result.evaluations} field evaluations
+          </div>
+        </div>
+      ) : (
+        <div style={{ fontSize: '10px', color: '#aaa' }}>Add at least two points.</div>
+      )}
+    </div>
+  );
+};
+
+export default PathIntegralPanel;
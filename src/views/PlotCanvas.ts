@@ -0,0 +1,143 @@
+export interface PlotSeries {
+  name: string;
+  values: ArrayLike<number>;
+  color: string;
+}
+
+export const PLOT_COLORS = ['#4CAF50', '#2196F3', '#ff9800', '#e91e63', '#9c27b0', '#00bcd4', '#ffeb3b', '#f44336'];
+
+const MARGIN = { left: 52, right: 8, top: 8, bottom: 28 };
+
+const formatTick = (value: number): string =>
+  value === 0 ? '0' : Math.abs(value) >= 1e4 || Math.abs(value) < 1e-2 ? value.toExponential(1) : value.toPrecision(3);
+
+/**
+ * Minimal 2D-canvas plotting for panel readouts: line plots with a legend and
+ * heat maps over a regular grid. Each call redraws the whole canvas.
+ */
+export class PlotCanvas {
+  private canvas: HTMLCanvasElement;
+  private context: CanvasRenderingContext2D;
+
+  constructor(canvas: HTMLCanvasElement) {
+    this.canvas = canvas;
+    this.context = canvas.getContext('2d')!;
+  }
+
+  private get plotWidth(): number {
+    return this.canvas.width - MARGIN.left - MARGIN.right;
+  }
+
+  private get plotHeight(): number {
+    return this.canvas.height - MARGIN.top - MARGIN.bottom;
+  }
+
+  private drawFrame(xMin: number, xMax: number, yMin: number, yMax: number, xLabel: string, yLabel: string) {
+    const ctx = this.context;
+    const { width, height } = this.canvas;
+    ctx.strokeStyle = '#888';
+    ctx.strokeRect(MARGIN.left, MARGIN.top, this.plotWidth, this.plotHeight);
+    ctx.fillStyle = '#ccc';
+    ctx.font = '10px monospace';
+    ctx.textAlign = 'center';
+    ctx.fillText(formatTick(xMin), MARGIN.left, height - MARGIN.bottom + 12);
+    ctx.fillText(formatTick(xMax), width - MARGIN.right - 10, height - MARGIN.bottom + 12);
+    ctx.fillText(xLabel, MARGIN.left + this.plotWidth / 2, height - 4);
+    ctx.textAlign = 'right';
+    ctx.fillText(formatTick(yMax), MARGIN.left - 3, MARGIN.top + 8);
+    ctx.fillText(formatTick(yMin), MARGIN.left - 3, MARGIN.top + this.plotHeight);
+    ctx.save();
+    ctx.translate(10, MARGIN.top + this.plotHeight / 2);
+    ctx.rotate(-Math.PI / 2);
+    ctx.textAlign = 'center';
+    ctx.fillText(yLabel, 0, 0);
+    ctx.restore();
+  }
+
+  public clear() {
+    this.context.clearRect(0, 0, this.canvas.width, this.canvas.height);
+  }
+
+  /**
+   * One polyline per series over the shared x values
+   */
+  public plotLines(x: ArrayLike<number>, series: PlotSeries[], xLabel: string, yLabel: string = '') {
+    this.clear();
+    if (x.length === 0 || series.length === 0) return;
+    let yMin = Infinity;
+    let yMax = -Infinity;
+    for (const { values } of series) {
+      for (let i = 0; i < values.length; i++) {
+        if (!Number.isFinite(values[i])) continue;
+        yMin = Math.min(yMin, values[i]);
+        yMax = Math.max(yMax, values[i]);
+      }
+    }
+    if (!Number.isFinite(yMin)) return;
+    if (yMin === yMax) {
+      yMin -= Math.abs(yMin) * 0.1 || 1;
+      yMax += Math.abs(yMax) * 0.1 || 1;
+    }
+    const xMin = x[0];
+    const xMax = x[x.length - 1] === xMin ? xMin + 1 : x[x.length - 1];
+    this.drawFrame(xMin, xMax, yMin, yMax, xLabel, yLabel);
+
+    const ctx = this.context;
+    const toX = (value: number) => MARGIN.left + ((value - xMin) / (xMax - xMin)) * this.plotWidth;
+    const toY = (value: number) => MARGIN.top + (1 - (value - yMin) / (yMax - yMin)) * this.plotHeight;
+    series.forEach(({ name, values, color }, s) => {
+      ctx.strokeStyle = color;
+      ctx.beginPath();
+      for (let i = 0; i < x.length; i++) {
+        if (i === 0) ctx.moveTo(toX(x[i]), toY(values[i]));
+        else ctx.lineTo(toX(x[i]), toY(values[i]));
+      }
+      ctx.stroke();
+      ctx.fillStyle = color;
+      ctx.textAlign = 'left';
+      ctx.fillText(name, MARGIN.left + 4, MARGIN.top + 10 + s * 11);
+    });
+  }
+
+  /**
+   * Heat map of values[i * y.length + j] at (x[i], y[j]), with a colour bar
+   * range in the corner
+   */
+  public plotHeatMap(x: ArrayLike<number>, y: ArrayLike<number>, values: ArrayLike<number>, xLabel: string, yLabel: string) {
+    this.clear();
+    if (x.length === 0 || y.length === 0) return;
+    let min = Infinity;
+    let max = -Infinity;
+    for (let i = 0; i < values.length; i++) {
+      if (!Number.isFinite(values[i])) continue;
+      min = Math.min(min, values[i]);
+      max = Math.max(max, values[i]);
+    }
+    if (!Number.isFinite(min)) return;
+    const span = max - min || 1;
+
+    const ctx = this.context;
+    const cellWidth = this.plotWidth / x.length;
+    const cellHeight = this.plotHeight / y.length;
+    for (let i = 0; i < x.length; i++) {
+      for (let j = 0; j < y.length; j++) {
+        const t = (values[i * y.length + j] - min) / span;
+        // Blue → green → yellow ramp
+        const r = Math.round(255 * Math.max(0, 2 * t - 1));
+        const g = Math.round(255 * Math.min(1, 2 * t));
+        const b = Math.round(255 * Math.max(0, 1 - 2 * t));
+        ctx.fillStyle = `rgb(${r},${g},${b})`;
+        ctx.fillRect(
+          MARGIN.left + i * cellWidth,
+          MARGIN.top + (y.length - 1 - j) * cellHeight,
+          Math.ceil(cellWidth),
+          Math.ceil(cellHeight)
+        );
+      }
+    }
+    this.drawFrame(x[0], x[x.length - 1], y[0], y[y.length - 1], xLabel, yLabel);
+    ctx.fillStyle = '#fff';
+    ctx.textAlign = 'right';
+    ctx.fillText(`${formatTick(min)} … ${formatTick(max)}`, this.canvas.width - MARGIN.right - 2, MARGIN.top + 10);
+  }
+}
@@ -0,0 +1,294 @@
+import * as THREE from 'three';
+import { MeshBasicNodeMaterial } from 'three/webgpu';
+import type { TextureNode } from 'three/webgpu';
+import {
+  abs,
+  clamp,
+  float,
+  floor,
+  fract,
+  fwidth,
+  ivec2,
+  log,
+  max,
+  min,
+  mix,
+  select,
+  sign,
+  smoothstep,
+  textureLoad,
+  uniform,
+  uv,
+  vec3,
+} from 'three/tsl';
+import type { Charge } from '../models/Charge';
+import type { ChargeTree } from '../models/ChargeTree';
+import { packCharges } from '../models/FieldKernel';
+import { emptyFieldSources, shareChargeTree } from '../models/FieldSources';
+import type { FieldSources } from '../models/FieldSources';
+import { slicePlaneBasis, sliceLevels, slicePotentialRange } from '../models/PotentialSlice';
+import type { SlicePlane } from '../models/PotentialSlice';
+import { WorkerPool } from '../workers/WorkerPool';
+import type {
+  PotentialSliceWorkerRequest,
+  PotentialSliceWorkerResult,
+} from '../workers/potentialSlice.worker';
+
+export type SliceColormap = 'diverging' | 'ramp';
+
+export interface PotentialSliceConfig {
+  resolution: number; // Texels per side of the final pass
+  colormap: SliceColormap;
+  scale: 'linear' | 'log';
+  logDecades: number; // Decades of |V| below the range that the log scale spans
+  contourCount: number; // Isolines per half of the colour scale; 0 hides them
+  range: number | null; // |V| at the ends of the colour scale; null takes it from the first pass
+  opacity: number;
+}
+
+export interface SliceProgress {
+  resolution: number; // Texels per side of the pass just shown
+  level: number; // 1-based pass number
+  levels: number;
+  range: number; // |V| at the ends of the colour scale
+}
+
+/**
+ * Potential on a plane as a colour-mapped texture. Each plane or charge
+ * change restarts a chain of passes at 64², 128², … up to the configured
+ * resolution; every pass is split into row bands across a worker pool and
+ * replaces the texture when all its bands are in, so the slice sharpens in
+ * place. Stale passes are dropped by generation.
+ *
+ * The texture holds raw potentials; colormap, log scaling and contour lines
+ * are applied in the material, so display changes need no resampling.
+ * Samples are interpolated bilinearly by hand because 32-bit float
+ * textures are not filterable everywhere.
+ */
+export class PotentialSliceRenderer {
+  private scene: THREE.Scene;
+  private config: PotentialSliceConfig;
+  private onProgress: (progress: SliceProgress | null) => void;
+  private pool: WorkerPool<PotentialSliceWorkerRequest, PotentialSliceWorkerResult>;
+  private geometry: THREE.BufferGeometry;
+  private material: MeshBasicNodeMaterial;
+  private mesh: THREE.Mesh;
+  private texture: THREE.DataTexture;
+  private samples: TextureNode[];
+  private plane: SlicePlane | null = null;
+  private sources: FieldSources = emptyFieldSources();
+  private generation = 0;
+  private autoRange = 1;
+  private progress: SliceProgress | null = null;
+  private visible = true;
+
+  private size = uniform(1);
+  private range = uniform(1);
+  private logMode = uniform(0);
+  private logScale = uniform(1e4);
+  private colormap = uniform(0);
+  private contourCount = uniform(0);
+
+  constructor(
+    scene: THREE.Scene,
+    onProgress: (progress: SliceProgress | null) => void,
+    config: PotentialSliceConfig = createDefaultPotentialSliceConfig()
+  ) {
+    this.scene = scene;
+    this.onProgress = onProgress;
+    this.config = config;
+    this.pool = new WorkerPool<PotentialSliceWorkerRequest, PotentialSliceWorkerResult>(
+      () => new Worker(new URL('../workers/potentialSlice.worker.ts', import.meta.url), { type: 'module' })
+    );
+
+    this.texture = this.createTexture(new Float32Array(1), 1);
+    const coord = uv().mul(this.size).sub(0.5);
+    const corner = floor(coord);
+    const blend = coord.sub(corner);
+    const last = this.size.sub(1);
+    const x0 = clamp(corner.x, 0, last);
+    const x1 = clamp(corner.x.add(1), 0, last);
+    const y0 = clamp(corner.y, 0, last);
+    const y1 = clamp(corner.y.add(1), 0, last);
+    this.samples = [
+      textureLoad(this.texture, ivec2(x0, y0)),
+      textureLoad(this.texture, ivec2(x1, y0)),
+      textureLoad(this.texture, ivec2(x0, y1)),
+      textureLoad(this.texture, ivec2(x1, y1)),
+    ];
+    const [s00, s10, s01, s11] = this.samples;
+    const potential = mix(mix(s00.r, s10.r, blend.x), mix(s01.r, s11.r, blend.x), blend.y);
+
+    // Signed position on the colour scale, -1 … 1
+    const relative = abs(potential).div(this.range);
+    const linear = min(relative, float(1));
+    const logarithmic = clamp(log(relative.mul(this.logScale).add(1)).div(log(this.logScale.add(1))), 0, 1);
+    const t = sign(potential).mul(mix(linear, logarithmic, this.logMode));
+    const s = t.mul(0.5).add(0.5);
+
+    const white = vec3(1, 1, 1);
+    const diverging = select(
+      s.lessThan(0.5),
+      mix(vec3(0.23, 0.3, 0.75), white, s.mul(2)),
+      mix(white, vec3(0.7, 0.02, 0.15), s.mul(2).sub(1))
+    );
+    // Same blue → green → yellow ramp as the panel heat maps
+    const ramp = vec3(max(s.mul(2).sub(1), float(0)), min(s.mul(2), float(1)), max(float(1).sub(s.mul(2)), float(0)));
+    const base = select(this.colormap.greaterThan(0.5), ramp, diverging);
+
+    const level = t.mul(this.contourCount);
+    const distance = abs(fract(level.sub(0.5)).sub(0.5));
+    const line = float(1).sub(smoothstep(float(0), fwidth(level).mul(1.5), distance));
+    const contour = line.mul(min(this.contourCount, float(1)));
+
+    this.material = new MeshBasicNodeMaterial({
+      transparent: true,
+      side: THREE.DoubleSide,
+      depthWrite: false,
+    });
+    this.material.colorNode = mix(base, vec3(0, 0, 0), contour.mul(0.7));
+
+    this.geometry = new THREE.BufferGeometry();
+    this.geometry.setIndex([0, 1, 2, 0, 2, 3]);
+    this.geometry.setAttribute('uv', new THREE.Float32BufferAttribute([0, 0, 1, 0, 1, 1, 0, 1], 2));
+    this.mesh = new THREE.Mesh(this.geometry, this.material);
+    this.mesh.visible = false;
+    this.scene.add(this.mesh);
+    this.setConfig(config);
+  }
+
+  private createTexture(data: Float32Array, size: number): THREE.DataTexture {
+    const texture = new THREE.DataTexture(data, size, size, THREE.RedFormat, THREE.FloatType);
+    texture.minFilter = THREE.NearestFilter;
+    texture.magFilter = THREE.NearestFilter;
+    texture.needsUpdate = true;
+    return texture;
+  }
+
+  public setPlane(plane: SlicePlane | null) {
+    this.plane = plane;
+    if (!plane) {
+      this.generation++;
+      this.pool.cancelPending();
+      this.mesh.visible = false;
+      this.progress = null;
+      this.onProgress(null);
+      return;
+    }
+    const { origin: o, u, v } = slicePlaneBasis(plane);
+    this.geometry.setAttribute(
+      'position',
+      new THREE.Float32BufferAttribute(
+        [
+          o.x, o.y, o.z,
+          o.x + u.x, o.y + u.y, o.z + u.z,
+          o.x + u.x + v.x, o.y + u.y + v.y, o.z + u.z + v.z,
+          o.x + v.x, o.y + v.y, o.z + v.z,
+        ],
+        3
+      )
+    );
+    this.geometry.computeBoundingSphere();
+    this.refine();
+  }
+
+  /**
+   * The workers are sent the dataset only when it changes; each pass's
+   * requests carry just the editable charges
+   */
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
+    if (dataset !== this.sources.dataset) this.pool.broadcast({ type: 'dataset', dataset: shareChargeTree(dataset) });
+    this.sources = { charges: packCharges(charges), dataset };
+    this.refine();
+  }
+
+  /**
+   * Apply display settings; only a resolution change resamples
+   */
+  public setConfig(config: PotentialSliceConfig) {
+    const resample = config.resolution !== this.config.resolution;
+    this.config = config;
+    this.logMode.value = config.scale === 'log' ? 1 : 0;
+    this.logScale.value = Math.pow(10, Math.max(1, config.logDecades));
+    this.colormap.value = config.colormap === 'ramp' ? 1 : 0;
+    this.contourCount.value = Math.max(0, Math.round(config.contourCount));
+    this.material.opacity = config.opacity;
+    this.applyRange();
+    if (resample) this.refine();
+  }
+
+  private applyRange() {
+    this.range.value = this.config.range !== null && this.config.range > 0 ? this.config.range : this.autoRange;
+    if (this.progress) {
+      this.progress = { ...this.progress, range: this.range.value };
+      this.onProgress(this.progress);
+    }
+  }
+
+  private async refine() {
+    const plane = this.plane;
+    if (!plane) return;
+    const generation = ++this.generation;
+    this.pool.cancelPending();
+    const { charges } = this.sources;
+    const levels = sliceLevels(this.config.resolution);
+
+    for (let level = 0; level < levels.length; level++) {
+      const n = levels[level];
+      const bandRows = Math.ceil(n / this.pool.size);
+      const bands: Promise<PotentialSliceWorkerResult>[] = [];
+      for (let rowStart = 0; rowStart < n; rowStart += bandRows) {
+        const rowEnd = Math.min(n, rowStart + bandRows);
+        bands.push(this.pool.run({ type: 'rows', charges, plane, resolution: n, rowStart, rowEnd }));
+      }
+      let results: PotentialSliceWorkerResult[];
+      try {
+        results = await Promise.all(bands);
+      } catch {
+        return; // Cancelled by a newer pass
+      }
+      if (generation !== this.generation) return;
+
+      const values = new Float32Array(n * n);
+      for (const band of results) values.set(band.potential, band.rowStart * n);
+      if (level === 0) this.autoRange = slicePotentialRange(values);
+      this.upload(values, n);
+      this.mesh.visible = this.visible;
+      this.progress = { resolution: n, level: level + 1, levels: levels.length, range: 0 };
+      this.applyRange();
+    }
+  }
+
+  private upload(values: Float32Array, n: number) {
+    this.texture.dispose();
+    this.texture = this.createTexture(values, n);
+    for (const sample of this.samples) sample.value = this.texture;
+    this.size.value = n;
+  }
+
+  public setVisible(visible: boolean) {
+    this.visible = visible;
+    this.mesh.visible = visible && this.progress !== null;
+  }
+
+  public dispose() {
+    this.generation++;
+    this.pool.dispose();
+    this.scene.remove(this.mesh);
+    this.geometry.dispose();
+    this.material.dispose();
+    this.texture.dispose();
+  }
+}
+
+export function createDefaultPotentialSliceConfig(): PotentialSliceConfig {
+  return {
+    resolution: 512,
+    colormap: 'diverging',
+    scale: 'log',
+    logDecades: 4,
+    contourCount: 8,
+    range: null,
+    opacity: 0.85,
+  };
+}
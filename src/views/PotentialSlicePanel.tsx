@@ -0,0 +1,203 @@
+import React, { useState } from 'react';
+import type { SliceAxis, SlicePlane } from '../models/PotentialSlice';
+import type { PotentialSliceConfig, SliceColormap, SliceProgress } from './PotentialSlice';
+
+interface PotentialSlicePanelProps {
+  config: PotentialSliceConfig;
+  progress: SliceProgress | null;
+  onPlaneChange: (plane: SlicePlane | null) => void;
+  onConfigChange: (config: PotentialSliceConfig) => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const PotentialSlicePanel: React.FC<PotentialSlicePanelProps> = ({
+  config,
+  progress,
+  onPlaneChange,
+  onConfigChange,
+}) => {
+  const [shown, setShown] = useState(false);
+  const [plane, setPlane] = useState<SlicePlane>({ axis: 'z', offset: 0, halfSize: 5 });
+
+  // Moving the plane restarts the coarse-to-fine passes straight away
+  const updatePlane = (next: SlicePlane) => {
+    setPlane(next);
+    if (shown) onPlaneChange(next);
+  };
+
+  const toggle = () => {
+    setShown(!shown);
+    onPlaneChange(shown ? null : plane);
+  };
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>Potential Slice</div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Normal
+          <select
+            value={plane.axis}
+            onChange={(e) => updatePlane({ ...plane, axis: e.target.value as SliceAxis })}
+            style={inputStyle}
+          >
+            <option value="x">X</option>
+            <option value="y">Y</option>
+            <option value="z">Z</option>
+          </select>
+        </label>
+        <label>
+          Half size
+          <input
+            type="number"
+            min={0.5}
+            step={0.5}
+            value={plane.halfSize}
+            onChange={(e) => updatePlane({ ...plane, halfSize: Math.max(0.5, parseFloat(e.target.value) || 0) })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Texels
+          <select
+            value={config.resolution}
+            onChange={(e) => onConfigChange({ ...config, resolution: parseInt(e.target.value) })}
+            style={inputStyle}
+          >
+            <option value={512}>512²</option>
+            <option value={1024}>1024²</option>
+          </select>
+        </label>
+      </div>
+
+      <label style={{ display: 'block', marginBottom: '5px' }}>
+        Offset: {plane.offset.toFixed(2)}
+        <input
+          type="range"
+          min={-plane.halfSize}
+          max={plane.halfSize}
+          step={0.05}
+          value={plane.offset}
+          onChange={(e) => updatePlane({ ...plane, offset: parseFloat(e.target.value) || 0 })}
+          style={{ width: '100%' }}
+        />
+      </label>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Colours
+          <select
+            value={config.colormap}
+            onChange={(e) => onConfigChange({ ...config, colormap: e.target.value as SliceColormap })}
+            style={inputStyle}
+          >
+            <option value="diverging">± V</option>
+            <option value="ramp">Ramp</option>
+          </select>
+        </label>
+        <label>
+          Scale
+          <select
+            value={config.scale}
+            onChange={(e) => onConfigChange({ ...config, scale: e.target.value as 'linear' | 'log' })}
+            style={inputStyle}
+          >
+            <option value="log">Log</option>
+            <option value="linear">Linear</option>
+          </select>
+        </label>
+        <label>
+          Decades
+          <input
+            type="number"
+            min={1}
+            max={12}
+            value={config.logDecades}
+            disabled={config.scale !== 'log'}
+            onChange={(e) => onConfigChange({ ...config, logDecades: parseFloat(e.target.value) || 1 })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Contours
+          <input
+            type="number"
+            min={0}
+            max={50}
+            value={config.contourCount}
+            onChange={(e) => onConfigChange({ ...config, contourCount: parseInt(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Range (V)
+          <input
+            type="number"
+            value={config.range ?? ''}
+            placeholder="auto"
+            onChange={(e) =>
+              onConfigChange({ ...config, range: e.target.value === '' ? null : parseFloat(e.target.value) || 0 })
+            }
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Opacity
+          <input
+            type="number"
+            min={0.1}
+            max={1}
+            step={0.05}
+            value={config.opacity}
+            onChange={(e) => onConfigChange({ ...config, opacity: parseFloat(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <button onClick={toggle} style={{ ...buttonStyle, background: shown ? '#f44336' : '#4CAF50' }}>
+          {shown ? 'Hide Slice' : 'Show Slice'}
+        </button>
+      </div>
+
+      {shown && progress && (
+        <div style={{ fontSize: '10px', color: '#aaa' }}>
+          {progress.resolution}² (pass {progress.level}/{progress.levels}), colour range ±{progress.range.toExponential(2)} V
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default PotentialSlicePanel;
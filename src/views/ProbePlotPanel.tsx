@@ -0,0 +1,182 @@
+import React, { useEffect, useRef, useState } from 'react';
+import { MAX_PROBE_SAMPLES } from '../models/ProbeSampling';
+import type { ProbeSamples, ProbeShape } from '../models/ProbeSampling';
+import { PlotCanvas } from './PlotCanvas';
+
+interface ProbePlotPanelProps {
+  samples: ProbeSamples | null;
+  onShapeChange: (shape: ProbeShape | null) => void;
+}
+
+type Vec3 = { x: number; y: number; z: number };
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const ProbePlotPanel: React.FC<ProbePlotPanelProps> = ({ samples, onShapeChange }) => {
+  const [kind, setKind] = useState<ProbeShape['kind']>('line');
+  // Line: A → B. Rectangle: origin A with edges U and V
+  const [pointA, setPointA] = useState<Vec3>({ x: -5, y: 0, z: 0 });
+  const [pointB, setPointB] = useState<Vec3>({ x: 5, y: 0, z: 0 });
+  const [edgeU, setEdgeU] = useState<Vec3>({ x: 10, y: 0, z: 0 });
+  const [edgeV, setEdgeV] = useState<Vec3>({ x: 0, y: 10, z: 0 });
+  const [lineSamples, setLineSamples] = useState(1000);
+  const [gridSamples, setGridSamples] = useState(100); // Per side
+  const [quantity, setQuantity] = useState<'potential' | 'field'>('potential');
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+
+  useEffect(() => {
+    if (!canvasRef.current) return;
+    const plot = new PlotCanvas(canvasRef.current);
+    if (!samples) {
+      plot.clear();
+      return;
+    }
+    const values = quantity === 'potential' ? samples.potential : samples.fieldMagnitude;
+    const label = quantity === 'potential' ? 'V (V)' : '|E| (V/m)';
+    if (samples.shape.kind === 'line') {
+      plot.plotLines(samples.coordinates[0], [{ name: label, values, color: '#ff9800' }], 's (m)', label);
+    } else {
+      plot.plotHeatMap(samples.coordinates[0], samples.coordinates[1], values, 'u (m)', 'v (m)');
+    }
+  }, [samples, quantity]);
+
+  const apply = () => {
+    if (kind === 'line') {
+      onShapeChange({ kind, start: { ...pointA }, end: { ...pointB }, samples: lineSamples });
+    } else {
+      onShapeChange({
+        kind,
+        origin: { ...pointA },
+        u: { ...edgeU },
+        v: { ...edgeV },
+        samplesU: gridSamples,
+        samplesV: gridSamples,
+      });
+    }
+  };
+
+  const vectorInputs = (label: string, value: Vec3, onChange: (value: Vec3) => void) => (
+    <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+      {(['x', 'y', 'z'] as const).map((axis) => (
+        <label key={axis}>
+          {label} {axis.toUpperCase()}
+          <input
+            type="number"
+            value={value[axis]}
+            onChange={(e) => onChange({ ...value, [axis]: parseFloat(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+      ))}
+    </div>
+  );
+
+  let minimum = 0;
+  let maximum = 0;
+  if (samples) {
+    const values = quantity === 'potential' ? samples.potential : samples.fieldMagnitude;
+    minimum = Infinity;
+    maximum = -Infinity;
+    for (let i = 0; i < values.length; i++) {
+      minimum = Math.min(minimum, values[i]);
+      maximum = Math.max(maximum, values[i]);
+    }
+  }
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>Probe Line / Grid</div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Shape
+          <select value={kind} onChange={(e) => setKind(e.target.value as ProbeShape['kind'])} style={inputStyle}>
+            <option value="line">Line</option>
+            <option value="rect">Rectangle</option>
+          </select>
+        </label>
+        <label>
+          {kind === 'line' ? 'Samples' : 'Per side'}
+          <input
+            type="number"
+            min={2}
+            max={kind === 'line' ? MAX_PROBE_SAMPLES : Math.floor(Math.sqrt(MAX_PROBE_SAMPLES))}
+            value={kind === 'line' ? lineSamples : gridSamples}
+            onChange={(e) => {
+              const value = parseInt(e.target.value) || 2;
+              if (kind === 'line') setLineSamples(value);
+              else setGridSamples(value);
+            }}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Plot
+          <select
+            value={quantity}
+            onChange={(e) => setQuantity(e.target.value as 'potential' | 'field')}
+            style={inputStyle}
+          >
+            <option value="potential">V</option>
+            <option value="field">|E|</option>
+          </select>
+        </label>
+      </div>
+
+      {vectorInputs(kind === 'line' ? 'From' : 'Origin', pointA, setPointA)}
+      {kind === 'line' ? vectorInputs('To', pointB, setPointB) : vectorInputs('U', edgeU, setEdgeU)}
+      {kind === 'rect' && vectorInputs('V', edgeV, setEdgeV)}
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <button onClick={apply} style={{ ...buttonStyle, background: '#4CAF50' }}>
+          Place
+        </button>
+        <button onClick={() => onShapeChange(null)} disabled={!samples} style={{ ...buttonStyle, background: '#f44336' }}>
+          Clear
+        </button>
+      </div>
+
+      {samples && (
+        <div style={{ fontSize: '10px', color: '#aaa' }}>
+          {samples.potential.length} samples, min {minimum.toExponential(3)}, max {maximum.toExponential(3)}
+        </div>
+      )}
+      <canvas
+        ref={canvasRef}
+        width={300}
+        height={180}
+        style={{ display: samples ? 'block' : 'none', marginTop: '5px' }}
+      />
+    </div>
+  );
+};
+
+export default ProbePlotPanel;
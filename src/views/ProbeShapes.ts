@@ -0,0 +1,141 @@
+import * as THREE from 'three';
+import type { Charge } from '../models/Charge';
+import type { ChargeTree } from '../models/ChargeTree';
+import { packCharges } from '../models/FieldKernel';
+import { emptyFieldSources, shareChargeTree } from '../models/FieldSources';
+import type { FieldSources } from '../models/FieldSources';
+import type { ProbeSamples, ProbeShape } from '../models/ProbeSampling';
+import type {
+  ProbeSamplingWorkerRequest,
+  ProbeSamplingWorkerResult,
+} from '../workers/probeSampling.worker';
+
+export interface ProbeShapeConfig {
+  color: number;
+}
+
+/**
+ * Outline of the active probe line or rectangle, plus the worker that samples
+ * it. Requests coalesce: while one is in flight, further edits only mark the
+ * shape dirty, and a single fresh request goes out when the reply arrives, so
+ * rapid charge drags never queue up stale work. That reply is still shown
+ * meanwhile, unless the shape itself changed since it was requested.
+ */
+export class ProbeShapeRenderer {
+  private scene: THREE.Scene;
+  private worker: Worker;
+  private onSamples: (samples: ProbeSamples | null) => void;
+  private geometry: THREE.BufferGeometry;
+  private material: THREE.LineBasicMaterial;
+  private outline: THREE.LineSegments;
+  private shape: ProbeShape | null = null;
+  private sources: FieldSources = emptyFieldSources();
+  private generation = 0;
+  private inFlight = false;
+  private dirty = false;
+
+  constructor(
+    scene: THREE.Scene,
+    onSamples: (samples: ProbeSamples | null) => void,
+    config: ProbeShapeConfig = createDefaultProbeShapeConfig()
+  ) {
+    this.scene = scene;
+    this.onSamples = onSamples;
+    this.geometry = new THREE.BufferGeometry();
+    this.material = new THREE.LineBasicMaterial({ color: config.color });
+    this.outline = new THREE.LineSegments(this.geometry, this.material);
+    this.outline.frustumCulled = false;
+    this.scene.add(this.outline);
+
+    this.worker = new Worker(
+      new URL('../workers/probeSampling.worker.ts', import.meta.url),
+      { type: 'module' }
+    );
+    this.worker.onmessage = (event: MessageEvent<ProbeSamplingWorkerResult>) => {
+      this.inFlight = false;
+      if (event.data.generation === this.generation) this.onSamples(event.data.samples);
+      if (this.dirty) {
+        this.dirty = false;
+        this.request();
+      }
+    };
+  }
+
+  public setShape(shape: ProbeShape | null) {
+    this.shape = shape;
+    this.updateOutline();
+    // Replies for the previous shape no longer apply
+    this.generation++;
+    if (shape) {
+      this.request();
+    } else {
+      this.onSamples(null);
+    }
+  }
+
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
+    // The worker keeps the dataset; requests carry only the editable charges
+    if (dataset !== this.sources.dataset) {
+      const message: ProbeSamplingWorkerRequest = { type: 'dataset', dataset: shareChargeTree(dataset) };
+      this.worker.postMessage(message);
+    }
+    this.sources = { charges: packCharges(charges), dataset };
+    this.request();
+  }
+
+  private request() {
+    if (!this.shape) return;
+    if (this.inFlight) {
+      this.dirty = true;
+      return;
+    }
+    const message: ProbeSamplingWorkerRequest = {
+      type: 'sample',
+      generation: ++this.generation,
+      charges: this.sources.charges,
+      shape: this.shape,
+    };
+    this.inFlight = true;
+    this.worker.postMessage(message);
+  }
+
+  private updateOutline() {
+    const shape = this.shape;
+    if (!shape) {
+      this.geometry.deleteAttribute('position');
+      return;
+    }
+    let vertices: number[];
+    if (shape.kind === 'line') {
+      vertices = [shape.start.x, shape.start.y, shape.start.z, shape.end.x, shape.end.y, shape.end.z];
+    } else {
+      const { origin: o, u, v } = shape;
+      const corners = [
+        [o.x, o.y, o.z],
+        [o.x + u.x, o.y + u.y, o.z + u.z],
+        [o.x + u.x + v.x, o.y + u.y + v.y, o.z + u.z + v.z],
+        [o.x + v.x, o.y + v.y, o.z + v.z],
+      ];
+      vertices = [];
+      for (let i = 0; i < 4; i++) vertices.push(...corners[i], ...corners[(i + 1) % 4]);
+    }
+    this.geometry.setAttribute('position', new THREE.Float32BufferAttribute(vertices, 3));
+  }
+
+  public setVisible(visible: boolean) {
+    this.outline.visible = visible;
+  }
+
+  public dispose() {
+    this.worker.terminate();
+    this.scene.remove(this.outline);
+    this.geometry.dispose();
+    this.material.dispose();
+  }
+}
+
+export function createDefaultProbeShapeConfig(): ProbeShapeConfig {
+  return {
+    color: 0xff9800,
+  };
+}
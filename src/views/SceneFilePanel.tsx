@@ -0,0 +1,228 @@
+import React, { useState } from 'react';
+import { ELEMENTARY_CHARGE, createDefaultChargeTextOptions } from '../export/ChargeTextParser';
+import type { ChargeTextOptions } from '../export/ChargeTextParser';
+import type { VtkFormat } from '../export/VtkExport';
+import { createDefaultUrlStateOptions } from '../export/UrlState';
+import type { UrlStateOptions } from '../export/UrlState';
+
+export interface SceneFileStatus {
+  message: string;
+  progress: number | null; // 0 … 1 while a file is being read
+}
+
+interface SceneFilePanelProps {
+  datasetCount: number; // Charges held only in the display-only dataset
+  status: SceneFileStatus | null;
+  onSave: (precision: 'float32' | 'float64') => void;
+  onLoad: (file: File) => void;
+  onImport: (file: File, options: ChargeTextOptions) => void;
+  onClearDataset: () => void;
+  onExportFields: (format: VtkFormat) => void;
+  onExportGltf: () => void;
+  onShareLink: (options: UrlStateOptions) => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const CHARGE_UNITS: Record<string, number> = {
+  e: ELEMENTARY_CHARGE,
+  'μC': 1e-6,
+  C: 1,
+};
+
+const SceneFilePanel: React.FC<SceneFilePanelProps> = ({
+  datasetCount,
+  status,
+  onSave,
+  onLoad,
+  onImport,
+  onClearDataset,
+  onExportFields,
+  onExportGltf,
+  onShareLink,
+}) => {
+  const [precision, setPrecision] = useState<'float32' | 'float64'>('float64');
+  const [shareOptions, setShareOptions] = useState<UrlStateOptions>(createDefaultUrlStateOptions);
+  const [exportFormat, setExportFormat] = useState<VtkFormat>('xml');
+  const [importOptions, setImportOptions] = useState<ChargeTextOptions>(createDefaultChargeTextOptions);
+  const chargeUnit =
+    Object.keys(CHARGE_UNITS).find((unit) => CHARGE_UNITS[unit] === importOptions.chargeUnit) ?? 'e';
+  const busy = status?.progress !== null && status?.progress !== undefined;
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>Scene File</div>
+
+      <label style={{ display: 'block', marginBottom: '5px' }}>
+        Precision
+        <select
+          value={precision}
+          onChange={(e) => setPrecision(e.target.value as 'float32' | 'float64')}
+          style={inputStyle}
+        >
+          <option value="float64">float64</option>
+          <option value="float32">float32 (half the size)</option>
+        </select>
+      </label>
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <button onClick={() => onSave(precision)} disabled={busy} style={{ ...buttonStyle, background: '#4CAF50' }}>
+          Save
+        </button>
+        <label style={{ ...buttonStyle, background: '#2196F3', textAlign: 'center' }}>
+          Load
+          <input
+            type="file"
+            accept=".efvs"
+            disabled={busy}
+            style={{ display: 'none' }}
+            onChange={(e) => {
+              const file = e.target.files?.[0];
+              if (file) onLoad(file);
+              e.target.value = '';
+            }}
+          />
+        </label>
+      </div>
+
+      <div style={{ fontSize: '12px', fontWeight: 'bold', margin: '10px 0 5px' }}>Import charges (PQR / XYZ / CSV)</div>
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Scale
+          <input
+            type="number"
+            step={0.01}
+            value={importOptions.lengthScale}
+            onChange={(e) => setImportOptions({ ...importOptions, lengthScale: parseFloat(e.target.value) || 0 })}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          Charge in
+          <select
+            value={chargeUnit}
+            onChange={(e) => setImportOptions({ ...importOptions, chargeUnit: CHARGE_UNITS[e.target.value] })}
+            style={inputStyle}
+          >
+            {Object.keys(CHARGE_UNITS).map((unit) => (
+              <option key={unit} value={unit}>
+                {unit}
+              </option>
+            ))}
+          </select>
+        </label>
+        <label style={{ display: 'flex', alignItems: 'flex-end', gap: '5px' }}>
+          <input
+            type="checkbox"
+            checked={importOptions.recenter}
+            onChange={(e) => setImportOptions({ ...importOptions, recenter: e.target.checked })}
+          />
+          Centre
+        </label>
+      </div>
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <label style={{ ...buttonStyle, background: '#2196F3', textAlign: 'center' }}>
+          Import…
+          <input
+            type="file"
+            accept=".pqr,.xyz,.csv,.txt"
+            disabled={busy}
+            style={{ display: 'none' }}
+            onChange={(e) => {
+              const file = e.target.files?.[0];
+              if (file) onImport(file, importOptions);
+              e.target.value = '';
+            }}
+          />
+        </label>
+      </div>
+
+      <div style={{ fontSize: '12px', fontWeight: 'bold', margin: '10px 0 5px' }}>Export fields</div>
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <select
+          value={exportFormat}
+          onChange={(e) => setExportFormat(e.target.value as VtkFormat)}
+          style={{ ...inputStyle, flex: 1 }}
+        >
+          <option value="xml">VTK XML (.vti / .vtp)</option>
+          <option value="legacy">Legacy VTK (.vtk)</option>
+          <option value="raw">Raw + NRRD headers</option>
+        </select>
+        <button onClick={() => onExportFields(exportFormat)} disabled={busy} style={{ ...buttonStyle, background: '#4CAF50' }}>
+          Export
+        </button>
+      </div>
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <button onClick={onExportGltf} disabled={busy} style={{ ...buttonStyle, background: '#2196F3' }}>
+          Export scene as GLB
+        </button>
+      </div>
+
+      <div style={{ fontSize: '12px', fontWeight: 'bold', margin: '10px 0 5px' }}>Share link</div>
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        <select
+          value={shareOptions.gridStep}
+          onChange={(e) => setShareOptions({ ...shareOptions, gridStep: parseFloat(e.target.value) })}
+          style={{ ...inputStyle, flex: 1 }}
+        >
+          <option value={0.001}>Grid 0.001</option>
+          <option value={0.01}>Grid 0.01</option>
+          <option value={0.1}>Grid 0.1 (shortest)</option>
+        </select>
+        <button onClick={() => onShareLink(shareOptions)} disabled={busy} style={{ ...buttonStyle, background: '#2196F3' }}>
+          Copy link
+        </button>
+      </div>
+
+      {datasetCount > 0 && (
+        <div style={{ display: 'flex', gap: '5px', alignItems: 'center', marginBottom: '5px', fontSize: '10px' }}>
+          <span style={{ flex: 2 }}>{datasetCount.toLocaleString()} charges shown as points (not editable)</span>
+          <button onClick={onClearDataset} style={{ ...buttonStyle, background: '#f44336' }}>
+            Clear
+          </button>
+        </div>
+      )}
+
+      {status && (
+        <div style={{ fontSize: '10px', color: '#aaa' }}>
+          {status.message}
+          {busy && (
+            <div style={{ height: '4px', background: '#333', marginTop: '3px' }}>
+              <div style={{ height: '100%', width: `${Math.round(status.progress! * 100)}%`, background: '#2196F3' }} />
+            </div>
+          )}
+        </div>
+      )}
+    </div>
+  );
+};
+
+export default SceneFilePanel;
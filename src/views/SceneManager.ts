@@ -3,18 +3,14 @@ import { OrbitControls } from 'three/addons/controls/OrbitControls.js';
 import { WebGPURenderer } from 'three/webgpu';
 
 export class SceneManager {
-  public renderer: WebGPURenderer | THREE.WebGLRenderer;
+  public renderer: WebGPURenderer;
   public scene: THREE.Scene;
   public camera: THREE.PerspectiveCamera;
   public controls: OrbitControls | null = null;
 
   constructor() {
-    // Initialize renderer
-    if ('gpu' in navigator) {
-      this.renderer = new WebGPURenderer({ antialias: true });
-    } else {
-      this.renderer = new THREE.WebGLRenderer({ antialias: true });
-    }
+    // Initialize renderer (falls back to a WebGL 2 backend without WebGPU)
+    this.renderer = new WebGPURenderer({ antialias: true });
     this.renderer.setClearColor(0x282c34, 1);
     this.renderer.setPixelRatio(window.devicePixelRatio);
     this.renderer.setSize(window.innerWidth, window.innerHeight);
@@ -0,0 +1,243 @@
+import React, { useEffect, useRef, useState } from 'react';
+import type { Charge } from '../models/Charge';
+import type { SweepAxis, SweepParameter, SweepResult } from '../models/ParameterSweep';
+import { PLOT_COLORS, PlotCanvas } from './PlotCanvas';
+
+interface SweepPanelProps {
+  charges: Charge[];
+  result: SweepResult | null;
+  status: string | null; // Progress or error text
+  onRun: (axes: SweepAxis[]) => void;
+  onExportCsv: () => void;
+  onSaveSpec: (axes: SweepAxis[]) => void; // Sweep JSON for the run-sweep CLI
+}
+
+interface AxisDraft {
+  kind: SweepParameter['kind'];
+  chargeId: string;
+  anchorId: string;
+  axis: 'x' | 'y' | 'z';
+  from: number; // μC for magnitudes, m otherwise
+  to: number;
+  steps: number;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const toAxis = (draft: AxisDraft): SweepAxis => {
+  const scale = draft.kind === 'magnitude' ? 1e-6 : 1;
+  let parameter: SweepParameter;
+  switch (draft.kind) {
+    case 'magnitude':
+      parameter = { kind: 'magnitude', chargeId: draft.chargeId };
+      break;
+    case 'separation':
+      parameter = { kind: 'separation', chargeId: draft.chargeId, anchorId: draft.anchorId };
+      break;
+    case 'coordinate':
+      parameter = { kind: 'coordinate', chargeId: draft.chargeId, axis: draft.axis };
+      break;
+  }
+  return { parameter, from: draft.from * scale, to: draft.to * scale, steps: draft.steps };
+};
+
+const SweepPanel: React.FC<SweepPanelProps> = ({ charges, result, status, onRun, onExportCsv, onSaveSpec }) => {
+  const firstId = charges[0]?.id ?? '';
+  const [drafts, setDrafts] = useState<AxisDraft[]>([
+    { kind: 'magnitude', chargeId: firstId, anchorId: firstId, axis: 'x', from: -5, to: 5, steps: 100 },
+  ]);
+  const [metricIndex, setMetricIndex] = useState(0);
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+
+  useEffect(() => {
+    if (!canvasRef.current) return;
+    const plot = new PlotCanvas(canvasRef.current);
+    if (!result || result.metrics.length === 0) {
+      plot.clear();
+      return;
+    }
+    const metric = Math.min(metricIndex, result.metrics.length - 1);
+    const metricCount = result.metrics.length;
+    const column = new Float64Array(result.values.length / metricCount);
+    for (let c = 0; c < column.length; c++) column[c] = result.values[c * metricCount + metric];
+    const labels = result.axisLabels;
+    if (result.axisValues.length === 1) {
+      plot.plotLines(
+        result.axisValues[0],
+        [{ name: result.metrics[metric], values: column, color: PLOT_COLORS[metric % PLOT_COLORS.length] }],
+        labels[0],
+      );
+    } else {
+      plot.plotHeatMap(result.axisValues[0], result.axisValues[1], column, labels[0], labels[1]);
+    }
+  }, [result, metricIndex]);
+
+  const updateDraft = (index: number, patch: Partial<AxisDraft>) => {
+    setDrafts((prev) => prev.map((draft, i) => (i === index ? { ...draft, ...patch } : draft)));
+  };
+
+  const chargeSelect = (value: string, onChange: (id: string) => void) => (
+    <select value={value} onChange={(e) => onChange(e.target.value)} style={inputStyle}>
+      {charges.map((charge, index) => (
+        <option key={charge.id} value={charge.id}>
+          Charge {index + 1}
+        </option>
+      ))}
+    </select>
+  );
+
+  const numberInput = (value: number, onChange: (value: number) => void) => (
+    <input
+      type="number"
+      value={value}
+      onChange={(e) => onChange(parseFloat(e.target.value) || 0)}
+      style={inputStyle}
+    />
+  );
+
+  const configurations = drafts.reduce((count, draft) => count * Math.max(draft.steps, 1), 1);
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Parameter Sweep ({configurations} configurations)
+      </div>
+
+      {drafts.map((draft, index) => (
+        <div key={index} style={{ marginBottom: '8px', borderLeft: '2px solid #555', paddingLeft: '5px' }}>
+          <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+            <label>
+              Axis {index + 1}
+              <select
+                value={draft.kind}
+                onChange={(e) => updateDraft(index, { kind: e.target.value as AxisDraft['kind'] })}
+                style={inputStyle}
+              >
+                <option value="magnitude">Magnitude (μC)</option>
+                <option value="separation">Separation (m)</option>
+                <option value="coordinate">Coordinate (m)</option>
+              </select>
+            </label>
+            <label>
+              Charge
+              {chargeSelect(draft.chargeId, (chargeId) => updateDraft(index, { chargeId }))}
+            </label>
+            {draft.kind === 'separation' && (
+              <label>
+                From charge
+                {chargeSelect(draft.anchorId, (anchorId) => updateDraft(index, { anchorId }))}
+              </label>
+            )}
+            {draft.kind === 'coordinate' && (
+              <label>
+                Coordinate
+                <select
+                  value={draft.axis}
+                  onChange={(e) => updateDraft(index, { axis: e.target.value as 'x' | 'y' | 'z' })}
+                  style={inputStyle}
+                >
+                  <option value="x">X</option>
+                  <option value="y">Y</option>
+                  <option value="z">Z</option>
+                </select>
+              </label>
+            )}
+          </div>
+          <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px' }}>
+            <label>
+              From
+              {numberInput(draft.from, (from) => updateDraft(index, { from }))}
+            </label>
+            <label>
+              To
+              {numberInput(draft.to, (to) => updateDraft(index, { to }))}
+            </label>
+            <label>
+              Steps
+              {numberInput(draft.steps, (steps) => updateDraft(index, { steps: Math.max(1, Math.round(steps)) }))}
+            </label>
+          </div>
+        </div>
+      ))}
+
+      <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+        {drafts.length === 1 ? (
+          <button
+            onClick={() => setDrafts((prev) => [...prev, { ...prev[0], kind: 'separation', from: 0.5, to: 5, steps: 50 }])}
+            style={{ ...buttonStyle, background: '#4CAF50' }}
+          >
+            + Axis
+          </button>
+        ) : (
+          <button onClick={() => setDrafts((prev) => prev.slice(0, 1))} style={{ ...buttonStyle, background: '#f44336' }}>
+            − Axis
+          </button>
+        )}
+        <button
+          onClick={() => onRun(drafts.map(toAxis))}
+          disabled={charges.length === 0}
+          style={{ ...buttonStyle, background: '#2196F3' }}
+        >
+          Run
+        </button>
+        <button onClick={onExportCsv} disabled={!result} style={{ ...buttonStyle, background: '#2196F3' }}>
+          CSV
+        </button>
+        <button onClick={() => onSaveSpec(drafts.map(toAxis))} style={{ ...buttonStyle, background: '#2196F3' }}>
+          JSON
+        </button>
+      </div>
+
+      {status && <div style={{ fontSize: '10px', color: '#aaa', marginBottom: '5px' }}>{status}</div>}
+
+      {result && (
+        <label style={{ fontSize: '10px' }}>
+          Metric
+          <select value={metricIndex} onChange={(e) => setMetricIndex(parseInt(e.target.value))} style={inputStyle}>
+            {result.metrics.map((metric, index) => (
+              <option key={metric} value={index}>
+                {metric}
+              </option>
+            ))}
+          </select>
+        </label>
+      )}
+      <canvas
+        ref={canvasRef}
+        width={300}
+        height={180}
+        style={{ display: result ? 'block' : 'none', marginTop: '5px' }}
+      />
+    </div>
+  );
+};
+
+export default SweepPanel;
@@ -0,0 +1,186 @@
+import React, { useState } from 'react';
+import type { ChargeKeyframe } from '../models/Timeline';
+
+interface TimelinePanelProps {
+  keyframes: ChargeKeyframe[];
+  fps: number;
+  progress: { ready: number; total: number } | null; // While precomputing
+  cacheBytes: number | null; // Size of the finished cache, null if none
+  active: boolean; // Showing the cached animation instead of the live scene
+  playing: boolean;
+  onAddKeyframe: (time: number) => void; // Captures the current charges
+  onRemoveKeyframe: (time: number) => void;
+  onFpsChange: (fps: number) => void;
+  onPrecompute: () => void;
+  onTogglePlaying: () => void;
+  onStop: () => void;
+  onExportArchive: () => void;
+  onSaveTimeline: () => void;
+}
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const buttonStyle: React.CSSProperties = {
+  flex: 1,
+  padding: '8px 12px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '4px',
+  cursor: 'pointer',
+  fontSize: '11px',
+};
+
+const TimelinePanel: React.FC<TimelinePanelProps> = ({
+  keyframes,
+  fps,
+  progress,
+  cacheBytes,
+  active,
+  playing,
+  onAddKeyframe,
+  onRemoveKeyframe,
+  onFpsChange,
+  onPrecompute,
+  onTogglePlaying,
+  onStop,
+  onExportArchive,
+  onSaveTimeline,
+}) => {
+  const lastTime = keyframes.length > 0 ? keyframes[keyframes.length - 1].time : -1;
+  const [time, setTime] = useState(0);
+  const computing = progress !== null && progress.ready < progress.total;
+
+  return (
+    <div
+      style={{
+        background: 'rgba(0, 0, 0, 0.8)',
+        color: 'white',
+        padding: '15px',
+        borderRadius: '8px',
+        fontFamily: 'monospace',
+        fontSize: '12px',
+        minWidth: '260px',
+      }}
+    >
+      <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
+        Timeline ({keyframes.length} keyframes)
+      </div>
+
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '10px' }}>
+        <label>
+          t (s)
+          <input
+            type="number"
+            value={time}
+            onChange={(e) => setTime(parseFloat(e.target.value) || 0)}
+            style={inputStyle}
+          />
+        </label>
+        <label>
+          FPS
+          <input
+            type="number"
+            value={fps}
+            onChange={(e) => onFpsChange(Math.max(parseFloat(e.target.value) || 0, 1))}
+            style={inputStyle}
+          />
+        </label>
+        <button
+          onClick={() => {
+            onAddKeyframe(time);
+            setTime(Math.max(time, lastTime) + 1);
+          }}
+          style={{ ...buttonStyle, background: '#4CAF50', alignSelf: 'end' }}
+        >
+          + Key
+        </button>
+      </div>
+
+      {keyframes.map((keyframe) => (
+        <div
+          key={keyframe.time}
+          style={{
+            display: 'flex',
+            justifyContent: 'space-between',
+            alignItems: 'center',
+            fontSize: '10px',
+            marginBottom: '4px',
+          }}
+        >
+          <span>
+            t={keyframe.time.toFixed(2)}s ({keyframe.charges.length} charges)
+          </span>
+          <button
+            onClick={() => onRemoveKeyframe(keyframe.time)}
+            style={{
+              padding: '2px 6px',
+              background: '#f44336',
+              color: 'white',
+              border: 'none',
+              borderRadius: '3px',
+              cursor: 'pointer',
+              fontSize: '10px',
+            }}
+          >
+            Remove
+          </button>
+        </div>
+      ))}
+
+      <button
+        onClick={onPrecompute}
+        disabled={keyframes.length < 2 || computing}
+        style={{ ...buttonStyle, width: '100%', background: '#2196F3', margin: '10px 0 5px' }}
+      >
+        {computing ? `Computing ${progress!.ready}/${progress!.total}...` : 'Precompute Frames'}
+      </button>
+
+      {cacheBytes !== null && (
+        <>
+          <div style={{ fontSize: '10px', marginBottom: '5px' }}>
+            Cache: {(cacheBytes / (1024 * 1024)).toFixed(1)} MB
+          </div>
+          <div style={{ display: 'flex', gap: '5px', marginBottom: '5px' }}>
+            <button
+              onClick={onTogglePlaying}
+              style={{ ...buttonStyle, background: playing ? '#f44336' : '#4CAF50' }}
+            >
+              {playing ? 'Pause' : 'Play'}
+            </button>
+            <button
+              onClick={onStop}
+              disabled={!active}
+              style={{ ...buttonStyle, background: '#607D8B' }}
+            >
+              Live View
+            </button>
+          </div>
+          <button
+            onClick={onExportArchive}
+            style={{ ...buttonStyle, width: '100%', background: '#607D8B', marginBottom: '5px' }}
+          >
+            Export Frames (.tar)
+          </button>
+        </>
+      )}
+
+      <button
+        onClick={onSaveTimeline}
+        disabled={keyframes.length === 0}
+        style={{ ...buttonStyle, width: '100%', background: '#607D8B' }}
+      >
+        Save Timeline (.json)
+      </button>
+    </div>
+  );
+};
+
+export default TimelinePanel;
@@ -1,12 +1,23 @@
 import * as THREE from 'three';
-import { electricFieldAt } from '../models/Charge';
 import type { Charge } from '../models/Charge';
+import { buildChargeTree } from '../models/ChargeTree';
+import type { ChargeTree } from '../models/ChargeTree';
+import { generateGridPositions, packCharges } from '../models/FieldKernel';
+import type { FieldKind } from '../models/FieldKernel';
+import { sourcesFieldBatch } from '../models/FieldSources';
+import { magneticFieldBatch, packCurrents } from '../models/Current';
+import type { CurrentSource } from '../models/Current';
+import { buildPhasorField, evaluatePhasorField } from '../models/PhasorField';
+import type { OscillatingSource, PhasorField } from '../models/PhasorField';
+import { gltfGeometryFromBufferGeometry } from '../export/GltfExport';
+import type { GltfNodeSource } from '../export/GltfExport';
 
 export interface VectorFieldConfig {
   gridSize: number;
   bounds: { min: THREE.Vector3; max: THREE.Vector3 };
   arrowScale: number;
-  maxFieldMagnitude: number;
+  maxFieldMagnitude: number; // N/C
+  maxMagneticFieldMagnitude: number; // T
   showDirectionOnly: boolean;
 }
 
@@ -17,7 +28,19 @@ export class VectorFieldRenderer {
   private arrowMaterial: THREE.MeshBasicMaterial;
   private config: VectorFieldConfig;
   private charges: Charge[] = [];
-  private gridPoints: THREE.Vector3[] = [];
+  private dataset: ChargeTree = buildChargeTree(packCharges([]));
+  private currents: CurrentSource[] = [];
+  private fieldKind: FieldKind = 'electric';
+  private gridPositions: Float32Array = new Float32Array(0); // xyz interleaved
+  private staticField: Float32Array = new Float32Array(0); // E of the static charges, or B of the currents
+  private displayField: Float32Array = new Float32Array(0); // Static + oscillating at phasorTime
+  private staticPotential: Float32Array = new Float32Array(0); // V of the static charges (electric only)
+  private appliedField: Float32Array = new Float32Array(0); // Field the arrows currently show
+  private oscillatingSources: OscillatingSource[] = [];
+  private phasorField: PhasorField | null = null;
+  private phasorTime = 0;
+  private dynamicField: Float32Array | null = null; // Externally computed (e.g. moving charges)
+  private frameField: Float32Array | null = null; // Precomputed animation frame, replaces everything else
   private readonly upVector: THREE.Vector3 = new THREE.Vector3(0, 1, 0);
 
   constructor(scene: THREE.Scene, config: VectorFieldConfig) {
@@ -40,8 +63,8 @@ export class VectorFieldRenderer {
       this.arrowMesh.dispose();
     }
 
-    this.gridPoints = this.generateGridPoints();
-    const instanceCount = this.gridPoints.length;
+    this.setGridPositions(this.generateGridPoints());
+    const instanceCount = this.gridPositions.length / 3;
     
     if (instanceCount === 0) return;
 
@@ -55,41 +78,81 @@ export class VectorFieldRenderer {
     this.scene.add(this.arrowMesh);
   }
 
-  private generateGridPoints(): THREE.Vector3[] {
-    const points: THREE.Vector3[] = [];
+  private generateGridPoints(): Float32Array {
     const { min, max } = this.config.bounds;
-    const step = (max.x - min.x) / this.config.gridSize;
-    
-    for (let x = 0; x < this.config.gridSize; x++) {
-      for (let y = 0; y < this.config.gridSize; y++) {
-        for (let z = 0; z < this.config.gridSize; z++) {
-          const point = new THREE.Vector3(
-            min.x + x * step,
-            min.y + y * step,
-            min.z + z * step
-          );
-          points.push(point);
-        }
+    return generateGridPositions(min, max, this.config.gridSize);
+  }
+
+  private setGridPositions(points: Float32Array) {
+    this.gridPositions = points;
+    this.staticField = new Float32Array(points.length);
+    this.displayField = new Float32Array(points.length);
+    this.staticPotential = new Float32Array(points.length / 3);
+    this.phasorField = this.oscillatingSources.length > 0
+      ? buildPhasorField(points, this.oscillatingSources)
+      : null;
+  }
+
+  private updateVectorField() {
+    if (!this.arrowMesh) return;
+    if (this.fieldKind === 'magnetic') {
+      magneticFieldBatch(packCurrents(this.currents), this.gridPositions, this.staticField);
+    } else {
+      const sources = { charges: packCharges(this.charges), dataset: this.dataset };
+      sourcesFieldBatch(sources, this.gridPositions, this.staticField, this.staticPotential);
+    }
+    this.refreshArrows();
+  }
+
+  /**
+   * Combine the static field with the oscillating sources' phasors at the
+   * current time (a cheap axpy per frequency) and update the arrows
+   */
+  private refreshArrows() {
+    if (this.frameField && this.frameField.length === this.gridPositions.length) {
+      this.applyField(this.frameField);
+      return;
+    }
+
+    // Oscillating and moving sources only contribute to E
+    if (this.fieldKind === 'magnetic' || (!this.phasorField && !this.dynamicField)) {
+      this.applyField(this.staticField);
+      return;
+    }
+
+    if (this.phasorField) {
+      evaluatePhasorField(this.phasorField, this.phasorTime, this.staticField, this.displayField);
+    } else {
+      this.displayField.set(this.staticField);
+    }
+    const dynamicField = this.dynamicField;
+    if (dynamicField && dynamicField.length === this.displayField.length) {
+      for (let i = 0; i < dynamicField.length; i++) {
+        this.displayField[i] += dynamicField[i];
       }
     }
-    
-    return points;
+    this.applyField(this.displayField);
   }
 
-  private updateVectorField() {
+  private applyField(fieldBuffer: Float32Array) {
     if (!this.arrowMesh) return;
-    const gridPoints = this.gridPoints;
+    this.appliedField = fieldBuffer;
+    const gridPositions = this.gridPositions;
     const matrix = new THREE.Matrix4();
     const position = new THREE.Vector3();
     const scale = new THREE.Vector3();
     const quaternion = new THREE.Quaternion();
+    const field = new THREE.Vector3();
+    const direction = new THREE.Vector3();
+    const maxMagnitude = this.fieldKind === 'magnetic'
+      ? this.config.maxMagneticFieldMagnitude
+      : this.config.maxFieldMagnitude;
+    const cutoff = maxMagnitude * 1e-10; // Below this an arrow is hidden
 
-    for (let i = 0; i < gridPoints.length; i++) {
-      const point = gridPoints[i];
-      const fieldResult = electricFieldAt(point, this.charges);
-      const field = fieldResult.field;
+    for (let i = 0; i < gridPositions.length / 3; i++) {
+      field.fromArray(fieldBuffer, i * 3);
 
-      if (field.length() < 1e-6) {
+      if (field.length() < cutoff) {
         matrix.makeScale(0, 0, 0);
         this.arrowMesh.setMatrixAt(i, matrix);
         continue;
@@ -100,15 +163,15 @@ export class VectorFieldRenderer {
         arrowLength = 0.3; 
       } else {
         // CHANGE: Scale field magnitude more reasonably
-        const normalizedMagnitude = Math.min(arrowLength / this.config.maxFieldMagnitude, 1);
+        const normalizedMagnitude = Math.min(arrowLength / maxMagnitude, 1);
         arrowLength = Math.max(normalizedMagnitude * this.config.arrowScale, 0.1); // Minimize visible size
       }
 
-      position.copy(point);
+      position.fromArray(gridPositions, i * 3);
       
       scale.set(1, arrowLength, 1);
       
-      const direction = field.clone().normalize();
+      direction.copy(field).normalize();
       quaternion.setFromUnitVectors(this.upVector, direction);
 
       matrix.compose(position, quaternion, scale);
@@ -118,8 +181,9 @@ export class VectorFieldRenderer {
     this.arrowMesh.instanceMatrix.needsUpdate = true;
   }
 
-  public updateCharges(charges: Charge[]) {
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
     this.charges = charges;
+    this.dataset = dataset;
     if (!this.arrowMesh) return;
     
     const wasVisible = this.arrowMesh.visible;
@@ -135,14 +199,125 @@ export class VectorFieldRenderer {
     }
   }
 
+  public updateCurrents(currents: CurrentSource[]) {
+    this.currents = currents;
+    if (this.fieldKind === 'magnetic') {
+      this.updateVectorField();
+    }
+  }
+
+  /**
+   * Draw E from the charges or B from the currents
+   */
+  public setFieldKind(kind: FieldKind) {
+    if (kind === this.fieldKind) return;
+    this.fieldKind = kind;
+    this.updateVectorField();
+  }
+
+  /**
+   * Oscillating sources are superposed on the static field; their complex
+   * amplitudes on the grid are computed here once, not per frame
+   */
+  public setOscillatingSources(sources: OscillatingSource[]) {
+    this.oscillatingSources = sources;
+    this.phasorField = sources.length > 0
+      ? buildPhasorField(this.gridPositions, sources)
+      : null;
+    this.refreshArrows();
+  }
+
+  /**
+   * Grid sample positions (xyz interleaved), for computing fields elsewhere
+   */
+  public getGridPositions(): Float32Array {
+    return this.gridPositions;
+  }
+
+  /**
+   * The samples behind the arrows: grid positions, the field as displayed
+   * and, for E, the static charges' potential. Views of the live buffers.
+   */
+  public getSamples(): { positions: Float32Array; field: Float32Array; potential: Float32Array | null; kind: FieldKind } {
+    return {
+      positions: this.gridPositions,
+      field: this.appliedField.length === this.gridPositions.length ? this.appliedField : this.staticField,
+      potential: this.fieldKind === 'electric' ? this.staticPotential : null,
+      kind: this.fieldKind,
+    };
+  }
+
+  /**
+   * The arrows as one cone mesh with a transform per visible arrow, for
+   * glTF export; null when there are none
+   */
+  public getGltfNode(): GltfNodeSource | null {
+    const mesh = this.arrowMesh;
+    if (!mesh || !mesh.visible) return null;
+    const matrix = new THREE.Matrix4();
+    const position = new THREE.Vector3();
+    const quaternion = new THREE.Quaternion();
+    const scale = new THREE.Vector3();
+    const translations: number[] = [];
+    const rotations: number[] = [];
+    const scales: number[] = [];
+    for (let i = 0; i < mesh.count; i++) {
+      mesh.getMatrixAt(i, matrix);
+      matrix.decompose(position, quaternion, scale);
+      if (scale.y === 0) continue; // Hidden below the cutoff
+      translations.push(position.x, position.y, position.z);
+      rotations.push(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
+      scales.push(scale.x, scale.y, scale.z);
+    }
+    if (translations.length === 0) return null;
+    const color = this.arrowMaterial.color;
+    return {
+      name: 'Field arrows',
+      geometry: gltfGeometryFromBufferGeometry(this.arrowGeometry),
+      material: { color: [color.r, color.g, color.b, this.arrowMaterial.opacity], unlit: true, doubleSided: false },
+      instances: {
+        translations: new Float32Array(translations),
+        rotations: new Float32Array(rotations),
+        scales: new Float32Array(scales),
+      },
+    };
+  }
+
+  /**
+   * Add an externally computed field (same layout as getGridPositions) to the
+   * arrows; null removes it
+   */
+  public setDynamicField(field: Float32Array | null) {
+    this.dynamicField = field;
+    this.refreshArrows();
+  }
+
+  /**
+   * Show a precomputed field (same layout as getGridPositions) instead of the
+   * live one; null returns to the live field
+   */
+  public setFrameField(field: Float32Array | null) {
+    this.frameField = field;
+    this.refreshArrows();
+  }
+
+  /**
+   * Show the oscillating field at `time` seconds
+   */
+  public setPhasorTime(time: number) {
+    this.phasorTime = time;
+    if (this.phasorField) {
+      this.refreshArrows();
+    }
+  }
+
   public updateConfig(config: Partial<VectorFieldConfig>) {
     const nextConfig = { ...this.config, ...config };
-    const oldGridPoints = this.gridPoints;
-    const oldCount = oldGridPoints.length;
+    const oldCount = this.gridPositions.length / 3;
     this.config = nextConfig;
   
-    this.gridPoints = this.generateGridPoints();
-    const newCount = this.gridPoints.length;
+    this.setGridPositions(this.generateGridPoints());
+    const newCount = this.gridPositions.length / 3;
     if (newCount !== oldCount || !this.arrowMesh) {
       this.createVectorField();
     } else {
@@ -179,6 +354,7 @@ export function createDefaultVectorFieldConfig(): VectorFieldConfig {
     },
     arrowScale: 2.0,
     maxFieldMagnitude: 1e4,
+    maxMagneticFieldMagnitude: 1e-6,
     showDirectionOnly: false
   };
 }
@@ -1,21 +1,135 @@
-import React from 'react';
-import type { VoltagePoint } from '../models/VoltagePoint';
+import React, { useMemo, useState } from 'react';
+import type { ProbeBuffer } from './VoltageProbes';
 
 interface VoltagePointsListProps {
-  voltagePoints: VoltagePoint[];
-  onRemoveVoltagePoint: (pointId: string) => void;
+  probes: ProbeBuffer;
+  onRemoveVoltagePoints: (pointIds: string[]) => void;
   onRemoveAllVoltagePoints: () => void;
 }
 
+type SortOrder = 'placed' | 'voltage-asc' | 'voltage-desc';
+
+const ROW_HEIGHT = 22; // px
+const VIEW_HEIGHT = 220; // px
+const OVERSCAN = 6; // Rows rendered beyond each edge of the view
+
+const inputStyle: React.CSSProperties = {
+  width: '100%',
+  padding: '4px',
+  borderRadius: '3px',
+  border: '1px solid #555',
+  background: 'rgba(255, 255, 255, 0.1)',
+  color: 'white',
+  fontSize: '11px',
+};
+
+const smallButtonStyle: React.CSSProperties = {
+  padding: '4px 8px',
+  color: 'white',
+  border: 'none',
+  borderRadius: '3px',
+  cursor: 'pointer',
+  fontSize: '10px',
+};
+
+/**
+ * Windowed list over the probe buffer: only the rows in view (plus a little
+ * overscan) are rendered, and each row reads position and potential straight
+ * from the buffer's typed arrays by row index. Sorting and filtering produce
+ * a Uint32Array of rows. Labels are the buffer's placement numbers, so they
+ * change neither with the sort nor when another probe is deleted.
+ */
 const VoltagePointsList: React.FC<VoltagePointsListProps> = ({
-  voltagePoints,
-  onRemoveVoltagePoint,
+  probes,
+  onRemoveVoltagePoints,
   onRemoveAllVoltagePoints,
 }) => {
-  if (voltagePoints.length === 0) {
+  const [sortOrder, setSortOrder] = useState<SortOrder>('placed');
+  const [minVoltage, setMinVoltage] = useState('');
+  const [maxVoltage, setMaxVoltage] = useState('');
+  const [selected, setSelected] = useState<Set<string>>(() => new Set());
+  const [scrollTop, setScrollTop] = useState(0);
+
+  const count = probes.ids.length;
+  // The buffer object is reused, but each recompute replaces its potentials
+  const { potentials } = probes;
+  const rows = useMemo(() => {
+    const min = minVoltage === '' ? -Infinity : parseFloat(minVoltage) || 0;
+    const max = maxVoltage === '' ? Infinity : parseFloat(maxVoltage) || 0;
+    const kept = new Uint32Array(potentials.length);
+    let length = 0;
+    for (let i = 0; i < potentials.length; i++) {
+      if (potentials[i] >= min && potentials[i] <= max) kept[length++] = i;
+    }
+    const view = kept.subarray(0, length);
+    if (sortOrder === 'voltage-asc') view.sort((a, b) => potentials[a] - potentials[b]);
+    else if (sortOrder === 'voltage-desc') view.sort((a, b) => potentials[b] - potentials[a]);
+    return view;
+  }, [potentials, sortOrder, minVoltage, maxVoltage]);
+
+  if (count === 0) {
     return null;
   }
 
+  const first = Math.max(0, Math.floor(scrollTop / ROW_HEIGHT) - OVERSCAN);
+  const last = Math.min(rows.length, Math.ceil((scrollTop + VIEW_HEIGHT) / ROW_HEIGHT) + OVERSCAN);
+
+  const toggle = (id: string) => {
+    setSelected((prev) => {
+      const next = new Set(prev);
+      if (next.has(id)) next.delete(id);
+      else next.add(id);
+      return next;
+    });
+  };
+
+  const selectFiltered = () => {
+    setSelected(new Set(Array.from(rows, (row) => probes.ids[row])));
+  };
+
+  const removeSelected = () => {
+    onRemoveVoltagePoints(Array.from(selected).filter((id) => probes.index.has(id)));
+    setSelected(new Set());
+  };
+
+  const selectedCount = Array.from(selected).filter((id) => probes.index.has(id)).length;
+  const visibleRows: React.ReactElement[] = [];
+  for (let r = first; r < last; r++) {
+    const row = rows[r];
+    const id = probes.ids[row];
+    const { positions } = probes;
+    visibleRows.push(
+      <div
+        key={id}
+        style={{
+          position: 'absolute',
+          top: r * ROW_HEIGHT,
+          left: 0,
+          right: 0,
+          height: ROW_HEIGHT,
+          display: 'grid',
+          gridTemplateColumns: '18px 40px 1fr 80px 18px',
+          alignItems: 'center',
+          fontSize: '10px',
+        }}
+      >
+        <input type="checkbox" checked={selected.has(id)} onChange={() => toggle(id)} />
+        <span style={{ fontWeight: 'bold' }}>P{probes.labels[row]}</span>
+        <span>
+          ({positions[row * 3].toFixed(2)}, {positions[row * 3 + 1].toFixed(2)}, {positions[row * 3 + 2].toFixed(2)})
+        </span>
+        <span style={{ textAlign: 'right' }}>{potentials[row].toExponential(2)} V</span>
+        <span
+          onClick={() => onRemoveVoltagePoints([id])}
+          style={{ cursor: 'pointer', color: '#f44336', textAlign: 'center' }}
+          title="Remove"
+        >
+          ×
+        </span>
+      </div>,
+    );
+  }
+
   return (
     <div
       style={{
@@ -29,73 +143,55 @@ const VoltagePointsList: React.FC<VoltagePointsListProps> = ({
         fontFamily: 'monospace',
         fontSize: '12px',
         minWidth: '300px',
-        maxHeight: '300px',
-        overflowY: 'auto',
       }}
     >
       <div style={{ fontSize: '14px', fontWeight: 'bold', marginBottom: '10px' }}>
-        Voltage Points ({voltagePoints.length})
+        Voltage Points ({rows.length === count ? count : `${rows.length} of ${count}`})
       </div>
 
-      {voltagePoints.map((point, index) => (
-        <div
-          key={point.id}
-          style={{
-            border: '1px solid #555',
-            padding: '8px',
-            marginBottom: '5px',
-            borderRadius: '4px',
-            backgroundColor: 'rgba(255, 255, 255, 0.1)',
-          }}
-        >
-          <div style={{ fontWeight: 'bold', marginBottom: '4px' }}>
-            Point {index + 1}
-          </div>
-          <div style={{ fontSize: '10px', marginBottom: '2px' }}>
-            Position: ({point.position.x.toFixed(2)}, {point.position.y.toFixed(2)},{' '}
-            {point.position.z.toFixed(2)})
-          </div>
-          <div style={{ fontSize: '10px', marginBottom: '4px' }}>
-            Voltage: {point.voltage.toExponential(2)} V
-          </div>
-          <button
-            onClick={() => onRemoveVoltagePoint(point.id)}
-            style={{
-              padding: '4px 8px',
-              background: '#f44336',
-              color: 'white',
-              border: 'none',
-              borderRadius: '3px',
-              cursor: 'pointer',
-              fontSize: '10px',
-            }}
-          >
-            Remove
-          </button>
-        </div>
-      ))}
-
-      {voltagePoints.length > 0 && (
+      <div style={{ display: 'grid', gridTemplateColumns: '1fr 1fr 1fr', gap: '5px', marginBottom: '5px' }}>
+        <label>
+          Sort
+          <select value={sortOrder} onChange={(e) => setSortOrder(e.target.value as SortOrder)} style={inputStyle}>
+            <option value="placed">Placed</option>
+            <option value="voltage-asc">V ↑</option>
+            <option value="voltage-desc">V ↓</option>
+          </select>
+        </label>
+        <label>
+          Min V
+          <input type="number" value={minVoltage} placeholder="any" onChange={(e) => setMinVoltage(e.target.value)} style={inputStyle} />
+        </label>
+        <label>
+          Max V
+          <input type="number" value={maxVoltage} placeholder="any" onChange={(e) => setMaxVoltage(e.target.value)} style={inputStyle} />
+        </label>
+      </div>
+
+      <div
+        onScroll={(e) => setScrollTop(e.currentTarget.scrollTop)}
+        style={{ height: VIEW_HEIGHT, overflowY: 'auto', position: 'relative', borderTop: '1px solid #555' }}
+      >
+        <div style={{ height: rows.length * ROW_HEIGHT, position: 'relative' }}>{visibleRows}</div>
+      </div>
+
+      <div style={{ display: 'flex', gap: '5px', marginTop: '8px' }}>
+        <button onClick={selectFiltered} style={{ ...smallButtonStyle, background: '#2196F3', flex: 1 }}>
+          Select shown
+        </button>
         <button
-          onClick={onRemoveAllVoltagePoints}
-          style={{
-            padding: '8px 12px',
-            background: '#ff6b6b',
-            color: 'white',
-            border: 'none',
-            borderRadius: '4px',
-            cursor: 'pointer',
-            fontSize: '11px',
-            width: '100%',
-            marginTop: '10px',
-          }}
+          onClick={removeSelected}
+          disabled={selectedCount === 0}
+          style={{ ...smallButtonStyle, background: '#f44336', flex: 1 }}
         >
+          Delete selected ({selectedCount})
+        </button>
+        <button onClick={onRemoveAllVoltagePoints} style={{ ...smallButtonStyle, background: '#ff6b6b', flex: 1 }}>
           🗑 Remove All
         </button>
-      )}
+      </div>
     </div>
   );
 };
 
 export default VoltagePointsList;
-
@@ -0,0 +1,244 @@
+import * as THREE from 'three';
+import type { Charge } from '../models/Charge';
+import { buildChargeTree } from '../models/ChargeTree';
+import type { ChargeTree } from '../models/ChargeTree';
+import { packCharges } from '../models/FieldKernel';
+import type { Vec3Like } from '../models/FieldKernel';
+import { sourcesFieldBatch } from '../models/FieldSources';
+
+export interface VoltageProbeConfig {
+  probeRadius: number;
+  probeColor: number;
+  arrowColor: number;
+  sampleStep: number; // Spacing of the 3×3×3 arrow samples around each probe
+  arrowScale: number; // Arrow length multiplier at maxFieldMagnitude
+  maxFieldMagnitude: number; // Field (V/m) at which arrows stop growing
+}
+
+// Offsets of the 26 arrow samples (the 3×3×3 block minus its centre)
+const SAMPLES_PER_PROBE = 26;
+
+/**
+ * Live probe data in probe order. UI rows index into these arrays instead of
+ * holding per-probe objects. Every recompute hands out a fresh `potentials`
+ * array, so its identity marks a new version.
+ */
+export interface ProbeBuffer {
+  ids: string[];
+  index: Map<string, number>; // Probe id → row
+  positions: Float64Array; // xyz per probe
+  labels: Uint32Array; // Placement number per probe, kept for the probe's lifetime
+  potentials: Float64Array; // V per probe, replaced by every recompute
+  version: number; // Incremented by every recompute; the workspace re-renders on it
+}
+
+/**
+ * Voltage probes as one instanced sphere mesh plus one instanced arrow mesh
+ * for the field samples around every probe. Each update evaluates all probe
+ * potentials and all arrow samples in a single batch-kernel call and writes
+ * the potentials into the shared probe buffer.
+ */
+export class VoltageProbeRenderer {
+  private scene: THREE.Scene;
+  private config: VoltageProbeConfig;
+  private buffer: ProbeBuffer = {
+    ids: [],
+    index: new Map(),
+    positions: new Float64Array(0),
+    labels: new Uint32Array(0),
+    potentials: new Float64Array(0),
+    version: 0,
+  };
+  // Placement numbers by probe id; numbering restarts once every probe is gone
+  private labels = new Map<string, number>();
+  private nextLabel = 1;
+  private points = new Float64Array(0); // Per probe: centre, then its arrow samples
+  private field = new Float64Array(0);
+  private potential = new Float64Array(0);
+  private charges: Charge[] = [];
+  private dataset: ChargeTree = buildChargeTree(packCharges([]));
+  private probeGeometry: THREE.SphereGeometry;
+  private probeMaterial: THREE.MeshBasicMaterial;
+  private arrowGeometry: THREE.ConeGeometry;
+  private arrowMaterial: THREE.MeshBasicMaterial;
+  private probes: THREE.InstancedMesh;
+  private arrows: THREE.InstancedMesh;
+  private upVector = new THREE.Vector3(0, 1, 0);
+  private visible = true;
+
+  constructor(scene: THREE.Scene, config: VoltageProbeConfig = createDefaultVoltageProbeConfig()) {
+    this.scene = scene;
+    this.config = config;
+    this.probeGeometry = new THREE.SphereGeometry(config.probeRadius, 12, 12);
+    this.probeMaterial = new THREE.MeshBasicMaterial({ color: config.probeColor, transparent: true, opacity: 0.8 });
+    this.arrowGeometry = new THREE.ConeGeometry(0.05, 0.2, 8);
+    this.arrowMaterial = new THREE.MeshBasicMaterial({ color: config.arrowColor, transparent: true, opacity: 0.8 });
+    this.probes = this.createMesh(this.probeGeometry, this.probeMaterial, 16);
+    this.arrows = this.createMesh(this.arrowGeometry, this.arrowMaterial, 16 * SAMPLES_PER_PROBE);
+  }
+
+  private createMesh(geometry: THREE.BufferGeometry, material: THREE.Material, capacity: number): THREE.InstancedMesh {
+    const mesh = new THREE.InstancedMesh(geometry, material, capacity);
+    mesh.instanceMatrix.setUsage(THREE.DynamicDrawUsage);
+    mesh.count = 0;
+    mesh.visible = this.visible;
+    this.scene.add(mesh);
+    return mesh;
+  }
+
+  /**
+   * Grow both instanced meshes (doubling) to hold `count` probes
+   */
+  private ensureCapacity(count: number) {
+    if (this.probes.instanceMatrix.count >= count) return;
+    const capacity = Math.max(count, this.probes.instanceMatrix.count * 2);
+    for (const mesh of [this.probes, this.arrows]) {
+      this.scene.remove(mesh);
+      mesh.dispose();
+    }
+    this.probes = this.createMesh(this.probeGeometry, this.probeMaterial, capacity);
+    this.arrows = this.createMesh(this.arrowGeometry, this.arrowMaterial, capacity * SAMPLES_PER_PROBE);
+  }
+
+  public getBuffer(): ProbeBuffer {
+    return this.buffer;
+  }
+
+  /**
+   * Replace the probe set and evaluate it. Probes not seen before are
+   * numbered after every earlier one, so deleting a probe never relabels the
+   * rest.
+   */
+  public setProbes(probes: { id: string; position: Vec3Like }[]) {
+    const stride = (SAMPLES_PER_PROBE + 1) * 3;
+    const step = this.config.sampleStep;
+    const buffer = this.buffer;
+    buffer.ids = probes.map((probe) => probe.id);
+    buffer.index = new Map(buffer.ids.map((id, i) => [id, i]));
+    if (probes.length === 0) this.nextLabel = 1;
+    const labels = new Map<string, number>();
+    for (const id of buffer.ids) labels.set(id, this.labels.get(id) ?? this.nextLabel++);
+    this.labels = labels;
+    buffer.labels = Uint32Array.from(buffer.ids, (id) => labels.get(id)!);
+    buffer.positions = new Float64Array(probes.length * 3);
+    this.points = new Float64Array(probes.length * stride);
+    this.field = new Float64Array(probes.length * (SAMPLES_PER_PROBE + 1) * 3);
+    this.potential = new Float64Array(probes.length * (SAMPLES_PER_PROBE + 1));
+
+    const matrix = new THREE.Matrix4();
+    this.ensureCapacity(probes.length);
+    probes.forEach(({ position }, p) => {
+      buffer.positions[p * 3] = position.x;
+      buffer.positions[p * 3 + 1] = position.y;
+      buffer.positions[p * 3 + 2] = position.z;
+      let offset = p * stride;
+      this.points[offset++] = position.x;
+      this.points[offset++] = position.y;
+      this.points[offset++] = position.z;
+      for (let x = -1; x <= 1; x++) {
+        for (let y = -1; y <= 1; y++) {
+          for (let z = -1; z <= 1; z++) {
+            if (x === 0 && y === 0 && z === 0) continue;
+            this.points[offset++] = position.x + x * step;
+            this.points[offset++] = position.y + y * step;
+            this.points[offset++] = position.z + z * step;
+          }
+        }
+      }
+      this.probes.setMatrixAt(p, matrix.makeTranslation(position.x, position.y, position.z));
+    });
+    this.probes.count = probes.length;
+    this.probes.instanceMatrix.needsUpdate = true;
+    this.probes.computeBoundingSphere();
+    this.recompute();
+  }
+
+  /**
+   * Re-evaluate every probe for new charges
+   */
+  public updateCharges(charges: Charge[], dataset: ChargeTree) {
+    this.charges = charges;
+    this.dataset = dataset;
+    this.recompute();
+  }
+
+  private recompute() {
+    const probeCount = this.buffer.ids.length;
+    const potentials = new Float64Array(probeCount);
+    this.buffer.potentials = potentials;
+    this.buffer.version++;
+    if (probeCount === 0) {
+      this.arrows.count = 0;
+      return;
+    }
+    const sources = { charges: packCharges(this.charges), dataset: this.dataset };
+    sourcesFieldBatch(sources, this.points, this.field, this.potential);
+
+    const matrix = new THREE.Matrix4();
+    const position = new THREE.Vector3();
+    const direction = new THREE.Vector3();
+    const quaternion = new THREE.Quaternion();
+    const scale = new THREE.Vector3();
+    const { arrowScale, maxFieldMagnitude } = this.config;
+
+    for (let p = 0; p < probeCount; p++) {
+      const base = p * (SAMPLES_PER_PROBE + 1);
+      potentials[p] = this.potential[base];
+      for (let s = 0; s < SAMPLES_PER_PROBE; s++) {
+        const i = base + 1 + s;
+        direction.fromArray(this.field, i * 3);
+        const magnitude = direction.length();
+        if (magnitude < 1e-6) {
+          matrix.makeScale(0, 0, 0);
+        } else {
+          const length = Math.max(Math.min(magnitude / maxFieldMagnitude, 1) * arrowScale, 0.1);
+          quaternion.setFromUnitVectors(this.upVector, direction.divideScalar(magnitude));
+          matrix.compose(position.fromArray(this.points, i * 3), quaternion, scale.set(1, length, 1));
+        }
+        this.arrows.setMatrixAt(p * SAMPLES_PER_PROBE + s, matrix);
+      }
+    }
+    this.arrows.count = probeCount * SAMPLES_PER_PROBE;
+    this.arrows.instanceMatrix.needsUpdate = true;
+    this.arrows.computeBoundingSphere();
+  }
+
+  /**
+   * Object to raycast for probe picking; map hits back with probeIdAt
+   */
+  public getPickTarget(): THREE.Object3D {
+    return this.probes;
+  }
+
+  public probeIdAt(instanceId: number | undefined): string | null {
+    return instanceId !== undefined && instanceId < this.buffer.ids.length ? this.buffer.ids[instanceId] : null;
+  }
+
+  public setVisible(visible: boolean) {
+    this.visible = visible;
+    this.probes.visible = visible;
+    this.arrows.visible = visible;
+  }
+
+  public dispose() {
+    for (const mesh of [this.probes, this.arrows]) {
+      this.scene.remove(mesh);
+      mesh.dispose();
+    }
+    this.probeGeometry.dispose();
+    this.probeMaterial.dispose();
+    this.arrowGeometry.dispose();
+    this.arrowMaterial.dispose();
+  }
+}
+
+export function createDefaultVoltageProbeConfig(): VoltageProbeConfig {
+  return {
+    probeRadius: 0.15,
+    probeColor: 0x00ff00,
+    arrowColor: 0x4444ff,
+    sampleStep: 0.4,
+    arrowScale: 2.0,
+    maxFieldMagnitude: 1e4,
+  };
+}
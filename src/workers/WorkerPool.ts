@@ -0,0 +1,85 @@
+interface PoolTask<Request, Result> {
+  request: Request;
+  transfer: Transferable[];
+  resolve: (result: Result) => void;
+  reject: (error: unknown) => void;
+}
+
+/**
+ * Fixed set of identical workers that each handle one request at a time and
+ * reply with exactly one message. Tasks queue until a worker is free.
+ */
+export class WorkerPool<Request, Result> {
+  private idle: Worker[] = [];
+  private workers: Worker[] = [];
+  private queue: PoolTask<Request, Result>[] = [];
+  private running = new Map<Worker, PoolTask<Request, Result>>();
+
+  constructor(createWorker: () => Worker, size: number = defaultPoolSize()) {
+    for (let i = 0; i < size; i++) {
+      const worker = createWorker();
+      worker.onmessage = (event: MessageEvent<Result>) => this.finish(worker, (task) => task.resolve(event.data));
+      worker.onerror = (event: ErrorEvent) => this.finish(worker, (task) => task.reject(event.error ?? event.message));
+      this.workers.push(worker);
+      this.idle.push(worker);
+    }
+  }
+
+  get size(): number {
+    return this.workers.length;
+  }
+
+  public run(request: Request, transfer: Transferable[] = []): Promise<Result> {
+    return new Promise<Result>((resolve, reject) => {
+      this.queue.push({ request, transfer, resolve, reject });
+      this.dispatch();
+    });
+  }
+
+  /**
+   * Post a message to every worker; each sees it before any task dispatched
+   * later. Workers must not reply to it, so it is not a task.
+   */
+  public broadcast(message: Request) {
+    for (const worker of this.workers) worker.postMessage(message);
+  }
+
+  /**
+   * Drop queued tasks (rejecting them); tasks already running still finish
+   */
+  public cancelPending() {
+    const dropped = this.queue;
+    this.queue = [];
+    for (const task of dropped) task.reject(new Error('Cancelled'));
+  }
+
+  private finish(worker: Worker, settle: (task: PoolTask<Request, Result>) => void) {
+    const task = this.running.get(worker);
+    this.running.delete(worker);
+    this.idle.push(worker);
+    if (task) settle(task);
+    this.dispatch();
+  }
+
+  private dispatch() {
+    while (this.idle.length > 0 && this.queue.length > 0) {
+      const worker = this.idle.pop()!;
+      const task = this.queue.shift()!;
+      this.running.set(worker, task);
+      worker.postMessage(task.request, task.transfer);
+    }
+  }
+
+  public dispose() {
+    this.cancelPending();
+    for (const worker of this.workers) worker.terminate();
+    for (const task of this.running.values()) task.reject(new Error('Worker pool disposed'));
+    this.running.clear();
+    this.workers = [];
+    this.idle = [];
+  }
+}
+
+export function defaultPoolSize(): number {
+  return Math.max(1, Math.min(8, (navigator.hardwareConcurrency || 2) - 1));
+}
@@ -0,0 +1,20 @@
+import { computeCapacitanceMatrix } from '../models/Capacitance';
+import type { CapacitanceOptions, CapacitanceResult, Conductor } from '../models/Capacitance';
+
+export interface CapacitanceWorkerRequest {
+  conductors: Conductor[];
+  options: CapacitanceOptions;
+}
+
+export type CapacitanceWorkerResult = { result: CapacitanceResult } | { error: string };
+
+self.onmessage = (event: MessageEvent<CapacitanceWorkerRequest>) => {
+  const { conductors, options } = event.data;
+  let reply: CapacitanceWorkerResult;
+  try {
+    reply = { result: computeCapacitanceMatrix(conductors, options) };
+  } catch (error) {
+    reply = { error: error instanceof Error ? error.message : String(error) };
+  }
+  self.postMessage(reply, 'result' in reply ? { transfer: [reply.result.matrix.buffer as ArrayBuffer] } : {});
+};
@@ -0,0 +1,49 @@
+import { ChargeTextParser } from '../export/ChargeTextParser';
+import type { ChargeBatch, ChargeTextFormat, ChargeTextOptions } from '../export/ChargeTextParser';
+
+export interface ChargeTextImportWorkerRequest {
+  file: File;
+  format: ChargeTextFormat;
+  options: ChargeTextOptions;
+}
+
+export type ChargeTextImportWorkerMessage =
+  | { type: 'batch'; batch: ChargeBatch; loaded: number; total: number }
+  | { type: 'done'; count: number; skipped: number }
+  | { type: 'error'; message: string };
+
+self.onmessage = async (event: MessageEvent<ChargeTextImportWorkerRequest>) => {
+  const { file, format, options } = event.data;
+  const post = (message: ChargeTextImportWorkerMessage, transfer: Transferable[] = []) =>
+    self.postMessage(message, { transfer });
+  const postBatch = (batch: ChargeBatch, loaded: number) =>
+    post({ type: 'batch', batch, loaded, total: file.size }, [
+      batch.positions.buffer as ArrayBuffer,
+      batch.magnitudes.buffer as ArrayBuffer,
+    ]);
+
+  try {
+    // Bytes are counted before decoding so progress tracks the file itself
+    let loaded = 0;
+    const counted = file.stream().pipeThrough(
+      new TransformStream<Uint8Array, Uint8Array>({
+        transform(chunk, controller) {
+          loaded += chunk.length;
+          controller.enqueue(chunk);
+        },
+      })
+    );
+    const reader = counted.pipeThrough(new TextDecoderStream()).getReader();
+    const parser = new ChargeTextParser(format, options);
+    for (;;) {
+      const { done, value } = await reader.read();
+      if (done) break;
+      for (const batch of parser.push(value)) postBatch(batch, loaded);
+    }
+    const last = parser.finish();
+    if (last) postBatch(last, file.size);
+    post({ type: 'done', count: parser.count, skipped: parser.skipped });
+  } catch (error) {
+    post({ type: 'error', message: error instanceof Error ? error.message : String(error) });
+  }
+};
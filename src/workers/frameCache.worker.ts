@@ -0,0 +1,24 @@
+import { computeFrame, encodeFrame } from '../models/FrameCache';
+import type { FieldLineTraceConfig } from '../models/FieldLineTracer';
+import type { Timeline } from '../models/Timeline';
+
+export interface FrameCacheWorkerRequest {
+  timeline: Timeline;
+  gridPositions: Float32Array;
+  lineConfig: FieldLineTraceConfig;
+  frames: number[]; // Frame indices to compute
+}
+
+export interface FrameCacheWorkerResult {
+  frames: number[];
+  buffers: ArrayBuffer[]; // Encoded frames, same order as `frames`
+}
+
+self.onmessage = (event: MessageEvent<FrameCacheWorkerRequest>) => {
+  const { timeline, gridPositions, lineConfig, frames } = event.data;
+  const buffers = frames.map((frame) =>
+    encodeFrame(computeFrame(timeline, frame / timeline.fps, gridPositions, lineConfig))
+  );
+  const result: FrameCacheWorkerResult = { frames, buffers };
+  self.postMessage(result, { transfer: buffers });
+};
@@ -0,0 +1,14 @@
+import { buildGlb } from '../export/GltfExport';
+import type { GltfExportRequest } from '../export/GltfExport';
+
+export type GltfExportWorkerRequest = GltfExportRequest;
+
+export interface GltfExportWorkerResult {
+  glb: Uint8Array<ArrayBuffer>;
+}
+
+self.onmessage = (event: MessageEvent<GltfExportWorkerRequest>) => {
+  const glb = buildGlb(event.data);
+  const result: GltfExportWorkerResult = { glb };
+  self.postMessage(result, { transfer: [glb.buffer] });
+};
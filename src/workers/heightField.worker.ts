@@ -0,0 +1,34 @@
+import type { PackedCharges } from '../models/FieldKernel';
+import { emptyFieldSources } from '../models/FieldSources';
+import type { DatasetMessage } from '../models/FieldSources';
+import { computeHeightTile } from '../models/HeightField';
+import type { HeightFieldSpec, HeightTile } from '../models/HeightField';
+
+export type HeightFieldWorkerRequest =
+  | DatasetMessage
+  | {
+      type: 'tiles';
+      generation: number;
+      charges: PackedCharges;
+      spec: HeightFieldSpec;
+      tiles: number[];
+    };
+
+export interface HeightFieldWorkerResult {
+  generation: number;
+  tiles: HeightTile[];
+}
+
+let dataset = emptyFieldSources().dataset;
+
+self.onmessage = (event: MessageEvent<HeightFieldWorkerRequest>) => {
+  if (event.data.type === 'dataset') {
+    dataset = event.data.dataset;
+    return;
+  }
+  const { generation, charges, spec, tiles } = event.data;
+  const sources = { charges, dataset };
+  const computed = tiles.map((tile) => computeHeightTile(sources, spec, tile));
+  const result: HeightFieldWorkerResult = { generation, tiles: computed };
+  self.postMessage(result, { transfer: computed.map((tile) => tile.heights.buffer as ArrayBuffer) });
+};
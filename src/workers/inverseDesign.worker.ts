@@ -0,0 +1,37 @@
+import { InverseDesigner } from '../models/InverseDesign';
+import type { InverseDesignOptions, InverseDesignResult, InverseProbe } from '../models/InverseDesign';
+import type { PackedCharges } from '../models/FieldKernel';
+
+export interface InverseDesignWorkerRequest {
+  charges: PackedCharges; // Only the positions are used
+  probes: InverseProbe[];
+  options: InverseDesignOptions;
+}
+
+export type InverseDesignWorkerResult = { result: InverseDesignResult | null } | { error: string };
+
+// The designer's normal equations depend only on charge positions, so it
+// outlives requests until the charges move and folds in probe changes
+let designer: InverseDesigner | null = null;
+let positions = new Float64Array(0);
+
+const samePositions = (next: Float64Array) =>
+  next.length === positions.length && next.every((value, i) => value === positions[i]);
+
+self.onmessage = (event: MessageEvent<InverseDesignWorkerRequest>) => {
+  const { charges, probes, options } = event.data;
+  let reply: InverseDesignWorkerResult;
+  try {
+    if (!designer || !samePositions(charges.positions)) {
+      designer = new InverseDesigner(charges);
+      positions = charges.positions;
+    }
+    designer.syncProbes(probes);
+    reply = { result: designer.probeCount > 0 ? designer.solve(options) : null };
+  } catch (error) {
+    designer = null;
+    reply = { error: error instanceof Error ? error.message : String(error) };
+  }
+  const transfer = 'result' in reply && reply.result ? [reply.result.magnitudes.buffer as ArrayBuffer] : [];
+  self.postMessage(reply, { transfer });
+};
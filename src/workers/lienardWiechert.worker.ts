@@ -0,0 +1,41 @@
+import { lienardWiechertFieldBatch } from '../models/LienardWiechert';
+import type { MovingCharge } from '../models/LienardWiechert';
+
+export type LienardWiechertWorkerRequest =
+  | { type: 'configure'; charges: MovingCharge[]; points: Float32Array; speedOfLight: number }
+  // The output buffer is handed over by the caller and transferred back filled
+  | { type: 'evaluate'; time: number; generation: number; field: Float32Array };
+
+export interface LienardWiechertWorkerResult {
+  type: 'field';
+  time: number;
+  generation: number; // Echoed so results from an older configuration can be dropped
+  field: Float32Array;
+}
+
+let charges: MovingCharge[] = [];
+let points: Float32Array = new Float32Array(0);
+let speedOfLight = 1;
+// Previous retarded-time solutions, one per charge/point pair (warm starts)
+let retardedTimes: Float64Array = new Float64Array(0);
+
+self.onmessage = (event: MessageEvent<LienardWiechertWorkerRequest>) => {
+  const message = event.data;
+
+  switch (message.type) {
+    case 'configure':
+      charges = message.charges;
+      points = message.points;
+      speedOfLight = message.speedOfLight;
+      retardedTimes = new Float64Array(charges.length * (points.length / 3)).fill(NaN);
+      break;
+
+    case 'evaluate': {
+      const { field, time, generation } = message;
+      lienardWiechertFieldBatch(charges, points, time, speedOfLight, retardedTimes, field);
+      const result: LienardWiechertWorkerResult = { type: 'field', time, generation, field };
+      self.postMessage(result, { transfer: [field.buffer as ArrayBuffer] });
+      break;
+    }
+  }
+};
@@ -0,0 +1,104 @@
+import { FieldLattice } from '../models/FieldLattice';
+import type { LatticeBounds } from '../models/FieldLattice';
+import type { PackedCharges } from '../models/FieldKernel';
+import { emptyFieldSources } from '../models/FieldSources';
+import type { DatasetMessage, FieldSources } from '../models/FieldSources';
+import { createParticleState, spawnParticles, stepParticles } from '../models/TestParticles';
+import type { ParticleState, ParticleSwarmConfig } from '../models/TestParticles';
+
+export type ParticleWorkerRequest =
+  | {
+      type: 'configure';
+      capacity: number;
+      bounds: LatticeBounds;
+      resolution: number;
+      captureRadius: number;
+    }
+  // Always followed by a 'charges' message, which rebuilds the lattice
+  | DatasetMessage
+  // Answered with a 'lattice' reply once the rebuild is done
+  | { type: 'charges'; charges: PackedCharges }
+  | { type: 'spawn'; swarm: ParticleSwarmConfig }
+  | { type: 'clear' }
+  // Output buffers are handed over by the caller and transferred back filled
+  | { type: 'step'; dt: number; substeps: number; positions: Float32Array; alive: Uint8Array };
+
+export interface ParticleWorkerStepResult {
+  type: 'step';
+  count: number;
+  positions: Float32Array;
+  alive: Uint8Array;
+}
+
+export type ParticleWorkerResult = ParticleWorkerStepResult | { type: 'lattice' };
+
+let state: ParticleState = createParticleState(0);
+let bounds: LatticeBounds | null = null;
+let resolution = 48;
+let captureRadius = 0.2;
+let sources: FieldSources = emptyFieldSources();
+let lattice: FieldLattice | null = null;
+
+const rebuildLattice = () => {
+  lattice = bounds ? FieldLattice.build(sources, bounds, resolution, true) : null;
+};
+
+self.onmessage = (event: MessageEvent<ParticleWorkerRequest>) => {
+  const message = event.data;
+
+  switch (message.type) {
+    case 'configure':
+      state = createParticleState(message.capacity);
+      bounds = message.bounds;
+      resolution = message.resolution;
+      captureRadius = message.captureRadius;
+      rebuildLattice();
+      break;
+
+    case 'dataset':
+      sources = { ...sources, dataset: message.dataset };
+      break;
+
+    case 'charges': {
+      sources = { ...sources, charges: message.charges };
+      rebuildLattice();
+      const result: ParticleWorkerResult = { type: 'lattice' };
+      self.postMessage(result);
+      break;
+    }
+
+    case 'spawn':
+      spawnParticles(state, message.swarm);
+      break;
+
+    case 'clear':
+      state.count = 0;
+      state.alive.fill(0);
+      break;
+
+    case 'step': {
+      if (lattice) {
+        const dt = message.dt / message.substeps;
+        for (let s = 0; s < message.substeps; s++) {
+          // Only the editable charges capture particles; the dataset acts through the lattice
+          stepParticles(state, lattice, sources.charges, dt, captureRadius);
+        }
+      }
+
+      const { positions, alive } = message;
+      positions.set(state.positions.subarray(0, state.count * 3));
+      alive.set(state.alive.subarray(0, state.count));
+
+      const result: ParticleWorkerResult = {
+        type: 'step',
+        count: state.count,
+        positions,
+        alive,
+      };
+      self.postMessage(result, {
+        transfer: [positions.buffer as ArrayBuffer, alive.buffer as ArrayBuffer],
+      });
+      break;
+    }
+  }
+};
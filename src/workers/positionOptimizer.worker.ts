@@ -0,0 +1,54 @@
+import { minimizeLbfgs } from '../models/Lbfgs';
+import type { LbfgsOptions, LbfgsStopReason } from '../models/Lbfgs';
+import { PositionObjectiveEvaluator } from '../models/PositionObjective';
+import type { PositionObjective, PositionPenalties } from '../models/PositionObjective';
+import type { PackedCharges } from '../models/FieldKernel';
+
+export interface PositionOptimizerRequest {
+  charges: PackedCharges; // Starting positions; magnitudes stay fixed
+  objective: PositionObjective;
+  penalties: PositionPenalties;
+  options: LbfgsOptions;
+}
+
+export type PositionOptimizerMessage =
+  | { type: 'iteration'; iteration: number; value: number; gradientNorm: number; positions: Float64Array }
+  | { type: 'done'; reason: LbfgsStopReason; iterations: number; evaluations: number; value: number };
+
+// One run per worker: the caller terminates the worker to cancel
+self.onmessage = (event: MessageEvent<PositionOptimizerRequest>) => {
+  const { charges, objective, penalties, options } = event.data;
+  const evaluator = new PositionObjectiveEvaluator(charges, objective, penalties);
+
+  const post = (message: PositionOptimizerMessage) => {
+    self.postMessage(message, message.type === 'iteration' ? { transfer: [message.positions.buffer as ArrayBuffer] } : {});
+  };
+
+  const start = Float64Array.from(charges.positions);
+  const initialGradient = new Float64Array(start.length);
+  post({
+    type: 'iteration',
+    iteration: 0,
+    value: evaluator.evaluate(start, initialGradient),
+    gradientNorm: initialGradient.reduce((max, g) => Math.max(max, Math.abs(g)), 0),
+    positions: Float64Array.from(start),
+  });
+
+  const result = minimizeLbfgs(evaluator.evaluate, start, options, (iterate) => {
+    post({
+      type: 'iteration',
+      iteration: iterate.iteration,
+      value: iterate.value,
+      gradientNorm: iterate.gradientNorm,
+      positions: iterate.x,
+    });
+    return true;
+  });
+  post({
+    type: 'done',
+    reason: result.reason,
+    iterations: result.iterations,
+    evaluations: evaluator.evaluations,
+    value: result.value,
+  });
+};
@@ -0,0 +1,34 @@
+import type { PackedCharges } from '../models/FieldKernel';
+import { emptyFieldSources } from '../models/FieldSources';
+import type { DatasetMessage } from '../models/FieldSources';
+import { sampleSliceRows } from '../models/PotentialSlice';
+import type { SlicePlane } from '../models/PotentialSlice';
+
+export type PotentialSliceWorkerRequest =
+  | DatasetMessage
+  | {
+      type: 'rows';
+      charges: PackedCharges;
+      plane: SlicePlane;
+      resolution: number;
+      rowStart: number;
+      rowEnd: number;
+    };
+
+export interface PotentialSliceWorkerResult {
+  rowStart: number;
+  potential: Float32Array;
+}
+
+let dataset = emptyFieldSources().dataset;
+
+self.onmessage = (event: MessageEvent<PotentialSliceWorkerRequest>) => {
+  if (event.data.type === 'dataset') {
+    dataset = event.data.dataset;
+    return;
+  }
+  const { charges, plane, resolution, rowStart, rowEnd } = event.data;
+  const potential = sampleSliceRows({ charges, dataset }, plane, resolution, rowStart, rowEnd);
+  const result: PotentialSliceWorkerResult = { rowStart, potential };
+  self.postMessage(result, { transfer: [potential.buffer as ArrayBuffer] });
+};
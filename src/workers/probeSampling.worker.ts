@@ -0,0 +1,38 @@
+import type { PackedCharges } from '../models/FieldKernel';
+import { emptyFieldSources } from '../models/FieldSources';
+import type { DatasetMessage } from '../models/FieldSources';
+import { sampleProbeShape } from '../models/ProbeSampling';
+import type { ProbeSamples, ProbeShape } from '../models/ProbeSampling';
+
+export type ProbeSamplingWorkerRequest =
+  | DatasetMessage
+  | {
+      type: 'sample';
+      generation: number;
+      charges: PackedCharges;
+      shape: ProbeShape;
+    };
+
+export interface ProbeSamplingWorkerResult {
+  generation: number;
+  samples: ProbeSamples;
+}
+
+let dataset = emptyFieldSources().dataset;
+
+self.onmessage = (event: MessageEvent<ProbeSamplingWorkerRequest>) => {
+  if (event.data.type === 'dataset') {
+    dataset = event.data.dataset;
+    return;
+  }
+  const { generation, charges, shape } = event.data;
+  const samples = sampleProbeShape({ charges, dataset }, shape);
+  const result: ProbeSamplingWorkerResult = { generation, samples };
+  self.postMessage(result, {
+    transfer: [
+      samples.potential.buffer as ArrayBuffer,
+      samples.fieldMagnitude.buffer as ArrayBuffer,
+      ...samples.coordinates.map((coordinate) => coordinate.buffer as ArrayBuffer),
+    ],
+  });
+};
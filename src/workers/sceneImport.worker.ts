@@ -0,0 +1,37 @@
+import { SceneDecoder } from '../export/SceneFile';
+import type { SceneData } from '../export/SceneFile';
+
+export interface SceneImportWorkerRequest {
+  file: File;
+}
+
+export type SceneImportWorkerMessage =
+  | { type: 'progress'; loaded: number; total: number }
+  | { type: 'done'; scene: SceneData }
+  | { type: 'error'; message: string };
+
+const PROGRESS_INTERVAL = 8 * 1024 * 1024; // Bytes between progress messages
+
+self.onmessage = async (event: MessageEvent<SceneImportWorkerRequest>) => {
+  const { file } = event.data;
+  const post = (message: SceneImportWorkerMessage, transfer: Transferable[] = []) =>
+    self.postMessage(message, { transfer });
+  try {
+    const decoder = new SceneDecoder();
+    const reader = file.stream().getReader();
+    let reported = 0;
+    for (;;) {
+      const { done, value } = await reader.read();
+      if (done) break;
+      decoder.push(value);
+      if (decoder.bytesRead - reported >= PROGRESS_INTERVAL) {
+        reported = decoder.bytesRead;
+        post({ type: 'progress', loaded: reported, total: file.size });
+      }
+    }
+    const scene = decoder.finish();
+    post({ type: 'done', scene }, [scene.positions.buffer as ArrayBuffer, scene.magnitudes.buffer as ArrayBuffer]);
+  } catch (error) {
+    post({ type: 'error', message: error instanceof Error ? error.message : String(error) });
+  }
+};
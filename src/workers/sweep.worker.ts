@@ -0,0 +1,18 @@
+import { evaluateSweepRange } from '../models/ParameterSweep';
+import type { SweepSpec } from '../models/ParameterSweep';
+
+export interface SweepWorkerRequest {
+  spec: SweepSpec;
+  indices: Uint32Array; // Configurations to evaluate, a slice of the evaluation order
+}
+
+export interface SweepWorkerResult {
+  rows: Float64Array; // Metrics per configuration, same order as `indices`
+}
+
+self.onmessage = (event: MessageEvent<SweepWorkerRequest>) => {
+  const { spec, indices } = event.data;
+  const rows = evaluateSweepRange(spec, indices, 0, indices.length);
+  const result: SweepWorkerResult = { rows };
+  self.postMessage(result, { transfer: [rows.buffer as ArrayBuffer] });
+};
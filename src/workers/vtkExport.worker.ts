@@ -0,0 +1,15 @@
+import { buildVtkExport } from '../export/VtkExport';
+import type { VtkExportRequest } from '../export/VtkExport';
+import type { TarEntry } from '../export/TarArchive';
+
+export type VtkExportWorkerRequest = VtkExportRequest;
+
+export interface VtkExportWorkerResult {
+  entries: TarEntry[];
+}
+
+self.onmessage = (event: MessageEvent<VtkExportWorkerRequest>) => {
+  const entries = buildVtkExport(event.data);
+  const result: VtkExportWorkerResult = { entries };
+  self.postMessage(result, { transfer: entries.map((entry) => entry.data.buffer as ArrayBuffer) });
+};
@@ -0,0 +1,19 @@
+import { defineConfig } from 'vite'
+
+// Builds the DOM-free Node tools in scripts/ (no React or Cloudflare plugins)
+export default defineConfig({
+  build: {
+    ssr: true,
+    outDir: 'dist-node',
+    emptyOutDir: true,
+    target: 'node20',
+    rollupOptions: {
+      input: {
+        'export-frames': 'scripts/export-frames.ts',
+        'run-sweep': 'scripts/run-sweep.ts',
+        'export-vtk': 'scripts/export-vtk.ts',
+      },
+      output: { entryFileNames: '[name].js' },
+    },
+  },
+})